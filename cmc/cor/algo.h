@@ -0,0 +1,80 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * algo.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by the algorithms in cor/algo/code.h.
+ *
+ * Every algorithm takes how many threads it may use. The array is split in as
+ * many contiguous slices, each handled by one cmc_thread worker, with the
+ * first slice handled by the calling thread.
+ */
+
+#ifndef CMC_COR_ALGO_H
+#define CMC_COR_ALGO_H
+
+#include "core.h"
+
+/**
+ * CMC_ALGO_THREADS
+ *
+ * Size of the pool of threads that split the work of an algorithm, counting
+ * the thread that called it. Larger thread counts are clamped to it.
+ */
+#define CMC_ALGO_THREADS 64
+
+/**
+ * CMC_ALGO_PARALLEL_THRESHOLD
+ *
+ * Minimum amount of elements given to each thread.
+ */
+#define CMC_ALGO_PARALLEL_THRESHOLD 1024
+
+/**
+ * enum cmc_algo_op
+ *
+ * What a worker does with its slice of the array.
+ */
+enum cmc_algo_op
+{
+    CMC_ALGO_FOR_EACH, // Visits every element
+    CMC_ALGO_MAP,      // Writes the mapped elements to another array
+    CMC_ALGO_COUNT,    // Counts the elements that satisfy a predicate
+    CMC_ALGO_REDUCE,   // Reduces the slice to one value
+    CMC_ALGO_FILL,     // Overwrites every element with a value
+    CMC_ALGO_MASK,     // Stores the result of a predicate for every element
+    CMC_ALGO_TALLY,    // Counts the elements marked in a mask
+    CMC_ALGO_SCATTER   // Copies the elements to one of two arrays by a mask
+};
+
+#endif /* CMC_COR_ALGO_H */
@@ -0,0 +1,370 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * code.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Algorithms shared by the array based collections with the ALGO extension.
+ * This file is included once for every collection that uses it, after its
+ * header and before its code, generating functions for V with the prefix PFX.
+ *
+ * Every algorithm splits the array into up to n_threads contiguous slices (see
+ * cor/algo.h). The first slice is handled by the calling thread and each of the
+ * others by a cmc_thread worker. If a worker can't be spawned, its slice is
+ * handled by the calling thread too. The user functions are called from many
+ * threads at once and must be safe to do so.
+ *
+ * - _impl_algo_reduce: the first slice is reduced starting from the initial
+ *   value and every other slice from its first element. The partial results
+ *   are then reduced in order. This is the same as reducing the whole array
+ *   from the start as long as the reducer is associative.
+ * - _impl_algo_mask and _impl_algo_scatter: a stable partition in two passes.
+ *   The first one stores the result of the predicate for every element so that
+ *   the predicate is called only once for each of them. The second one counts
+ *   the marked elements of each slice, so that every worker knows where to
+ *   start writing, and then copies the elements.
+ */
+
+/* A slice of the array and what is done with it */
+struct CMC_(SNAME, _algo_task)
+{
+    enum cmc_algo_op op;
+    V *array;
+    size_t begin;
+    size_t end;
+    /* Output arrays. Elements marked in mask go to accepted and the others */
+    /* to rejected, if not NULL. */
+    V *accepted;
+    V *rejected;
+    bool *mask;
+    /* Where this slice starts writing to accepted and rejected */
+    size_t offset_accepted;
+    size_t offset_rejected;
+    /* User functions */
+    void (*visitor)(V, void *);
+    V (*mapper)(V, void *);
+    bool (*predicate)(V, void *);
+    V (*reducer)(V, V, void *);
+    V (*cpy)(V);
+    void *args;
+    /* Value to fill the slice with or result of a reduction */
+    V value;
+    /* If the reduction starts from value instead of the first element */
+    bool seeded;
+    /* Result of counting */
+    size_t count;
+    /* The worker thread running this task */
+    struct cmc_thread thread;
+    /* If the worker thread was successfully created */
+    bool spawned;
+};
+
+/* Implementation Detail Functions */
+int CMC_(PFX, _impl_algo_worker)(void *args);
+size_t CMC_(PFX, _impl_algo_split)(struct CMC_(SNAME, _algo_task) *tasks, enum cmc_algo_op op, V *array, size_t count,
+                                   size_t n_threads);
+void CMC_(PFX, _impl_algo_run)(struct CMC_(SNAME, _algo_task) *tasks, size_t n_tasks);
+void CMC_(PFX, _impl_algo_for_each)(V *array, size_t count, void (*visitor)(V, void *), void *args, size_t n_threads);
+void CMC_(PFX, _impl_algo_map)(V *array, size_t count, V *result, V (*mapper)(V, void *), void *args,
+                               size_t n_threads);
+size_t CMC_(PFX, _impl_algo_count)(V *array, size_t count, bool (*predicate)(V, void *), void *args,
+                                   size_t n_threads);
+V CMC_(PFX, _impl_algo_reduce)(V *array, size_t count, V initial, V (*reducer)(V, V, void *), void *args,
+                               size_t n_threads);
+void CMC_(PFX, _impl_algo_fill)(V *array, size_t count, V value, V (*cpy)(V), size_t n_threads);
+size_t CMC_(PFX, _impl_algo_mask)(V *array, size_t count, bool *mask, bool (*predicate)(V, void *), void *args,
+                                  size_t n_threads);
+void CMC_(PFX, _impl_algo_scatter)(V *array, size_t count, bool *mask, V *accepted, V *rejected, size_t n_threads);
+
+int CMC_(PFX, _impl_algo_worker)(void *args)
+{
+    struct CMC_(SNAME, _algo_task) *task = args;
+
+    V *array = task->array;
+
+    switch (task->op)
+    {
+    case CMC_ALGO_FOR_EACH:
+        for (size_t i = task->begin; i < task->end; i++)
+            task->visitor(array[i], task->args);
+        break;
+    case CMC_ALGO_MAP:
+        for (size_t i = task->begin; i < task->end; i++)
+            task->accepted[i] = task->mapper(array[i], task->args);
+        break;
+    case CMC_ALGO_COUNT:
+        task->count = 0;
+        for (size_t i = task->begin; i < task->end; i++)
+            task->count += task->predicate(array[i], task->args);
+        break;
+    case CMC_ALGO_REDUCE: {
+        size_t i = task->begin;
+        if (!task->seeded)
+            task->value = array[i++];
+        for (; i < task->end; i++)
+            task->value = task->reducer(task->value, array[i], task->args);
+        break;
+    }
+    case CMC_ALGO_FILL:
+        for (size_t i = task->begin; i < task->end; i++)
+            array[i] = task->cpy ? task->cpy(task->value) : task->value;
+        break;
+    case CMC_ALGO_MASK:
+        task->count = 0;
+        for (size_t i = task->begin; i < task->end; i++)
+        {
+            task->mask[i] = task->predicate(array[i], task->args);
+            task->count += task->mask[i];
+        }
+        break;
+    case CMC_ALGO_TALLY:
+        task->count = 0;
+        for (size_t i = task->begin; i < task->end; i++)
+            task->count += task->mask[i];
+        break;
+    case CMC_ALGO_SCATTER: {
+        V *accepted = task->accepted + task->offset_accepted;
+        V *rejected = task->rejected ? task->rejected + task->offset_rejected : NULL;
+        for (size_t i = task->begin; i < task->end; i++)
+        {
+            if (task->mask[i])
+                *accepted++ = array[i];
+            else if (rejected)
+                *rejected++ = array[i];
+        }
+        break;
+    }
+    }
+
+    return 0;
+}
+
+/* Splits the array between up to n_threads tasks and returns how many were */
+/* used. Each task gets at least CMC_ALGO_PARALLEL_THRESHOLD elements. */
+size_t CMC_(PFX, _impl_algo_split)(struct CMC_(SNAME, _algo_task) *tasks, enum cmc_algo_op op, V *array, size_t count,
+                                   size_t n_threads)
+{
+    if (n_threads > CMC_ALGO_THREADS)
+        n_threads = CMC_ALGO_THREADS;
+    if (n_threads > count / CMC_ALGO_PARALLEL_THRESHOLD)
+        n_threads = count / CMC_ALGO_PARALLEL_THRESHOLD;
+    if (n_threads < 1)
+        n_threads = 1;
+
+    for (size_t t = 0; t < n_threads; t++)
+    {
+        tasks[t].op = op;
+        tasks[t].array = array;
+        tasks[t].begin = count * t / n_threads;
+        tasks[t].end = count * (t + 1) / n_threads;
+    }
+
+    return n_threads;
+}
+
+/* Runs every task, the first one in the current thread */
+void CMC_(PFX, _impl_algo_run)(struct CMC_(SNAME, _algo_task) *tasks, size_t n_tasks)
+{
+    for (size_t t = 1; t < n_tasks; t++)
+        tasks[t].spawned = cmc_thrd_create(&tasks[t].thread, CMC_(PFX, _impl_algo_worker), &tasks[t]);
+
+    CMC_(PFX, _impl_algo_worker)(&tasks[0]);
+
+    for (size_t t = 1; t < n_tasks; t++)
+    {
+        /* Could not spawn a thread so do the work here */
+        if (!tasks[t].spawned)
+            CMC_(PFX, _impl_algo_worker)(&tasks[t]);
+        else
+            cmc_thrd_join(&tasks[t].thread, NULL);
+    }
+}
+
+void CMC_(PFX, _impl_algo_for_each)(V *array, size_t count, void (*visitor)(V, void *), void *args, size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_FOR_EACH, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].visitor = visitor;
+        tasks[t].args = args;
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+}
+
+/* Writes the mapped elements to result, which can be the array itself */
+void CMC_(PFX, _impl_algo_map)(V *array, size_t count, V *result, V (*mapper)(V, void *), void *args,
+                               size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_MAP, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].accepted = result;
+        tasks[t].mapper = mapper;
+        tasks[t].args = args;
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+}
+
+size_t CMC_(PFX, _impl_algo_count)(V *array, size_t count, bool (*predicate)(V, void *), void *args,
+                                   size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_COUNT, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].predicate = predicate;
+        tasks[t].args = args;
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+
+    size_t result = 0;
+
+    for (size_t t = 0; t < n_tasks; t++)
+        result += tasks[t].count;
+
+    return result;
+}
+
+V CMC_(PFX, _impl_algo_reduce)(V *array, size_t count, V initial, V (*reducer)(V, V, void *), void *args,
+                               size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_REDUCE, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].reducer = reducer;
+        tasks[t].args = args;
+        tasks[t].seeded = t == 0;
+    }
+
+    tasks[0].value = initial;
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+
+    V result = tasks[0].value;
+
+    for (size_t t = 1; t < n_tasks; t++)
+        result = reducer(result, tasks[t].value, args);
+
+    return result;
+}
+
+/* Overwrites every element with value or a copy of it if cpy is not NULL */
+void CMC_(PFX, _impl_algo_fill)(V *array, size_t count, V value, V (*cpy)(V), size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_FILL, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].value = value;
+        tasks[t].cpy = cpy;
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+}
+
+/* Stores the result of the predicate for every element in mask and returns */
+/* how many elements satisfy it */
+size_t CMC_(PFX, _impl_algo_mask)(V *array, size_t count, bool *mask, bool (*predicate)(V, void *), void *args,
+                                  size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_MASK, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].mask = mask;
+        tasks[t].predicate = predicate;
+        tasks[t].args = args;
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+
+    size_t result = 0;
+
+    for (size_t t = 0; t < n_tasks; t++)
+        result += tasks[t].count;
+
+    return result;
+}
+
+/* Copies the elements marked in mask to accepted and the others to rejected */
+/* if it is not NULL, keeping their order. Neither can overlap the array. */
+void CMC_(PFX, _impl_algo_scatter)(V *array, size_t count, bool *mask, V *accepted, V *rejected, size_t n_threads)
+{
+    struct CMC_(SNAME, _algo_task) tasks[CMC_ALGO_THREADS];
+
+    size_t n_tasks = CMC_(PFX, _impl_algo_split)(tasks, CMC_ALGO_TALLY, array, count, n_threads);
+
+    for (size_t t = 0; t < n_tasks; t++)
+        tasks[t].mask = mask;
+
+    if (n_tasks > 1)
+        CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+
+    size_t offset_accepted = 0;
+    size_t offset_rejected = 0;
+
+    for (size_t t = 0; t < n_tasks; t++)
+    {
+        tasks[t].op = CMC_ALGO_SCATTER;
+        tasks[t].accepted = accepted;
+        tasks[t].rejected = rejected;
+        tasks[t].offset_accepted = offset_accepted;
+        tasks[t].offset_rejected = offset_rejected;
+
+        /* A single task starts writing at the beginning of both arrays */
+        if (n_tasks > 1)
+        {
+            offset_accepted += tasks[t].count;
+            offset_rejected += (tasks[t].end - tasks[t].begin) - tasks[t].count;
+        }
+    }
+
+    CMC_(PFX, _impl_algo_run)(tasks, n_tasks);
+}
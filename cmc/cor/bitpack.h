@@ -0,0 +1,198 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * bitpack.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by bit-packed collections.
+ *
+ * A block of CMC_BITPACK_BLOCK 32-bit integers that fit in `width` bits is
+ * stored in exactly `4 * width` 32-bit words. The integers are laid out in 4
+ * interleaved lanes: integer i belongs to lane i % 4 and lane j only uses the
+ * words j, j + 4, j + 8, ... This way the four lanes can be packed and
+ * unpacked at once by a 128-bit SIMD register. When SSE2 is not available the
+ * same layout is unpacked one lane at a time.
+ */
+
+#ifndef CMC_COR_BITPACK_H
+#define CMC_COR_BITPACK_H
+
+#include "core.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * CMC_BITPACK_BLOCK
+ *
+ * How many integers are packed together in a block.
+ */
+#define CMC_BITPACK_BLOCK 128
+
+/**
+ * cmc_bitpack_width
+ *
+ * Minimum amount of bits needed to represent every integer of a block.
+ */
+static inline unsigned cmc_bitpack_width(const uint32_t *in)
+{
+    uint32_t all = 0;
+
+    for (size_t i = 0; i < CMC_BITPACK_BLOCK; i++)
+        all |= in[i];
+
+    unsigned width = 0;
+
+    while (all)
+    {
+        all >>= 1;
+        width++;
+    }
+
+    return width;
+}
+
+/**
+ * cmc_bitpack_pack
+ *
+ * Packs a block of integers into 4 * width words. Every integer must fit in
+ * width bits.
+ */
+static inline void cmc_bitpack_pack(const uint32_t *in, uint32_t *out, unsigned width)
+{
+    if (width == 0)
+        return;
+
+    for (size_t lane = 0; lane < 4; lane++)
+    {
+        uint32_t *word = out + lane;
+        unsigned shift = 0;
+
+        *word = 0;
+
+        for (size_t row = 0; row < CMC_BITPACK_BLOCK / 4; row++)
+        {
+            uint32_t value = in[row * 4 + lane];
+
+            *word |= value << shift;
+            shift += width;
+
+            if (shift >= 32)
+            {
+                shift -= 32;
+
+                if (row + 1 < CMC_BITPACK_BLOCK / 4 || shift > 0)
+                {
+                    word += 4;
+                    *word = shift > 0 ? value >> (width - shift) : 0;
+                }
+            }
+        }
+    }
+}
+
+/**
+ * cmc_bitpack_unpack
+ *
+ * Unpacks a block of integers that was packed with the same width.
+ */
+static inline void cmc_bitpack_unpack(const uint32_t *in, uint32_t *out, unsigned width)
+{
+    if (width == 0)
+    {
+        memset(out, 0, sizeof(uint32_t) * CMC_BITPACK_BLOCK);
+        return;
+    }
+
+    const uint32_t mask = width == 32 ? UINT32_MAX : (UINT32_C(1) << width) - 1;
+
+#if defined(__SSE2__)
+    const __m128i vmask = _mm_set1_epi32((int)mask);
+
+    __m128i current = _mm_loadu_si128((const __m128i *)in);
+    unsigned loaded = 1;
+    unsigned shift = 0;
+
+    for (size_t row = 0; row < CMC_BITPACK_BLOCK / 4; row++)
+    {
+        __m128i value = _mm_srl_epi32(current, _mm_cvtsi32_si128((int)shift));
+
+        shift += width;
+
+        if (shift >= 32)
+        {
+            shift -= 32;
+
+            if (loaded < width)
+            {
+                current = _mm_loadu_si128((const __m128i *)(in + 4 * loaded++));
+
+                if (shift > 0)
+                    value = _mm_or_si128(value, _mm_sll_epi32(current, _mm_cvtsi32_si128((int)(width - shift))));
+            }
+        }
+
+        _mm_storeu_si128((__m128i *)(out + row * 4), _mm_and_si128(value, vmask));
+    }
+#else
+    for (size_t lane = 0; lane < 4; lane++)
+    {
+        const uint32_t *word = in + lane;
+        unsigned shift = 0;
+
+        for (size_t row = 0; row < CMC_BITPACK_BLOCK / 4; row++)
+        {
+            uint32_t value = *word >> shift;
+
+            shift += width;
+
+            if (shift >= 32)
+            {
+                shift -= 32;
+
+                if (row + 1 < CMC_BITPACK_BLOCK / 4 || shift > 0)
+                {
+                    word += 4;
+
+                    if (shift > 0)
+                        value |= *word << (width - shift);
+                }
+            }
+
+            out[row * 4 + lane] = value & mask;
+        }
+    }
+#endif
+}
+
+#endif /* CMC_COR_BITPACK_H */
@@ -38,8 +38,9 @@
  * Here you will find:
  *  - CMC_
  *  - CMC_TO_STRING
- *  - CMC_INTERNAL_PREFIX_[ITER|NODE|ENTRY|FKEY|FVAL]
- *  - CMC_DEF_[ITER|NODE|ENTRY|FKEY|FVAL]
+ *  - CMC_PREFETCH
+ *  - CMC_INTERNAL_PREFIX_[ITER|NODE|ENTRY|FKEY|FVAL|FAGG|VIEW]
+ *  - CMC_DEF_[ITER|NODE|ENTRY|FKEY|FVAL|FAGG|VIEW]
  */
 
 #ifndef CMC_COR_CORE_H
@@ -65,6 +66,13 @@
 
 #define CMC_UNUSED_PARAM(param) ((void)param)
 
+/* Hints that the memory at addr will be read soon */
+#if defined(__GNUC__) || defined(__clang__)
+#define CMC_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+#define CMC_PREFETCH(addr) ((void)(addr))
+#endif
+
 #define CMC__(A, B) A##B
 #define CMC_(A, B) CMC__(A, B)
 
@@ -83,12 +91,16 @@
 #define CMC_INTERNAL_PREFIX_ENTRY Entry
 #define CMC_INTERNAL_PREFIX_FVAL FVal
 #define CMC_INTERNAL_PREFIX_FKEY FKey
+#define CMC_INTERNAL_PREFIX_FAGG FAgg
+#define CMC_INTERNAL_PREFIX_VIEW View
 #else
 #define CMC_INTERNAL_PREFIX_ITER _iter
 #define CMC_INTERNAL_PREFIX_NODE _node
 #define CMC_INTERNAL_PREFIX_ENTRY _entry
 #define CMC_INTERNAL_PREFIX_FVAL _fval
 #define CMC_INTERNAL_PREFIX_FKEY _fkey
+#define CMC_INTERNAL_PREFIX_FAGG _fagg
+#define CMC_INTERNAL_PREFIX_VIEW _view
 #endif
 
 #define CMC_DEF_ITER(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_ITER)
@@ -96,5 +108,7 @@
 #define CMC_DEF_ENTRY(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_ENTRY)
 #define CMC_DEF_FVAL(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_FVAL)
 #define CMC_DEF_FKEY(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_FKEY)
+#define CMC_DEF_FAGG(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_FAGG)
+#define CMC_DEF_VIEW(SNAME) CMC_(SNAME, CMC_INTERNAL_PREFIX_VIEW)
 
 #endif /* CMC_COR_CORE_H */
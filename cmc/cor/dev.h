@@ -43,4 +43,15 @@
 #define CMC_DEV_FCALL cmc_log_trace("fcall")
 #endif
 
+/* A view keeps the generation of the buffer of the collection it was taken */
+/* from, which changes every time that buffer is reallocated */
+#ifndef CMC_DEV_VIEW_CHECK
+#define CMC_DEV_VIEW_CHECK(view) \
+    do \
+    { \
+        if ((view)->target && (view)->generation != (view)->target->generation) \
+            cmc_log_error("view used after the buffer of its collection was reallocated"); \
+    } while (0)
+#endif
+
 #endif /* CMC_COR_DEV_H */
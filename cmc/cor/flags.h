@@ -57,6 +57,7 @@ enum cmc_flags
     CMC_FLAG_MUTEX     =  9, // Generic error regarding mutexes
     CMC_FLAG_FULL      = 10, // When a collection that doesn't resize is full
     CMC_FLAG_FTABLE    = 11, // When a required ftable function is missing
+    CMC_FLAG_IO        = 12, // Reading from or writing to a file failed
 };
 // clang-format on
 
@@ -65,8 +66,9 @@ enum cmc_flags
  *
  * Maps the error codes to their character representation.
  */
-CMC_UNUSED static const char *cmc_flags_to_str[12] = {
-    "OK", "ALLOC", "EMPTY", "NOT_FOUND", "INVALID", "RANGE", "DUPLICATE", "ERROR", "THREAD", "MUTEX", "FULL", "FTABLE"
+CMC_UNUSED static const char *cmc_flags_to_str[13] = {
+    "OK",    "ALLOC", "EMPTY", "NOT_FOUND", "INVALID", "RANGE",  "DUPLICATE",
+    "ERROR", "THREAD", "MUTEX", "FULL",     "FTABLE",  "IO"
 };
 
 #endif /* CMC_COR_FLAGS_H */
@@ -0,0 +1,111 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * growth.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Growth policy of the collections based on dynamic arrays.
+ *
+ * A full buffer is grown by CMC_GROWTH_FACTOR until its size reaches
+ * CMC_GROWTH_THRESHOLD bytes. Above it, the buffer grows by a fixed chunk of
+ * CMC_GROWTH_CHUNK bytes, which wastes much less memory on huge buffers. Each
+ * growth by a chunk is cheap only if the allocator doesn't copy the buffer,
+ * like cmc_alloc_node_mremap from utl/mremap.h, so the chunks are disabled by
+ * default.
+ *
+ * These can be defined before including any collection. The same policy is
+ * then used by every collection.
+ */
+
+#ifndef CMC_COR_GROWTH_H
+#define CMC_COR_GROWTH_H
+
+#include "core.h"
+
+/**
+ * CMC_GROWTH_FACTOR
+ *
+ * How many times larger a full buffer becomes when it is grown.
+ */
+#ifndef CMC_GROWTH_FACTOR
+#define CMC_GROWTH_FACTOR 2.0
+#endif
+
+/**
+ * CMC_GROWTH_THRESHOLD
+ *
+ * Size in bytes above which a buffer grows by CMC_GROWTH_CHUNK.
+ */
+#ifndef CMC_GROWTH_THRESHOLD
+#define CMC_GROWTH_THRESHOLD SIZE_MAX
+#endif
+
+/**
+ * CMC_GROWTH_CHUNK
+ *
+ * Amount of bytes added to a buffer larger than CMC_GROWTH_THRESHOLD.
+ */
+#ifndef CMC_GROWTH_CHUNK
+#define CMC_GROWTH_CHUNK ((size_t)1 << 26)
+#endif
+
+/**
+ * cmc_growth_capacity
+ *
+ * New capacity of a buffer of elements of size_of bytes that has to fit at
+ * least required elements. The result is always larger than capacity.
+ */
+static inline size_t cmc_growth_capacity(size_t capacity, size_t required, size_t size_of)
+{
+    size_t limit = SIZE_MAX / size_of;
+    size_t result;
+
+    if (capacity > CMC_GROWTH_THRESHOLD / size_of)
+    {
+        size_t chunk = CMC_GROWTH_CHUNK / size_of;
+
+        result = chunk > limit - capacity ? limit : capacity + (chunk > 0 ? chunk : 1);
+    }
+    else
+    {
+        double grown = (double)capacity * CMC_GROWTH_FACTOR;
+
+        result = grown >= (double)limit ? limit : (size_t)grown;
+    }
+
+    if (result <= capacity)
+        result = capacity + 1;
+
+    return result < required ? required : result;
+}
+
+#endif /* CMC_COR_GROWTH_H */
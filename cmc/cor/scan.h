@@ -0,0 +1,179 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * scan.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by the search and reduction kernels in cor/scan/code.h.
+ *
+ * The kernels work on arrays of arithmetic values and compare them with the
+ * built-in operators instead of a comparator function. When SSE2 is available,
+ * integers of 32 or 64 bits are compared against the searched value sixteen or
+ * eight at a time with SIMD equality comparisons.
+ */
+
+#ifndef CMC_COR_SCAN_H
+#define CMC_COR_SCAN_H
+
+#include "core.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * CMC_SCAN_LANES
+ *
+ * Amount of independent accumulators used by the reductions and of elements
+ * tested at once by the searches. Keeping them apart lets compilers put them
+ * in SIMD registers. For floating point values, this also fixes the order in
+ * which the elements are added.
+ */
+#define CMC_SCAN_LANES 16
+
+#if defined(__SSE2__)
+
+/**
+ * cmc_scan_skip_[32|64]
+ *
+ * Skips blocks of sixteen (32 bit) or eight (64 bit) integers starting at A
+ * that have no integer equal to value. Returns the index of the first block
+ * with a match, or where the last full block ends. The caller compares the
+ * remaining integers one by one.
+ */
+static inline size_t cmc_scan_skip_32(const void *A, size_t count, uint32_t value)
+{
+    const __m128i *p = (const __m128i *)A;
+    __m128i v = _mm_set1_epi32((int32_t)value);
+
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16, p += 4)
+    {
+        __m128i eq = _mm_cmpeq_epi32(_mm_loadu_si128(p), v);
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(_mm_loadu_si128(p + 1), v));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(_mm_loadu_si128(p + 2), v));
+        eq = _mm_or_si128(eq, _mm_cmpeq_epi32(_mm_loadu_si128(p + 3), v));
+
+        if (_mm_movemask_epi8(eq) != 0)
+            break;
+    }
+
+    return i;
+}
+
+/* Lanes of 64 bits where x and y are equal */
+static inline __m128i cmc_scan_cmpeq_64(__m128i x, __m128i y)
+{
+    __m128i eq = _mm_cmpeq_epi32(x, y);
+
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+
+static inline size_t cmc_scan_skip_64(const void *A, size_t count, uint64_t value)
+{
+    const __m128i *p = (const __m128i *)A;
+    __m128i v = _mm_set1_epi64x((int64_t)value);
+
+    size_t i = 0;
+
+    for (; i + 8 <= count; i += 8, p += 4)
+    {
+        __m128i eq = cmc_scan_cmpeq_64(_mm_loadu_si128(p), v);
+        eq = _mm_or_si128(eq, cmc_scan_cmpeq_64(_mm_loadu_si128(p + 1), v));
+        eq = _mm_or_si128(eq, cmc_scan_cmpeq_64(_mm_loadu_si128(p + 2), v));
+        eq = _mm_or_si128(eq, cmc_scan_cmpeq_64(_mm_loadu_si128(p + 3), v));
+
+        if (_mm_movemask_epi8(eq) != 0)
+            break;
+    }
+
+    return i;
+}
+
+/**
+ * cmc_scan_count_[32|64]
+ *
+ * Counts how many of the integers starting at A are equal to value, four (32
+ * bit) or two (64 bit) at a time. Only whole vectors are counted and how many
+ * integers were visited is returned through done.
+ */
+static inline size_t cmc_scan_count_32(const void *A, size_t count, uint32_t value, size_t *done)
+{
+    const __m128i *p = (const __m128i *)A;
+    __m128i v = _mm_set1_epi32((int32_t)value);
+
+    size_t result = 0;
+    size_t i = 0;
+
+    while (i + 4 <= count)
+    {
+        /* Each lane subtracts -1 on a match. Lanes are added up before they */
+        /* can overflow. */
+        __m128i acc = _mm_setzero_si128();
+
+        for (size_t n = 0; n < (1u << 30) && i + 4 <= count; n++, i += 4)
+            acc = _mm_sub_epi32(acc, _mm_cmpeq_epi32(_mm_loadu_si128(p++), v));
+
+        uint32_t lanes[4];
+        _mm_storeu_si128((__m128i *)lanes, acc);
+
+        result += (size_t)lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    *done = i;
+
+    return result;
+}
+
+static inline size_t cmc_scan_count_64(const void *A, size_t count, uint64_t value, size_t *done)
+{
+    const __m128i *p = (const __m128i *)A;
+    __m128i v = _mm_set1_epi64x((int64_t)value);
+    __m128i acc = _mm_setzero_si128();
+
+    size_t i = 0;
+
+    for (; i + 2 <= count; i += 2)
+        acc = _mm_sub_epi64(acc, cmc_scan_cmpeq_64(_mm_loadu_si128(p++), v));
+
+    uint64_t lanes[2];
+    _mm_storeu_si128((__m128i *)lanes, acc);
+
+    *done = i;
+
+    return (size_t)(lanes[0] + lanes[1]);
+}
+
+#endif /* __SSE2__ */
+
+#endif /* CMC_COR_SCAN_H */
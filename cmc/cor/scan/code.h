@@ -0,0 +1,213 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * code.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Search and reduction kernels for arrays of arithmetic values. This file is
+ * included once for every collection that defines CMC_ARITHMETIC_V, after its
+ * header and before its code, generating functions for V with the prefix PFX.
+ * Elements are compared with the built-in operators.
+ *
+ * - _impl_scan_find and _impl_scan_find_last: test CMC_SCAN_LANES elements at
+ *   a time and only look for the exact position in a block that has a match.
+ *   Blocks of 32 or 64 bit integers are tested with SIMD instructions.
+ * - _impl_scan_count: counts the elements equal to a value, with SIMD
+ *   instructions for 32 or 64 bit integers.
+ * - _impl_scan_min, _impl_scan_max and _impl_scan_sum: reduce the array into
+ *   CMC_SCAN_LANES independent accumulators, which compilers vectorize, and
+ *   then combine them.
+ */
+
+/* Implementation Detail Functions */
+size_t CMC_(PFX, _impl_scan_find)(V *A, size_t count, V value);
+size_t CMC_(PFX, _impl_scan_find_last)(V *A, size_t count, V value);
+size_t CMC_(PFX, _impl_scan_count)(V *A, size_t count, V value);
+V CMC_(PFX, _impl_scan_min)(V *A, size_t count);
+V CMC_(PFX, _impl_scan_max)(V *A, size_t count);
+V CMC_(PFX, _impl_scan_sum)(V *A, size_t count);
+
+/* Index of the first element equal to value or count if there is none */
+size_t CMC_(PFX, _impl_scan_find)(V *A, size_t count, V value)
+{
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    if ((V)0.5 == 0 && sizeof(V) == sizeof(uint32_t))
+        i = cmc_scan_skip_32(A, count, (uint32_t)value);
+    else if ((V)0.5 == 0 && sizeof(V) == sizeof(uint64_t))
+        i = cmc_scan_skip_64(A, count, (uint64_t)value);
+#endif
+
+    for (; i + CMC_SCAN_LANES <= count; i += CMC_SCAN_LANES)
+    {
+        bool match = false;
+
+        for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+            match |= A[i + j] == value;
+
+        if (match)
+            break;
+    }
+
+    for (; i < count; i++)
+    {
+        if (A[i] == value)
+            return i;
+    }
+
+    return count;
+}
+
+/* Index of the last element equal to value or count if there is none */
+size_t CMC_(PFX, _impl_scan_find_last)(V *A, size_t count, V value)
+{
+    size_t i = count;
+
+    for (; i >= CMC_SCAN_LANES; i -= CMC_SCAN_LANES)
+    {
+        bool match = false;
+
+        for (size_t j = 1; j <= CMC_SCAN_LANES; j++)
+            match |= A[i - j] == value;
+
+        if (match)
+            break;
+    }
+
+    for (; i > 0; i--)
+    {
+        if (A[i - 1] == value)
+            return i - 1;
+    }
+
+    return count;
+}
+
+size_t CMC_(PFX, _impl_scan_count)(V *A, size_t count, V value)
+{
+    size_t result = 0;
+    size_t i = 0;
+
+#if defined(__SSE2__)
+    if ((V)0.5 == 0 && sizeof(V) == sizeof(uint32_t))
+        result = cmc_scan_count_32(A, count, (uint32_t)value, &i);
+    else if ((V)0.5 == 0 && sizeof(V) == sizeof(uint64_t))
+        result = cmc_scan_count_64(A, count, (uint64_t)value, &i);
+#endif
+
+    for (; i < count; i++)
+        result += A[i] == value;
+
+    return result;
+}
+
+/* The array must not be empty */
+V CMC_(PFX, _impl_scan_min)(V *A, size_t count)
+{
+    V lanes[CMC_SCAN_LANES];
+
+    for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+        lanes[j] = A[0];
+
+    size_t i = 0;
+
+    for (; i + CMC_SCAN_LANES <= count; i += CMC_SCAN_LANES)
+    {
+        for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+            lanes[j] = A[i + j] < lanes[j] ? A[i + j] : lanes[j];
+    }
+
+    for (; i < count; i++)
+        lanes[0] = A[i] < lanes[0] ? A[i] : lanes[0];
+
+    V result = lanes[0];
+
+    for (size_t j = 1; j < CMC_SCAN_LANES; j++)
+        result = lanes[j] < result ? lanes[j] : result;
+
+    return result;
+}
+
+/* The array must not be empty */
+V CMC_(PFX, _impl_scan_max)(V *A, size_t count)
+{
+    V lanes[CMC_SCAN_LANES];
+
+    for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+        lanes[j] = A[0];
+
+    size_t i = 0;
+
+    for (; i + CMC_SCAN_LANES <= count; i += CMC_SCAN_LANES)
+    {
+        for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+            lanes[j] = A[i + j] > lanes[j] ? A[i + j] : lanes[j];
+    }
+
+    for (; i < count; i++)
+        lanes[0] = A[i] > lanes[0] ? A[i] : lanes[0];
+
+    V result = lanes[0];
+
+    for (size_t j = 1; j < CMC_SCAN_LANES; j++)
+        result = lanes[j] > result ? lanes[j] : result;
+
+    return result;
+}
+
+/* Sum of every element, computed in V */
+V CMC_(PFX, _impl_scan_sum)(V *A, size_t count)
+{
+    V lanes[CMC_SCAN_LANES];
+
+    for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+        lanes[j] = 0;
+
+    size_t i = 0;
+
+    for (; i + CMC_SCAN_LANES <= count; i += CMC_SCAN_LANES)
+    {
+        for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+            lanes[j] += A[i + j];
+    }
+
+    for (; i < count; i++)
+        lanes[0] += A[i];
+
+    V result = 0;
+
+    for (size_t j = 0; j < CMC_SCAN_LANES; j++)
+        result += lanes[j];
+
+    return result;
+}
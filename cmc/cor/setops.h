@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * setops.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by the set operation kernels in cor/setops/code.h.
+ *
+ * The kernels work on sorted arrays of arithmetic values and compare them with
+ * the built-in operators instead of a comparator function. Integers of 32 or
+ * 64 bits are also tested four against four at a time with SIMD equality
+ * comparisons when SSE2 is available.
+ */
+
+#ifndef CMC_COR_SETOPS_H
+#define CMC_COR_SETOPS_H
+
+#include "core.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/**
+ * CMC_SETOPS_GALLOP_RATIO
+ *
+ * When one array is this many times larger than the other, each element of
+ * the smaller array is searched in the larger one with an exponential search
+ * instead of merging both arrays.
+ */
+#define CMC_SETOPS_GALLOP_RATIO 32
+
+/**
+ * cmc_setops_any_equal_[32|64]
+ *
+ * If any of the four integers starting at a is equal to any of the four
+ * integers starting at b. Without SSE2 these are always true so that the
+ * caller falls back to comparing the elements one by one.
+ */
+static inline bool cmc_setops_any_equal_32(const void *a, const void *b)
+{
+#if defined(__SSE2__)
+    __m128i va = _mm_loadu_si128((const __m128i *)a);
+    __m128i vb = _mm_loadu_si128((const __m128i *)b);
+
+    /* Compare against every rotation of b */
+    __m128i eq = _mm_cmpeq_epi32(va, vb);
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+    eq = _mm_or_si128(eq, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+    return _mm_movemask_epi8(eq) != 0;
+#else
+    CMC_UNUSED_PARAM(a);
+    CMC_UNUSED_PARAM(b);
+
+    return true;
+#endif
+}
+
+#if defined(__SSE2__)
+/* Lanes of 64 bits where x and y are equal */
+static inline __m128i cmc_setops_cmpeq_64(__m128i x, __m128i y)
+{
+    __m128i eq = _mm_cmpeq_epi32(x, y);
+
+    return _mm_and_si128(eq, _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+}
+#endif
+
+static inline bool cmc_setops_any_equal_64(const void *a, const void *b)
+{
+#if defined(__SSE2__)
+    __m128i a0 = _mm_loadu_si128((const __m128i *)a);
+    __m128i a1 = _mm_loadu_si128((const __m128i *)a + 1);
+    __m128i b0 = _mm_loadu_si128((const __m128i *)b);
+    __m128i b1 = _mm_loadu_si128((const __m128i *)b + 1);
+
+    /* Same as b0 and b1 with their two halves swapped */
+    __m128i s0 = _mm_shuffle_epi32(b0, _MM_SHUFFLE(1, 0, 3, 2));
+    __m128i s1 = _mm_shuffle_epi32(b1, _MM_SHUFFLE(1, 0, 3, 2));
+
+    __m128i eq = cmc_setops_cmpeq_64(a0, b0);
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a0, s0));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a0, b1));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a0, s1));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a1, b0));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a1, s0));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a1, b1));
+    eq = _mm_or_si128(eq, cmc_setops_cmpeq_64(a1, s1));
+
+    return _mm_movemask_epi8(eq) != 0;
+#else
+    CMC_UNUSED_PARAM(a);
+    CMC_UNUSED_PARAM(b);
+
+    return true;
+#endif
+}
+
+#endif /* CMC_COR_SETOPS_H */
@@ -0,0 +1,251 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * code.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Set operation kernels for sorted arrays of arithmetic values. This file is
+ * included once for every collection that defines CMC_ARITHMETIC_V, after its
+ * header and before its code, generating functions for V with the prefix PFX.
+ * Equal elements are matched one to one, so for arrays with repeated elements
+ * the intersection keeps the smallest and the union the largest amount of
+ * each of them.
+ *
+ * - _impl_setops_intersection: merges both arrays skipping four elements at a
+ *   time while the blocks can't have anything in common. Blocks of integers
+ *   are tested for equal elements with SIMD instructions. When one array is
+ *   much smaller than the other it switches to _impl_setops_gallop.
+ * - _impl_setops_gallop: searches each element of the smaller array in the
+ *   larger one with an exponential search from the last match.
+ * - _impl_setops_union: branchless merge of both arrays. When one array is
+ *   much smaller than the other, the runs of the larger array between the
+ *   elements of the smaller one are found with an exponential search and
+ *   copied at once by _impl_setops_gallop_union.
+ */
+
+/* Implementation Detail Functions */
+size_t CMC_(PFX, _impl_setops_intersection)(V *A, size_t count_A, V *B, size_t count_B, V *result);
+size_t CMC_(PFX, _impl_setops_gallop)(V *A, size_t count_A, V *B, size_t count_B, V *result);
+size_t CMC_(PFX, _impl_setops_union)(V *A, size_t count_A, V *B, size_t count_B, V *result);
+size_t CMC_(PFX, _impl_setops_gallop_union)(V *A, size_t count_A, V *B, size_t count_B, V *result);
+size_t CMC_(PFX, _impl_setops_search)(V *B, size_t from, size_t count_B, V value);
+bool CMC_(PFX, _impl_setops_any_equal)(V *A, V *B);
+
+/* Writes the elements that are in both A and B to result, which must be */
+/* able to hold the smallest of both arrays. Returns how many were written. */
+size_t CMC_(PFX, _impl_setops_intersection)(V *A, size_t count_A, V *B, size_t count_B, V *result)
+{
+    if (count_A / CMC_SETOPS_GALLOP_RATIO > count_B)
+        return CMC_(PFX, _impl_setops_gallop)(B, count_B, A, count_A, result);
+    if (count_B / CMC_SETOPS_GALLOP_RATIO > count_A)
+        return CMC_(PFX, _impl_setops_gallop)(A, count_A, B, count_B, result);
+
+    size_t i = 0, j = 0, k = 0;
+
+    while (i + 4 <= count_A && j + 4 <= count_B)
+    {
+        V last_A = A[i + 3];
+        V last_B = B[j + 3];
+
+        /* A whole block is smaller than the other one */
+        if (last_A < B[j])
+        {
+            i += 4;
+            continue;
+        }
+
+        if (last_B < A[i])
+        {
+            j += 4;
+            continue;
+        }
+
+        /* Overlapping blocks without any element in common. Their last */
+        /* elements differ and the smaller one ends its block. */
+        if (!CMC_(PFX, _impl_setops_any_equal)(A + i, B + j))
+        {
+            if (last_A < last_B)
+                i += 4;
+            else
+                j += 4;
+
+            continue;
+        }
+
+        /* Merge until one of the blocks ends */
+        size_t end_A = i + 4, end_B = j + 4;
+
+        while (i < end_A && j < end_B)
+        {
+            V a = A[i], b = B[j];
+
+            result[k] = a;
+            k += a == b;
+            i += !(b < a);
+            j += !(a < b);
+        }
+    }
+
+    while (i < count_A && j < count_B)
+    {
+        V a = A[i], b = B[j];
+
+        result[k] = a;
+        k += a == b;
+        i += !(b < a);
+        j += !(a < b);
+    }
+
+    return k;
+}
+
+/* Intersection of a small array A with a much larger array B */
+size_t CMC_(PFX, _impl_setops_gallop)(V *A, size_t count_A, V *B, size_t count_B, V *result)
+{
+    size_t j = 0, k = 0;
+
+    for (size_t i = 0; i < count_A && j < count_B; i++)
+    {
+        V value = A[i];
+
+        j = CMC_(PFX, _impl_setops_search)(B, j, count_B, value);
+
+        if (j < count_B && B[j] == value)
+        {
+            result[k++] = value;
+            j++;
+        }
+    }
+
+    return k;
+}
+
+/* Writes the elements that are in A or B to result, which must be able to */
+/* hold both arrays. Returns how many were written. */
+size_t CMC_(PFX, _impl_setops_union)(V *A, size_t count_A, V *B, size_t count_B, V *result)
+{
+    if (count_A / CMC_SETOPS_GALLOP_RATIO > count_B)
+        return CMC_(PFX, _impl_setops_gallop_union)(B, count_B, A, count_A, result);
+    if (count_B / CMC_SETOPS_GALLOP_RATIO > count_A)
+        return CMC_(PFX, _impl_setops_gallop_union)(A, count_A, B, count_B, result);
+
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < count_A && j < count_B)
+    {
+        V a = A[i], b = B[j];
+        bool take_A = !(b < a);
+
+        result[k++] = take_A ? a : b;
+        i += take_A;
+        j += !(a < b);
+    }
+
+    if (i < count_A)
+    {
+        memcpy(result + k, A + i, sizeof(V) * (count_A - i));
+        k += count_A - i;
+    }
+
+    if (j < count_B)
+    {
+        memcpy(result + k, B + j, sizeof(V) * (count_B - j));
+        k += count_B - j;
+    }
+
+    return k;
+}
+
+/* Union of a small array A with a much larger array B */
+size_t CMC_(PFX, _impl_setops_gallop_union)(V *A, size_t count_A, V *B, size_t count_B, V *result)
+{
+    size_t j = 0, k = 0;
+
+    for (size_t i = 0; i < count_A; i++)
+    {
+        V value = A[i];
+
+        size_t next = CMC_(PFX, _impl_setops_search)(B, j, count_B, value);
+
+        memcpy(result + k, B + j, sizeof(V) * (next - j));
+        k += next - j;
+
+        result[k++] = value;
+        j = next < count_B && B[next] == value ? next + 1 : next;
+    }
+
+    memcpy(result + k, B + j, sizeof(V) * (count_B - j));
+
+    return k + (count_B - j);
+}
+
+/* Index of the first element of B from the index from onwards that is not */
+/* smaller than value, found with an exponential search */
+size_t CMC_(PFX, _impl_setops_search)(V *B, size_t from, size_t count_B, V value)
+{
+    if (from >= count_B || !(B[from] < value))
+        return from;
+
+    /* B[from + bound / 2] < value and value <= B[from + bound] */
+    size_t bound = 1;
+
+    while (from + bound < count_B && B[from + bound] < value)
+        bound *= 2;
+
+    size_t low = from + bound / 2;
+    size_t high = from + bound < count_B ? from + bound : count_B;
+
+    while (high - low > 1)
+    {
+        size_t middle = low + (high - low) / 2;
+
+        if (B[middle] < value)
+            low = middle;
+        else
+            high = middle;
+    }
+
+    return high;
+}
+
+/* If any of the four elements starting at A is equal to any of the four */
+/* elements starting at B. Only integers can be compared by their bits, so */
+/* for other types this is always true. */
+bool CMC_(PFX, _impl_setops_any_equal)(V *A, V *B)
+{
+    if ((V)0.5 == 0 && sizeof(V) == sizeof(uint32_t))
+        return cmc_setops_any_equal_32(A, B);
+    if ((V)0.5 == 0 && sizeof(V) == sizeof(uint64_t))
+        return cmc_setops_any_equal_64(A, B);
+
+    return true;
+}
@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * skiplist.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by skiplist collections.
+ */
+
+#ifndef CMC_COR_SKIPLIST_H
+#define CMC_COR_SKIPLIST_H
+
+#include "core.h"
+
+/**
+ * CMC_SKIPLIST_MAX_LEVEL
+ *
+ * Maximum amount of levels of a skiplist. Nodes are promoted to the next
+ * level with a probability of 1/2, so this is enough for 2^32 elements.
+ */
+#define CMC_SKIPLIST_MAX_LEVEL 32
+
+/**
+ * cmc_skiplist_seed
+ *
+ * Scrambles any value (like an address) into a non-zero random generator
+ * state using splitmix64.
+ */
+static inline uint64_t cmc_skiplist_seed(uint64_t x)
+{
+    x += UINT64_C(0x9E3779B97F4A7C15);
+    x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+    x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+    x = x ^ (x >> 31);
+
+    return x != 0 ? x : 1;
+}
+
+/**
+ * cmc_skiplist_level
+ *
+ * Advances a xorshift64* random generator state and picks the level of a new
+ * node. Level n is picked with a probability of 1/2^n.
+ */
+static inline size_t cmc_skiplist_level(uint64_t *state)
+{
+    uint64_t x = *state;
+
+    x ^= x >> 12;
+    x ^= x << 25;
+    x ^= x >> 27;
+
+    *state = x;
+
+    x *= UINT64_C(0x2545F4914F6CDD1D);
+
+    /* Each leading one bit promotes the node to the next level */
+    size_t level = 1;
+
+    while ((x & (UINT64_C(1) << 63)) && level < CMC_SKIPLIST_MAX_LEVEL)
+    {
+        x <<= 1;
+        level++;
+    }
+
+    return level;
+}
+
+#endif /* CMC_COR_SKIPLIST_H */
@@ -0,0 +1,130 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * sort.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Things commonly used by the sorting algorithms in cor/sort/code.h.
+ *
+ * A collection can be sorted with a radix sort by defining CMC_SORT_KEY
+ * before including it. CMC_SORT_KEY must name a function or macro that maps
+ * a V to an uint64_t such that keys are ordered exactly like f_val->cmp
+ * orders the values. The functions below do that for the built-in types.
+ */
+
+#ifndef CMC_COR_SORT_H
+#define CMC_COR_SORT_H
+
+#include "core.h"
+
+/**
+ * CMC_SORT_INSERTION_THRESHOLD
+ *
+ * Partitions smaller than this are sorted with an insertion sort.
+ */
+#define CMC_SORT_INSERTION_THRESHOLD 24
+
+/**
+ * CMC_SORT_NINTHER_THRESHOLD
+ *
+ * Partitions larger than this pick their pivot from nine elements instead of
+ * three.
+ */
+#define CMC_SORT_NINTHER_THRESHOLD 128
+
+/**
+ * CMC_SORT_RADIX_THRESHOLD
+ *
+ * Unstable sorts of arrays smaller than this don't use a radix sort even if
+ * CMC_SORT_KEY is defined since the counting passes would dominate.
+ */
+#define CMC_SORT_RADIX_THRESHOLD 1024
+
+/**
+ * CMC_SORT_PARALLEL_THRESHOLD
+ *
+ * Minimum amount of elements given to each thread of a parallel sort.
+ */
+#define CMC_SORT_PARALLEL_THRESHOLD 4096
+
+/**
+ * cmc_sort_log2
+ *
+ * Floor of the base 2 logarithm of n, or 0 if n is 0.
+ */
+static inline size_t cmc_sort_log2(size_t n)
+{
+    size_t log = 0;
+
+    while (n >>= 1)
+        log++;
+
+    return log;
+}
+
+/**
+ * cmc_sort_key_[u64|i64|f64|f32]
+ *
+ * Radix keys for the built-in types. Smaller integer types are converted to
+ * the 64 bits ones. Negative floating point numbers have all their bits
+ * flipped and positive ones only have their sign flipped. NaN is sorted
+ * after positive infinity or before negative infinity, depending on its sign.
+ */
+static inline uint64_t cmc_sort_key_u64(uint64_t value)
+{
+    return value;
+}
+
+static inline uint64_t cmc_sort_key_i64(int64_t value)
+{
+    return (uint64_t)value ^ (UINT64_C(1) << 63);
+}
+
+static inline uint64_t cmc_sort_key_f64(double value)
+{
+    uint64_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & (UINT64_C(1) << 63)) ? ~bits : bits | (UINT64_C(1) << 63);
+}
+
+static inline uint64_t cmc_sort_key_f32(float value)
+{
+    uint32_t bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+
+    return (bits & (UINT32_C(1) << 31)) ? (uint32_t)~bits : bits | (UINT32_C(1) << 31);
+}
+
+#endif /* CMC_COR_SORT_H */
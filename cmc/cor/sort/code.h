@@ -0,0 +1,687 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * code.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * Sorting algorithms shared by the array based collections. This file is
+ * included once for every collection that uses it, after its header and
+ * before its code, generating functions for V with the prefix PFX.
+ *
+ * - _impl_sort_unstable: pattern-defeating quicksort. A quicksort that uses
+ *   insertion sort for small partitions, detects already sorted partitions,
+ *   breaks up patterns that lead to bad partitions and falls back to heap sort
+ *   when partitioning keeps going badly. It is O(n log n) in the worst case.
+ * - _impl_sort_stable: bottom-up merge sort using a buffer as large as the
+ *   array. Already ordered runs are not merged.
+ * - If CMC_SORT_KEY is defined both use an LSD radix sort over the keys
+ *   instead. Passes over bytes that are the same for every key are skipped.
+ * - With CMC_EXT_PSORT, _impl_sort_parallel splits the array between
+ *   cmc_thread workers that sort their slices and then merge them in pairs.
+ */
+
+/* Implementation Detail Functions */
+void CMC_(PFX, _impl_sort_unstable)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc);
+bool CMC_(PFX, _impl_sort_stable)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc);
+void CMC_(PFX, _impl_sort_buffered)(V *array, V *buffer, size_t count, int (*cmp)(V, V));
+void CMC_(PFX, _impl_sort_insertion)(V *begin, V *end, int (*cmp)(V, V), bool leftmost);
+bool CMC_(PFX, _impl_sort_partial_insertion)(V *begin, V *end, int (*cmp)(V, V));
+void CMC_(PFX, _impl_sort_heapsort)(V *begin, V *end, int (*cmp)(V, V));
+void CMC_(PFX, _impl_sort_pdq)(V *begin, V *end, int (*cmp)(V, V), size_t bad_allowed, bool leftmost);
+void CMC_(PFX, _impl_sort_swap)(V *a, V *b);
+void CMC_(PFX, _impl_sort_sort3)(V *a, V *b, V *c, int (*cmp)(V, V));
+V *CMC_(PFX, _impl_sort_partition_right)(V *begin, V *end, int (*cmp)(V, V), bool *partitioned);
+V *CMC_(PFX, _impl_sort_partition_left)(V *begin, V *end, int (*cmp)(V, V));
+void CMC_(PFX, _impl_sort_merge)(V *from, V *to, size_t begin, size_t middle, size_t end, int (*cmp)(V, V));
+#ifdef CMC_SORT_KEY
+void CMC_(PFX, _impl_sort_radix)(V *array, V *buffer, size_t count);
+#endif
+
+/* Sorts an array in place. If CMC_SORT_KEY is defined, large arrays are */
+/* radix sorted when a buffer for them can be allocated. */
+void CMC_(PFX, _impl_sort_unstable)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc)
+{
+    if (count < 2)
+        return;
+
+#ifdef CMC_SORT_KEY
+    if (count >= CMC_SORT_RADIX_THRESHOLD)
+    {
+        V *buffer = alloc->malloc(sizeof(V) * count);
+
+        if (buffer)
+        {
+            CMC_(PFX, _impl_sort_radix)(array, buffer, count);
+            alloc->free(buffer);
+            return;
+        }
+    }
+#else
+    CMC_UNUSED_PARAM(alloc);
+#endif
+
+    CMC_(PFX, _impl_sort_pdq)(array, array + count, cmp, cmc_sort_log2(count), true);
+}
+
+/* Sorts an array keeping the order of equal elements. Returns false if the */
+/* buffer could not be allocated. */
+bool CMC_(PFX, _impl_sort_stable)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc)
+{
+    if (count <= CMC_SORT_INSERTION_THRESHOLD)
+    {
+        if (count > 1)
+            CMC_(PFX, _impl_sort_insertion)(array, array + count, cmp, true);
+
+        return true;
+    }
+
+    V *buffer = alloc->malloc(sizeof(V) * count);
+
+    if (!buffer)
+        return false;
+
+    CMC_(PFX, _impl_sort_buffered)(array, buffer, count, cmp);
+
+    alloc->free(buffer);
+
+    return true;
+}
+
+/* Stable sort with a buffer of count elements. The result is in array. */
+void CMC_(PFX, _impl_sort_buffered)(V *array, V *buffer, size_t count, int (*cmp)(V, V))
+{
+#ifdef CMC_SORT_KEY
+    CMC_UNUSED_PARAM(cmp);
+
+    CMC_(PFX, _impl_sort_radix)(array, buffer, count);
+#else
+    /* Small runs are sorted in place and then merged back and forth */
+    for (size_t i = 0; i < count; i += CMC_SORT_INSERTION_THRESHOLD)
+    {
+        size_t end = i + CMC_SORT_INSERTION_THRESHOLD < count ? i + CMC_SORT_INSERTION_THRESHOLD : count;
+
+        CMC_(PFX, _impl_sort_insertion)(array + i, array + end, cmp, true);
+    }
+
+    V *from = array;
+    V *to = buffer;
+
+    for (size_t width = CMC_SORT_INSERTION_THRESHOLD; width < count; width *= 2)
+    {
+        for (size_t i = 0; i < count; i += 2 * width)
+        {
+            size_t middle = i + width < count ? i + width : count;
+            size_t end = middle + width < count ? middle + width : count;
+
+            CMC_(PFX, _impl_sort_merge)(from, to, i, middle, end, cmp);
+        }
+
+        V *tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != array)
+        memcpy(array, from, sizeof(V) * count);
+#endif
+}
+
+/* Merges from[begin, middle) and from[middle, end) into to[begin, end) */
+void CMC_(PFX, _impl_sort_merge)(V *from, V *to, size_t begin, size_t middle, size_t end, int (*cmp)(V, V))
+{
+    /* Already in order */
+    if (middle == end || begin == middle || cmp(from[middle - 1], from[middle]) <= 0)
+    {
+        memcpy(to + begin, from + begin, sizeof(V) * (end - begin));
+        return;
+    }
+
+    size_t i = begin;
+    size_t j = middle;
+    size_t k = begin;
+
+    while (i < middle && j < end)
+    {
+        /* On ties the left run goes first */
+        if (cmp(from[j], from[i]) < 0)
+            to[k++] = from[j++];
+        else
+            to[k++] = from[i++];
+    }
+
+    memcpy(to + k, from + i, sizeof(V) * (middle - i));
+    k += middle - i;
+    memcpy(to + k, from + j, sizeof(V) * (end - j));
+}
+
+/* If leftmost is false the element before begin must not be greater than */
+/* any element in the range, which makes it a sentinel for the inner loop */
+void CMC_(PFX, _impl_sort_insertion)(V *begin, V *end, int (*cmp)(V, V), bool leftmost)
+{
+    if (begin == end)
+        return;
+
+    for (V *cur = begin + 1; cur != end; cur++)
+    {
+        V *sift = cur;
+        V *sift_1 = cur - 1;
+
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            V tmp = *sift;
+
+            do
+            {
+                *sift-- = *sift_1;
+            } while ((!leftmost || sift != begin) && cmp(tmp, *--sift_1) < 0);
+
+            *sift = tmp;
+        }
+    }
+}
+
+/* Insertion sort that gives up after moving a few elements. Returns true if */
+/* the range was sorted. */
+bool CMC_(PFX, _impl_sort_partial_insertion)(V *begin, V *end, int (*cmp)(V, V))
+{
+    if (begin == end)
+        return true;
+
+    size_t limit = 0;
+
+    for (V *cur = begin + 1; cur != end; cur++)
+    {
+        if (limit > 8)
+            return false;
+
+        V *sift = cur;
+        V *sift_1 = cur - 1;
+
+        if (cmp(*sift, *sift_1) < 0)
+        {
+            V tmp = *sift;
+
+            do
+            {
+                *sift-- = *sift_1;
+            } while (sift != begin && cmp(tmp, *--sift_1) < 0);
+
+            *sift = tmp;
+            limit += (size_t)(cur - sift);
+        }
+    }
+
+    return true;
+}
+
+void CMC_(PFX, _impl_sort_heapsort)(V *begin, V *end, int (*cmp)(V, V))
+{
+    size_t count = (size_t)(end - begin);
+
+    for (size_t i = count / 2; i-- > 0;)
+    {
+        /* Sift down */
+        for (size_t node = i, child; (child = 2 * node + 1) < count; node = child)
+        {
+            if (child + 1 < count && cmp(begin[child], begin[child + 1]) < 0)
+                child++;
+
+            if (cmp(begin[node], begin[child]) >= 0)
+                break;
+
+            V tmp = begin[node];
+            begin[node] = begin[child];
+            begin[child] = tmp;
+        }
+    }
+
+    for (size_t last = count; last-- > 1;)
+    {
+        V tmp = begin[0];
+        begin[0] = begin[last];
+        begin[last] = tmp;
+
+        for (size_t node = 0, child; (child = 2 * node + 1) < last; node = child)
+        {
+            if (child + 1 < last && cmp(begin[child], begin[child + 1]) < 0)
+                child++;
+
+            if (cmp(begin[node], begin[child]) >= 0)
+                break;
+
+            tmp = begin[node];
+            begin[node] = begin[child];
+            begin[child] = tmp;
+        }
+    }
+}
+
+/* Partitions [begin, end) around *begin. Elements equal to the pivot go to */
+/* the right. Sets partitioned if no elements had to be swapped. Returns the */
+/* final position of the pivot. */
+V *CMC_(PFX, _impl_sort_partition_right)(V *begin, V *end, int (*cmp)(V, V), bool *partitioned)
+{
+    V pivot = *begin;
+    V *first = begin;
+    V *last = end;
+
+    /* The median of three guarantees there is an element not less than the */
+    /* pivot so this loop stops */
+    while (cmp(*++first, pivot) < 0)
+        ;
+
+    /* If the first element was not less than the pivot there might not be */
+    /* an element less than it */
+    if (first - 1 == begin)
+    {
+        while (first < last && cmp(*--last, pivot) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+
+    *partitioned = first >= last;
+
+    while (first < last)
+    {
+        V tmp = *first;
+        *first = *last;
+        *last = tmp;
+
+        while (cmp(*++first, pivot) < 0)
+            ;
+        while (cmp(*--last, pivot) >= 0)
+            ;
+    }
+
+    V *pivot_pos = first - 1;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+
+    return pivot_pos;
+}
+
+/* Partitions [begin, end) around *begin putting elements equal to the pivot */
+/* to the left. Used when the pivot is equal to the element before begin, */
+/* in which case every element equal to it is already in place. */
+V *CMC_(PFX, _impl_sort_partition_left)(V *begin, V *end, int (*cmp)(V, V))
+{
+    V pivot = *begin;
+    V *first = begin;
+    V *last = end;
+
+    while (cmp(pivot, *--last) < 0)
+        ;
+
+    if (last + 1 == end)
+    {
+        while (first < last && cmp(pivot, *++first) >= 0)
+            ;
+    }
+    else
+    {
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+
+    while (first < last)
+    {
+        V tmp = *first;
+        *first = *last;
+        *last = tmp;
+
+        while (cmp(pivot, *--last) < 0)
+            ;
+        while (cmp(pivot, *++first) >= 0)
+            ;
+    }
+
+    V *pivot_pos = last;
+    *begin = *pivot_pos;
+    *pivot_pos = pivot;
+
+    return pivot_pos;
+}
+
+void CMC_(PFX, _impl_sort_pdq)(V *begin, V *end, int (*cmp)(V, V), size_t bad_allowed, bool leftmost)
+{
+    /* The right partition is sorted by the loop and the left one recursively */
+    while (true)
+    {
+        size_t size = (size_t)(end - begin);
+
+        if (size < CMC_SORT_INSERTION_THRESHOLD)
+        {
+            CMC_(PFX, _impl_sort_insertion)(begin, end, cmp, leftmost);
+            break;
+        }
+
+        /* The pivot is moved to begin */
+        size_t s2 = size / 2;
+
+        if (size > CMC_SORT_NINTHER_THRESHOLD)
+        {
+            CMC_(PFX, _impl_sort_sort3)(begin, begin + s2, end - 1, cmp);
+            CMC_(PFX, _impl_sort_sort3)(begin + 1, begin + (s2 - 1), end - 2, cmp);
+            CMC_(PFX, _impl_sort_sort3)(begin + 2, begin + (s2 + 1), end - 3, cmp);
+            CMC_(PFX, _impl_sort_sort3)(begin + (s2 - 1), begin + s2, begin + (s2 + 1), cmp);
+            CMC_(PFX, _impl_sort_swap)(begin, begin + s2);
+        }
+        else
+            CMC_(PFX, _impl_sort_sort3)(begin + s2, begin, end - 1, cmp);
+
+        /* If the pivot is equal to the element before this partition, which */
+        /* is not greater than any element in it, then every element equal to */
+        /* the pivot can be skipped. This makes many duplicates cheap. */
+        if (!leftmost && cmp(*(begin - 1), *begin) >= 0)
+        {
+            begin = CMC_(PFX, _impl_sort_partition_left)(begin, end, cmp) + 1;
+            continue;
+        }
+
+        bool partitioned;
+        V *pivot_pos = CMC_(PFX, _impl_sort_partition_right)(begin, end, cmp, &partitioned);
+
+        size_t l_size = (size_t)(pivot_pos - begin);
+        size_t r_size = (size_t)(end - (pivot_pos + 1));
+
+        if (l_size < size / 8 || r_size < size / 8)
+        {
+            /* Too many bad partitions */
+            if (--bad_allowed == 0)
+            {
+                CMC_(PFX, _impl_sort_heapsort)(begin, end, cmp);
+                break;
+            }
+
+            /* Shuffle a few elements to break up the pattern */
+            if (l_size >= CMC_SORT_INSERTION_THRESHOLD)
+            {
+                CMC_(PFX, _impl_sort_swap)(begin, begin + l_size / 4);
+                CMC_(PFX, _impl_sort_swap)(pivot_pos - 1, pivot_pos - l_size / 4);
+
+                if (l_size > CMC_SORT_NINTHER_THRESHOLD)
+                {
+                    CMC_(PFX, _impl_sort_swap)(begin + 1, begin + (l_size / 4 + 1));
+                    CMC_(PFX, _impl_sort_swap)(begin + 2, begin + (l_size / 4 + 2));
+                    CMC_(PFX, _impl_sort_swap)(pivot_pos - 2, pivot_pos - (l_size / 4 + 1));
+                    CMC_(PFX, _impl_sort_swap)(pivot_pos - 3, pivot_pos - (l_size / 4 + 2));
+                }
+            }
+
+            if (r_size >= CMC_SORT_INSERTION_THRESHOLD)
+            {
+                CMC_(PFX, _impl_sort_swap)(pivot_pos + 1, pivot_pos + (1 + r_size / 4));
+                CMC_(PFX, _impl_sort_swap)(end - 1, end - r_size / 4);
+
+                if (r_size > CMC_SORT_NINTHER_THRESHOLD)
+                {
+                    CMC_(PFX, _impl_sort_swap)(pivot_pos + 2, pivot_pos + (2 + r_size / 4));
+                    CMC_(PFX, _impl_sort_swap)(pivot_pos + 3, pivot_pos + (3 + r_size / 4));
+                    CMC_(PFX, _impl_sort_swap)(end - 2, end - (1 + r_size / 4));
+                    CMC_(PFX, _impl_sort_swap)(end - 3, end - (2 + r_size / 4));
+                }
+            }
+        }
+        else if (partitioned && CMC_(PFX, _impl_sort_partial_insertion)(begin, pivot_pos, cmp) &&
+                 CMC_(PFX, _impl_sort_partial_insertion)(pivot_pos + 1, end, cmp))
+        {
+            /* The partition was already sorted or very close to it */
+            break;
+        }
+
+        CMC_(PFX, _impl_sort_pdq)(begin, pivot_pos, cmp, bad_allowed, leftmost);
+
+        begin = pivot_pos + 1;
+        leftmost = false;
+    }
+}
+
+void CMC_(PFX, _impl_sort_swap)(V *a, V *b)
+{
+    V tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+/* Sorts the three elements */
+void CMC_(PFX, _impl_sort_sort3)(V *a, V *b, V *c, int (*cmp)(V, V))
+{
+    if (cmp(*b, *a) < 0)
+        CMC_(PFX, _impl_sort_swap)(a, b);
+    if (cmp(*c, *b) < 0)
+        CMC_(PFX, _impl_sort_swap)(b, c);
+    if (cmp(*b, *a) < 0)
+        CMC_(PFX, _impl_sort_swap)(a, b);
+}
+
+#ifdef CMC_SORT_KEY
+
+/* Sorts by the keys given by CMC_SORT_KEY, one byte at a time starting */
+/* from the least significant one. The result is in array. */
+void CMC_(PFX, _impl_sort_radix)(V *array, V *buffer, size_t count)
+{
+    size_t histogram[8][256] = { { 0 } };
+
+    for (size_t i = 0; i < count; i++)
+    {
+        uint64_t key = CMC_SORT_KEY(array[i]);
+
+        for (size_t b = 0; b < 8; b++)
+            histogram[b][(key >> (b * 8)) & 0xFF]++;
+    }
+
+    V *from = array;
+    V *to = buffer;
+
+    for (size_t b = 0; b < 8; b++)
+    {
+        size_t *counts = histogram[b];
+
+        /* Every key has the same byte here */
+        if (counts[(CMC_SORT_KEY(from[0]) >> (b * 8)) & 0xFF] == count)
+            continue;
+
+        size_t offset = 0;
+
+        for (size_t d = 0; d < 256; d++)
+        {
+            size_t c = counts[d];
+            counts[d] = offset;
+            offset += c;
+        }
+
+        for (size_t i = 0; i < count; i++)
+            to[counts[(CMC_SORT_KEY(from[i]) >> (b * 8)) & 0xFF]++] = from[i];
+
+        V *tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != array)
+        memcpy(array, from, sizeof(V) * count);
+}
+
+#endif /* CMC_SORT_KEY */
+
+#ifdef CMC_EXT_PSORT
+
+/* A slice of a parallel sort. Either the runs [begin, middle) and [middle, */
+/* end) of from are merged into to or the slice [begin, end) of from is */
+/* sorted using to as a buffer. */
+struct CMC_(SNAME, _sort_task)
+{
+    V *from;
+    V *to;
+    size_t begin;
+    size_t middle;
+    size_t end;
+    int (*cmp)(V, V);
+    /* If the task merges two runs instead of sorting */
+    bool merge;
+    /* The worker thread running this task */
+    struct cmc_thread thread;
+    /* If the worker thread was successfully created */
+    bool spawned;
+};
+
+int CMC_(PFX, _impl_sort_worker)(void *args);
+void CMC_(PFX, _impl_sort_run)(struct CMC_(SNAME, _sort_task) *tasks, size_t n_tasks);
+bool CMC_(PFX, _impl_sort_parallel)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc,
+                                    size_t n_threads);
+
+int CMC_(PFX, _impl_sort_worker)(void *args)
+{
+    struct CMC_(SNAME, _sort_task) *task = args;
+
+    if (task->merge)
+        CMC_(PFX, _impl_sort_merge)(task->from, task->to, task->begin, task->middle, task->end, task->cmp);
+    else
+        CMC_(PFX, _impl_sort_buffered)(task->from + task->begin, task->to + task->begin, task->end - task->begin,
+                                       task->cmp);
+
+    return 0;
+}
+
+/* Runs every task, the first one in the current thread */
+void CMC_(PFX, _impl_sort_run)(struct CMC_(SNAME, _sort_task) *tasks, size_t n_tasks)
+{
+    for (size_t t = 1; t < n_tasks; t++)
+        tasks[t].spawned = cmc_thrd_create(&tasks[t].thread, CMC_(PFX, _impl_sort_worker), &tasks[t]);
+
+    CMC_(PFX, _impl_sort_worker)(&tasks[0]);
+
+    for (size_t t = 1; t < n_tasks; t++)
+    {
+        /* Could not spawn a thread so do the work here */
+        if (!tasks[t].spawned)
+            CMC_(PFX, _impl_sort_worker)(&tasks[t]);
+        else
+            cmc_thrd_join(&tasks[t].thread, NULL);
+    }
+}
+
+/* Stable sort split between n_threads threads. Each one sorts a slice and */
+/* then pairs of adjacent slices are merged until one is left. Returns */
+/* false if memory could not be allocated. */
+bool CMC_(PFX, _impl_sort_parallel)(V *array, size_t count, int (*cmp)(V, V), CMC_ALLOC_TYPE alloc,
+                                    size_t n_threads)
+{
+    if (n_threads > count / CMC_SORT_PARALLEL_THRESHOLD)
+        n_threads = count / CMC_SORT_PARALLEL_THRESHOLD;
+
+    /* Not worth splitting the work */
+    if (n_threads < 2)
+        return CMC_(PFX, _impl_sort_stable)(array, count, cmp, alloc);
+
+    V *buffer = alloc->malloc(sizeof(V) * count);
+    struct CMC_(SNAME, _sort_task) *tasks = alloc->malloc(sizeof(struct CMC_(SNAME, _sort_task)) * n_threads);
+    size_t *bounds = alloc->malloc(sizeof(size_t) * (n_threads + 1));
+
+    if (!buffer || !tasks || !bounds)
+    {
+        if (buffer)
+            alloc->free(buffer);
+        if (tasks)
+            alloc->free(tasks);
+        if (bounds)
+            alloc->free(bounds);
+
+        return false;
+    }
+
+    size_t n_runs = n_threads;
+
+    for (size_t t = 0; t <= n_runs; t++)
+        bounds[t] = count * t / n_runs;
+
+    for (size_t t = 0; t < n_runs; t++)
+    {
+        tasks[t].from = array;
+        tasks[t].to = buffer;
+        tasks[t].begin = bounds[t];
+        tasks[t].middle = bounds[t + 1];
+        tasks[t].end = bounds[t + 1];
+        tasks[t].cmp = cmp;
+        tasks[t].merge = false;
+    }
+
+    CMC_(PFX, _impl_sort_run)(tasks, n_runs);
+
+    V *from = array;
+    V *to = buffer;
+
+    while (n_runs > 1)
+    {
+        size_t n_tasks = 0;
+
+        /* A run without a pair is copied as it is */
+        for (size_t r = 0; r < n_runs; r += 2)
+        {
+            struct CMC_(SNAME, _sort_task) *task = &tasks[n_tasks++];
+
+            task->from = from;
+            task->to = to;
+            task->begin = bounds[r];
+            task->middle = bounds[r + 1];
+            task->end = r + 1 < n_runs ? bounds[r + 2] : bounds[r + 1];
+            task->merge = true;
+
+            bounds[n_tasks - 1] = task->begin;
+        }
+
+        bounds[n_tasks] = count;
+
+        CMC_(PFX, _impl_sort_run)(tasks, n_tasks);
+
+        n_runs = n_tasks;
+
+        V *tmp = from;
+        from = to;
+        to = tmp;
+    }
+
+    if (from != array)
+        memcpy(array, from, sizeof(V) * count);
+
+    alloc->free(buffer);
+    alloc->free(tasks);
+    alloc->free(bounds);
+
+    return true;
+}
+
+#endif /* CMC_EXT_PSORT */
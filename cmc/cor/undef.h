@@ -39,29 +39,44 @@
 /* You never want these to fallthrough since they should be unique for each collection */
 #undef PFX
 #undef SNAME
+#undef CMC_SBO_ANCHOR
 
 #ifndef CMC_ARGS_FALLTHROUGH
 
 #undef CMC_DEV
 #undef CMC_SAC
+#undef CMC_SBO
+#undef CMC_GAPLIST_LIST
 
 #ifndef CMC_ARGS_KEY_FALLTHROUGH
 #undef K
+#undef CMC_ARITHMETIC_K
+#undef CMC_TRIVIAL_K
 #endif
 
 #ifndef CMC_ARGS_VAL_FALLTHROUGH
 #undef V
+#undef CMC_ARITHMETIC_V
+#undef CMC_TRIVIAL_V
+#undef CMC_SORT_KEY
 #endif
 
 #undef SIZE
+#undef AGG
 
 #ifndef CMC_EXT_FALLTHROUGH
+#undef CMC_EXT_ALGO
 #undef CMC_EXT_INIT
 #undef CMC_EXT_ITER
 #undef CMC_EXT_NODE
+#undef CMC_EXT_RANK
 #undef CMC_EXT_SEQ
 #undef CMC_EXT_SETF
+#undef CMC_EXT_PSETF
+#undef CMC_EXT_PSORT
 #undef CMC_EXT_STR
+#undef CMC_EXT_VIEW
+#undef CMC_EXT_XSORT
 #endif
 
 #endif
@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * cskiplist.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * CSkipList
+ *
+ * A concurrent SkipList. It is a sorted map that can be used by many threads
+ * at the same time without locks. Insertions link nodes with atomic
+ * compare-and-swap operations and removals first mark a node as logically
+ * deleted, after which any thread that passes by helps unlinking it. Lookups
+ * never write to the list.
+ *
+ * Removed nodes can still be visible to other threads, so they are kept in a
+ * list of retired nodes and only freed by _reclaim, _clear or _free, which
+ * must be called when no other thread is using the skiplist. Values can't be
+ * updated in place; remove and insert them again instead.
+ */
+
+#include <stdatomic.h>
+
+#include "cor/core.h"
+#include "cor/skiplist.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - cskiplist key data type
+ * V - cskiplist value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/cskiplist/struct.h"
+
+/* Function declaration */
+#include "cmc/cskiplist/header.h"
+
+/* Function implementation */
+#include "cmc/cskiplist/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - cskiplist iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_CSKIPLIST_PARTS ITER, STR
+/**/
+#include "cmc/cskiplist/ext/struct.h"
+/**/
+#include "cmc/cskiplist/ext/header.h"
+/**/
+#include "cmc/cskiplist/ext/code.h"
+
+#include "cor/undef.h"
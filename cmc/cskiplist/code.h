@@ -0,0 +1,729 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value, size_t level);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_ptr)(uintptr_t link);
+static bool CMC_(PFX, _impl_marked)(uintptr_t link);
+static size_t CMC_(PFX, _impl_level)(struct SNAME *_map_);
+static void CMC_(PFX, _impl_flag)(struct SNAME *_map_, int flag);
+static bool CMC_(PFX, _impl_find)(struct SNAME *_map_, K key, struct CMC_DEF_NODE(SNAME) * *preds,
+                                  struct CMC_DEF_NODE(SNAME) * *succs);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_search)(struct SNAME *_map_, K key,
+                                                           struct CMC_DEF_NODE(SNAME) * *pred);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first)(struct SNAME *_map_);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next)(struct CMC_DEF_NODE(SNAME) * node);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                     CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->alloc = alloc;
+    _map_->head = CMC_(PFX, _impl_new_node)(_map_, (K){ 0 }, (V){ 0 }, CMC_SKIPLIST_MAX_LEVEL);
+
+    if (!_map_->head)
+    {
+        alloc->free(_map_);
+        return NULL;
+    }
+
+    atomic_init(&_map_->level, 1);
+    atomic_init(&_map_->count, 0);
+    atomic_init(&_map_->flag, CMC_FLAG_OK);
+    atomic_init(&_map_->retired, NULL);
+    atomic_init(&_map_->rng, cmc_skiplist_seed((uint64_t)(uintptr_t)_map_));
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+/* Not thread-safe. No other thread can be using the skiplist. */
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _reclaim)(_map_);
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_ptr)(atomic_load(&_map_->head->next[0]));
+
+    while (scan != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *next = CMC_(PFX, _impl_ptr)(atomic_load(&scan->next[0]));
+
+        if (_map_->f_key->free)
+            _map_->f_key->free(scan->key);
+        if (_map_->f_val->free)
+            _map_->f_val->free(scan->value);
+
+        _map_->alloc->free(scan);
+
+        scan = next;
+    }
+
+    for (size_t i = 0; i < CMC_SKIPLIST_MAX_LEVEL; i++)
+        atomic_store(&_map_->head->next[i], (uintptr_t)NULL);
+
+    atomic_store(&_map_->level, 1);
+    atomic_store(&_map_->count, 0);
+    atomic_store(&_map_->flag, CMC_FLAG_OK);
+}
+
+/* Not thread-safe. No other thread can be using the skiplist. */
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _clear)(_map_);
+
+    _map_->alloc->free(_map_->head);
+    _map_->alloc->free(_map_);
+}
+
+/* Frees every removed node. Not thread-safe: it must only be called when no */
+/* other thread can be holding a reference to a node, like an iterator. */
+void CMC_(PFX, _reclaim)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* A removed node might still be linked in levels that no thread has */
+    /* passed through since it was removed */
+    for (size_t i = 0; i < CMC_SKIPLIST_MAX_LEVEL; i++)
+    {
+        struct CMC_DEF_NODE(SNAME) *pred = _map_->head;
+        struct CMC_DEF_NODE(SNAME) *curr = CMC_(PFX, _impl_ptr)(atomic_load(&pred->next[i]));
+
+        while (curr != NULL)
+        {
+            uintptr_t next = atomic_load(&curr->next[i]);
+
+            if (CMC_(PFX, _impl_marked)(next))
+                atomic_store(&pred->next[i], (uintptr_t)CMC_(PFX, _impl_ptr)(next));
+            else
+                pred = curr;
+
+            curr = CMC_(PFX, _impl_ptr)(next);
+        }
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = atomic_exchange(&_map_->retired, NULL);
+
+    while (scan != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *next = scan->retired;
+
+        _map_->alloc->free(scan);
+
+        scan = next;
+    }
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *preds[CMC_SKIPLIST_MAX_LEVEL];
+    struct CMC_DEF_NODE(SNAME) *succs[CMC_SKIPLIST_MAX_LEVEL];
+
+    size_t level = CMC_(PFX, _impl_level)(_map_);
+    size_t top = atomic_load(&_map_->level);
+
+    /* Searches must go through every level of the new node */
+    while (top < level && !atomic_compare_exchange_weak(&_map_->level, &top, level))
+        ;
+
+    struct CMC_DEF_NODE(SNAME) *node = NULL;
+
+    while (true)
+    {
+        if (CMC_(PFX, _impl_find)(_map_, key, preds, succs))
+        {
+            /* The node was never visible to other threads */
+            if (node)
+                _map_->alloc->free(node);
+
+            CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_DUPLICATE);
+            return false;
+        }
+
+        if (!node)
+        {
+            node = CMC_(PFX, _impl_new_node)(_map_, key, value, level);
+
+            if (!node)
+            {
+                CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_ALLOC);
+                return false;
+            }
+        }
+
+        for (size_t i = 0; i < level; i++)
+            atomic_store(&node->next[i], (uintptr_t)succs[i]);
+
+        /* Linking the bottom level is what adds the key to the map */
+        uintptr_t expected = (uintptr_t)succs[0];
+
+        if (atomic_compare_exchange_strong(&preds[0]->next[0], &expected, (uintptr_t)node))
+            break;
+    }
+
+    /* Upper levels only speed up searches. They are linked from the bottom */
+    /* up and linking stops if the node gets removed in the meantime. */
+    for (size_t i = 1; i < level; i++)
+    {
+        bool linked = false;
+
+        while (!linked)
+        {
+            uintptr_t next = atomic_load(&node->next[i]);
+
+            if (CMC_(PFX, _impl_marked)(next))
+                break;
+
+            /* Only a removal can change the link of this node */
+            if (CMC_(PFX, _impl_ptr)(next) != succs[i] &&
+                !atomic_compare_exchange_strong(&node->next[i], &next, (uintptr_t)succs[i]))
+                break;
+
+            uintptr_t expected = (uintptr_t)succs[i];
+
+            linked = atomic_compare_exchange_strong(&preds[i]->next[i], &expected, (uintptr_t)node);
+
+            if (!linked)
+            {
+                CMC_(PFX, _impl_find)(_map_, key, preds, succs);
+
+                if (succs[0] != node)
+                    break;
+            }
+        }
+
+        if (!linked)
+            break;
+    }
+
+    atomic_fetch_add(&_map_->count, 1);
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_EMPTY);
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *preds[CMC_SKIPLIST_MAX_LEVEL];
+    struct CMC_DEF_NODE(SNAME) *succs[CMC_SKIPLIST_MAX_LEVEL];
+
+    if (!CMC_(PFX, _impl_find)(_map_, key, preds, succs))
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_NOT_FOUND);
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = succs[0];
+
+    /* Marks the upper levels first so that the node stops being linked */
+    for (size_t i = node->level - 1; i > 0; i--)
+    {
+        uintptr_t next = atomic_load(&node->next[i]);
+
+        while (!CMC_(PFX, _impl_marked)(next) && !atomic_compare_exchange_weak(&node->next[i], &next, next | 1))
+            ;
+    }
+
+    /* Whoever marks the bottom level removes the key */
+    uintptr_t next = atomic_load(&node->next[0]);
+
+    while (true)
+    {
+        if (CMC_(PFX, _impl_marked)(next))
+        {
+            CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_NOT_FOUND);
+            return false;
+        }
+
+        if (atomic_compare_exchange_strong(&node->next[0], &next, next | 1))
+            break;
+    }
+
+    if (out_value)
+        *out_value = node->value;
+
+    /* Searching for the key unlinks the node from every level */
+    CMC_(PFX, _impl_find)(_map_, key, preds, succs);
+
+    node->retired = atomic_load(&_map_->retired);
+
+    while (!atomic_compare_exchange_weak(&_map_->retired, &node->retired, node))
+        ;
+
+    atomic_fetch_sub(&_map_->count, 1);
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *pred = _map_->head;
+
+    for (size_t i = atomic_load(&_map_->level); i > 0; i--)
+    {
+        struct CMC_DEF_NODE(SNAME) *curr = CMC_(PFX, _impl_ptr)(atomic_load(&pred->next[i - 1]));
+
+        while (curr != NULL)
+        {
+            uintptr_t next = atomic_load(&curr->next[i - 1]);
+
+            if (!CMC_(PFX, _impl_marked)(next))
+                pred = curr;
+
+            curr = CMC_(PFX, _impl_ptr)(next);
+        }
+    }
+
+    if (pred == _map_->head)
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_EMPTY);
+        return false;
+    }
+
+    if (key)
+        *key = pred->key;
+    if (value)
+        *value = pred->value;
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_first)(_map_);
+
+    if (node == NULL)
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_EMPTY);
+        return false;
+    }
+
+    if (key)
+        *key = node->key;
+    if (value)
+        *value = node->value;
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Greatest key that is less than or equal to the given key */
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *pred;
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_search)(_map_, key, &pred);
+
+    if (node == NULL || _map_->f_key->cmp(node->key, key) != 0)
+        node = pred;
+
+    if (node == NULL)
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_NOT_FOUND);
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Smallest key that is greater than or equal to the given key */
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_search)(_map_, key, NULL);
+
+    if (node == NULL)
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_NOT_FOUND);
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+V CMC_(PFX, _get)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_search)(_map_, key, NULL);
+
+    if (node == NULL || _map_->f_key->cmp(node->key, key) != 0)
+    {
+        CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_NOT_FOUND);
+        return (V){ 0 };
+    }
+
+    CMC_(PFX, _impl_flag)(_map_, CMC_FLAG_OK);
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->value;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_search)(_map_, key, NULL);
+
+    bool result = node != NULL && _map_->f_key->cmp(node->key, key) == 0;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return atomic_load(&_map_->count) == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return atomic_load(&_map_->count);
+}
+
+/* Only meaningful if no other thread is using the skiplist */
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return atomic_load_explicit(&_map_->flag, memory_order_relaxed);
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value, size_t level)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node =
+        _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)) + sizeof(_Atomic(uintptr_t)) * level);
+
+    if (!node)
+        return NULL;
+
+    node->key = key;
+    node->value = value;
+    node->level = level;
+    node->retired = NULL;
+
+    for (size_t i = 0; i < level; i++)
+        atomic_init(&node->next[i], (uintptr_t)NULL);
+
+    return node;
+}
+
+/* Node pointed to by a link, without its mark */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_ptr)(uintptr_t link)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return (struct CMC_DEF_NODE(SNAME) *)(link & ~(uintptr_t)1);
+}
+
+/* If the node that owns the link was removed from its level */
+static bool CMC_(PFX, _impl_marked)(uintptr_t link)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return (link & 1) != 0;
+}
+
+/* Level of a new node. The shared state is only a counter bumped with a */
+/* single atomic add; each call scrambles its own ticket into a generator. */
+static size_t CMC_(PFX, _impl_level)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    uint64_t state = cmc_skiplist_seed(atomic_fetch_add_explicit(&_map_->rng, 1, memory_order_relaxed));
+
+    return cmc_skiplist_level(&state);
+}
+
+/* The flag is rarely changed, so reading it first avoids writing to memory */
+/* shared by every thread */
+static void CMC_(PFX, _impl_flag)(struct SNAME *_map_, int flag)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (atomic_load_explicit(&_map_->flag, memory_order_relaxed) != flag)
+        atomic_store_explicit(&_map_->flag, flag, memory_order_relaxed);
+}
+
+/**
+ * Fills preds and succs with the last node before the key and the first node
+ * after or at the key on each level, unlinking every removed node along the
+ * way. Returns true if the key is in the map.
+ */
+static bool CMC_(PFX, _impl_find)(struct SNAME *_map_, K key, struct CMC_DEF_NODE(SNAME) * *preds,
+                                  struct CMC_DEF_NODE(SNAME) * *succs)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool retry = true;
+
+    while (retry)
+    {
+        retry = false;
+
+        struct CMC_DEF_NODE(SNAME) *pred = _map_->head;
+
+        for (size_t i = atomic_load(&_map_->level); i > 0 && !retry; i--)
+        {
+            struct CMC_DEF_NODE(SNAME) *curr = CMC_(PFX, _impl_ptr)(atomic_load(&pred->next[i - 1]));
+
+            while (curr != NULL)
+            {
+                uintptr_t next = atomic_load(&curr->next[i - 1]);
+
+                if (CMC_(PFX, _impl_marked)(next))
+                {
+                    uintptr_t expected = (uintptr_t)curr;
+
+                    /* If pred was changed or removed, start over */
+                    if (!atomic_compare_exchange_strong(&pred->next[i - 1], &expected,
+                                                        (uintptr_t)CMC_(PFX, _impl_ptr)(next)))
+                    {
+                        retry = true;
+                        break;
+                    }
+                }
+                else if (_map_->f_key->cmp(curr->key, key) < 0)
+                    pred = curr;
+                else
+                    break;
+
+                curr = CMC_(PFX, _impl_ptr)(next);
+            }
+
+            preds[i - 1] = pred;
+            succs[i - 1] = curr;
+        }
+    }
+
+    return succs[0] != NULL && _map_->f_key->cmp(succs[0]->key, key) == 0;
+}
+
+/* Wait-free version of find used by lookups. Returns the first node with a */
+/* key greater than or equal to the given key and optionally the last node */
+/* before it, skipping removed nodes without unlinking them. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_search)(struct SNAME *_map_, K key,
+                                                           struct CMC_DEF_NODE(SNAME) * *pred)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->head;
+    struct CMC_DEF_NODE(SNAME) *curr = NULL;
+
+    for (size_t i = atomic_load(&_map_->level); i > 0; i--)
+    {
+        curr = CMC_(PFX, _impl_ptr)(atomic_load(&scan->next[i - 1]));
+
+        while (curr != NULL)
+        {
+            uintptr_t next = atomic_load(&curr->next[i - 1]);
+
+            if (!CMC_(PFX, _impl_marked)(next))
+            {
+                if (_map_->f_key->cmp(curr->key, key) >= 0)
+                    break;
+
+                scan = curr;
+            }
+
+            curr = CMC_(PFX, _impl_ptr)(next);
+        }
+    }
+
+    if (pred)
+        *pred = scan == _map_->head ? NULL : scan;
+
+    return curr;
+}
+
+/* First node that is not removed */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_next)(_map_->head);
+}
+
+/* Next node in the bottom level that is not removed */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_ptr)(atomic_load(&node->next[0]));
+
+    while (scan != NULL && CMC_(PFX, _impl_marked)(atomic_load(&scan->next[0])))
+        scan = CMC_(PFX, _impl_ptr)(atomic_load(&scan->next[0]));
+
+    return scan;
+}
@@ -0,0 +1,216 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * ITER
+ *
+ * CSkipList forward iterator. It can be used while other threads modify the
+ * skiplist and sees every key that is not removed before it is reached.
+ */
+#ifdef CMC_EXT_ITER
+
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.cursor = CMC_(PFX, _impl_first)(target);
+    iter.index = 0;
+    iter.end = iter.cursor == NULL;
+
+    return iter;
+}
+
+/* Iterator at the first key that is greater than or equal to the given key */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.cursor = CMC_(PFX, _impl_search)(target, key, NULL);
+    iter.index = 0;
+    iter.end = iter.cursor == NULL;
+
+    return iter;
+}
+
+bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return iter->end;
+}
+
+bool CMC_(PFX, _iter_next)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->end)
+        return false;
+
+    struct CMC_DEF_NODE(SNAME) *next = CMC_(PFX, _impl_next)(iter->cursor);
+
+    /* The cursor is kept at the last node */
+    if (next == NULL)
+    {
+        iter->end = true;
+        return false;
+    }
+
+    iter->cursor = next;
+    iter->index++;
+
+    return true;
+}
+
+/* Returns true only if the iterator moved all the steps */
+bool CMC_(PFX, _iter_advance)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (steps == 0)
+        return false;
+
+    for (size_t i = 0; i < steps; i++)
+    {
+        if (!CMC_(PFX, _iter_next)(iter))
+            return false;
+    }
+
+    return true;
+}
+
+K CMC_(PFX, _iter_key)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->cursor == NULL)
+        return (K){ 0 };
+
+    return iter->cursor->key;
+}
+
+V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->cursor == NULL)
+        return (V){ 0 };
+
+    return iter->cursor->value;
+}
+
+size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return iter->index;
+}
+
+#endif /* CMC_EXT_ITER */
+
+/**
+ * STR
+ *
+ * Print helper functions.
+ */
+#ifdef CMC_EXT_STR
+
+bool CMC_(PFX, _to_string)(struct SNAME *_map_, FILE *fptr)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *m_ = _map_;
+
+    return 0 <= fprintf(fptr,
+                        "struct %s<%s, %s> "
+                        "at %p { "
+                        "head:%p, "
+                        "level:%" PRIuMAX ", "
+                        "count:%" PRIuMAX ", "
+                        "flag:%d, "
+                        "f_val:%p, "
+                        "f_key:%p, "
+                        "alloc:%p, "
+                        "callbacks:%p }",
+                        CMC_TO_STRING(SNAME), CMC_TO_STRING(K), CMC_TO_STRING(V), m_, m_->head,
+                        (uintmax_t)atomic_load(&m_->level), (uintmax_t)atomic_load(&m_->count),
+                        atomic_load(&m_->flag), m_->f_key, m_->f_val, m_->alloc, CMC_CALLBACKS_GET(m_));
+}
+
+bool CMC_(PFX, _print)(struct SNAME *_map_, FILE *fptr, const char *start, const char *separator, const char *end,
+                       const char *key_val_sep)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    fprintf(fptr, "%s", start);
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first)(_map_);
+
+    while (scan != NULL)
+    {
+        if (!_map_->f_key->str(fptr, scan->key))
+            return false;
+
+        fprintf(fptr, "%s", key_val_sep);
+
+        if (!_map_->f_val->str(fptr, scan->value))
+            return false;
+
+        scan = CMC_(PFX, _impl_next)(scan);
+
+        if (scan != NULL)
+            fprintf(fptr, "%s", separator);
+    }
+
+    fprintf(fptr, "%s", end);
+
+    return true;
+}
+
+#endif /* CMC_EXT_STR */
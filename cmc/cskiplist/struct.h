@@ -0,0 +1,77 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* CSkipList Structure */
+struct SNAME
+{
+    /* Sentinel node before the first element, with every level */
+    struct CMC_DEF_NODE(SNAME) * head;
+
+    /* Highest level that any node has ever had */
+    atomic_size_t level;
+
+    /* Current amount of keys */
+    atomic_size_t count;
+
+    /* Flags indicating errors or success of the last operation */
+    atomic_int flag;
+
+    /* Key function table */
+    struct CMC_DEF_FKEY(SNAME) * f_key;
+
+    /* Value function table */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+
+    /* Removed nodes waiting to be freed */
+    struct CMC_DEF_NODE(SNAME) * _Atomic retired;
+
+    /* Ticket counter that seeds the level of new nodes */
+    _Atomic uint64_t rng;
+
+    /* Custom allocation functions */
+    CMC_ALLOC_TYPE alloc;
+
+    /* Custom callback functions */
+    CMC_CALLBACKS_DECL;
+};
+
+/* CSkipList Node */
+struct CMC_DEF_NODE(SNAME)
+{
+    /* Node Key */
+    K key;
+
+    /* Node Value */
+    V value;
+
+    /* Amount of levels this node is part of */
+    size_t level;
+
+    /* Next retired node, once this node is removed */
+    struct CMC_DEF_NODE(SNAME) * retired;
+
+    /* Next node in each level. The lowest bit is set when this node is */
+    /* removed from that level. */
+    _Atomic(uintptr_t) next[];
+};
@@ -52,7 +52,11 @@
  * would take O(N) due to the need to shift all elements in the deque.
  */
 
+#include "cor/algo.h"
 #include "cor/core.h"
+#include "cor/growth.h"
+#include "cor/scan.h"
+#include "cor/sort.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -61,6 +65,9 @@
 /**
  * Used values
  * V - deque data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SORT_KEY - optional, radix sort key of V (see cor/sort.h)
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -71,17 +78,37 @@
 /* Function declaration */
 #include "cmc/deque/header.h"
 
+/* Sorting algorithms */
+#ifdef CMC_EXT_PSORT
+#include "utl/thread.h"
+#endif
+
+#include "cor/sort/code.h"
+
+/* Search and reduction kernels */
+#ifdef CMC_ARITHMETIC_V
+#include "cor/scan/code.h"
+#endif
+
+/* Parallel algorithms */
+#ifdef CMC_EXT_ALGO
+#include "utl/thread.h"
+#include "cor/algo/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/deque/code.h"
 
 /**
  * Extensions
  *
+ * ALGO - Parallel algorithms (requires cmc_thread)
  * INIT - Initializes the struct on the stack
  * ITER - Deque iterator
+ * PSORT - Parallel sort (requires cmc_thread)
  * STR - Print helper functions
  */
-#define CMC_EXT_DEQUE_PARTS INIT, ITER, STR
+#define CMC_EXT_DEQUE_PARTS ALGO, INIT, ITER, PSORT, STR
 /**/
 #include "cmc/deque/ext/struct.h"
 /**/
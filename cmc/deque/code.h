@@ -23,7 +23,9 @@
  */
 
 /* Implementation Detail Functions */
-/* None */
+static V *CMC_(PFX, _impl_linearize)(struct SNAME *_deque_);
+static size_t CMC_(PFX, _impl_head_count)(struct SNAME *_deque_);
+static void CMC_(PFX, _impl_copy_ordered)(struct SNAME *_deque_, V *dest);
 
 struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -83,6 +85,7 @@ void CMC_(PFX, _clear)(struct SNAME *_deque_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_deque_->f_val->free)
     {
         for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
@@ -92,6 +95,7 @@ void CMC_(PFX, _clear)(struct SNAME *_deque_)
             i = (i + 1) % _deque_->capacity;
         }
     }
+#endif
 
     memset(_deque_->buffer, 0, sizeof(V) * _deque_->capacity);
 
@@ -108,6 +112,7 @@ void CMC_(PFX, _free)(struct SNAME *_deque_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_deque_->f_val->free)
     {
         for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
@@ -117,6 +122,7 @@ void CMC_(PFX, _free)(struct SNAME *_deque_)
             i = (i + 1) % _deque_->capacity;
         }
     }
+#endif
 
     _deque_->alloc->free(_deque_->buffer);
     _deque_->alloc->free(_deque_);
@@ -148,7 +154,7 @@ bool CMC_(PFX, _push_front)(struct SNAME *_deque_, V value)
 
     if (CMC_(PFX, _full)(_deque_))
     {
-        if (!CMC_(PFX, _resize)(_deque_, _deque_->capacity * 2))
+        if (!CMC_(PFX, _resize)(_deque_, cmc_growth_capacity(_deque_->capacity, _deque_->count + 1, sizeof(V))))
             return false;
     }
 
@@ -172,7 +178,7 @@ bool CMC_(PFX, _push_back)(struct SNAME *_deque_, V value)
 
     if (CMC_(PFX, _full)(_deque_))
     {
-        if (!CMC_(PFX, _resize)(_deque_, _deque_->capacity * 2))
+        if (!CMC_(PFX, _resize)(_deque_, cmc_growth_capacity(_deque_->capacity, _deque_->count + 1, sizeof(V))))
             return false;
     }
 
@@ -274,6 +280,137 @@ V CMC_(PFX, _back)(struct SNAME *_deque_)
     return _deque_->buffer[(_deque_->back == 0) ? _deque_->capacity - 1 : _deque_->back - 1];
 }
 
+size_t CMC_(PFX, _count_of)(struct SNAME *_deque_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifdef CMC_ARITHMETIC_V
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    size_t result = CMC_(PFX, _impl_scan_count)(_deque_->buffer + _deque_->front, head, value) +
+                    CMC_(PFX, _impl_scan_count)(_deque_->buffer, _deque_->count - head, value);
+#else
+    size_t result = 0;
+
+    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
+    {
+        result += _deque_->f_val->cmp(_deque_->buffer[i], value) == 0;
+
+        i = (i + 1) % _deque_->capacity;
+    }
+#endif
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+V CMC_(PFX, _min)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    V result = CMC_(PFX, _impl_scan_min)(_deque_->buffer + _deque_->front, head);
+
+    if (head < _deque_->count)
+    {
+        V tail = CMC_(PFX, _impl_scan_min)(_deque_->buffer, _deque_->count - head);
+        result = tail < result ? tail : result;
+    }
+#else
+    V result = _deque_->buffer[_deque_->front];
+
+    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
+    {
+        if (_deque_->f_val->cmp(_deque_->buffer[i], result) < 0)
+            result = _deque_->buffer[i];
+
+        i = (i + 1) % _deque_->capacity;
+    }
+#endif
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+V CMC_(PFX, _max)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    V result = CMC_(PFX, _impl_scan_max)(_deque_->buffer + _deque_->front, head);
+
+    if (head < _deque_->count)
+    {
+        V tail = CMC_(PFX, _impl_scan_max)(_deque_->buffer, _deque_->count - head);
+        result = tail > result ? tail : result;
+    }
+#else
+    V result = _deque_->buffer[_deque_->front];
+
+    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
+    {
+        if (_deque_->f_val->cmp(_deque_->buffer[i], result) > 0)
+            result = _deque_->buffer[i];
+
+        i = (i + 1) % _deque_->capacity;
+    }
+#endif
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    V result = CMC_(PFX, _impl_scan_sum)(_deque_->buffer + _deque_->front, head) +
+               CMC_(PFX, _impl_scan_sum)(_deque_->buffer, _deque_->count - head);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+#endif
+
 bool CMC_(PFX, _contains)(struct SNAME *_deque_, V value)
 {
 #ifdef CMC_DEV
@@ -282,6 +419,12 @@ bool CMC_(PFX, _contains)(struct SNAME *_deque_, V value)
 
     _deque_->flag = CMC_FLAG_OK;
 
+#ifdef CMC_ARITHMETIC_V
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    bool result = CMC_(PFX, _impl_scan_find)(_deque_->buffer + _deque_->front, head, value) != head ||
+                  CMC_(PFX, _impl_scan_find)(_deque_->buffer, _deque_->count - head, value) != _deque_->count - head;
+#else
     bool result = false;
 
     for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
@@ -294,6 +437,7 @@ bool CMC_(PFX, _contains)(struct SNAME *_deque_, V value)
 
         i = (i + 1) % _deque_->capacity;
     }
+#endif
 
     CMC_CALLBACKS_CALL(_deque_);
 
@@ -362,6 +506,35 @@ bool CMC_(PFX, _resize)(struct SNAME *_deque_, size_t capacity)
         return false;
     }
 
+    if (capacity > _deque_->capacity)
+    {
+        V *grown = _deque_->alloc->realloc(_deque_->buffer, sizeof(V) * capacity);
+
+        if (!grown)
+        {
+            _deque_->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        /* The buffer is grown in place, so only the elements that wrap */
+        /* around, from front to the old end, are moved to the new end */
+        if (_deque_->front + _deque_->count > _deque_->capacity)
+        {
+            size_t tail = _deque_->capacity - _deque_->front;
+
+            memmove(grown + capacity - tail, grown + _deque_->front, sizeof(V) * tail);
+
+            _deque_->front = capacity - tail;
+        }
+        else
+            _deque_->back = _deque_->front + _deque_->count;
+
+        _deque_->buffer = grown;
+        _deque_->capacity = capacity;
+
+        goto success;
+    }
+
     V *new_buffer = _deque_->alloc->malloc(sizeof(V) * capacity);
 
     if (!new_buffer)
@@ -370,19 +543,14 @@ bool CMC_(PFX, _resize)(struct SNAME *_deque_, size_t capacity)
         return false;
     }
 
-    for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
-    {
-        new_buffer[j] = _deque_->buffer[i];
-
-        i = (i + 1) % _deque_->capacity;
-    }
+    CMC_(PFX, _impl_copy_ordered)(_deque_, new_buffer);
 
     _deque_->alloc->free(_deque_->buffer);
 
     _deque_->buffer = new_buffer;
     _deque_->capacity = capacity;
     _deque_->front = 0;
-    _deque_->back = _deque_->count;
+    _deque_->back = _deque_->count == capacity ? 0 : _deque_->count;
 
 success:
 
@@ -391,6 +559,38 @@ success:
     return true;
 }
 
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_deque_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->capacity - _deque_->count >= size)
+    {
+        _deque_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _deque_->count)
+    {
+        _deque_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_deque_, _deque_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_deque_, _deque_->count > 0 ? _deque_->count : 1);
+}
+
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_deque_)
 {
 #ifdef CMC_DEV
@@ -407,6 +607,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_deque_)
 
     CMC_CALLBACKS_ASSIGN(result, _deque_->callbacks);
 
+#ifndef CMC_TRIVIAL_V
     if (_deque_->f_val->cpy)
     {
         for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
@@ -417,14 +618,8 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_deque_)
         }
     }
     else
-    {
-        for (size_t i = _deque_->front, j = 0; j < _deque_->count; j++)
-        {
-            result->buffer[j] = _deque_->buffer[i];
-
-            i = (i + 1) % _deque_->capacity;
-        }
-    }
+#endif
+        CMC_(PFX, _impl_copy_ordered)(_deque_, result->buffer);
 
     result->count = _deque_->count;
     result->front = 0;
@@ -447,6 +642,25 @@ bool CMC_(PFX, _equals)(struct SNAME *_deque1_, struct SNAME *_deque2_)
     if (_deque1_->count != _deque2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    /* Compared in blocks that end where either of the buffers wraps around */
+    for (size_t i = _deque1_->front, j = _deque2_->front, k = 0; k < _deque1_->count;)
+    {
+        size_t block = _deque1_->count - k;
+
+        if (block > _deque1_->capacity - i)
+            block = _deque1_->capacity - i;
+        if (block > _deque2_->capacity - j)
+            block = _deque2_->capacity - j;
+
+        if (memcmp(_deque1_->buffer + i, _deque2_->buffer + j, sizeof(V) * block) != 0)
+            return false;
+
+        k += block;
+        i = (i + block) % _deque1_->capacity;
+        j = (j + block) % _deque2_->capacity;
+    }
+#else
     size_t i, j, k;
     for (i = _deque1_->front, j = _deque2_->front, k = 0; k < _deque1_->count; k++)
     {
@@ -456,6 +670,104 @@ bool CMC_(PFX, _equals)(struct SNAME *_deque1_, struct SNAME *_deque2_)
         i = (i + 1) % _deque1_->capacity;
         j = (j + 1) % _deque2_->capacity;
     }
+#endif
 
     return true;
 }
+
+/* Sorts the deque from front to back. The order of equal elements is not */
+/* kept. */
+void CMC_(PFX, _sort)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    CMC_(PFX, _impl_sort_unstable)(array, _deque_->count, _deque_->f_val->cmp, _deque_->alloc);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+}
+
+/* Sorts the deque from front to back keeping equal elements in the same */
+/* order. Returns false if the memory needed could not be allocated. */
+bool CMC_(PFX, _stable_sort)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    if (!CMC_(PFX, _impl_sort_stable)(array, _deque_->count, _deque_->f_val->cmp, _deque_->alloc))
+    {
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+/* Makes the elements contiguous in the buffer, if they wrap around its end, */
+/* by rotating it in place. Returns the address of the front element. */
+static V *CMC_(PFX, _impl_linearize)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->front + _deque_->count <= _deque_->capacity)
+        return _deque_->buffer + _deque_->front;
+
+    /* Rotating left by front is the same as reversing [0, front) and */
+    /* [front, capacity) and then the whole buffer */
+    size_t bounds[3][2] = { { 0, _deque_->front }, { _deque_->front, _deque_->capacity }, { 0, _deque_->capacity } };
+
+    for (size_t r = 0; r < 3; r++)
+    {
+        for (size_t i = bounds[r][0], j = bounds[r][1]; i + 1 < j; i++, j--)
+        {
+            V tmp = _deque_->buffer[i];
+            _deque_->buffer[i] = _deque_->buffer[j - 1];
+            _deque_->buffer[j - 1] = tmp;
+        }
+    }
+
+    _deque_->front = 0;
+    _deque_->back = _deque_->count == _deque_->capacity ? 0 : _deque_->count;
+
+    return _deque_->buffer;
+}
+
+/* Amount of elements from the front to the end of the buffer. The other */
+/* elements wrapped around to the start of the buffer. */
+static size_t CMC_(PFX, _impl_head_count)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t head = _deque_->capacity - _deque_->front;
+
+    return head < _deque_->count ? head : _deque_->count;
+}
+
+/* Copies the elements to dest, from front to back, in at most two blocks */
+static void CMC_(PFX, _impl_copy_ordered)(struct SNAME *_deque_, V *dest)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t head = CMC_(PFX, _impl_head_count)(_deque_);
+
+    memcpy(dest, _deque_->buffer + _deque_->front, sizeof(V) * head);
+    memcpy(dest + head, _deque_->buffer, sizeof(V) * (_deque_->count - head));
+}
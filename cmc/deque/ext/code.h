@@ -22,6 +22,234 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the deque. The buffer is first made
+ * contiguous and then split in up to n_threads slices, each handled by a
+ * cmc_thread worker. Deques smaller than CMC_ALGO_PARALLEL_THRESHOLD are
+ * handled by the current thread alone. The functions passed to them must be
+ * safe to be called from many threads at once when n_threads is greater than 1.
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_deque_, void (*visitor)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    CMC_(PFX, _impl_algo_for_each)(array, _deque_->count, visitor, args, n_threads);
+
+    _deque_->flag = CMC_FLAG_OK;
+}
+
+/* Replaces the elements of dest by the elements of the deque passed through */
+/* mapper. If dest is the deque itself, mapper takes ownership of them. */
+bool CMC_(PFX, _map_into)(struct SNAME *_deque_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    if (dest == _deque_)
+        CMC_(PFX, _impl_algo_map)(array, _deque_->count, array, mapper, args, n_threads);
+    else
+    {
+        if (dest->capacity < _deque_->count && !CMC_(PFX, _resize)(dest, _deque_->count))
+        {
+            _deque_->flag = dest->flag;
+            return false;
+        }
+
+        CMC_(PFX, _clear)(dest);
+
+        CMC_(PFX, _impl_algo_map)(array, _deque_->count, dest->buffer, mapper, args, n_threads);
+
+        dest->count = _deque_->count;
+        dest->back = dest->count == dest->capacity ? 0 : dest->count;
+    }
+
+    dest->flag = CMC_FLAG_OK;
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(dest);
+
+    return true;
+}
+
+/* Returns a new deque with a copy of every element that satisfies predicate */
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _deque_->alloc->malloc(sizeof(bool) * _deque_->count);
+
+    if (!mask && _deque_->count > 0)
+    {
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(array, _deque_->count, mask, predicate, args, n_threads);
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(matches > 0 ? matches : 1, _deque_->f_val, _deque_->alloc, NULL);
+
+    if (!result)
+    {
+        _deque_->alloc->free(mask);
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _deque_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(array, _deque_->count, mask, result->buffer, NULL, n_threads);
+
+#ifndef CMC_TRIVIAL_V
+    if (_deque_->f_val->cpy)
+    {
+        for (size_t i = 0; i < matches; i++)
+            result->buffer[i] = _deque_->f_val->cpy(result->buffer[i]);
+    }
+#endif
+
+    result->count = matches;
+    result->back = matches == result->capacity ? 0 : matches;
+
+    _deque_->alloc->free(mask);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+/* Combines every element, from front to back, starting from initial. When */
+/* n_threads is greater than 1, reducer must also be associative. */
+V CMC_(PFX, _reduce)(struct SNAME *_deque_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_reduce)(array, _deque_->count, initial, reducer, args, n_threads);
+}
+
+size_t CMC_(PFX, _count_if)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_count)(array, _deque_->count, predicate, args, n_threads);
+}
+
+/* Keeps in the deque the elements that satisfy predicate and moves the rest */
+/* to a new deque. Both keep the relative order of their elements. */
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _deque_->alloc->malloc(sizeof(bool) * _deque_->count);
+    V *kept = _deque_->alloc->malloc(sizeof(V) * _deque_->count);
+
+    if ((!mask || !kept) && _deque_->count > 0)
+    {
+        _deque_->alloc->free(mask);
+        _deque_->alloc->free(kept);
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(array, _deque_->count, mask, predicate, args, n_threads);
+    size_t rejected = _deque_->count - matches;
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(rejected > 0 ? rejected : 1, _deque_->f_val, _deque_->alloc, NULL);
+
+    if (!result)
+    {
+        _deque_->alloc->free(mask);
+        _deque_->alloc->free(kept);
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _deque_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(array, _deque_->count, mask, kept, result->buffer, n_threads);
+
+    memcpy(array, kept, sizeof(V) * matches);
+    memset(array + matches, 0, sizeof(V) * rejected);
+
+    _deque_->count = matches;
+    _deque_->back = (_deque_->front + matches) % _deque_->capacity;
+
+    result->count = rejected;
+    result->back = rejected == result->capacity ? 0 : rejected;
+
+    _deque_->alloc->free(mask);
+    _deque_->alloc->free(kept);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+/* Overwrites every element with value, or a copy of it if the deque has a */
+/* cpy function. The previous elements are freed. */
+void CMC_(PFX, _fill)(struct SNAME *_deque_, V value, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+#ifndef CMC_TRIVIAL_V
+    if (_deque_->f_val->free)
+    {
+        for (size_t i = 0; i < _deque_->count; i++)
+            _deque_->f_val->free(array[i]);
+    }
+#endif
+
+#ifdef CMC_TRIVIAL_V
+    CMC_(PFX, _impl_algo_fill)(array, _deque_->count, value, NULL, n_threads);
+#else
+    CMC_(PFX, _impl_algo_fill)(array, _deque_->count, value, _deque_->f_val->cpy, n_threads);
+#endif
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+}
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -82,6 +310,7 @@ void CMC_(PFX, _release)(struct SNAME _deque_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_deque_.f_val->free)
     {
         for (size_t i = _deque_.front, j = 0; j < _deque_.count; j++)
@@ -91,6 +320,7 @@ void CMC_(PFX, _release)(struct SNAME _deque_)
             i = (i + 1) % _deque_.capacity;
         }
     }
+#endif
 
     _deque_.alloc->free(_deque_.buffer);
 }
@@ -372,6 +602,39 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort. The deque is split between cmc_thread workers that sort
+ * their slices with a stable sort and then merge them in pairs.
+ */
+#ifdef CMC_EXT_PSORT
+
+/* Same as stable_sort() but using up to n_threads threads. Small deques are */
+/* sorted by the current thread alone. */
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_deque_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *array = CMC_(PFX, _impl_linearize)(_deque_);
+
+    if (!CMC_(PFX, _impl_sort_parallel)(array, _deque_->count, _deque_->f_val->cmp, _deque_->alloc, n_threads))
+    {
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+#endif /* CMC_EXT_PSORT */
+
 /**
  * STR
  *
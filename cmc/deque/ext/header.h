@@ -22,6 +22,26 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the deque. They can be split between
+ * up to n_threads cmc_thread workers (see cor/algo.h).
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_deque_, void (*visitor)(V, void *), void *args, size_t n_threads);
+bool CMC_(PFX, _map_into)(struct SNAME *_deque_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads);
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+V CMC_(PFX, _reduce)(struct SNAME *_deque_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads);
+size_t CMC_(PFX, _count_if)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_deque_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads);
+void CMC_(PFX, _fill)(struct SNAME *_deque_, V value, size_t n_threads);
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -65,6 +85,17 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter);
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort.
+ */
+#ifdef CMC_EXT_PSORT
+
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_deque_, size_t n_threads);
+
+#endif /* CMC_EXT_PSORT */
+
 /**
  * STR
  *
@@ -55,6 +55,12 @@ bool CMC_(PFX, _pop_back)(struct SNAME *_deque_);
 /* Element Access */
 V CMC_(PFX, _front)(struct SNAME *_deque_);
 V CMC_(PFX, _back)(struct SNAME *_deque_);
+size_t CMC_(PFX, _count_of)(struct SNAME *_deque_, V value);
+V CMC_(PFX, _min)(struct SNAME *_deque_);
+V CMC_(PFX, _max)(struct SNAME *_deque_);
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_deque_);
+#endif
 /* Collection State */
 bool CMC_(PFX, _contains)(struct SNAME *_deque_, V value);
 bool CMC_(PFX, _empty)(struct SNAME *_deque_);
@@ -64,5 +70,9 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_deque_);
 int CMC_(PFX, _flag)(struct SNAME *_deque_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_deque_, size_t capacity);
+bool CMC_(PFX, _reserve)(struct SNAME *_deque_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_deque_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_deque_);
 bool CMC_(PFX, _equals)(struct SNAME *_deque1_, struct SNAME *_deque2_);
+void CMC_(PFX, _sort)(struct SNAME *_deque_);
+bool CMC_(PFX, _stable_sort)(struct SNAME *_deque_);
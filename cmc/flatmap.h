@@ -0,0 +1,98 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * flatmap.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * FlatMap
+ *
+ * A flat map is a sorted map that keeps its keys and values in two parallel
+ * dynamic arrays, both ordered by key. Searches are branchless binary searches
+ * over the array of keys only and iterating over the map in order is a plain
+ * walk over both arrays. Inserting or removing a key moves every entry after
+ * it, so the FlatMap is meant for small maps, of up to a few hundred keys,
+ * that are read much more often than they are modified. For those it is
+ * faster and much smaller than a TreeMap.
+ *
+ * Entries added with insert_many() are appended to the arrays and only sorted
+ * and merged into the map, like in a SortedList, by the next function that
+ * needs the map to be sorted. If a key was already in the map, or it appears
+ * more than once, only its first entry is kept and the others are freed with
+ * f_key->free and f_val->free.
+ *
+ * When CMC_ARITHMETIC_K is defined, searches compare the last few keys with
+ * the built-in operators instead of f_key->cmp.
+ */
+
+#include "cor/core.h"
+#include "cor/sort.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - flatmap key data type
+ * V - flatmap value data type
+ * CMC_ARITHMETIC_K - optional, K can be compared with the built-in operators
+ * CMC_TRIVIAL_K - optional, K is copied, compared and freed bitwise
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/flatmap/struct.h"
+
+/* Function declaration */
+#include "cmc/flatmap/header.h"
+
+/* Function implementation */
+#include "cmc/flatmap/code.h"
+
+/**
+ * Extensions
+ *
+ * INIT - Initializes the struct on the stack
+ * ITER - Map iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_FLATMAP_PARTS INIT, ITER, STR
+/**/
+#include "cmc/flatmap/ext/struct.h"
+/**/
+#include "cmc/flatmap/ext/header.h"
+/**/
+#include "cmc/flatmap/ext/code.h"
+
+#include "cor/undef.h"
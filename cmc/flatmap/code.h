@@ -0,0 +1,1078 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, size_t count, K key);
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_map_, size_t count, K key);
+static size_t CMC_(PFX, _impl_find)(struct SNAME *_map_, K key);
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_map_, size_t size);
+static void CMC_(PFX, _impl_insert_tail)(struct SNAME *_map_);
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_map_);
+static void CMC_(PFX, _impl_sort_insertion)(struct SNAME *_map_, K *keys, V *values, size_t count);
+static void CMC_(PFX, _impl_sort_merge)(struct SNAME *_map_, K *from_keys, V *from_values, K *to_keys, V *to_values,
+                                        size_t begin, size_t middle, size_t end);
+
+struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(capacity, f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FKEY(SNAME) * f_key,
+                                     struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
+                                     CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (capacity < 1)
+        return NULL;
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->keys = alloc->calloc(capacity, sizeof(K));
+    _map_->values = alloc->calloc(capacity, sizeof(V));
+
+    if (!_map_->keys || !_map_->values)
+    {
+        alloc->free(_map_->keys);
+        alloc->free(_map_->values);
+        alloc->free(_map_);
+        return NULL;
+    }
+
+    _map_->capacity = capacity;
+    _map_->count = 0;
+    _map_->sorted = 0;
+    _map_->flag = CMC_FLAG_OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#if !defined(CMC_TRIVIAL_K) || !defined(CMC_TRIVIAL_V)
+    for (size_t i = 0; i < _map_->count; i++)
+    {
+#ifndef CMC_TRIVIAL_K
+        if (_map_->f_key->free)
+            _map_->f_key->free(_map_->keys[i]);
+#endif
+#ifndef CMC_TRIVIAL_V
+        if (_map_->f_val->free)
+            _map_->f_val->free(_map_->values[i]);
+#endif
+    }
+#endif
+
+    memset(_map_->keys, 0, sizeof(K) * _map_->capacity);
+    memset(_map_->values, 0, sizeof(V) * _map_->capacity);
+
+    _map_->count = 0;
+    _map_->sorted = 0;
+    _map_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#if !defined(CMC_TRIVIAL_K) || !defined(CMC_TRIVIAL_V)
+    for (size_t i = 0; i < _map_->count; i++)
+    {
+#ifndef CMC_TRIVIAL_K
+        if (_map_->f_key->free)
+            _map_->f_key->free(_map_->keys[i]);
+#endif
+#ifndef CMC_TRIVIAL_V
+        if (_map_->f_val->free)
+            _map_->f_val->free(_map_->values[i]);
+#endif
+    }
+#endif
+
+    _map_->alloc->free(_map_->keys);
+    _map_->alloc->free(_map_->values);
+    _map_->alloc->free(_map_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    _map_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_map_, _map_->count, key);
+
+    if (index < _map_->count && _map_->f_key->cmp(_map_->keys[index], key) == 0)
+    {
+        _map_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    if (CMC_(PFX, _full)(_map_))
+    {
+        if (!CMC_(PFX, _resize)(_map_, _map_->capacity * 2))
+            return false;
+    }
+
+    size_t after = _map_->count - index;
+
+    memmove(_map_->keys + index + 1, _map_->keys + index, after * sizeof(K));
+    memmove(_map_->values + index + 1, _map_->values + index, after * sizeof(V));
+
+    _map_->keys[index] = key;
+    _map_->values[index] = value;
+
+    _map_->count++;
+    _map_->sorted = _map_->count;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Adds size entries at once. They are appended to the map and sorted along */
+/* with the rest of it only when needed. Keys that are already in the map */
+/* or that are repeated are discarded by then (see flatmap.h). */
+bool CMC_(PFX, _insert_many)(struct SNAME *_map_, K *keys, V *values, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* An empty batch leaves the map untouched */
+    if (size == 0)
+    {
+        _map_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (!CMC_(PFX, _impl_reserve)(_map_, size))
+        return false;
+
+    memcpy(_map_->keys + _map_->count, keys, size * sizeof(K));
+    memcpy(_map_->values + _map_->count, values, size * sizeof(V));
+
+    _map_->count += size;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t index = CMC_(PFX, _impl_find)(_map_, key);
+
+    if (index == _map_->count)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (old_value)
+        *old_value = _map_->values[index];
+
+    _map_->values[index] = new_value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    size_t index = CMC_(PFX, _impl_find)(_map_, key);
+
+    if (index == _map_->count)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = _map_->values[index];
+
+    size_t after = _map_->count - index - 1;
+
+    memmove(_map_->keys + index, _map_->keys + index + 1, after * sizeof(K));
+    memmove(_map_->values + index, _map_->values + index + 1, after * sizeof(V));
+
+    _map_->count--;
+    _map_->sorted = _map_->count;
+
+    _map_->keys[_map_->count] = (K){ 0 };
+    _map_->values[_map_->count] = (V){ 0 };
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_map_);
+
+    if (key)
+        *key = _map_->keys[_map_->count - 1];
+    if (value)
+        *value = _map_->values[_map_->count - 1];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_map_);
+
+    if (key)
+        *key = _map_->keys[0];
+    if (value)
+        *value = _map_->values[0];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_map_);
+
+    size_t index = CMC_(PFX, _impl_upper_bound)(_map_, _map_->count, key);
+
+    if (index == 0)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = _map_->keys[index - 1];
+    if (out_value)
+        *out_value = _map_->values[index - 1];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_map_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_map_, _map_->count, key);
+
+    if (index == _map_->count)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = _map_->keys[index];
+    if (out_value)
+        *out_value = _map_->values[index];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+V CMC_(PFX, _get)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    size_t index = CMC_(PFX, _impl_find)(_map_, key);
+
+    if (index == _map_->count)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (V){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return _map_->values[index];
+}
+
+V *CMC_(PFX, _get_ref)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return NULL;
+    }
+
+    size_t index = CMC_(PFX, _impl_find)(_map_, key);
+
+    if (index == _map_->count)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return NULL;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return &(_map_->values[index]);
+}
+
+/* Index in the arrays of the first key that is not less than key, or the */
+/* amount of keys if there is none */
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map_);
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return CMC_(PFX, _impl_lower_bound)(_map_, _map_->count, key);
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_map_))
+        return false;
+
+    bool result = CMC_(PFX, _impl_find)(_map_, key) < _map_->count;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count == 0;
+}
+
+bool CMC_(PFX, _full)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count >= _map_->capacity;
+}
+
+/* Entries that are still waiting to be merged might be duplicates, so they */
+/* are merged first */
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map_);
+
+    return _map_->count;
+}
+
+size_t CMC_(PFX, _capacity)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->capacity;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->flag;
+}
+
+bool CMC_(PFX, _resize)(struct SNAME *_map_, size_t capacity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_map_->capacity == capacity)
+        goto success;
+
+    if (capacity < _map_->count)
+    {
+        _map_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    K *new_keys = _map_->alloc->realloc(_map_->keys, sizeof(K) * capacity);
+
+    if (!new_keys)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _map_->keys = new_keys;
+
+    V *new_values = _map_->alloc->realloc(_map_->values, sizeof(V) * capacity);
+
+    if (!new_values)
+    {
+        /* Both arrays still have room for the smallest of both capacities */
+        if (capacity < _map_->capacity)
+            _map_->capacity = capacity;
+
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _map_->values = new_values;
+    _map_->capacity = capacity;
+
+success:
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Merges the entries added by insert_many() into the map. A few entries are */
+/* inserted one by one, while many of them are sorted on their own and then */
+/* merged in a single pass. */
+void CMC_(PFX, _sort)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t tail = _map_->count - _map_->sorted;
+
+    if (tail == 0)
+        return;
+
+    if (tail <= CMC_SORT_INSERTION_THRESHOLD || !CMC_(PFX, _impl_merge_tail)(_map_))
+        CMC_(PFX, _impl_insert_tail)(_map_);
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map_);
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(_map_->capacity, _map_->f_key, _map_->f_val, _map_->alloc, NULL);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _map_->callbacks);
+
+#ifdef CMC_TRIVIAL_K
+    memcpy(result->keys, _map_->keys, sizeof(K) * _map_->count);
+#else
+    if (_map_->f_key->cpy)
+    {
+        for (size_t i = 0; i < _map_->count; i++)
+            result->keys[i] = _map_->f_key->cpy(_map_->keys[i]);
+    }
+    else
+        memcpy(result->keys, _map_->keys, sizeof(K) * _map_->count);
+#endif
+
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->values, _map_->values, sizeof(V) * _map_->count);
+#else
+    if (_map_->f_val->cpy)
+    {
+        for (size_t i = 0; i < _map_->count; i++)
+            result->values[i] = _map_->f_val->cpy(_map_->values[i]);
+    }
+    else
+        memcpy(result->values, _map_->values, sizeof(V) * _map_->count);
+#endif
+
+    result->count = _map_->count;
+    result->sorted = _map_->count;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map1_);
+    CMC_(PFX, _sort)(_map2_);
+
+    _map1_->flag = CMC_FLAG_OK;
+    _map2_->flag = CMC_FLAG_OK;
+
+    if (_map1_->count != _map2_->count)
+        return false;
+
+#ifdef CMC_TRIVIAL_K
+    if (memcmp(_map1_->keys, _map2_->keys, sizeof(K) * _map1_->count) != 0)
+        return false;
+#endif
+#ifdef CMC_TRIVIAL_V
+    if (memcmp(_map1_->values, _map2_->values, sizeof(V) * _map1_->count) != 0)
+        return false;
+#endif
+
+#if !defined(CMC_TRIVIAL_K) || !defined(CMC_TRIVIAL_V)
+    for (size_t i = 0; i < _map1_->count; i++)
+    {
+#ifndef CMC_TRIVIAL_K
+        if (_map1_->f_key->cmp(_map1_->keys[i], _map2_->keys[i]) != 0)
+            return false;
+#endif
+#ifndef CMC_TRIVIAL_V
+        if (_map1_->f_val->cmp(_map1_->values[i], _map2_->values[i]) != 0)
+            return false;
+#endif
+    }
+#endif
+
+    return true;
+}
+
+/* Both bound searches below are the same branchless searches used by the */
+/* SortedList, over the first count keys. When K is an arithmetic type */
+/* (CMC_ARITHMETIC_K is defined) the last few keys are counted with plain */
+/* comparisons, which compilers vectorize. */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, size_t count, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = count;
+
+    if (n == 0)
+        return 0;
+
+    K *base = _map_->keys;
+
+#ifdef CMC_ARITHMETIC_K
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
+    {
+        size_t half = n / 2;
+
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _map_->f_key->cmp(base[half], key) < 0 ? base + half : base;
+        n -= half;
+    }
+
+#ifdef CMC_ARITHMETIC_K
+    size_t index = (size_t)(base - _map_->keys);
+
+    for (size_t i = 0; i < n; i++)
+        index += base[i] < key;
+
+    return index;
+#else
+    return (size_t)(base - _map_->keys) + (_map_->f_key->cmp(base[0], key) < 0);
+#endif
+}
+
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_map_, size_t count, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = count;
+
+    if (n == 0)
+        return 0;
+
+    K *base = _map_->keys;
+
+#ifdef CMC_ARITHMETIC_K
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
+    {
+        size_t half = n / 2;
+
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _map_->f_key->cmp(base[half], key) <= 0 ? base + half : base;
+        n -= half;
+    }
+
+#ifdef CMC_ARITHMETIC_K
+    size_t index = (size_t)(base - _map_->keys);
+
+    for (size_t i = 0; i < n; i++)
+        index += base[i] <= key;
+
+    return index;
+#else
+    return (size_t)(base - _map_->keys) + (_map_->f_key->cmp(base[0], key) <= 0);
+#endif
+}
+
+/* Sorts the map and returns the index of key or count if it is not found */
+static size_t CMC_(PFX, _impl_find)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_map_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_map_, _map_->count, key);
+
+    if (index < _map_->count && _map_->f_key->cmp(_map_->keys[index], key) == 0)
+        return index;
+
+    return _map_->count;
+}
+
+/* Makes room for size more entries */
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_map_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_map_->capacity - _map_->count >= size)
+        return true;
+
+    size_t capacity = _map_->capacity * 2;
+
+    if (capacity < _map_->count + size)
+        capacity = _map_->count + size;
+
+    return CMC_(PFX, _resize)(_map_, capacity);
+}
+
+/* Moves each entry after the sorted prefix into its place, discarding it if */
+/* its key is already there. It needs no extra memory. */
+static void CMC_(PFX, _impl_insert_tail)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    K *keys = _map_->keys;
+    V *values = _map_->values;
+
+    /* The prefix grows into slots that were already read */
+    size_t n = _map_->sorted;
+
+    for (size_t i = _map_->sorted; i < _map_->count; i++)
+    {
+        K key = keys[i];
+        V value = values[i];
+
+        size_t index = CMC_(PFX, _impl_lower_bound)(_map_, n, key);
+
+        if (index < n && _map_->f_key->cmp(keys[index], key) == 0)
+        {
+#ifndef CMC_TRIVIAL_K
+            if (_map_->f_key->free)
+                _map_->f_key->free(key);
+#endif
+#ifndef CMC_TRIVIAL_V
+            if (_map_->f_val->free)
+                _map_->f_val->free(value);
+#endif
+
+            continue;
+        }
+
+        memmove(keys + index + 1, keys + index, (n - index) * sizeof(K));
+        memmove(values + index + 1, values + index, (n - index) * sizeof(V));
+
+        keys[index] = key;
+        values[index] = value;
+
+        n++;
+    }
+
+    memset(keys + n, 0, (_map_->count - n) * sizeof(K));
+    memset(values + n, 0, (_map_->count - n) * sizeof(V));
+
+    _map_->count = n;
+    _map_->sorted = n;
+}
+
+/* Sorts the entries after the sorted prefix with a stable merge sort, merges */
+/* them into the prefix and then drops every entry whose key is equal to the */
+/* one before it. On ties entries from the prefix come first, so the first */
+/* entry of each key is kept. Returns false if a scratch buffer for the */
+/* entries could not be allocated. */
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t sorted = _map_->sorted;
+    size_t tail = _map_->count - sorted;
+
+    K *scratch_keys = _map_->alloc->malloc(sizeof(K) * tail);
+    V *scratch_values = _map_->alloc->malloc(sizeof(V) * tail);
+
+    if (!scratch_keys || !scratch_values)
+    {
+        _map_->alloc->free(scratch_keys);
+        _map_->alloc->free(scratch_values);
+        return false;
+    }
+
+    K *keys = _map_->keys;
+    V *values = _map_->values;
+
+    /* Small runs are sorted in place and then merged back and forth */
+    for (size_t i = 0; i < tail; i += CMC_SORT_INSERTION_THRESHOLD)
+    {
+        size_t end = i + CMC_SORT_INSERTION_THRESHOLD < tail ? i + CMC_SORT_INSERTION_THRESHOLD : tail;
+
+        CMC_(PFX, _impl_sort_insertion)(_map_, keys + sorted + i, values + sorted + i, end - i);
+    }
+
+    K *from_keys = keys + sorted;
+    V *from_values = values + sorted;
+    K *to_keys = scratch_keys;
+    V *to_values = scratch_values;
+
+    for (size_t width = CMC_SORT_INSERTION_THRESHOLD; width < tail; width *= 2)
+    {
+        for (size_t i = 0; i < tail; i += 2 * width)
+        {
+            size_t middle = i + width < tail ? i + width : tail;
+            size_t end = middle + width < tail ? middle + width : tail;
+
+            CMC_(PFX, _impl_sort_merge)(_map_, from_keys, from_values, to_keys, to_values, i, middle, end);
+        }
+
+        K *tmp_keys = from_keys;
+        from_keys = to_keys;
+        to_keys = tmp_keys;
+
+        V *tmp_values = from_values;
+        from_values = to_values;
+        to_values = tmp_values;
+    }
+
+    /* The sorted tail is merged from the scratch buffer */
+    if (from_keys != scratch_keys)
+    {
+        memcpy(scratch_keys, keys + sorted, sizeof(K) * tail);
+        memcpy(scratch_values, values + sorted, sizeof(V) * tail);
+    }
+
+    /* Merge from the back so only the tail needs to be copied out */
+    size_t i = sorted;
+    size_t j = tail;
+    size_t k = _map_->count;
+
+    while (j > 0)
+    {
+        if (i > 0 && _map_->f_key->cmp(keys[i - 1], scratch_keys[j - 1]) > 0)
+        {
+            --i;
+            --k;
+            keys[k] = keys[i];
+            values[k] = values[i];
+        }
+        else
+        {
+            --j;
+            --k;
+            keys[k] = scratch_keys[j];
+            values[k] = scratch_values[j];
+        }
+    }
+
+    _map_->alloc->free(scratch_keys);
+    _map_->alloc->free(scratch_values);
+
+    size_t n = 1;
+
+    for (size_t r = 1; r < _map_->count; r++)
+    {
+        if (_map_->f_key->cmp(keys[n - 1], keys[r]) == 0)
+        {
+#ifndef CMC_TRIVIAL_K
+            if (_map_->f_key->free)
+                _map_->f_key->free(keys[r]);
+#endif
+#ifndef CMC_TRIVIAL_V
+            if (_map_->f_val->free)
+                _map_->f_val->free(values[r]);
+#endif
+        }
+        else
+        {
+            keys[n] = keys[r];
+            values[n] = values[r];
+            n++;
+        }
+    }
+
+    memset(keys + n, 0, (_map_->count - n) * sizeof(K));
+    memset(values + n, 0, (_map_->count - n) * sizeof(V));
+
+    _map_->count = n;
+    _map_->sorted = n;
+
+    return true;
+}
+
+/* Stable insertion sort of count entries */
+static void CMC_(PFX, _impl_sort_insertion)(struct SNAME *_map_, K *keys, V *values, size_t count)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    for (size_t i = 1; i < count; i++)
+    {
+        K key = keys[i];
+        V value = values[i];
+
+        size_t j = i;
+
+        while (j > 0 && _map_->f_key->cmp(key, keys[j - 1]) < 0)
+        {
+            keys[j] = keys[j - 1];
+            values[j] = values[j - 1];
+            j--;
+        }
+
+        keys[j] = key;
+        values[j] = value;
+    }
+}
+
+/* Merges the entries in [begin, middle) and [middle, end) of the from arrays */
+/* into [begin, end) of the to arrays */
+static void CMC_(PFX, _impl_sort_merge)(struct SNAME *_map_, K *from_keys, V *from_values, K *to_keys, V *to_values,
+                                        size_t begin, size_t middle, size_t end)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Already in order */
+    if (middle == end || begin == middle || _map_->f_key->cmp(from_keys[middle - 1], from_keys[middle]) <= 0)
+    {
+        memcpy(to_keys + begin, from_keys + begin, sizeof(K) * (end - begin));
+        memcpy(to_values + begin, from_values + begin, sizeof(V) * (end - begin));
+        return;
+    }
+
+    size_t i = begin;
+    size_t j = middle;
+    size_t k = begin;
+
+    while (i < middle && j < end)
+    {
+        /* On ties the left run goes first */
+        if (_map_->f_key->cmp(from_keys[j], from_keys[i]) < 0)
+        {
+            to_keys[k] = from_keys[j];
+            to_values[k++] = from_values[j++];
+        }
+        else
+        {
+            to_keys[k] = from_keys[i];
+            to_values[k++] = from_values[i++];
+        }
+    }
+
+    memcpy(to_keys + k, from_keys + i, sizeof(K) * (middle - i));
+    memcpy(to_values + k, from_values + i, sizeof(V) * (middle - i));
+    k += middle - i;
+    memcpy(to_keys + k, from_keys + j, sizeof(K) * (end - j));
+    memcpy(to_values + k, from_values + j, sizeof(V) * (end - j));
+}
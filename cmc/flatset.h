@@ -0,0 +1,104 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * flatset.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * FlatSet
+ *
+ * A flat set is a sorted set that keeps its elements in a sorted dynamic
+ * array. Searches are branchless binary searches and iterating over the set
+ * in order is a plain walk over the array. Inserting or removing an element
+ * moves every element after it, so the FlatSet is meant for small sets, of up
+ * to a few hundred elements, that are read much more often than they are
+ * modified. For those it is faster and much smaller than a TreeSet.
+ *
+ * Elements added with insert_many() are appended to the array and only
+ * sorted and merged into the set, like in a SortedList, by the next function
+ * that needs the set to be sorted. The array is sorted with the stable sort
+ * of cor/sort/code.h. If an element was already in the set, or it appears
+ * more than once, only its first occurrence is kept and the others are freed
+ * with f_val->free.
+ *
+ * When CMC_ARITHMETIC_V is defined, searches compare the last few elements
+ * with the built-in operators instead of f_val->cmp.
+ */
+
+#include "cor/core.h"
+#include "cor/sort.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * V - flatset data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SORT_KEY - optional, radix sort key of V (see cor/sort.h)
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/flatset/struct.h"
+
+/* Function declaration */
+#include "cmc/flatset/header.h"
+
+/* Sorting algorithms */
+#ifdef CMC_EXT_PSORT
+#include "utl/thread.h"
+#endif
+
+#include "cor/sort/code.h"
+
+/* Function implementation */
+#include "cmc/flatset/code.h"
+
+/**
+ * Extensions
+ *
+ * INIT - Initializes the struct on the stack
+ * ITER - Set iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_FLATSET_PARTS INIT, ITER, STR
+/**/
+#include "cmc/flatset/ext/struct.h"
+/**/
+#include "cmc/flatset/ext/header.h"
+/**/
+#include "cmc/flatset/ext/code.h"
+
+#include "cor/undef.h"
@@ -0,0 +1,777 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_set_, size_t count, V value);
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_set_, size_t count, V value);
+static size_t CMC_(PFX, _impl_find)(struct SNAME *_set_, V value);
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_set_, size_t size);
+static void CMC_(PFX, _impl_insert_tail)(struct SNAME *_set_);
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_set_);
+
+struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(capacity, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
+                                     CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (capacity < 1)
+        return NULL;
+
+    if (!f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_set_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_set_)
+        return NULL;
+
+    _set_->buffer = alloc->calloc(capacity, sizeof(V));
+
+    if (!_set_->buffer)
+    {
+        alloc->free(_set_);
+        return NULL;
+    }
+
+    _set_->capacity = capacity;
+    _set_->count = 0;
+    _set_->sorted = 0;
+    _set_->flag = CMC_FLAG_OK;
+    _set_->f_val = f_val;
+    _set_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_set_, callbacks);
+
+    return _set_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_set_->f_val->free)
+    {
+        for (size_t i = 0; i < _set_->count; i++)
+            _set_->f_val->free(_set_->buffer[i]);
+    }
+#endif
+
+    memset(_set_->buffer, 0, sizeof(V) * _set_->capacity);
+
+    _set_->count = 0;
+    _set_->sorted = 0;
+    _set_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_set_->f_val->free)
+    {
+        for (size_t i = 0; i < _set_->count; i++)
+            _set_->f_val->free(_set_->buffer[i]);
+    }
+#endif
+
+    _set_->alloc->free(_set_->buffer);
+    _set_->alloc->free(_set_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_set_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _set_->alloc = &cmc_alloc_node_default;
+    else
+        _set_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_set_, callbacks);
+
+    _set_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_set_, _set_->count, value);
+
+    if (index < _set_->count && _set_->f_val->cmp(_set_->buffer[index], value) == 0)
+    {
+        _set_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    if (CMC_(PFX, _full)(_set_))
+    {
+        if (!CMC_(PFX, _resize)(_set_, _set_->capacity * 2))
+            return false;
+    }
+
+    memmove(_set_->buffer + index + 1, _set_->buffer + index, (_set_->count - index) * sizeof(V));
+
+    _set_->buffer[index] = value;
+
+    _set_->count++;
+    _set_->sorted = _set_->count;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Adds size elements at once. They are appended to the set and sorted along */
+/* with the rest of it only when needed. Elements that are already in the */
+/* set or that are repeated are discarded by then (see flatset.h). */
+bool CMC_(PFX, _insert_many)(struct SNAME *_set_, V *values, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* An empty batch leaves the set untouched */
+    if (size == 0)
+    {
+        _set_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (!CMC_(PFX, _impl_reserve)(_set_, size))
+        return false;
+
+    memcpy(_set_->buffer + _set_->count, values, size * sizeof(V));
+
+    _set_->count += size;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    size_t index = CMC_(PFX, _impl_find)(_set_, value);
+
+    if (index == _set_->count)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    memmove(_set_->buffer + index, _set_->buffer + index + 1, (_set_->count - index - 1) * sizeof(V));
+
+    _set_->count--;
+    _set_->sorted = _set_->count;
+
+    _set_->buffer[_set_->count] = (V){ 0 };
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_set_, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_set_);
+
+    if (value)
+        *value = _set_->buffer[_set_->count - 1];
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_set_, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_set_);
+
+    if (value)
+        *value = _set_->buffer[0];
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _floor)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_set_);
+
+    size_t index = CMC_(PFX, _impl_upper_bound)(_set_, _set_->count, value);
+
+    if (index == 0)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = _set_->buffer[index - 1];
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_set_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_set_, _set_->count, value);
+
+    if (index == _set_->count)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = _set_->buffer[index];
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Index in the buffer of the first element that is not less than value, or */
+/* the amount of elements if there is none */
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set_);
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return CMC_(PFX, _impl_lower_bound)(_set_, _set_->count, value);
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_set_))
+        return false;
+
+    bool result = CMC_(PFX, _impl_find)(_set_, value) < _set_->count;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->count == 0;
+}
+
+bool CMC_(PFX, _full)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->count >= _set_->capacity;
+}
+
+/* Elements that are still waiting to be merged might be duplicates, so they */
+/* are merged first */
+size_t CMC_(PFX, _count)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set_);
+
+    return _set_->count;
+}
+
+size_t CMC_(PFX, _capacity)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->capacity;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->flag;
+}
+
+bool CMC_(PFX, _resize)(struct SNAME *_set_, size_t capacity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_set_->capacity == capacity)
+        goto success;
+
+    if (capacity < _set_->count)
+    {
+        _set_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    V *new_buffer = _set_->alloc->realloc(_set_->buffer, sizeof(V) * capacity);
+
+    if (!new_buffer)
+    {
+        _set_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _set_->buffer = new_buffer;
+    _set_->capacity = capacity;
+
+success:
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Merges the elements added by insert_many() into the set. A few elements */
+/* are inserted one by one, while many of them are sorted on their own and */
+/* then merged in a single pass. */
+void CMC_(PFX, _sort)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t tail = _set_->count - _set_->sorted;
+
+    if (tail == 0)
+        return;
+
+    if (tail <= CMC_SORT_INSERTION_THRESHOLD || !CMC_(PFX, _impl_merge_tail)(_set_))
+        CMC_(PFX, _impl_insert_tail)(_set_);
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set_);
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(_set_->capacity, _set_->f_val, _set_->alloc, NULL);
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _set_->callbacks);
+
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _set_->buffer, sizeof(V) * _set_->count);
+#else
+    if (_set_->f_val->cpy)
+    {
+        for (size_t i = 0; i < _set_->count; i++)
+            result->buffer[i] = _set_->f_val->cpy(_set_->buffer[i]);
+    }
+    else
+        memcpy(result->buffer, _set_->buffer, sizeof(V) * _set_->count);
+#endif
+
+    result->count = _set_->count;
+    result->sorted = _set_->count;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set1_);
+    CMC_(PFX, _sort)(_set2_);
+
+    _set1_->flag = CMC_FLAG_OK;
+    _set2_->flag = CMC_FLAG_OK;
+
+    if (_set1_->count != _set2_->count)
+        return false;
+
+#ifdef CMC_TRIVIAL_V
+    return memcmp(_set1_->buffer, _set2_->buffer, sizeof(V) * _set1_->count) == 0;
+#else
+    for (size_t i = 0; i < _set1_->count; i++)
+    {
+        if (_set1_->f_val->cmp(_set1_->buffer[i], _set2_->buffer[i]) != 0)
+            return false;
+    }
+
+    return true;
+#endif
+}
+
+/* Both bound searches below are the same branchless searches used by the */
+/* SortedList, over the first count elements. When V is an arithmetic type */
+/* (CMC_ARITHMETIC_V is defined) the last few elements are counted with */
+/* plain comparisons, which compilers vectorize. */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_set_, size_t count, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = count;
+
+    if (n == 0)
+        return 0;
+
+    V *base = _set_->buffer;
+
+#ifdef CMC_ARITHMETIC_V
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
+    {
+        size_t half = n / 2;
+
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _set_->f_val->cmp(base[half], value) < 0 ? base + half : base;
+        n -= half;
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    size_t index = (size_t)(base - _set_->buffer);
+
+    for (size_t i = 0; i < n; i++)
+        index += base[i] < value;
+
+    return index;
+#else
+    return (size_t)(base - _set_->buffer) + (_set_->f_val->cmp(base[0], value) < 0);
+#endif
+}
+
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_set_, size_t count, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = count;
+
+    if (n == 0)
+        return 0;
+
+    V *base = _set_->buffer;
+
+#ifdef CMC_ARITHMETIC_V
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
+    {
+        size_t half = n / 2;
+
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _set_->f_val->cmp(base[half], value) <= 0 ? base + half : base;
+        n -= half;
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    size_t index = (size_t)(base - _set_->buffer);
+
+    for (size_t i = 0; i < n; i++)
+        index += base[i] <= value;
+
+    return index;
+#else
+    return (size_t)(base - _set_->buffer) + (_set_->f_val->cmp(base[0], value) <= 0);
+#endif
+}
+
+/* Sorts the set and returns the index of value or count if it is not found */
+static size_t CMC_(PFX, _impl_find)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_set_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_set_, _set_->count, value);
+
+    if (index < _set_->count && _set_->f_val->cmp(_set_->buffer[index], value) == 0)
+        return index;
+
+    return _set_->count;
+}
+
+/* Makes room for size more elements */
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_set_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_set_->capacity - _set_->count >= size)
+        return true;
+
+    size_t capacity = _set_->capacity * 2;
+
+    if (capacity < _set_->count + size)
+        capacity = _set_->count + size;
+
+    return CMC_(PFX, _resize)(_set_, capacity);
+}
+
+/* Moves each element after the sorted prefix into its place, discarding it */
+/* if it is already there. It needs no extra memory. */
+static void CMC_(PFX, _impl_insert_tail)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *buffer = _set_->buffer;
+
+    /* The prefix grows into slots that were already read */
+    size_t n = _set_->sorted;
+
+    for (size_t i = _set_->sorted; i < _set_->count; i++)
+    {
+        V value = buffer[i];
+
+        size_t index = CMC_(PFX, _impl_lower_bound)(_set_, n, value);
+
+        if (index < n && _set_->f_val->cmp(buffer[index], value) == 0)
+        {
+#ifndef CMC_TRIVIAL_V
+            if (_set_->f_val->free)
+                _set_->f_val->free(value);
+#endif
+
+            continue;
+        }
+
+        memmove(buffer + index + 1, buffer + index, (n - index) * sizeof(V));
+
+        buffer[index] = value;
+
+        n++;
+    }
+
+    memset(buffer + n, 0, (_set_->count - n) * sizeof(V));
+
+    _set_->count = n;
+    _set_->sorted = n;
+}
+
+/* Sorts the elements after the sorted prefix with a stable sort, merges them */
+/* into the prefix and then drops every element that is equal to the one */
+/* before it. On ties elements from the prefix come first, so the first */
+/* occurrence of each element is kept. Returns false if a scratch buffer for */
+/* the elements could not be allocated. */
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *buffer = _set_->buffer;
+    size_t sorted = _set_->sorted;
+    size_t tail = _set_->count - sorted;
+
+    V *scratch = _set_->alloc->malloc(sizeof(V) * tail);
+
+    if (!scratch)
+        return false;
+
+    CMC_(PFX, _impl_sort_buffered)(buffer + sorted, scratch, tail, _set_->f_val->cmp);
+
+    memcpy(scratch, buffer + sorted, sizeof(V) * tail);
+
+    /* Merge from the back so only the tail needs to be copied out */
+    size_t i = sorted;
+    size_t j = tail;
+    size_t k = _set_->count;
+
+    while (j > 0)
+    {
+        if (i > 0 && _set_->f_val->cmp(buffer[i - 1], scratch[j - 1]) > 0)
+            buffer[--k] = buffer[--i];
+        else
+            buffer[--k] = scratch[--j];
+    }
+
+    _set_->alloc->free(scratch);
+
+    size_t n = 1;
+
+    for (size_t r = 1; r < _set_->count; r++)
+    {
+        if (_set_->f_val->cmp(buffer[n - 1], buffer[r]) == 0)
+        {
+#ifndef CMC_TRIVIAL_V
+            if (_set_->f_val->free)
+                _set_->f_val->free(buffer[r]);
+#endif
+        }
+        else
+            buffer[n++] = buffer[r];
+    }
+
+    memset(buffer + n, 0, (_set_->count - n) * sizeof(V));
+
+    _set_->count = n;
+    _set_->sorted = n;
+
+    return true;
+}
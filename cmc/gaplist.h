@@ -0,0 +1,109 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * gaplist.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * GapList
+ *
+ * A GapList is a List backed by a gap buffer. Its elements are stored in a
+ * dynamic array that has all of its free slots, the gap, at one position of
+ * the array instead of at its end. Elements before the gap are at the start of
+ * the buffer and elements after it are at the end of the buffer.
+ *
+ * Adding or removing an element at the position of the gap is done in
+ * constant time. Edits somewhere else first move the gap to that position,
+ * which moves only the elements that are between the old and the new position
+ * of the gap. This makes a GapList much faster than a List when most of the
+ * edits happen close to each other, like a cursor in a text editor, while
+ * keeping random access in constant time.
+ *
+ * The gap is only moved by functions that add or remove elements and by
+ * functions that need the elements to be contiguous, like sort().
+ *
+ * When CMC_GAPLIST_LIST is defined to the SNAME of a List with the same V, a
+ * GapList can be created from a List and turned back into one. The buffer is
+ * handed over without copying the elements, but to_list() first moves the gap
+ * to the end of the buffer. That List can't be using CMC_SAC or CMC_SBO.
+ */
+
+#include "cor/core.h"
+#include "cor/growth.h"
+#include "cor/sort.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * V - gaplist data type
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SORT_KEY - optional, radix sort key of V (see cor/sort.h)
+ * CMC_GAPLIST_LIST - optional, SNAME of a List of V to convert from and to
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/gaplist/struct.h"
+
+/* Function declaration */
+#include "cmc/gaplist/header.h"
+
+/* Sorting algorithms */
+#ifdef CMC_EXT_PSORT
+#include "utl/thread.h"
+#endif
+
+#include "cor/sort/code.h"
+
+/* Function implementation */
+#include "cmc/gaplist/code.h"
+
+/**
+ * Extensions
+ *
+ * INIT - Initializes the struct on the stack
+ * ITER - GapList iterator
+ * SEQ - Push and pop sequence of items
+ * STR - Print helper functions
+ */
+#define CMC_EXT_GAPLIST_PARTS INIT, ITER, SEQ, STR
+/**/
+#include "cmc/gaplist/ext/struct.h"
+/**/
+#include "cmc/gaplist/ext/header.h"
+/**/
+#include "cmc/gaplist/ext/code.h"
+
+#include "cor/undef.h"
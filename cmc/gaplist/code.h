@@ -0,0 +1,855 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static size_t CMC_(PFX, _impl_index)(struct SNAME *_list_, size_t index);
+static void CMC_(PFX, _impl_move_gap)(struct SNAME *_list_, size_t index);
+
+struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(capacity, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
+                                     CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (capacity < 1)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_list_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_list_)
+        return NULL;
+
+    _list_->buffer = alloc->calloc(capacity, sizeof(V));
+
+    if (!_list_->buffer)
+    {
+        alloc->free(_list_);
+        return NULL;
+    }
+
+    _list_->capacity = capacity;
+    _list_->count = 0;
+    _list_->gap = 0;
+    _list_->flag = CMC_FLAG_OK;
+    _list_->f_val = f_val;
+    _list_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+
+    return _list_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val && _list_->f_val->free)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+            _list_->f_val->free(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)]);
+    }
+#endif
+
+    memset(_list_->buffer, 0, sizeof(V) * _list_->capacity);
+
+    _list_->count = 0;
+    _list_->gap = 0;
+    _list_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val && _list_->f_val->free)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+            _list_->f_val->free(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)]);
+    }
+#endif
+
+    _list_->alloc->free(_list_->buffer);
+    _list_->alloc->free(_list_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_list_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _list_->alloc = &cmc_alloc_node_default;
+    else
+        _list_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+
+    _list_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _push_front)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _push_at)(_list_, value, 0);
+}
+
+bool CMC_(PFX, _push_at)(struct SNAME *_list_, V value, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (index > _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return false;
+    }
+
+    if (CMC_(PFX, _full)(_list_))
+    {
+        if (!CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + 1, sizeof(V))))
+            return false;
+    }
+
+    CMC_(PFX, _impl_move_gap)(_list_, index);
+
+    _list_->buffer[_list_->gap++] = value;
+    _list_->count++;
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+bool CMC_(PFX, _push_back)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _push_at)(_list_, value, _list_->count);
+}
+
+bool CMC_(PFX, _pop_front)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _pop_at)(_list_, 0);
+}
+
+bool CMC_(PFX, _pop_at)(struct SNAME *_list_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    if (index >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return false;
+    }
+
+    /* The element is removed by growing the gap over it, from whichever */
+    /* side of the gap it is closer to */
+    if (index < _list_->gap)
+    {
+        CMC_(PFX, _impl_move_gap)(_list_, index + 1);
+
+        _list_->buffer[--_list_->gap] = (V){ 0 };
+    }
+    else
+    {
+        CMC_(PFX, _impl_move_gap)(_list_, index);
+
+        _list_->buffer[CMC_(PFX, _impl_index)(_list_, index)] = (V){ 0 };
+    }
+
+    _list_->count--;
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+bool CMC_(PFX, _pop_back)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _pop_at)(_list_, _list_->count - 1);
+}
+
+V CMC_(PFX, _front)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return _list_->buffer[CMC_(PFX, _impl_index)(_list_, 0)];
+}
+
+V CMC_(PFX, _get)(struct SNAME *_list_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        CMC_CALLBACKS_CALL(_list_);
+        return (V){ 0 };
+    }
+
+    if (index >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        CMC_CALLBACKS_CALL(_list_);
+        return (V){ 0 };
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return _list_->buffer[CMC_(PFX, _impl_index)(_list_, index)];
+}
+
+V *CMC_(PFX, _get_ref)(struct SNAME *_list_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return NULL;
+    }
+
+    if (index >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return NULL;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return &(_list_->buffer[CMC_(PFX, _impl_index)(_list_, index)]);
+}
+
+V CMC_(PFX, _back)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return _list_->buffer[CMC_(PFX, _impl_index)(_list_, _list_->count - 1)];
+}
+
+size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return 0;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    size_t result = _list_->count;
+
+    if (from_start)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+        {
+            if (0 == _list_->f_val->cmp(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)], value))
+            {
+                result = i;
+                break;
+            }
+        }
+    }
+    else
+    {
+        for (size_t i = _list_->count; i > 0; i--)
+        {
+            if (0 == _list_->f_val->cmp(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i - 1)], value))
+            {
+                result = i - 1;
+                break;
+            }
+        }
+    }
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+size_t CMC_(PFX, _count_of)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return 0;
+    }
+
+    size_t result = 0;
+
+    for (size_t i = 0; i < _list_->count; i++)
+        result += 0 == _list_->f_val->cmp(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)], value);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+V CMC_(PFX, _min)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return (V){ 0 };
+    }
+
+    V result = _list_->buffer[CMC_(PFX, _impl_index)(_list_, 0)];
+
+    for (size_t i = 1; i < _list_->count; i++)
+    {
+        V value = _list_->buffer[CMC_(PFX, _impl_index)(_list_, i)];
+
+        if (_list_->f_val->cmp(value, result) < 0)
+            result = value;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+V CMC_(PFX, _max)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return (V){ 0 };
+    }
+
+    V result = _list_->buffer[CMC_(PFX, _impl_index)(_list_, 0)];
+
+    for (size_t i = 1; i < _list_->count; i++)
+    {
+        V value = _list_->buffer[CMC_(PFX, _impl_index)(_list_, i)];
+
+        if (_list_->f_val->cmp(value, result) > 0)
+            result = value;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return false;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    bool result = false;
+
+    for (size_t i = 0; i < _list_->count; i++)
+    {
+        if (0 == _list_->f_val->cmp(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)], value))
+        {
+            result = true;
+            break;
+        }
+    }
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count == 0;
+}
+
+bool CMC_(PFX, _full)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count >= _list_->capacity;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count;
+}
+
+bool CMC_(PFX, _fits)(struct SNAME *_list_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count + size <= _list_->capacity;
+}
+
+size_t CMC_(PFX, _capacity)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->capacity;
+}
+
+/* Returns the index in the list where the gap currently is */
+size_t CMC_(PFX, _gap)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->gap;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->flag;
+}
+
+bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    if (_list_->capacity == capacity)
+        return true;
+
+    if (capacity < _list_->count)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    /* The elements after the gap stay at the end of the buffer */
+    size_t tail = _list_->count - _list_->gap;
+    size_t old_start = _list_->capacity - tail;
+    size_t new_start = capacity - tail;
+
+    if (capacity < _list_->capacity)
+        memmove(_list_->buffer + new_start, _list_->buffer + old_start, tail * sizeof(V));
+
+    V *new_buffer = _list_->alloc->realloc(_list_->buffer, sizeof(V) * capacity);
+
+    if (!new_buffer)
+    {
+        if (capacity < _list_->capacity)
+            memmove(_list_->buffer + old_start, _list_->buffer + new_start, tail * sizeof(V));
+
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    if (capacity > _list_->capacity)
+        memmove(new_buffer + new_start, new_buffer + old_start, tail * sizeof(V));
+
+    _list_->buffer = new_buffer;
+    _list_->capacity = capacity;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_list_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->capacity - _list_->count >= size)
+    {
+        _list_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _list_->count)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_list_, _list_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_list_, _list_->count > 0 ? _list_->count : 1);
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(_list_->capacity, _list_->f_val, _list_->alloc, NULL);
+
+    if (!result)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
+
+    /* The copy has its gap at the end */
+    size_t tail = _list_->count - _list_->gap;
+    V *after = _list_->buffer + _list_->capacity - tail;
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val && _list_->f_val->cpy)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+            result->buffer[i] = _list_->f_val->cpy(_list_->buffer[CMC_(PFX, _impl_index)(_list_, i)]);
+    }
+    else
+#endif
+    {
+        memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->gap);
+        memcpy(result->buffer + _list_->gap, after, sizeof(V) * tail);
+    }
+
+    result->count = _list_->count;
+    result->gap = _list_->count;
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list1_->flag = CMC_FLAG_OK;
+    _list2_->flag = CMC_FLAG_OK;
+
+    if (_list1_->count != _list2_->count)
+        return false;
+
+#ifdef CMC_TRIVIAL_V
+    /* Compared in blocks that end where the gap of either list starts */
+    for (size_t i = 0; i < _list1_->count;)
+    {
+        size_t block = _list1_->count - i;
+
+        if (i < _list1_->gap && block > _list1_->gap - i)
+            block = _list1_->gap - i;
+        if (i < _list2_->gap && block > _list2_->gap - i)
+            block = _list2_->gap - i;
+
+        V *values1 = _list1_->buffer + CMC_(PFX, _impl_index)(_list1_, i);
+        V *values2 = _list2_->buffer + CMC_(PFX, _impl_index)(_list2_, i);
+
+        if (memcmp(values1, values2, sizeof(V) * block) != 0)
+            return false;
+
+        i += block;
+    }
+#else
+    for (size_t i = 0; i < _list1_->count; i++)
+    {
+        V value1 = _list1_->buffer[CMC_(PFX, _impl_index)(_list1_, i)];
+        V value2 = _list2_->buffer[CMC_(PFX, _impl_index)(_list2_, i)];
+
+        if (0 != _list1_->f_val->cmp(value1, value2))
+            return false;
+    }
+#endif
+
+    return true;
+}
+
+/* Sorts the list. The order of equal elements is not kept. */
+void CMC_(PFX, _sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_move_gap)(_list_, _list_->count);
+
+    CMC_(PFX, _impl_sort_unstable)(_list_->buffer, _list_->count, _list_->f_val->cmp, _list_->alloc);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+}
+
+/* Sorts the list keeping equal elements in the same order. Returns false if */
+/* the memory needed could not be allocated. */
+bool CMC_(PFX, _stable_sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_move_gap)(_list_, _list_->count);
+
+    if (!CMC_(PFX, _impl_sort_stable)(_list_->buffer, _list_->count, _list_->f_val->cmp, _list_->alloc))
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+#ifdef CMC_GAPLIST_LIST
+/* Creates a GapList that takes over the buffer of the list. The list is */
+/* freed, but not its elements. */
+struct SNAME *CMC_(PFX, _from_list)(struct CMC_GAPLIST_LIST *list, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *_list_ = list->alloc->malloc(sizeof(struct SNAME));
+
+    if (!_list_)
+    {
+        list->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    _list_->buffer = list->buffer;
+    _list_->capacity = list->capacity;
+    _list_->count = list->count;
+    _list_->gap = list->count;
+    _list_->flag = CMC_FLAG_OK;
+    _list_->f_val = f_val;
+    _list_->alloc = list->alloc;
+    CMC_CALLBACKS_ASSIGN(_list_, CMC_CALLBACKS_GET(list));
+
+    list->alloc->free(list);
+
+    return _list_;
+}
+
+/* Creates a List that takes over the buffer of the GapList after moving the */
+/* gap to its end. The GapList is freed, but not its elements. */
+struct CMC_GAPLIST_LIST *CMC_(PFX, _to_list)(struct SNAME *_list_, struct CMC_DEF_FVAL(CMC_GAPLIST_LIST) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_GAPLIST_LIST *list = _list_->alloc->malloc(sizeof(struct CMC_GAPLIST_LIST));
+
+    if (!list)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_(PFX, _impl_move_gap)(_list_, _list_->count);
+
+    list->buffer = _list_->buffer;
+    list->capacity = _list_->capacity;
+    list->count = _list_->count;
+    list->flag = CMC_FLAG_OK;
+    list->f_val = f_val;
+    list->alloc = _list_->alloc;
+    CMC_CALLBACKS_ASSIGN(list, CMC_CALLBACKS_GET(_list_));
+#ifdef CMC_DEV
+    list->generation = 0;
+#endif
+
+    _list_->alloc->free(_list_);
+
+    return list;
+}
+#endif
+
+/* Maps an index of the list to its position in the buffer */
+static size_t CMC_(PFX, _impl_index)(struct SNAME *_list_, size_t index)
+{
+    return index < _list_->gap ? index : index + _list_->capacity - _list_->count;
+}
+
+/* Moves the gap so that it starts at the given index of the list. Only the */
+/* elements between the old and the new position of the gap are moved. */
+static void CMC_(PFX, _impl_move_gap)(struct SNAME *_list_, size_t index)
+{
+    size_t gap_size = _list_->capacity - _list_->count;
+
+    if (index < _list_->gap)
+    {
+        memmove(_list_->buffer + index + gap_size, _list_->buffer + index, (_list_->gap - index) * sizeof(V));
+    }
+    else if (index > _list_->gap)
+    {
+        memmove(_list_->buffer + _list_->gap, _list_->buffer + _list_->gap + gap_size,
+                (index - _list_->gap) * sizeof(V));
+    }
+
+    _list_->gap = index;
+}
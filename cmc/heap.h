@@ -51,7 +51,9 @@
  *     - min/max : Accesses the min/max element from the heap
  */
 
+#include "cor/algo.h"
 #include "cor/core.h"
+#include "cor/growth.h"
 #include "cor/heap.h"
 
 #ifdef CMC_DEV
@@ -61,6 +63,7 @@
 /**
  * Used values
  * V - heap value data type
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -71,17 +74,24 @@
 /* Function declaration */
 #include "cmc/heap/header.h"
 
+/* Parallel algorithms */
+#ifdef CMC_EXT_ALGO
+#include "utl/thread.h"
+#include "cor/algo/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/heap/code.h"
 
 /**
  * Extensions
  *
+ * ALGO - Parallel algorithms (requires cmc_thread)
  * INIT - Initializes the struct on the stack
  * ITER - heap iterator
  * STR - Print helper functions
  */
-#define CMC_EXT_HEAP_PARTS ITER, SETF, STR
+#define CMC_EXT_HEAP_PARTS ALGO, ITER, SETF, STR
 /**/
 #include "cmc/heap/ext/struct.h"
 /**/
@@ -86,6 +86,7 @@ void CMC_(PFX, _clear)(struct SNAME *_heap_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_heap_->f_val->free)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -93,6 +94,7 @@ void CMC_(PFX, _clear)(struct SNAME *_heap_)
             _heap_->f_val->free(_heap_->buffer[i]);
         }
     }
+#endif
 
     memset(_heap_->buffer, 0, sizeof(V) * _heap_->capacity);
 
@@ -106,6 +108,7 @@ void CMC_(PFX, _free)(struct SNAME *_heap_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_heap_->f_val->free)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -113,6 +116,7 @@ void CMC_(PFX, _free)(struct SNAME *_heap_)
             _heap_->f_val->free(_heap_->buffer[i]);
         }
     }
+#endif
 
     _heap_->alloc->free(_heap_->buffer);
     _heap_->alloc->free(_heap_);
@@ -144,7 +148,7 @@ bool CMC_(PFX, _insert)(struct SNAME *_heap_, V value)
 
     if (CMC_(PFX, _full)(_heap_))
     {
-        if (!CMC_(PFX, _resize)(_heap_, _heap_->count * 2))
+        if (!CMC_(PFX, _resize)(_heap_, cmc_growth_capacity(_heap_->capacity, _heap_->count + 1, sizeof(V))))
             return false;
     }
 
@@ -313,6 +317,38 @@ success:
     return true;
 }
 
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_heap_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_heap_->capacity - _heap_->count >= size)
+    {
+        _heap_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _heap_->count)
+    {
+        _heap_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_heap_, _heap_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_heap_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_heap_, _heap_->count > 0 ? _heap_->count : 1);
+}
+
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_)
 {
 #ifdef CMC_DEV
@@ -329,6 +365,9 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_)
 
     CMC_CALLBACKS_ASSIGN(result, _heap_->callbacks);
 
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _heap_->buffer, sizeof(V) * _heap_->count);
+#else
     if (_heap_->f_val->cpy)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -336,6 +375,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_)
     }
     else
         memcpy(result->buffer, _heap_->buffer, sizeof(V) * _heap_->count);
+#endif
 
     result->count = _heap_->count;
 
@@ -356,6 +396,9 @@ bool CMC_(PFX, _equals)(struct SNAME *_heap1_, struct SNAME *_heap2_)
     if (_heap1_->count != _heap2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    return memcmp(_heap1_->buffer, _heap2_->buffer, sizeof(V) * _heap1_->count) == 0;
+#else
     for (size_t i = 0; i < _heap1_->count; i++)
     {
         if (_heap1_->f_val->cmp(_heap1_->buffer[i], _heap2_->buffer[i]) != 0)
@@ -363,6 +406,7 @@ bool CMC_(PFX, _equals)(struct SNAME *_heap1_, struct SNAME *_heap2_)
     }
 
     return true;
+#endif
 }
 
 static void CMC_(PFX, _impl_float_up)(struct SNAME *_heap_, size_t index)
@@ -22,6 +22,237 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the heap in the order they are kept
+ * in its buffer. The buffer is split in up to n_threads slices, each handled
+ * by a cmc_thread worker, and heaps smaller than CMC_ALGO_PARALLEL_THRESHOLD
+ * are handled by the current thread alone. The functions passed to them must
+ * be safe to be called from many threads at once when n_threads is greater
+ * than 1. Heaps with new elements are rebuilt in linear time afterwards.
+ */
+#ifdef CMC_EXT_ALGO
+
+/* Implementation Detail Functions */
+static void CMC_(PFX, _impl_algo_heapify)(struct SNAME *_heap_);
+
+void CMC_(PFX, _for_each)(struct SNAME *_heap_, void (*visitor)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_algo_for_each)(_heap_->buffer, _heap_->count, visitor, args, n_threads);
+
+    _heap_->flag = CMC_FLAG_OK;
+}
+
+/* Replaces the elements of dest by the elements of the heap passed through */
+/* mapper. If dest is the heap itself, mapper takes ownership of them. */
+bool CMC_(PFX, _map_into)(struct SNAME *_heap_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (dest != _heap_)
+    {
+        if (dest->capacity < _heap_->count && !CMC_(PFX, _resize)(dest, _heap_->count))
+        {
+            _heap_->flag = dest->flag;
+            return false;
+        }
+
+        CMC_(PFX, _clear)(dest);
+    }
+
+    CMC_(PFX, _impl_algo_map)(_heap_->buffer, _heap_->count, dest->buffer, mapper, args, n_threads);
+
+    dest->count = _heap_->count;
+
+    CMC_(PFX, _impl_algo_heapify)(dest);
+
+    dest->flag = CMC_FLAG_OK;
+    _heap_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(dest);
+
+    return true;
+}
+
+/* Returns a new heap with a copy of every element that satisfies predicate */
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _heap_->alloc->malloc(sizeof(bool) * _heap_->count);
+
+    if (!mask && _heap_->count > 0)
+    {
+        _heap_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_heap_->buffer, _heap_->count, mask, predicate, args, n_threads);
+
+    struct SNAME *result =
+        CMC_(PFX, _new_custom)(matches > 0 ? matches : 1, _heap_->HO, _heap_->f_val, _heap_->alloc, NULL);
+
+    if (!result)
+    {
+        _heap_->alloc->free(mask);
+        _heap_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _heap_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_heap_->buffer, _heap_->count, mask, result->buffer, NULL, n_threads);
+
+#ifndef CMC_TRIVIAL_V
+    if (_heap_->f_val->cpy)
+    {
+        for (size_t i = 0; i < matches; i++)
+            result->buffer[i] = _heap_->f_val->cpy(result->buffer[i]);
+    }
+#endif
+
+    result->count = matches;
+
+    CMC_(PFX, _impl_algo_heapify)(result);
+
+    _heap_->alloc->free(mask);
+
+    _heap_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+/* Combines every element starting from initial. As the order of the */
+/* elements is not defined, reducer must be associative and commutative. */
+V CMC_(PFX, _reduce)(struct SNAME *_heap_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _heap_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_reduce)(_heap_->buffer, _heap_->count, initial, reducer, args, n_threads);
+}
+
+size_t CMC_(PFX, _count_if)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _heap_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_count)(_heap_->buffer, _heap_->count, predicate, args, n_threads);
+}
+
+/* Keeps in the heap the elements that satisfy predicate and moves the rest */
+/* to a new heap */
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _heap_->alloc->malloc(sizeof(bool) * _heap_->count);
+    V *kept = _heap_->alloc->malloc(sizeof(V) * _heap_->count);
+
+    if ((!mask || !kept) && _heap_->count > 0)
+    {
+        _heap_->alloc->free(mask);
+        _heap_->alloc->free(kept);
+        _heap_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_heap_->buffer, _heap_->count, mask, predicate, args, n_threads);
+    size_t rejected = _heap_->count - matches;
+
+    struct SNAME *result =
+        CMC_(PFX, _new_custom)(rejected > 0 ? rejected : 1, _heap_->HO, _heap_->f_val, _heap_->alloc, NULL);
+
+    if (!result)
+    {
+        _heap_->alloc->free(mask);
+        _heap_->alloc->free(kept);
+        _heap_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _heap_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_heap_->buffer, _heap_->count, mask, kept, result->buffer, n_threads);
+
+    memcpy(_heap_->buffer, kept, sizeof(V) * matches);
+    memset(_heap_->buffer + matches, 0, sizeof(V) * rejected);
+
+    _heap_->count = matches;
+    result->count = rejected;
+
+    CMC_(PFX, _impl_algo_heapify)(_heap_);
+    CMC_(PFX, _impl_algo_heapify)(result);
+
+    _heap_->alloc->free(mask);
+    _heap_->alloc->free(kept);
+
+    _heap_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_heap_);
+
+    return result;
+}
+
+/* Overwrites every element with value, or a copy of it if the heap has a */
+/* cpy function. The previous elements are freed. */
+void CMC_(PFX, _fill)(struct SNAME *_heap_, V value, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_heap_->f_val->free)
+    {
+        for (size_t i = 0; i < _heap_->count; i++)
+            _heap_->f_val->free(_heap_->buffer[i]);
+    }
+#endif
+
+#ifdef CMC_TRIVIAL_V
+    CMC_(PFX, _impl_algo_fill)(_heap_->buffer, _heap_->count, value, NULL, n_threads);
+#else
+    CMC_(PFX, _impl_algo_fill)(_heap_->buffer, _heap_->count, value, _heap_->f_val->cpy, n_threads);
+#endif
+
+    _heap_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_heap_);
+}
+
+/* Restores the heap property of the whole buffer, bottom-up */
+static void CMC_(PFX, _impl_algo_heapify)(struct SNAME *_heap_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    for (size_t i = _heap_->count / 2; i > 0; i--)
+        CMC_(PFX, _impl_float_down)(_heap_, i - 1);
+}
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
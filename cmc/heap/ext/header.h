@@ -22,6 +22,26 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the heap, in no particular order. They
+ * can be split between up to n_threads cmc_thread workers (see cor/algo.h).
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_heap_, void (*visitor)(V, void *), void *args, size_t n_threads);
+bool CMC_(PFX, _map_into)(struct SNAME *_heap_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads);
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+V CMC_(PFX, _reduce)(struct SNAME *_heap_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads);
+size_t CMC_(PFX, _count_if)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_heap_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads);
+void CMC_(PFX, _fill)(struct SNAME *_heap_, V value, size_t n_threads);
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -61,5 +61,7 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_heap_);
 int CMC_(PFX, _flag)(struct SNAME *_heap_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_heap_, size_t capacity);
+bool CMC_(PFX, _reserve)(struct SNAME *_heap_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_heap_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_);
 bool CMC_(PFX, _equals)(struct SNAME *_heap1_, struct SNAME *_heap2_);
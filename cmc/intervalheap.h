@@ -53,6 +53,7 @@
 /**
  * Used values
  * V - intervalheap value data type
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -73,7 +74,7 @@
  * ITER - intervalheap iterator
  * STR - Print helper functions
  */
-#define CMC_EXT_HEAP_PARTS ITER, SETF, STR
+#define CMC_EXT_INTERVALHEAP_PARTS ITER, SETF, STR
 /**/
 #include "cmc/intervalheap/ext/struct.h"
 /**/
@@ -87,6 +87,7 @@ void CMC_(PFX, _clear)(struct SNAME *_heap_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_heap_->f_val->free)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -94,6 +95,7 @@ void CMC_(PFX, _clear)(struct SNAME *_heap_)
             _heap_->f_val->free(_heap_->buffer[i / 2][i % 2]);
         }
     }
+#endif
 
     memset(_heap_->buffer, 0, sizeof(V[2]) * _heap_->capacity);
 
@@ -108,6 +110,7 @@ void CMC_(PFX, _free)(struct SNAME *_heap_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_heap_->f_val->free)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -115,6 +118,7 @@ void CMC_(PFX, _free)(struct SNAME *_heap_)
             _heap_->f_val->free(_heap_->buffer[i / 2][i % 2]);
         }
     }
+#endif
 
     _heap_->alloc->free(_heap_->buffer);
 
@@ -578,6 +582,9 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_)
         return NULL;
     }
 
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _heap_->buffer, sizeof(V[2]) * _heap_->capacity);
+#else
     if (_heap_->f_val->cpy)
     {
         for (size_t i = 0; i < _heap_->count; i++)
@@ -585,6 +592,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_heap_)
     }
     else
         memcpy(result->buffer, _heap_->buffer, sizeof(V[2]) * _heap_->capacity);
+#endif
 
     result->capacity = _heap_->capacity;
     result->size = _heap_->size;
@@ -611,6 +619,10 @@ bool CMC_(PFX, _equals)(struct SNAME *_heap1_, struct SNAME *_heap2_)
     if (_heap1_->count != _heap2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    /* Both pairs of values are laid out one after the other */
+    return memcmp(_heap1_->buffer, _heap2_->buffer, sizeof(V) * _heap1_->count) == 0;
+#else
     for (size_t i = 0; i < _heap1_->count; i++)
     {
         V value1 = _heap1_->buffer[i / 2][i % 2];
@@ -621,6 +633,7 @@ bool CMC_(PFX, _equals)(struct SNAME *_heap1_, struct SNAME *_heap2_)
     }
 
     return true;
+#endif
 }
 
 static void CMC_(PFX, _impl_float_up_max)(struct SNAME *_heap_)
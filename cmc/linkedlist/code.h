@@ -25,6 +25,7 @@
 /* Implementation Detail Functions */
 struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_list_, size_t index);
 struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_list_, V value);
+void CMC_(PFX, _impl_free_node)(struct SNAME *_list_, struct CMC_DEF_NODE(SNAME) * _node_);
 
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -58,6 +59,9 @@ struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALL
     _list_->count = 0;
     _list_->head = NULL;
     _list_->tail = NULL;
+    _list_->block = NULL;
+    _list_->block_size = 0;
+    _list_->block_count = 0;
     _list_->flag = CMC_FLAG_OK;
     _list_->f_val = f_val;
     _list_->alloc = alloc;
@@ -83,7 +87,7 @@ void CMC_(PFX, _clear)(struct SNAME *_list_)
             _list_->f_val->free(scan->value);
         }
 
-        _list_->alloc->free(scan);
+        CMC_(PFX, _impl_free_node)(_list_, scan);
 
         scan = _list_->head;
     }
@@ -241,7 +245,7 @@ bool CMC_(PFX, _pop_front)(struct SNAME *_list_)
     struct CMC_DEF_NODE(SNAME) *_node_ = _list_->head;
     _list_->head = _list_->head->next;
 
-    _list_->alloc->free(_node_);
+    CMC_(PFX, _impl_free_node)(_list_, _node_);
 
     if (_list_->head == NULL)
         _list_->tail = NULL;
@@ -291,7 +295,7 @@ bool CMC_(PFX, _pop_at)(struct SNAME *_list_, size_t index)
     _node_->next->prev = _node_->prev;
     _node_->prev->next = _node_->next;
 
-    _list_->alloc->free(_node_);
+    CMC_(PFX, _impl_free_node)(_list_, _node_);
 
     _list_->count--;
     _list_->flag = CMC_FLAG_OK;
@@ -316,7 +320,7 @@ bool CMC_(PFX, _pop_back)(struct SNAME *_list_)
     struct CMC_DEF_NODE(SNAME) *_node_ = _list_->tail;
     _list_->tail = _list_->tail->prev;
 
-    _list_->alloc->free(_node_);
+    CMC_(PFX, _impl_free_node)(_list_, _node_);
 
     if (_list_->tail == NULL)
         _list_->head = NULL;
@@ -528,6 +532,57 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
     return result;
 }
 
+/* Moves every node into a single contiguous block in list order, which */
+/* makes iteration cache friendly. Iterators and node pointers held by the */
+/* user are invalidated. */
+bool CMC_(PFX, _compact)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *nodes = _list_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)) * _list_->count);
+
+    if (!nodes)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _list_->head;
+
+    for (size_t i = 0; i < _list_->count; i++)
+    {
+        struct CMC_DEF_NODE(SNAME) *next = scan->next;
+
+        nodes[i].value = scan->value;
+        nodes[i].prev = i == 0 ? NULL : &nodes[i - 1];
+        nodes[i].next = i + 1 == _list_->count ? NULL : &nodes[i + 1];
+
+        /* Might also release a block from a previous compaction */
+        CMC_(PFX, _impl_free_node)(_list_, scan);
+
+        scan = next;
+    }
+
+    _list_->block = nodes;
+    _list_->block_size = _list_->count;
+    _list_->block_count = _list_->count;
+    _list_->head = &nodes[0];
+    _list_->tail = &nodes[_list_->count - 1];
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
 bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_)
 {
 #ifdef CMC_DEV
@@ -576,6 +631,32 @@ struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_list_, V v
     return _node_;
 }
 
+/* Frees a single node. Nodes that live in the block allocated by _compact */
+/* are not freed individually; the whole block is freed once all of them are */
+/* released. */
+void CMC_(PFX, _impl_free_node)(struct SNAME *_list_, struct CMC_DEF_NODE(SNAME) * _node_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    uintptr_t address = (uintptr_t)_node_;
+    uintptr_t start = (uintptr_t)_list_->block;
+
+    if (_list_->block && address >= start &&
+        address < start + _list_->block_size * sizeof(struct CMC_DEF_NODE(SNAME)))
+    {
+        if (--_list_->block_count == 0)
+        {
+            _list_->alloc->free(_list_->block);
+            _list_->block = NULL;
+            _list_->block_size = 0;
+        }
+    }
+    else
+        _list_->alloc->free(_node_);
+}
+
 struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_list_, size_t index)
 {
 #ifdef CMC_DEV
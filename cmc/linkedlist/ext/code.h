@@ -333,7 +333,7 @@ void CMC_(PFX, _free_node)(struct SNAME *_list_, struct CMC_DEF_NODE(SNAME) * _n
     CMC_DEV_FCALL;
 #endif
 
-    _list_->alloc->free(_node_);
+    CMC_(PFX, _impl_free_node)(_list_, _node_);
 }
 
 struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _head)(struct SNAME *_list_)
@@ -471,7 +471,7 @@ bool CMC_(PFX, _del_next)(struct SNAME *_owner_, struct CMC_DEF_NODE(SNAME) * _n
     else
         _owner_->tail = _node_;
 
-    _owner_->alloc->free(tmp);
+    CMC_(PFX, _impl_free_node)(_owner_, tmp);
 
     _owner_->count--;
     _owner_->flag = CMC_FLAG_OK;
@@ -495,7 +495,7 @@ bool CMC_(PFX, _del_curr)(struct SNAME *_owner_, struct CMC_DEF_NODE(SNAME) * _n
     else
         _owner_->tail = _node_->prev;
 
-    _owner_->alloc->free(_node_);
+    CMC_(PFX, _impl_free_node)(_owner_, _node_);
 
     _owner_->count--;
     _owner_->flag = CMC_FLAG_OK;
@@ -524,7 +524,7 @@ bool CMC_(PFX, _del_prev)(struct SNAME *_owner_, struct CMC_DEF_NODE(SNAME) * _n
     else
         _owner_->head = _node_;
 
-    _owner_->alloc->free(tmp);
+    CMC_(PFX, _impl_free_node)(_owner_, tmp);
 
     _owner_->count--;
     _owner_->flag = CMC_FLAG_OK;
@@ -66,5 +66,6 @@ bool CMC_(PFX, _empty)(struct SNAME *_list_);
 size_t CMC_(PFX, _count)(struct SNAME *_list_);
 int CMC_(PFX, _flag)(struct SNAME *_list_);
 /* Collection Utility */
+bool CMC_(PFX, _compact)(struct SNAME *_list_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_);
 bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_);
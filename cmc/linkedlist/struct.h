@@ -40,6 +40,13 @@ struct SNAME
     /* Value function table */
     struct CMC_DEF_FVAL(SNAME) * f_val;
 
+    /* Nodes allocated in a single block by _compact (optional) */
+    struct CMC_DEF_NODE(SNAME) * block;
+
+    /* Capacity of block and how many of its nodes are still in use */
+    size_t block_size;
+    size_t block_count;
+
     /* Custom allocation functions */
     CMC_ALLOC_TYPE alloc;
 
@@ -64,7 +64,11 @@
  * list.
  */
 
+#include "cor/algo.h"
 #include "cor/core.h"
+#include "cor/growth.h"
+#include "cor/scan.h"
+#include "cor/sort.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -74,9 +78,17 @@
 #error "When using CMC_SAC, please also define SIZE"
 #endif
 
+#if defined(CMC_SAC) && defined(CMC_SBO)
+#error "CMC_SAC and CMC_SBO can't be used together"
+#endif
+
 /**
  * Used values
  * V - list data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SORT_KEY - optional, radix sort key of V (see cor/sort.h)
+ * CMC_SBO - optional, amount of elements stored in the struct itself
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -87,18 +99,39 @@
 /* Function declaration */
 #include "cmc/list/header.h"
 
+/* Sorting algorithms */
+#ifdef CMC_EXT_PSORT
+#include "utl/thread.h"
+#endif
+
+#include "cor/sort/code.h"
+
+/* Search and reduction kernels */
+#ifdef CMC_ARITHMETIC_V
+#include "cor/scan/code.h"
+#endif
+
+/* Parallel algorithms */
+#ifdef CMC_EXT_ALGO
+#include "utl/thread.h"
+#include "cor/algo/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/list/code.h"
 
 /**
  * Extensions
  *
+ * ALGO - Parallel algorithms (requires cmc_thread)
  * INIT - Initializes the struct on the stack
  * ITER - List iterator
+ * PSORT - Parallel sort (requires cmc_thread)
  * SEQ - Push and pop sequence of items
  * STR - Print helper functions
+ * VIEW - Non-owning views of a range of the list
  */
-#define CMC_EXT_LIST_PARTS INIT, ITER, SEQ, STR
+#define CMC_EXT_LIST_PARTS ALGO, INIT, ITER, PSORT, SEQ, STR, VIEW
 /**/
 #include "cmc/list/ext/struct.h"
 /**/
@@ -22,8 +22,24 @@
  * SOFTWARE.
  */
 
+/* With CMC_SBO, the elements of a list with a capacity of at most CMC_SBO */
+/* are stored in the struct itself. The struct can be moved, like when it is */
+/* returned by _init(), so the buffer is pointed back to it at every call. */
+#ifdef CMC_SBO
+#define CMC_SBO_ANCHOR(list) \
+    do \
+    { \
+        if ((list)->capacity <= CMC_SBO) \
+            (list)->buffer = (list)->sbo; \
+    } while (0)
+#else
+#define CMC_SBO_ANCHOR(list)
+#endif
+
 /* Implementation Detail Functions */
-/* None */
+#ifdef CMC_SBO
+static V *CMC_(PFX, _impl_sbo_realloc)(struct SNAME *_list_, size_t capacity);
+#endif
 
 #ifdef CMC_SAC
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FVAL(SNAME) * f_val)
@@ -61,6 +77,11 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
         return NULL;
 #endif
 
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (!alloc)
         alloc = &cmc_alloc_node_default;
 
@@ -71,6 +92,11 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
 
 #ifdef CMC_SAC
     memset(_list_->buffer, 0, sizeof(V) * SIZE);
+#elif defined(CMC_SBO)
+    if (capacity == CMC_SBO)
+        _list_->buffer = memset(_list_->sbo, 0, sizeof(V) * CMC_SBO);
+    else
+        _list_->buffer = alloc->calloc(capacity, sizeof(V));
 #else
     _list_->buffer = alloc->calloc(capacity, sizeof(V));
 #endif
@@ -91,6 +117,9 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+#ifdef CMC_DEV
+    _list_->generation = 0;
+#endif
 
     return _list_;
 }
@@ -101,11 +130,15 @@ void CMC_(PFX, _clear)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
+#ifndef CMC_TRIVIAL_V
     if (_list_->f_val && _list_->f_val->free)
     {
         for (size_t i = 0; i < _list_->count; i++)
             _list_->f_val->free(_list_->buffer[i]);
     }
+#endif
 
 #ifdef CMC_SAC
     memset(_list_->buffer, 0, sizeof(V) * SIZE);
@@ -123,13 +156,20 @@ void CMC_(PFX, _free)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
+#ifndef CMC_TRIVIAL_V
     if (_list_->f_val && _list_->f_val->free)
     {
         for (size_t i = 0; i < _list_->count; i++)
             _list_->f_val->free(_list_->buffer[i]);
     }
+#endif
 
-#ifndef CMC_SAC
+#ifdef CMC_SBO
+    if (_list_->capacity > CMC_SBO)
+        _list_->alloc->free(_list_->buffer);
+#elif !defined(CMC_SAC)
     _list_->alloc->free(_list_->buffer);
 #endif
     _list_->alloc->free(_list_);
@@ -163,13 +203,15 @@ bool CMC_(PFX, _push_front)(struct SNAME *_list_, V value)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _full)(_list_))
     {
 #ifdef CMC_SAC
         _list_->flag = CMC_FLAG_FULL;
         return false;
 #else
-        if (!CMC_(PFX, _resize)(_list_, _list_->count * 2))
+        if (!CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + 1, sizeof(V))))
             return false;
 #endif
     }
@@ -195,6 +237,8 @@ bool CMC_(PFX, _push_at)(struct SNAME *_list_, V value, size_t index)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (index > _list_->count)
     {
         _list_->flag = CMC_FLAG_RANGE;
@@ -207,7 +251,7 @@ bool CMC_(PFX, _push_at)(struct SNAME *_list_, V value, size_t index)
         _list_->flag = CMC_FLAG_FULL;
         return false;
 #else
-        if (!CMC_(PFX, _resize)(_list_, _list_->count * 2))
+        if (!CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + 1, sizeof(V))))
             return false;
 #endif
     }
@@ -229,13 +273,15 @@ bool CMC_(PFX, _push_back)(struct SNAME *_list_, V value)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _full)(_list_))
     {
 #ifdef CMC_SAC
         _list_->flag = CMC_FLAG_FULL;
         return false;
 #else
-        if (!CMC_(PFX, _resize)(_list_, _list_->count * 2))
+        if (!CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + 1, sizeof(V))))
             return false;
 #endif
     }
@@ -254,6 +300,8 @@ bool CMC_(PFX, _pop_front)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -276,6 +324,8 @@ bool CMC_(PFX, _pop_at)(struct SNAME *_list_, size_t index)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -304,6 +354,8 @@ bool CMC_(PFX, _pop_back)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -325,6 +377,8 @@ V CMC_(PFX, _front)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -344,6 +398,8 @@ V CMC_(PFX, _get)(struct SNAME *_list_, size_t index)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -371,6 +427,8 @@ V *CMC_(PFX, _get_ref)(struct SNAME *_list_, size_t index)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -396,6 +454,8 @@ V CMC_(PFX, _back)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (CMC_(PFX, _empty)(_list_))
     {
         _list_->flag = CMC_FLAG_EMPTY;
@@ -415,6 +475,14 @@ size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
+#ifdef CMC_ARITHMETIC_V
+    _list_->flag = CMC_FLAG_OK;
+
+    size_t result = from_start ? CMC_(PFX, _impl_scan_find)(_list_->buffer, _list_->count, value)
+                               : CMC_(PFX, _impl_scan_find_last)(_list_->buffer, _list_->count, value);
+#else
     if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
     {
         _list_->flag = CMC_FLAG_FTABLE;
@@ -447,18 +515,153 @@ size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start)
             }
         }
     }
+#endif
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+size_t CMC_(PFX, _count_of)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+#ifdef CMC_ARITHMETIC_V
+    size_t result = CMC_(PFX, _impl_scan_count)(_list_->buffer, _list_->count, value);
+#else
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return 0;
+    }
+
+    size_t result = 0;
+
+    for (size_t i = 0; i < _list_->count; i++)
+        result += 0 == _list_->f_val->cmp(_list_->buffer[i], value);
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+V CMC_(PFX, _min)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    V result = CMC_(PFX, _impl_scan_min)(_list_->buffer, _list_->count);
+#else
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return (V){ 0 };
+    }
+
+    V result = _list_->buffer[0];
+
+    for (size_t i = 1; i < _list_->count; i++)
+    {
+        if (_list_->f_val->cmp(_list_->buffer[i], result) < 0)
+            result = _list_->buffer[i];
+    }
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
 
     CMC_CALLBACKS_CALL(_list_);
 
     return result;
 }
 
+V CMC_(PFX, _max)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    V result = CMC_(PFX, _impl_scan_max)(_list_->buffer, _list_->count);
+#else
+    if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
+    {
+        _list_->flag = CMC_FLAG_FTABLE;
+        return (V){ 0 };
+    }
+
+    V result = _list_->buffer[0];
+
+    for (size_t i = 1; i < _list_->count; i++)
+    {
+        if (_list_->f_val->cmp(_list_->buffer[i], result) > 0)
+            result = _list_->buffer[i];
+    }
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    V result = CMC_(PFX, _impl_scan_sum)(_list_->buffer, _list_->count);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+#endif
+
 bool CMC_(PFX, _contains)(struct SNAME *_list_, V value)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
+#ifdef CMC_ARITHMETIC_V
+    _list_->flag = CMC_FLAG_OK;
+
+    bool result = CMC_(PFX, _impl_scan_find)(_list_->buffer, _list_->count, value) != _list_->count;
+#else
     if (_list_->f_val == NULL || _list_->f_val->cmp == NULL)
     {
         _list_->flag = CMC_FLAG_FTABLE;
@@ -477,6 +680,7 @@ bool CMC_(PFX, _contains)(struct SNAME *_list_, V value)
             break;
         }
     }
+#endif
 
     CMC_CALLBACKS_CALL(_list_);
 
@@ -557,8 +761,15 @@ bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     _list_->flag = CMC_FLAG_OK;
 
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (_list_->capacity == capacity)
         return true;
 
@@ -568,7 +779,11 @@ bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity)
         return false;
     }
 
+#ifdef CMC_SBO
+    V *new_buffer = CMC_(PFX, _impl_sbo_realloc)(_list_, capacity);
+#else
     V *new_buffer = _list_->alloc->realloc(_list_->buffer, sizeof(V) * capacity);
+#endif
 
     if (!new_buffer)
     {
@@ -580,11 +795,46 @@ bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity)
 
     _list_->buffer = new_buffer;
     _list_->capacity = capacity;
+#ifdef CMC_DEV
+    _list_->generation++;
+#endif
 
     CMC_CALLBACKS_CALL(_list_);
 
     return true;
 }
+
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_list_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->capacity - _list_->count >= size)
+    {
+        _list_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _list_->count)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_list_, _list_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_list_, _list_->count > 0 ? _list_->count : 1);
+}
 #endif
 
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
@@ -593,6 +843,8 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
 #ifdef CMC_SAC
     struct SNAME *result = CMC_(PFX, _new_custom)(_list_->f_val, _list_->alloc, NULL);
 #else
@@ -607,6 +859,9 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
 
     CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
 
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count);
+#else
     if (_list_->f_val && _list_->f_val->cpy)
     {
         for (size_t i = 0; i < _list_->count; i++)
@@ -614,6 +869,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
     }
     else
         memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count);
+#endif
 
     result->count = _list_->count;
 
@@ -628,17 +884,94 @@ bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list1_);
+    CMC_SBO_ANCHOR(_list2_);
+
     _list1_->flag = CMC_FLAG_OK;
     _list2_->flag = CMC_FLAG_OK;
 
     if (_list1_->count != _list2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    return memcmp(_list1_->buffer, _list2_->buffer, sizeof(V) * _list1_->count) == 0;
+#else
     for (size_t i = 0; i < _list1_->count; i++)
     {
         if (0 != _list1_->f_val->cmp(_list1_->buffer[i], _list2_->buffer[i]))
             return false;
     }
 
+    return true;
+#endif
+}
+
+/* Sorts the list. The order of equal elements is not kept. */
+void CMC_(PFX, _sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    CMC_(PFX, _impl_sort_unstable)(_list_->buffer, _list_->count, _list_->f_val->cmp, _list_->alloc);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+}
+
+/* Sorts the list keeping equal elements in the same order. Returns false if */
+/* the memory needed could not be allocated. */
+bool CMC_(PFX, _stable_sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    if (!CMC_(PFX, _impl_sort_stable)(_list_->buffer, _list_->count, _list_->f_val->cmp, _list_->alloc))
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
     return true;
 }
+
+#ifdef CMC_SBO
+/* Moves the elements between the inline storage and the heap when the new */
+/* capacity is on the other side of CMC_SBO */
+static V *CMC_(PFX, _impl_sbo_realloc)(struct SNAME *_list_, size_t capacity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->capacity > CMC_SBO && capacity > CMC_SBO)
+        return _list_->alloc->realloc(_list_->buffer, sizeof(V) * capacity);
+
+    if (capacity <= CMC_SBO)
+    {
+        memcpy(_list_->sbo, _list_->buffer, sizeof(V) * _list_->count);
+        _list_->alloc->free(_list_->buffer);
+
+        return _list_->sbo;
+    }
+
+    V *new_buffer = _list_->alloc->malloc(sizeof(V) * capacity);
+
+    if (!new_buffer)
+        return NULL;
+
+    memcpy(new_buffer, _list_->sbo, sizeof(V) * _list_->count);
+
+    return new_buffer;
+}
+#endif
@@ -22,6 +22,238 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the list. The buffer is split in up
+ * to n_threads contiguous slices, each handled by a cmc_thread worker, and
+ * lists smaller than CMC_ALGO_PARALLEL_THRESHOLD are handled by the current
+ * thread alone. The functions passed to them must be safe to be called from
+ * many threads at once when n_threads is greater than 1.
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_list_, void (*visitor)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    CMC_(PFX, _impl_algo_for_each)(_list_->buffer, _list_->count, visitor, args, n_threads);
+
+    _list_->flag = CMC_FLAG_OK;
+}
+
+/* Replaces the elements of dest by the elements of the list passed through */
+/* mapper. If dest is the list itself, mapper takes ownership of them. */
+bool CMC_(PFX, _map_into)(struct SNAME *_list_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+    CMC_SBO_ANCHOR(dest);
+
+    if (dest != _list_)
+    {
+#ifndef CMC_SAC
+        if (dest->capacity < _list_->count && !CMC_(PFX, _resize)(dest, _list_->count))
+        {
+            _list_->flag = dest->flag;
+            return false;
+        }
+#endif
+
+        CMC_(PFX, _clear)(dest);
+    }
+
+    CMC_(PFX, _impl_algo_map)(_list_->buffer, _list_->count, dest->buffer, mapper, args, n_threads);
+
+    dest->count = _list_->count;
+
+    dest->flag = CMC_FLAG_OK;
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(dest);
+
+    return true;
+}
+
+/* Returns a new list with a copy of every element that satisfies predicate */
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    bool *mask = _list_->alloc->malloc(sizeof(bool) * _list_->count);
+
+    if (!mask && _list_->count > 0)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_list_->buffer, _list_->count, mask, predicate, args, n_threads);
+
+#ifdef CMC_SAC
+    struct SNAME *result = CMC_(PFX, _new_custom)(_list_->f_val, _list_->alloc, NULL);
+#else
+    struct SNAME *result = CMC_(PFX, _new_custom)(matches > 0 ? matches : 1, _list_->f_val, _list_->alloc, NULL);
+#endif
+
+    if (!result)
+    {
+        _list_->alloc->free(mask);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_list_->buffer, _list_->count, mask, result->buffer, NULL, n_threads);
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val->cpy)
+    {
+        for (size_t i = 0; i < matches; i++)
+            result->buffer[i] = _list_->f_val->cpy(result->buffer[i]);
+    }
+#endif
+
+    result->count = matches;
+
+    _list_->alloc->free(mask);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+/* Combines every element, in order, starting from initial. When n_threads */
+/* is greater than 1, reducer must also be associative. */
+V CMC_(PFX, _reduce)(struct SNAME *_list_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_reduce)(_list_->buffer, _list_->count, initial, reducer, args, n_threads);
+}
+
+size_t CMC_(PFX, _count_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_count)(_list_->buffer, _list_->count, predicate, args, n_threads);
+}
+
+/* Keeps in the list the elements that satisfy predicate and moves the rest */
+/* to a new list. Both keep the relative order of their elements. */
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    bool *mask = _list_->alloc->malloc(sizeof(bool) * _list_->count);
+    V *kept = _list_->alloc->malloc(sizeof(V) * _list_->count);
+
+    if ((!mask || !kept) && _list_->count > 0)
+    {
+        _list_->alloc->free(mask);
+        _list_->alloc->free(kept);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_list_->buffer, _list_->count, mask, predicate, args, n_threads);
+    size_t rejected = _list_->count - matches;
+
+#ifdef CMC_SAC
+    struct SNAME *result = CMC_(PFX, _new_custom)(_list_->f_val, _list_->alloc, NULL);
+#else
+    struct SNAME *result = CMC_(PFX, _new_custom)(rejected > 0 ? rejected : 1, _list_->f_val, _list_->alloc, NULL);
+#endif
+
+    if (!result)
+    {
+        _list_->alloc->free(mask);
+        _list_->alloc->free(kept);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_list_->buffer, _list_->count, mask, kept, result->buffer, n_threads);
+
+    memcpy(_list_->buffer, kept, sizeof(V) * matches);
+    memset(_list_->buffer + matches, 0, sizeof(V) * rejected);
+
+    _list_->count = matches;
+    result->count = rejected;
+
+    _list_->alloc->free(mask);
+    _list_->alloc->free(kept);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+/* Overwrites every element with value, or a copy of it if the list has a */
+/* cpy function. The previous elements are freed. */
+void CMC_(PFX, _fill)(struct SNAME *_list_, V value, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val->free)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+            _list_->f_val->free(_list_->buffer[i]);
+    }
+#endif
+
+#ifdef CMC_TRIVIAL_V
+    CMC_(PFX, _impl_algo_fill)(_list_->buffer, _list_->count, value, NULL, n_threads);
+#else
+    CMC_(PFX, _impl_algo_fill)(_list_->buffer, _list_->count, value, _list_->f_val->cpy, n_threads);
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+}
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -68,6 +300,11 @@ struct SNAME CMC_(PFX, _init_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
         return _list_;
 #endif
 
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (!f_val)
         return _list_;
 
@@ -76,6 +313,12 @@ struct SNAME CMC_(PFX, _init_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
 
 #ifdef CMC_SAC
     memset(_list_.buffer, 0, sizeof(V) * SIZE);
+#elif defined(CMC_SBO)
+    /* The inline storage was zeroed with the struct */
+    if (capacity == CMC_SBO)
+        _list_.buffer = _list_.sbo;
+    else
+        _list_.buffer = alloc->calloc(capacity, sizeof(V));
 #else
     _list_.buffer = alloc->calloc(capacity, sizeof(V));
 #endif
@@ -101,13 +344,20 @@ void CMC_(PFX, _release)(struct SNAME _list_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(&_list_);
+
+#ifndef CMC_TRIVIAL_V
     if (_list_.f_val->free)
     {
         for (size_t i = 0; i < _list_.count; i++)
             _list_.f_val->free(_list_.buffer[i]);
     }
+#endif
 
-#ifndef CMC_SAC
+#ifdef CMC_SBO
+    if (_list_.capacity > CMC_SBO)
+        _list_.alloc->free(_list_.buffer);
+#elif !defined(CMC_SAC)
     _list_.alloc->free(_list_.buffer);
 #endif
 }
@@ -127,6 +377,8 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(target);
+
     struct CMC_DEF_ITER(SNAME) iter;
 
     iter.target = target;
@@ -143,6 +395,8 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(target);
+
     struct CMC_DEF_ITER(SNAME) iter;
 
     iter.target = target;
@@ -331,6 +585,8 @@ V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(iter->target);
+
     if (CMC_(PFX, _empty)(iter->target))
         return (V){ 0 };
 
@@ -343,6 +599,8 @@ V *CMC_(PFX, _iter_rvalue)(struct CMC_DEF_ITER(SNAME) * iter)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(iter->target);
+
     if (CMC_(PFX, _empty)(iter->target))
         return NULL;
 
@@ -360,6 +618,39 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort. The list is split between cmc_thread workers that sort
+ * their slices with a stable sort and then merge them in pairs.
+ */
+#ifdef CMC_EXT_PSORT
+
+/* Same as stable_sort() but using up to n_threads threads. Small lists are */
+/* sorted by the current thread alone. */
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_list_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    if (!CMC_(PFX, _impl_sort_parallel)(_list_->buffer, _list_->count, _list_->f_val->cmp, _list_->alloc, n_threads))
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+#endif /* CMC_EXT_PSORT */
+
 /**
  * SEQ
  *
@@ -373,6 +664,8 @@ bool CMC_(PFX, _seq_push_front)(struct SNAME *_list_, V *values, size_t size)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (size == 0)
     {
         _list_->flag = CMC_FLAG_INVALID;
@@ -408,6 +701,8 @@ bool CMC_(PFX, _seq_push_at)(struct SNAME *_list_, V *values, size_t size, size_
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (size == 0)
     {
         _list_->flag = CMC_FLAG_INVALID;
@@ -454,6 +749,8 @@ bool CMC_(PFX, _seq_push_back)(struct SNAME *_list_, V *values, size_t size)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (size == 0)
     {
         _list_->flag = CMC_FLAG_INVALID;
@@ -487,6 +784,8 @@ bool CMC_(PFX, _seq_pop_at)(struct SNAME *_list_, size_t from, size_t to)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (from > to)
     {
         _list_->flag = CMC_FLAG_INVALID;
@@ -519,6 +818,8 @@ struct SNAME *CMC_(PFX, _seq_sublist)(struct SNAME *_list_, size_t from, size_t
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     if (from > to)
     {
         _list_->flag = CMC_FLAG_INVALID;
@@ -576,6 +877,8 @@ bool CMC_(PFX, _to_string)(struct SNAME *_list_, FILE *fptr)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     struct SNAME *l_ = _list_;
 
     return 0 <= fprintf(fptr,
@@ -604,6 +907,8 @@ bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, cons
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_list_);
+
     fprintf(fptr, "%s", start);
 
     for (size_t i = 0; i < _list_->count; i++)
@@ -621,3 +926,210 @@ bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, cons
 }
 
 #endif /* CMC_EXT_STR */
+
+/**
+ * VIEW
+ *
+ * Non-owning views of a range of the list. A view points straight into the
+ * list buffer, so it is invalidated by any function that may reallocate it
+ * (pushes, _resize, _reserve, _shrink_to_fit, ...) and by freeing the list.
+ * With CMC_DEV every view function logs an error when used on an invalidated
+ * view.
+ */
+#ifdef CMC_EXT_VIEW
+
+/* Views the elements in [from, to] */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view)(struct SNAME *_list_, size_t from, size_t to)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_list_);
+
+    if (from > to)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return (struct CMC_DEF_VIEW(SNAME)){ 0 };
+    }
+
+    if (to >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return (struct CMC_DEF_VIEW(SNAME)){ 0 };
+    }
+
+    struct CMC_DEF_VIEW(SNAME) view = { 0 };
+
+    view.data = _list_->buffer + from;
+    view.count = to - from + 1;
+    view.f_val = _list_->f_val;
+#ifdef CMC_DEV
+    view.target = _list_;
+    view.generation = _list_->generation;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return view;
+}
+
+/* Views the elements in [from, to] of another view. Returns an empty view */
+/* if the range is not valid. */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view_slice)(struct CMC_DEF_VIEW(SNAME) * view, size_t from, size_t to)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    struct CMC_DEF_VIEW(SNAME) slice = *view;
+
+    if (from > to || to >= view->count)
+    {
+        slice.data = NULL;
+        slice.count = 0;
+        return slice;
+    }
+
+    slice.data = view->data + from;
+    slice.count = to - from + 1;
+
+    return slice;
+}
+
+V CMC_(PFX, _view_get)(struct CMC_DEF_VIEW(SNAME) * view, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    if (index >= view->count)
+        return (V){ 0 };
+
+    return view->data[index];
+}
+
+/* Returns the count of the view if the value is not found */
+size_t CMC_(PFX, _view_index_of)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool from_start)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+#ifdef CMC_ARITHMETIC_V
+    return from_start ? CMC_(PFX, _impl_scan_find)(view->data, view->count, value)
+                      : CMC_(PFX, _impl_scan_find_last)(view->data, view->count, value);
+#else
+    if (from_start)
+    {
+        for (size_t i = 0; i < view->count; i++)
+        {
+            if (0 == view->f_val->cmp(view->data[i], value))
+                return i;
+        }
+    }
+    else
+    {
+        for (size_t i = view->count; i > 0; i--)
+        {
+            if (0 == view->f_val->cmp(view->data[i - 1], value))
+                return i - 1;
+        }
+    }
+
+    return view->count;
+#endif
+}
+
+size_t CMC_(PFX, _view_count_of)(struct CMC_DEF_VIEW(SNAME) * view, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+#ifdef CMC_ARITHMETIC_V
+    return CMC_(PFX, _impl_scan_count)(view->data, view->count, value);
+#else
+    size_t result = 0;
+
+    for (size_t i = 0; i < view->count; i++)
+        result += 0 == view->f_val->cmp(view->data[i], value);
+
+    return result;
+#endif
+}
+
+bool CMC_(PFX, _view_contains)(struct CMC_DEF_VIEW(SNAME) * view, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _view_index_of)(view, value, true) != view->count;
+}
+
+bool CMC_(PFX, _view_equals)(struct CMC_DEF_VIEW(SNAME) * view1, struct CMC_DEF_VIEW(SNAME) * view2)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view1);
+    CMC_DEV_VIEW_CHECK(view2);
+#endif
+
+    if (view1->count != view2->count)
+        return false;
+
+    for (size_t i = 0; i < view1->count; i++)
+    {
+        if (0 != view1->f_val->cmp(view1->data[i], view2->data[i]))
+            return false;
+    }
+
+    return true;
+}
+
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _view_for_each)(struct CMC_DEF_VIEW(SNAME) * view, void (*visitor)(V, void *), void *args,
+                               size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    CMC_(PFX, _impl_algo_for_each)(view->data, view->count, visitor, args, n_threads);
+}
+
+V CMC_(PFX, _view_reduce)(struct CMC_DEF_VIEW(SNAME) * view, V initial, V (*reducer)(V, V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _impl_algo_reduce)(view->data, view->count, initial, reducer, args, n_threads);
+}
+
+size_t CMC_(PFX, _view_count_if)(struct CMC_DEF_VIEW(SNAME) * view, bool (*predicate)(V, void *), void *args,
+                                 size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _impl_algo_count)(view->data, view->count, predicate, args, n_threads);
+}
+
+#endif /* CMC_EXT_ALGO */
+
+#endif /* CMC_EXT_VIEW */
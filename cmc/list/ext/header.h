@@ -22,6 +22,26 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the list. They can be split between
+ * up to n_threads cmc_thread workers (see cor/algo.h).
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_list_, void (*visitor)(V, void *), void *args, size_t n_threads);
+bool CMC_(PFX, _map_into)(struct SNAME *_list_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads);
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+V CMC_(PFX, _reduce)(struct SNAME *_list_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads);
+size_t CMC_(PFX, _count_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads);
+void CMC_(PFX, _fill)(struct SNAME *_list_, V value, size_t n_threads);
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -71,6 +91,17 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter);
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort.
+ */
+#ifdef CMC_EXT_PSORT
+
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_list_, size_t n_threads);
+
+#endif /* CMC_EXT_PSORT */
+
 /**
  * SEQ
  *
@@ -100,3 +131,32 @@ bool CMC_(PFX, _to_string)(struct SNAME *_list_, FILE *fptr);
 bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, const char *separator, const char *end);
 
 #endif /* CMC_EXT_STR */
+
+/**
+ * VIEW
+ *
+ * Non-owning views of a range of the list. A view is only valid while the
+ * list buffer is not reallocated.
+ */
+#ifdef CMC_EXT_VIEW
+
+/* View Initialization */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view)(struct SNAME *_list_, size_t from, size_t to);
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view_slice)(struct CMC_DEF_VIEW(SNAME) * view, size_t from, size_t to);
+/* View Access */
+V CMC_(PFX, _view_get)(struct CMC_DEF_VIEW(SNAME) * view, size_t index);
+size_t CMC_(PFX, _view_index_of)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool from_start);
+size_t CMC_(PFX, _view_count_of)(struct CMC_DEF_VIEW(SNAME) * view, V value);
+bool CMC_(PFX, _view_contains)(struct CMC_DEF_VIEW(SNAME) * view, V value);
+bool CMC_(PFX, _view_equals)(struct CMC_DEF_VIEW(SNAME) * view1, struct CMC_DEF_VIEW(SNAME) * view2);
+#ifdef CMC_EXT_ALGO
+/* View Algorithms */
+void CMC_(PFX, _view_for_each)(struct CMC_DEF_VIEW(SNAME) * view, void (*visitor)(V, void *), void *args,
+                               size_t n_threads);
+V CMC_(PFX, _view_reduce)(struct CMC_DEF_VIEW(SNAME) * view, V initial, V (*reducer)(V, V, void *), void *args,
+                          size_t n_threads);
+size_t CMC_(PFX, _view_count_if)(struct CMC_DEF_VIEW(SNAME) * view, bool (*predicate)(V, void *), void *args,
+                                 size_t n_threads);
+#endif
+
+#endif /* CMC_EXT_VIEW */
@@ -43,3 +43,29 @@ struct CMC_DEF_ITER(SNAME)
 };
 
 #endif /* CMC_EXT_ITER */
+
+/**
+ * VIEW
+ *
+ * Non-owning views of a range of the list.
+ */
+#ifdef CMC_EXT_VIEW
+
+/* List View */
+struct CMC_DEF_VIEW(SNAME)
+{
+    /* First element of the range, owned by the list */
+    V *data;
+    /* Amount of elements in the range */
+    size_t count;
+    /* Value function table of the list */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+#ifdef CMC_DEV
+    /* List the view was taken from */
+    struct SNAME *target;
+    /* Generation of the list buffer when the view was taken */
+    size_t generation;
+#endif
+};
+
+#endif /* CMC_EXT_VIEW */
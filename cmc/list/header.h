@@ -66,6 +66,12 @@ V CMC_(PFX, _get)(struct SNAME *_list_, size_t index);
 V *CMC_(PFX, _get_ref)(struct SNAME *_list_, size_t index);
 V CMC_(PFX, _back)(struct SNAME *_list_);
 size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start);
+size_t CMC_(PFX, _count_of)(struct SNAME *_list_, V value);
+V CMC_(PFX, _min)(struct SNAME *_list_);
+V CMC_(PFX, _max)(struct SNAME *_list_);
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_list_);
+#endif
 /* Collection State */
 bool CMC_(PFX, _contains)(struct SNAME *_list_, V value);
 bool CMC_(PFX, _empty)(struct SNAME *_list_);
@@ -76,5 +82,11 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_list_);
 int CMC_(PFX, _flag)(struct SNAME *_list_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity);
+#ifndef CMC_SAC
+bool CMC_(PFX, _reserve)(struct SNAME *_list_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_list_);
+#endif
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_);
 bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_);
+void CMC_(PFX, _sort)(struct SNAME *_list_);
+bool CMC_(PFX, _stable_sort)(struct SNAME *_list_);
@@ -31,6 +31,10 @@ struct SNAME
     V *buffer;
     /* Current array capacity */
     size_t capacity;
+#endif
+#ifdef CMC_SBO
+    /* Inline storage used as the buffer while the capacity is CMC_SBO */
+    V sbo[CMC_SBO];
 #endif
     /* Current amount of elements */
     size_t count;
@@ -42,4 +46,8 @@ struct SNAME
     CMC_ALLOC_TYPE alloc;
     /* Custom callback functions */
     CMC_CALLBACKS_DECL;
+#ifdef CMC_DEV
+    /* Incremented every time the buffer is reallocated, checked by views */
+    size_t generation;
+#endif
 };
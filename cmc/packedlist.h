@@ -0,0 +1,95 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * packedlist.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * PackedList
+ *
+ * A packed list is a frozen, compressed, sorted list of unsigned integers. It
+ * is built once from a sorted array, like the buffer of a SortedList or a
+ * sorted List, and it can't be modified afterwards. It is meant for very
+ * large lists of identifiers that are mostly scanned or searched.
+ *
+ * Implementation
+ *
+ * The elements are split in blocks of CMC_BITPACK_BLOCK elements. Each block
+ * stores its first element and the differences between consecutive elements,
+ * bit-packed with the smallest width that fits all of them (see
+ * cor/bitpack.h). Blocks whose differences don't fit in 32 bits are stored as
+ * two packed blocks with the lower and upper halves of the differences. The
+ * last element of each block is kept in a separate array that is used as a
+ * skip index, so searches only decode a single block.
+ *
+ * V must be an unsigned integer type of at most 64 bits. The PackedList does
+ * not have Functions Tables.
+ */
+
+#include "cor/bitpack.h"
+#include "cor/core.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * V - packedlist data type (an unsigned integer type)
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/packedlist/struct.h"
+
+/* Function declaration */
+#include "cmc/packedlist/header.h"
+
+/* Function implementation */
+#include "cmc/packedlist/code.h"
+
+/**
+ * Extensions
+ *
+ * INIT - Initializes the struct on the stack
+ * ITER - List iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_PACKEDLIST_PARTS INIT, ITER, STR
+/**/
+#include "cmc/packedlist/ext/struct.h"
+/**/
+#include "cmc/packedlist/ext/header.h"
+/**/
+#include "cmc/packedlist/ext/code.h"
+
+#include "cor/undef.h"
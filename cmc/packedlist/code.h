@@ -0,0 +1,489 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static bool CMC_(PFX, _impl_pack)(struct SNAME *_list_, V *values);
+static unsigned CMC_(PFX, _impl_differences)(V *values, size_t size, uint32_t *low, uint32_t *high);
+static void CMC_(PFX, _impl_decode_block)(struct SNAME *_list_, size_t block, V *out);
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_list_, V value, bool *found);
+
+struct SNAME *CMC_(PFX, _new)(V *values, size_t count)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(values, count, NULL, NULL);
+}
+
+/* The values must be sorted in ascending order. They are only read. */
+struct SNAME *CMC_(PFX, _new_custom)(V *values, size_t count, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (count > 0 && !values)
+        return NULL;
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (values[i] < values[i - 1])
+            return NULL;
+    }
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_list_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_list_)
+        return NULL;
+
+    _list_->data = NULL;
+    _list_->firsts = NULL;
+    _list_->maxima = NULL;
+    _list_->offsets = NULL;
+    _list_->widths = NULL;
+    _list_->blocks = (count + CMC_BITPACK_BLOCK - 1) / CMC_BITPACK_BLOCK;
+    _list_->count = count;
+    _list_->flag = CMC_FLAG_OK;
+    _list_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+
+    if (!CMC_(PFX, _impl_pack)(_list_, values))
+    {
+        CMC_(PFX, _free)(_list_);
+        return NULL;
+    }
+
+    return _list_;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->alloc->free(_list_->data);
+    _list_->alloc->free(_list_->firsts);
+    _list_->alloc->free(_list_->maxima);
+    _list_->alloc->free(_list_->offsets);
+    _list_->alloc->free(_list_->widths);
+    _list_->alloc->free(_list_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_list_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _list_->alloc = &cmc_alloc_node_default;
+    else
+        _list_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+
+    _list_->flag = CMC_FLAG_OK;
+}
+
+V CMC_(PFX, _max)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return _list_->maxima[_list_->blocks - 1];
+}
+
+V CMC_(PFX, _min)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return _list_->firsts[0];
+}
+
+V CMC_(PFX, _get)(struct SNAME *_list_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    if (index >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return (V){ 0 };
+    }
+
+    V values[CMC_BITPACK_BLOCK];
+
+    CMC_(PFX, _impl_decode_block)(_list_, index / CMC_BITPACK_BLOCK, values);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return values[index % CMC_BITPACK_BLOCK];
+}
+
+/* Index of the first element greater than or equal to value or count if */
+/* there is no such element */
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return CMC_(PFX, _impl_lower_bound)(_list_, value, NULL);
+}
+
+/* Decodes the elements in the range of indexes [from, to], both inclusive, */
+/* into buffer, which must be able to hold to - from + 1 elements. Returns */
+/* how many elements were decoded. */
+size_t CMC_(PFX, _decode)(struct SNAME *_list_, size_t from, size_t to, V *buffer)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (from > to)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return 0;
+    }
+
+    if (to >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return 0;
+    }
+
+    V values[CMC_BITPACK_BLOCK];
+
+    /* One past the last index to be decoded */
+    size_t stop = to + 1;
+
+    for (size_t i = from; i < stop;)
+    {
+        size_t block = i / CMC_BITPACK_BLOCK;
+        size_t begin = block * CMC_BITPACK_BLOCK;
+        size_t end = begin + CMC_BITPACK_BLOCK;
+
+        /* Whole blocks are decoded straight into the buffer */
+        if (i == begin && end <= stop)
+        {
+            CMC_(PFX, _impl_decode_block)(_list_, block, buffer + (i - from));
+        }
+        else
+        {
+            CMC_(PFX, _impl_decode_block)(_list_, block, values);
+
+            size_t size = (end < stop ? end : stop) - i;
+
+            memcpy(buffer + (i - from), values + (i - begin), sizeof(V) * size);
+        }
+
+        i = end < stop ? end : stop;
+    }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return stop - from;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    bool found = false;
+
+    CMC_(PFX, _impl_lower_bound)(_list_, value, &found);
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return found;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->count;
+}
+
+/* Total amount of bytes used by the list */
+size_t CMC_(PFX, _memory)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t words = 0;
+
+    if (_list_->blocks > 0)
+        words = _list_->offsets[_list_->blocks - 1] + 4 * _list_->widths[_list_->blocks - 1];
+
+    return sizeof(struct SNAME) + sizeof(uint32_t) * words +
+           _list_->blocks * (2 * sizeof(V) + sizeof(size_t) + sizeof(unsigned char));
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _list_->flag;
+}
+
+static bool CMC_(PFX, _impl_pack)(struct SNAME *_list_, V *values)
+{
+    size_t blocks = _list_->blocks;
+
+    if (blocks == 0)
+        return true;
+
+    _list_->firsts = _list_->alloc->malloc(sizeof(V) * blocks);
+    _list_->maxima = _list_->alloc->malloc(sizeof(V) * blocks);
+    _list_->offsets = _list_->alloc->malloc(sizeof(size_t) * blocks);
+    _list_->widths = _list_->alloc->malloc(sizeof(unsigned char) * blocks);
+
+    if (!_list_->firsts || !_list_->maxima || !_list_->offsets || !_list_->widths)
+        return false;
+
+    uint32_t low[CMC_BITPACK_BLOCK];
+    uint32_t high[CMC_BITPACK_BLOCK];
+
+    /* The first pass only measures the blocks */
+    size_t words = 0;
+
+    for (size_t b = 0; b < blocks; b++)
+    {
+        V *block = values + b * CMC_BITPACK_BLOCK;
+        size_t size = _list_->count - b * CMC_BITPACK_BLOCK;
+
+        if (size > CMC_BITPACK_BLOCK)
+            size = CMC_BITPACK_BLOCK;
+
+        unsigned width = CMC_(PFX, _impl_differences)(block, size, low, high);
+
+        _list_->firsts[b] = block[0];
+        _list_->maxima[b] = block[size - 1];
+        _list_->offsets[b] = words;
+        _list_->widths[b] = (unsigned char)width;
+
+        words += 4 * width;
+    }
+
+    /* At least one word so that every offset points inside the array */
+    _list_->data = _list_->alloc->malloc(sizeof(uint32_t) * (words > 0 ? words : 1));
+
+    if (!_list_->data)
+        return false;
+
+    for (size_t b = 0; b < blocks; b++)
+    {
+        V *block = values + b * CMC_BITPACK_BLOCK;
+        size_t size = _list_->count - b * CMC_BITPACK_BLOCK;
+
+        if (size > CMC_BITPACK_BLOCK)
+            size = CMC_BITPACK_BLOCK;
+
+        unsigned width = CMC_(PFX, _impl_differences)(block, size, low, high);
+        uint32_t *out = _list_->data + _list_->offsets[b];
+
+        if (width == 64)
+        {
+            cmc_bitpack_pack(low, out, 32);
+            cmc_bitpack_pack(high, out + 4 * 32, 32);
+        }
+        else
+            cmc_bitpack_pack(low, out, width);
+    }
+
+    return true;
+}
+
+/* Splits the differences between consecutive values of a block in their */
+/* lower and upper 32 bits, padding the block with zeros. Returns the width */
+/* used to pack the block. */
+static unsigned CMC_(PFX, _impl_differences)(V *values, size_t size, uint32_t *low, uint32_t *high)
+{
+    uint32_t upper = 0;
+
+    low[0] = 0;
+    high[0] = 0;
+
+    for (size_t i = 1; i < CMC_BITPACK_BLOCK; i++)
+    {
+        uint64_t difference = i < size ? (uint64_t)(values[i] - values[i - 1]) : 0;
+
+        low[i] = (uint32_t)difference;
+        high[i] = (uint32_t)(difference >> 32);
+
+        upper |= high[i];
+    }
+
+    if (upper)
+        return 64;
+
+    return cmc_bitpack_width(low);
+}
+
+/* Decodes all CMC_BITPACK_BLOCK elements of a block. The padding at the end */
+/* of the last block repeats the last element. */
+static void CMC_(PFX, _impl_decode_block)(struct SNAME *_list_, size_t block, V *out)
+{
+    uint32_t low[CMC_BITPACK_BLOCK];
+    const uint32_t *in = _list_->data + _list_->offsets[block];
+    unsigned width = _list_->widths[block];
+
+    V current = _list_->firsts[block];
+
+    if (width == 64)
+    {
+        uint32_t high[CMC_BITPACK_BLOCK];
+
+        cmc_bitpack_unpack(in, low, 32);
+        cmc_bitpack_unpack(in + 4 * 32, high, 32);
+
+        for (size_t i = 0; i < CMC_BITPACK_BLOCK; i++)
+        {
+            current += (V)((uint64_t)low[i] | ((uint64_t)high[i] << 32));
+            out[i] = current;
+        }
+    }
+    else
+    {
+        cmc_bitpack_unpack(in, low, width);
+
+        for (size_t i = 0; i < CMC_BITPACK_BLOCK; i++)
+        {
+            current += low[i];
+            out[i] = current;
+        }
+    }
+}
+
+/* The skip index is searched for the first block whose last element is not */
+/* smaller than value and then only that block is decoded */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_list_, V value, bool *found)
+{
+    if (found)
+        *found = false;
+
+    if (CMC_(PFX, _empty)(_list_))
+        return 0;
+
+    const V *base = _list_->maxima;
+    size_t n = _list_->blocks;
+
+    while (n > 1)
+    {
+        size_t half = n / 2;
+
+        base = base[half - 1] < value ? base + half : base;
+        n -= half;
+    }
+
+    size_t block = (size_t)(base - _list_->maxima) + (*base < value);
+
+    if (block == _list_->blocks)
+        return _list_->count;
+
+    V values[CMC_BITPACK_BLOCK];
+
+    CMC_(PFX, _impl_decode_block)(_list_, block, values);
+
+    size_t size = _list_->count - block * CMC_BITPACK_BLOCK;
+
+    if (size > CMC_BITPACK_BLOCK)
+        size = CMC_BITPACK_BLOCK;
+
+    size_t index = 0;
+
+    for (size_t i = 0; i < size; i++)
+        index += values[i] < value;
+
+    if (found)
+        *found = values[index] == value;
+
+    return block * CMC_BITPACK_BLOCK + index;
+}
@@ -0,0 +1,42 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Collection Allocation and Deallocation */
+struct SNAME *CMC_(PFX, _new)(V *values, size_t count);
+struct SNAME *CMC_(PFX, _new_custom)(V *values, size_t count, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks);
+void CMC_(PFX, _free)(struct SNAME *_list_);
+/* Customization of Allocation and Callbacks */
+void CMC_(PFX, _customize)(struct SNAME *_list_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks);
+/* Element Access */
+V CMC_(PFX, _max)(struct SNAME *_list_);
+V CMC_(PFX, _min)(struct SNAME *_list_);
+V CMC_(PFX, _get)(struct SNAME *_list_, size_t index);
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_list_, V value);
+size_t CMC_(PFX, _decode)(struct SNAME *_list_, size_t from, size_t to, V *buffer);
+/* Collection State */
+bool CMC_(PFX, _contains)(struct SNAME *_list_, V value);
+bool CMC_(PFX, _empty)(struct SNAME *_list_);
+size_t CMC_(PFX, _count)(struct SNAME *_list_);
+size_t CMC_(PFX, _memory)(struct SNAME *_list_);
+int CMC_(PFX, _flag)(struct SNAME *_list_);
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * ptreemap.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * PTreeMap
+ *
+ * A persistent TreeMap. It is a sorted map based on an AVL tree where nodes are
+ * never modified once they are shared. Insertions, updates and removals copy
+ * only the O(log n) nodes along the path to the affected key, and every node
+ * keeps a reference count so that different versions of the map can share the
+ * rest of the tree. This makes taking a snapshot an O(1) operation.
+ *
+ * Keys and values are shared between versions and are never freed by the
+ * collection. Reference counts are not atomic: a snapshot can be read from
+ * other threads while its origin is being modified, but creating and freeing
+ * handles that share nodes must be synchronized by the user.
+ */
+
+#include "cor/core.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - ptreemap key data type
+ * V - ptreemap value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/ptreemap/struct.h"
+
+/* Function declaration */
+#include "cmc/ptreemap/header.h"
+
+/* Function implementation */
+#include "cmc/ptreemap/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - ptreemap iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_PTREEMAP_PARTS ITER, STR
+/**/
+#include "cmc/ptreemap/ext/struct.h"
+/**/
+#include "cmc/ptreemap/ext/header.h"
+/**/
+#include "cmc/ptreemap/ext/code.h"
+
+#include "cor/undef.h"
@@ -0,0 +1,826 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key);
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node);
+static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_acquire)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_release)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_own)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_,
+                                                                 struct CMC_DEF_NODE(SNAME) * Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_insert)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_update)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V new_value, V *old_value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_remove)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V *out_value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_remove_min)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                               K *key, V *value);
+static bool CMC_(PFX, _impl_equals)(struct SNAME *_map1_, struct CMC_DEF_NODE(SNAME) * node, struct SNAME *_map2_);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                     CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->count = 0;
+    _map_->root = NULL;
+    _map_->flag = CMC_FLAG_OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+/* Releases this version of the map. Nodes still shared with other versions */
+/* are kept alive. Keys and values are never freed since they are shared. */
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_release)(_map_, _map_->root);
+
+    _map_->count = 0;
+    _map_->root = NULL;
+    _map_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _clear)(_map_);
+
+    _map_->alloc->free(_map_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    _map_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Checking first avoids copying the path of a key that already exists */
+    if (CMC_(PFX, _impl_get_node)(_map_, key) != NULL)
+    {
+        _map_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+    _map_->root = CMC_(PFX, _impl_insert)(_map_, _map_->root, key, value);
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return false;
+
+    _map_->count++;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _impl_get_node)(_map_, key) == NULL)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+    _map_->root = CMC_(PFX, _impl_update)(_map_, _map_->root, key, new_value, old_value);
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return false;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    if (CMC_(PFX, _impl_get_node)(_map_, key) == NULL)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+    _map_->root = CMC_(PFX, _impl_remove)(_map_, _map_->root, key, out_value);
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return false;
+
+    _map_->count--;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan->right != NULL)
+        scan = scan->right;
+
+    if (key)
+        *key = scan->key;
+    if (value)
+        *value = scan->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan->left != NULL)
+        scan = scan->left;
+
+    if (key)
+        *key = scan->key;
+    if (value)
+        *value = scan->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+V CMC_(PFX, _get)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (V){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->value;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool result = CMC_(PFX, _impl_get_node)(_map_, key) != NULL;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->flag;
+}
+
+/* Returns a new map that shares every node with the current one in O(1). */
+/* Both maps can be modified independently afterwards and each must be freed. */
+struct SNAME *CMC_(PFX, _snapshot)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Callback will be added later */
+    struct SNAME *result = CMC_(PFX, _new_custom)(_map_->f_key, _map_->f_val, _map_->alloc, NULL);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    result->root = CMC_(PFX, _impl_acquire)(_map_->root);
+    result->count = _map_->count;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_ASSIGN(result, _map_->callbacks);
+
+    return result;
+}
+
+/* Makes the map go back to the version of the given snapshot in O(1). The */
+/* snapshot is left untouched and still needs to be freed. */
+void CMC_(PFX, _restore)(struct SNAME *_map_, struct SNAME *snapshot)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Acquiring first keeps the nodes alive when both versions are the same */
+    struct CMC_DEF_NODE(SNAME) *root = CMC_(PFX, _impl_acquire)(snapshot->root);
+
+    CMC_(PFX, _impl_release)(_map_, _map_->root);
+
+    _map_->root = root;
+    _map_->count = snapshot->count;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+}
+
+/* Since nodes are never modified while shared, a copy is just a snapshot */
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _snapshot)(_map_);
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map1_->flag = CMC_FLAG_OK;
+    _map2_->flag = CMC_FLAG_OK;
+
+    if (_map1_->count != _map2_->count)
+        return false;
+
+    /* Versions that share their root are trivially equal */
+    if (_map1_->root == _map2_->root)
+        return true;
+
+    return CMC_(PFX, _impl_equals)(_map1_, _map1_->root, _map2_);
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!node)
+        return NULL;
+
+    node->key = key;
+    node->value = value;
+    node->right = NULL;
+    node->left = NULL;
+    node->height = 1;
+    node->refs = 1;
+
+    return node;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan != NULL)
+    {
+        int c = _map_->f_key->cmp(scan->key, key);
+
+        if (c > 0)
+            scan = scan->left;
+        else if (c < 0)
+            scan = scan->right;
+        else
+            return scan;
+    }
+
+    return NULL;
+}
+
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->height;
+}
+
+static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    unsigned char h_l = CMC_(PFX, _impl_h)(node->left);
+    unsigned char h_r = CMC_(PFX, _impl_h)(node->right);
+
+    return 1 + (h_l > h_r ? h_l : h_r);
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_acquire)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+        node->refs++;
+
+    return node;
+}
+
+/* Drops one reference to a node, freeing it and releasing its children when */
+/* no other node or map points to it */
+static void CMC_(PFX, _impl_release)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL && --node->refs == 0)
+    {
+        struct CMC_DEF_NODE(SNAME) *right = node->right;
+
+        CMC_(PFX, _impl_release)(_map_, node->left);
+
+        _map_->alloc->free(node);
+
+        /* Loop on the right child instead of recursing */
+        node = right;
+    }
+}
+
+/* Takes a reference to a node and returns a node with the same content that */
+/* can be modified in place, copying it if it is shared. On allocation */
+/* failure NULL is returned and the reference to the node is kept. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_own)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->refs == 1)
+        return node;
+
+    struct CMC_DEF_NODE(SNAME) *copy = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!copy)
+        return NULL;
+
+    *copy = *node;
+    copy->refs = 1;
+
+    CMC_(PFX, _impl_acquire)(copy->left);
+    CMC_(PFX, _impl_acquire)(copy->right);
+
+    /* Can't reach zero since the node was shared */
+    node->refs--;
+
+    return copy;
+}
+
+/* Every function below takes a reference to a subtree and returns the */
+/* reference to the subtree that replaces it. On allocation failure the */
+/* flag is set and the subtree returned still holds the same elements. */
+
+/**
+ * Z is the unbalanced node and Y its left child. Z must be owned and Y is
+ * owned before being modified. If that fails, the subtree is not rotated.
+ */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_,
+                                                                 struct CMC_DEF_NODE(SNAME) * Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *Y = CMC_(PFX, _impl_own)(_map_, Z->left);
+
+    if (!Y)
+        return Z;
+
+    Z->left = Y->right;
+    Y->right = Z;
+
+    Z->height = CMC_(PFX, _impl_hupdate)(Z);
+    Y->height = CMC_(PFX, _impl_hupdate)(Y);
+
+    return Y;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *Y = CMC_(PFX, _impl_own)(_map_, Z->right);
+
+    if (!Y)
+        return Z;
+
+    Z->right = Y->left;
+    Y->left = Z;
+
+    Z->height = CMC_(PFX, _impl_hupdate)(Z);
+    Y->height = CMC_(PFX, _impl_hupdate)(Y);
+
+    return Y;
+}
+
+/* Rebalances an owned node whose children are already balanced. When memory */
+/* runs out the subtree is left valid but less balanced. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+
+    unsigned char l = CMC_(PFX, _impl_h)(node->left);
+    unsigned char r = CMC_(PFX, _impl_h)(node->right);
+
+    if (l > r + 1)
+    {
+        struct CMC_DEF_NODE(SNAME) *child = CMC_(PFX, _impl_own)(_map_, node->left);
+
+        if (!child)
+            return node;
+
+        node->left = child;
+
+        if (CMC_(PFX, _impl_h)(child->left) < CMC_(PFX, _impl_h)(child->right))
+            node->left = CMC_(PFX, _impl_rotate_left)(_map_, child);
+
+        return CMC_(PFX, _impl_rotate_right)(_map_, node);
+    }
+    else if (r > l + 1)
+    {
+        struct CMC_DEF_NODE(SNAME) *child = CMC_(PFX, _impl_own)(_map_, node->right);
+
+        if (!child)
+            return node;
+
+        node->right = child;
+
+        if (CMC_(PFX, _impl_h)(child->right) < CMC_(PFX, _impl_h)(child->left))
+            node->right = CMC_(PFX, _impl_rotate_right)(_map_, child);
+
+        return CMC_(PFX, _impl_rotate_left)(_map_, node);
+    }
+
+    return node;
+}
+
+/* The key must not be in the subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_insert)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *result = CMC_(PFX, _impl_new_node)(_map_, key, value);
+
+        if (!result)
+            _map_->flag = CMC_FLAG_ALLOC;
+
+        return result;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *owned = CMC_(PFX, _impl_own)(_map_, node);
+
+    if (!owned)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return node;
+    }
+
+    if (_map_->f_key->cmp(owned->key, key) > 0)
+        owned->left = CMC_(PFX, _impl_insert)(_map_, owned->left, key, value);
+    else
+        owned->right = CMC_(PFX, _impl_insert)(_map_, owned->right, key, value);
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return owned;
+
+    return CMC_(PFX, _impl_rebalance)(_map_, owned);
+}
+
+/* The key must be in the subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_update)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V new_value, V *old_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *owned = CMC_(PFX, _impl_own)(_map_, node);
+
+    if (!owned)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return node;
+    }
+
+    int c = _map_->f_key->cmp(owned->key, key);
+
+    if (c > 0)
+        owned->left = CMC_(PFX, _impl_update)(_map_, owned->left, key, new_value, old_value);
+    else if (c < 0)
+        owned->right = CMC_(PFX, _impl_update)(_map_, owned->right, key, new_value, old_value);
+    else
+    {
+        if (old_value)
+            *old_value = owned->value;
+
+        owned->value = new_value;
+    }
+
+    return owned;
+}
+
+/* The key must be in the subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_remove)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                           K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *owned = CMC_(PFX, _impl_own)(_map_, node);
+
+    if (!owned)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return node;
+    }
+
+    int c = _map_->f_key->cmp(owned->key, key);
+
+    if (c > 0)
+        owned->left = CMC_(PFX, _impl_remove)(_map_, owned->left, key, out_value);
+    else if (c < 0)
+        owned->right = CMC_(PFX, _impl_remove)(_map_, owned->right, key, out_value);
+    else if (owned->left == NULL || owned->right == NULL)
+    {
+        /* The reference to the only child is passed on to the parent */
+        struct CMC_DEF_NODE(SNAME) *child = owned->left != NULL ? owned->left : owned->right;
+
+        if (out_value)
+            *out_value = owned->value;
+
+        _map_->alloc->free(owned);
+
+        return child;
+    }
+    else
+    {
+        K min_key;
+        V min_value;
+
+        owned->right = CMC_(PFX, _impl_remove_min)(_map_, owned->right, &min_key, &min_value);
+
+        if (_map_->flag != CMC_FLAG_OK)
+            return owned;
+
+        if (out_value)
+            *out_value = owned->value;
+
+        owned->key = min_key;
+        owned->value = min_value;
+    }
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return owned;
+
+    return CMC_(PFX, _impl_rebalance)(_map_, owned);
+}
+
+/* Removes the smallest node of a non-empty subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_remove_min)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                                               K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *owned = CMC_(PFX, _impl_own)(_map_, node);
+
+    if (!owned)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return node;
+    }
+
+    if (owned->left == NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *right = owned->right;
+
+        *key = owned->key;
+        *value = owned->value;
+
+        _map_->alloc->free(owned);
+
+        return right;
+    }
+
+    owned->left = CMC_(PFX, _impl_remove_min)(_map_, owned->left, key, value);
+
+    if (_map_->flag != CMC_FLAG_OK)
+        return owned;
+
+    return CMC_(PFX, _impl_rebalance)(_map_, owned);
+}
+
+/* Checks if every node of a subtree of map1 is also in map2 */
+static bool CMC_(PFX, _impl_equals)(struct SNAME *_map1_, struct CMC_DEF_NODE(SNAME) * node, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *other = CMC_(PFX, _impl_get_node)(_map2_, node->key);
+
+        if (other == NULL)
+            return false;
+
+        if (other != node && _map1_->f_val->cmp(node->value, other->value) != 0)
+            return false;
+
+        if (!CMC_(PFX, _impl_equals)(_map1_, node->left, _map2_))
+            return false;
+
+        node = node->right;
+    }
+
+    return true;
+}
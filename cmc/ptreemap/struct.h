@@ -0,0 +1,71 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* PTreemap Structure */
+struct SNAME
+{
+    /* Root node, possibly shared with other versions of the map */
+    struct CMC_DEF_NODE(SNAME) * root;
+
+    /* Current amount of keys */
+    size_t count;
+
+    /* Flags indicating errors or success */
+    int flag;
+
+    /* Key function table */
+    struct CMC_DEF_FKEY(SNAME) * f_key;
+
+    /* Value function table */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+
+    /* Custom allocation functions */
+    CMC_ALLOC_TYPE alloc;
+
+    /* Custom callback functions */
+    CMC_CALLBACKS_DECL;
+};
+
+/* PTreemap Node */
+struct CMC_DEF_NODE(SNAME)
+{
+    /* Node Key */
+    K key;
+
+    /* Node Value */
+    V value;
+
+    /* Node height used by the AVL tree to keep it strictly balanced */
+    unsigned char height;
+
+    /* Amount of parent nodes and maps pointing to this node. A node can only */
+    /* be modified in place when this is 1 */
+    size_t refs;
+
+    /* Right child node or subtree */
+    struct CMC_DEF_NODE(SNAME) * right;
+
+    /* Left child node or subtree */
+    struct CMC_DEF_NODE(SNAME) * left;
+};
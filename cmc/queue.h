@@ -65,6 +65,7 @@
  */
 
 #include "cor/core.h"
+#include "cor/growth.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -73,6 +74,7 @@
 /**
  * Used values
  * V - queue data type
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -23,7 +23,8 @@
  */
 
 /* Implementation Detail Functions */
-/* None */
+static size_t CMC_(PFX, _impl_head_count)(struct SNAME *_queue_);
+static void CMC_(PFX, _impl_copy_ordered)(struct SNAME *_queue_, V *dest);
 
 struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -83,6 +84,7 @@ void CMC_(PFX, _clear)(struct SNAME *_queue_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_queue_->f_val->free)
     {
         for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
@@ -92,6 +94,7 @@ void CMC_(PFX, _clear)(struct SNAME *_queue_)
             i = (i + 1) % _queue_->capacity;
         }
     }
+#endif
 
     memset(_queue_->buffer, 0, sizeof(V) * _queue_->capacity);
 
@@ -107,6 +110,7 @@ void CMC_(PFX, _free)(struct SNAME *_queue_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_queue_->f_val->free)
     {
         for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
@@ -116,6 +120,7 @@ void CMC_(PFX, _free)(struct SNAME *_queue_)
             i = (i + 1) % _queue_->capacity;
         }
     }
+#endif
 
     _queue_->alloc->free(_queue_->buffer);
     _queue_->alloc->free(_queue_);
@@ -147,7 +152,7 @@ bool CMC_(PFX, _enqueue)(struct SNAME *_queue_, V value)
 
     if (CMC_(PFX, _full)(_queue_))
     {
-        if (!CMC_(PFX, _resize)(_queue_, _queue_->capacity * 2))
+        if (!CMC_(PFX, _resize)(_queue_, cmc_growth_capacity(_queue_->capacity, _queue_->count + 1, sizeof(V))))
             return false;
     }
 
@@ -290,6 +295,35 @@ bool CMC_(PFX, _resize)(struct SNAME *_queue_, size_t capacity)
         return false;
     }
 
+    if (capacity > _queue_->capacity)
+    {
+        V *grown = _queue_->alloc->realloc(_queue_->buffer, sizeof(V) * capacity);
+
+        if (!grown)
+        {
+            _queue_->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        /* The buffer is grown in place, so only the elements that wrap */
+        /* around, from front to the old end, are moved to the new end */
+        if (_queue_->front + _queue_->count > _queue_->capacity)
+        {
+            size_t tail = _queue_->capacity - _queue_->front;
+
+            memmove(grown + capacity - tail, grown + _queue_->front, sizeof(V) * tail);
+
+            _queue_->front = capacity - tail;
+        }
+        else
+            _queue_->back = _queue_->front + _queue_->count;
+
+        _queue_->buffer = grown;
+        _queue_->capacity = capacity;
+
+        goto success;
+    }
+
     V *new_buffer = _queue_->alloc->malloc(sizeof(V) * capacity);
 
     if (!new_buffer)
@@ -298,19 +332,14 @@ bool CMC_(PFX, _resize)(struct SNAME *_queue_, size_t capacity)
         return false;
     }
 
-    for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
-    {
-        new_buffer[j] = _queue_->buffer[i];
-
-        i = (i + 1) % _queue_->capacity;
-    }
+    CMC_(PFX, _impl_copy_ordered)(_queue_, new_buffer);
 
     _queue_->alloc->free(_queue_->buffer);
 
     _queue_->buffer = new_buffer;
     _queue_->capacity = capacity;
     _queue_->front = 0;
-    _queue_->back = _queue_->count;
+    _queue_->back = _queue_->count == capacity ? 0 : _queue_->count;
 
 success:
 
@@ -321,6 +350,38 @@ success:
     return true;
 }
 
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_queue_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_queue_->capacity - _queue_->count >= size)
+    {
+        _queue_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _queue_->count)
+    {
+        _queue_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_queue_, _queue_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_queue_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_queue_, _queue_->count > 0 ? _queue_->count : 1);
+}
+
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_queue_)
 {
 #ifdef CMC_DEV
@@ -337,6 +398,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_queue_)
 
     CMC_CALLBACKS_ASSIGN(result, _queue_->callbacks);
 
+#ifndef CMC_TRIVIAL_V
     if (_queue_->f_val->cpy)
     {
         for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
@@ -347,14 +409,8 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_queue_)
         }
     }
     else
-    {
-        for (size_t i = _queue_->front, j = 0; j < _queue_->count; j++)
-        {
-            result->buffer[j] = _queue_->buffer[i];
-
-            i = (i + 1) % _queue_->capacity;
-        }
-    }
+#endif
+        CMC_(PFX, _impl_copy_ordered)(_queue_, result->buffer);
 
     result->count = _queue_->count;
     result->front = 0;
@@ -377,6 +433,25 @@ bool CMC_(PFX, _equals)(struct SNAME *_queue1_, struct SNAME *_queue2_)
     if (_queue1_->count != _queue2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    /* Compared in blocks that end where either of the buffers wraps around */
+    for (size_t i = _queue1_->front, j = _queue2_->front, k = 0; k < _queue1_->count;)
+    {
+        size_t block = _queue1_->count - k;
+
+        if (block > _queue1_->capacity - i)
+            block = _queue1_->capacity - i;
+        if (block > _queue2_->capacity - j)
+            block = _queue2_->capacity - j;
+
+        if (memcmp(_queue1_->buffer + i, _queue2_->buffer + j, sizeof(V) * block) != 0)
+            return false;
+
+        k += block;
+        i = (i + block) % _queue1_->capacity;
+        j = (j + block) % _queue2_->capacity;
+    }
+#else
     size_t i, j, k;
     for (i = _queue1_->front, j = _queue2_->front, k = 0; k < _queue1_->count; k++)
     {
@@ -386,6 +461,33 @@ bool CMC_(PFX, _equals)(struct SNAME *_queue1_, struct SNAME *_queue2_)
         i = (i + 1) % _queue1_->capacity;
         j = (j + 1) % _queue2_->capacity;
     }
+#endif
 
     return true;
 }
+
+/* Amount of elements from the front to the end of the buffer. The other */
+/* elements wrapped around to the start of the buffer. */
+static size_t CMC_(PFX, _impl_head_count)(struct SNAME *_queue_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t head = _queue_->capacity - _queue_->front;
+
+    return head < _queue_->count ? head : _queue_->count;
+}
+
+/* Copies the elements to dest, from front to back, in at most two blocks */
+static void CMC_(PFX, _impl_copy_ordered)(struct SNAME *_queue_, V *dest)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t head = CMC_(PFX, _impl_head_count)(_queue_);
+
+    memcpy(dest, _queue_->buffer + _queue_->front, sizeof(V) * head);
+    memcpy(dest + head, _queue_->buffer, sizeof(V) * (_queue_->count - head));
+}
@@ -82,6 +82,7 @@ void CMC_(PFX, _release)(struct SNAME _queue_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_queue_.f_val->free)
     {
         for (size_t i = _queue_.front, j = 0; j < _queue_.count; j++)
@@ -91,6 +92,7 @@ void CMC_(PFX, _release)(struct SNAME _queue_)
             i = (i + 1) % _queue_.capacity;
         }
     }
+#endif
 
     _queue_.alloc->free(_queue_.buffer);
 }
@@ -61,5 +61,7 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_queue_);
 int CMC_(PFX, _flag)(struct SNAME *_queue_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_queue_, size_t capacity);
+bool CMC_(PFX, _reserve)(struct SNAME *_queue_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_queue_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_queue_);
 bool CMC_(PFX, _equals)(struct SNAME *_queue1_, struct SNAME *_queue2_);
@@ -0,0 +1,110 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * segdeque.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * SegDeque
+ *
+ * A SegDeque is a Deque made of fixed size blocks of elements instead of one
+ * circular buffer. A map, which is a dynamic array of pointers to the blocks,
+ * keeps them in order from the front to the back, and only the blocks that
+ * hold elements are allocated.
+ *
+ * Pushing at either end only writes into the first or the last block, or
+ * takes a new one when that block is full, so the elements are never copied
+ * after they are added and their addresses stay the same until they are
+ * popped. When the map itself runs out of slots at one end, its pointers are
+ * centered again or the map is grown, which moves only one pointer per block.
+ * This avoids the stalls of a Deque that has to copy all of its elements to
+ * grow its buffer.
+ *
+ * A block that becomes empty is kept as a spare for the next block that is
+ * needed, so a SegDeque used as a work queue doesn't keep allocating and
+ * freeing blocks. Random access is constant time through get().
+ *
+ * Implementation
+ *
+ * Each block has CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) elements, that is, as
+ * many elements as fit in CMC_SEGDEQUE_BLOCK_BYTES, but never less than 16.
+ * CMC_SEGDEQUE_BLOCK_BYTES can be defined before including any SegDeque.
+ */
+
+#include "cor/core.h"
+#include "cor/growth.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+#ifndef CMC_SEGDEQUE_BLOCK_BYTES
+#define CMC_SEGDEQUE_BLOCK_BYTES 4096
+#endif
+
+#ifndef CMC_SEGDEQUE_BLOCK_LENGTH
+#define CMC_SEGDEQUE_BLOCK_LENGTH(size_of) \
+    ((size_of) * 16 < CMC_SEGDEQUE_BLOCK_BYTES ? CMC_SEGDEQUE_BLOCK_BYTES / (size_of) : 16)
+#endif
+
+/**
+ * Used values
+ * V - segdeque data type
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/segdeque/struct.h"
+
+/* Function declaration */
+#include "cmc/segdeque/header.h"
+
+/* Function implementation */
+#include "cmc/segdeque/code.h"
+
+/**
+ * Extensions
+ *
+ * INIT - Initializes the struct on the stack
+ * ITER - SegDeque iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_SEGDEQUE_PARTS INIT, ITER, STR
+/**/
+#include "cmc/segdeque/ext/struct.h"
+/**/
+#include "cmc/segdeque/ext/header.h"
+/**/
+#include "cmc/segdeque/ext/code.h"
+
+#include "cor/undef.h"
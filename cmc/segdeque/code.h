@@ -0,0 +1,706 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static V *CMC_(PFX, _impl_at)(struct SNAME *_deque_, size_t index);
+static size_t CMC_(PFX, _impl_used_blocks)(struct SNAME *_deque_);
+static bool CMC_(PFX, _impl_remap)(struct SNAME *_deque_, size_t map_size);
+static bool CMC_(PFX, _impl_grow_map)(struct SNAME *_deque_);
+static bool CMC_(PFX, _impl_acquire_block)(struct SNAME *_deque_, size_t block);
+static void CMC_(PFX, _impl_release_block)(struct SNAME *_deque_, size_t block);
+
+struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(capacity, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
+                                     CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (capacity < 1)
+        return NULL;
+
+    if (!f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_deque_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_deque_)
+        return NULL;
+
+    /* One more slot than the blocks needed so that the front is never at */
+    /* the start of the map */
+    size_t map_size = (capacity - 1) / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) + 2;
+
+    /* Blocks are only allocated when the first element is pushed to them */
+    _deque_->map = alloc->calloc(map_size, sizeof(V *));
+
+    if (!_deque_->map)
+    {
+        alloc->free(_deque_);
+        return NULL;
+    }
+
+    _deque_->map_size = map_size;
+    _deque_->front = map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) / 2;
+    _deque_->count = 0;
+    _deque_->spare = NULL;
+    _deque_->flag = CMC_FLAG_OK;
+    _deque_->f_val = f_val;
+    _deque_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_deque_, callbacks);
+
+    return _deque_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_deque_->f_val->free)
+    {
+        for (size_t i = 0; i < _deque_->count; i++)
+            _deque_->f_val->free(*CMC_(PFX, _impl_at)(_deque_, i));
+    }
+#endif
+
+    for (size_t i = 0; i < _deque_->map_size; i++)
+    {
+        if (_deque_->map[i])
+        {
+            memset(_deque_->map[i], 0, sizeof(V) * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)));
+
+            CMC_(PFX, _impl_release_block)(_deque_, i);
+        }
+    }
+
+    _deque_->count = 0;
+    _deque_->front = _deque_->map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) / 2;
+
+    _deque_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_deque_->f_val->free)
+    {
+        for (size_t i = 0; i < _deque_->count; i++)
+            _deque_->f_val->free(*CMC_(PFX, _impl_at)(_deque_, i));
+    }
+#endif
+
+    for (size_t i = 0; i < _deque_->map_size; i++)
+        _deque_->alloc->free(_deque_->map[i]);
+
+    _deque_->alloc->free(_deque_->spare);
+    _deque_->alloc->free(_deque_->map);
+    _deque_->alloc->free(_deque_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_deque_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _deque_->alloc = &cmc_alloc_node_default;
+    else
+        _deque_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_deque_, callbacks);
+
+    _deque_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _push_front)(struct SNAME *_deque_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->front == 0)
+    {
+        if (!CMC_(PFX, _impl_grow_map)(_deque_))
+            return false;
+    }
+
+    size_t position = _deque_->front - 1;
+    size_t block = position / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+
+    if (!CMC_(PFX, _impl_acquire_block)(_deque_, block))
+        return false;
+
+    _deque_->map[block][position % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V))] = value;
+
+    _deque_->front = position;
+    _deque_->count++;
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+bool CMC_(PFX, _push_back)(struct SNAME *_deque_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->front + _deque_->count == _deque_->map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)))
+    {
+        if (!CMC_(PFX, _impl_grow_map)(_deque_))
+            return false;
+    }
+
+    size_t position = _deque_->front + _deque_->count;
+    size_t block = position / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+
+    if (!CMC_(PFX, _impl_acquire_block)(_deque_, block))
+        return false;
+
+    _deque_->map[block][position % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V))] = value;
+
+    _deque_->count++;
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+bool CMC_(PFX, _pop_front)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    size_t block = _deque_->front / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+
+    *CMC_(PFX, _impl_at)(_deque_, 0) = (V){ 0 };
+
+    _deque_->front++;
+    _deque_->count--;
+
+    /* The block is released once its last element is popped */
+    if (_deque_->count == 0 || _deque_->front % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) == 0)
+        CMC_(PFX, _impl_release_block)(_deque_, block);
+
+    if (_deque_->count == 0)
+        _deque_->front = _deque_->map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) / 2;
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+bool CMC_(PFX, _pop_back)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    size_t position = _deque_->front + _deque_->count - 1;
+
+    *CMC_(PFX, _impl_at)(_deque_, _deque_->count - 1) = (V){ 0 };
+
+    _deque_->count--;
+
+    /* The block is released once its last element is popped */
+    if (_deque_->count == 0 || position % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) == 0)
+        CMC_(PFX, _impl_release_block)(_deque_, position / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)));
+
+    if (_deque_->count == 0)
+        _deque_->front = _deque_->map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) / 2;
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+V CMC_(PFX, _front)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return *CMC_(PFX, _impl_at)(_deque_, 0);
+}
+
+V CMC_(PFX, _back)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return *CMC_(PFX, _impl_at)(_deque_, _deque_->count - 1);
+}
+
+V CMC_(PFX, _get)(struct SNAME *_deque_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    if (index >= _deque_->count)
+    {
+        _deque_->flag = CMC_FLAG_RANGE;
+        return (V){ 0 };
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return *CMC_(PFX, _impl_at)(_deque_, index);
+}
+
+/* The address stays valid until the element is popped or the deque is */
+/* cleared, even if other elements are pushed */
+V *CMC_(PFX, _get_ref)(struct SNAME *_deque_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_deque_))
+    {
+        _deque_->flag = CMC_FLAG_EMPTY;
+        return NULL;
+    }
+
+    if (index >= _deque_->count)
+    {
+        _deque_->flag = CMC_FLAG_RANGE;
+        return NULL;
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return CMC_(PFX, _impl_at)(_deque_, index);
+}
+
+size_t CMC_(PFX, _count_of)(struct SNAME *_deque_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t result = 0;
+
+    for (size_t i = 0; i < _deque_->count; i++)
+        result += _deque_->f_val->cmp(*CMC_(PFX, _impl_at)(_deque_, i), value) == 0;
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_deque_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    bool result = false;
+
+    for (size_t i = 0; i < _deque_->count; i++)
+    {
+        if (_deque_->f_val->cmp(*CMC_(PFX, _impl_at)(_deque_, i), value) == 0)
+        {
+            result = true;
+            break;
+        }
+    }
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _deque_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _deque_->count;
+}
+
+/* Amount of elements that the map can address before it has to be */
+/* centered again or grown */
+size_t CMC_(PFX, _capacity)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _deque_->map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _deque_->flag;
+}
+
+/* Frees the spare block and shrinks the map to the blocks in use */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _deque_->alloc->free(_deque_->spare);
+    _deque_->spare = NULL;
+
+    size_t map_size = CMC_(PFX, _impl_used_blocks)(_deque_) + 2;
+
+    if (map_size < _deque_->map_size)
+    {
+        if (!CMC_(PFX, _impl_remap)(_deque_, map_size))
+        {
+            _deque_->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+    }
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_deque_);
+
+    return true;
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *result =
+        CMC_(PFX, _new_custom)(_deque_->count > 0 ? _deque_->count : 1, _deque_->f_val, _deque_->alloc, NULL);
+
+    if (!result)
+    {
+        _deque_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    for (size_t i = 0; i < _deque_->count; i++)
+    {
+        V value = *CMC_(PFX, _impl_at)(_deque_, i);
+
+#ifndef CMC_TRIVIAL_V
+        if (_deque_->f_val->cpy)
+            value = _deque_->f_val->cpy(value);
+#endif
+
+        if (!CMC_(PFX, _push_back)(result, value))
+        {
+#ifndef CMC_TRIVIAL_V
+            if (_deque_->f_val->cpy && _deque_->f_val->free)
+                _deque_->f_val->free(value);
+#endif
+
+            CMC_(PFX, _free)(result);
+
+            _deque_->flag = CMC_FLAG_ALLOC;
+            return NULL;
+        }
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _deque_->callbacks);
+
+    _deque_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_deque1_, struct SNAME *_deque2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _deque1_->flag = CMC_FLAG_OK;
+    _deque2_->flag = CMC_FLAG_OK;
+
+    if (_deque1_->count != _deque2_->count)
+        return false;
+
+#ifdef CMC_TRIVIAL_V
+    /* Compared in runs that end where a block of either deque ends */
+    for (size_t k = 0; k < _deque1_->count;)
+    {
+        size_t i = (_deque1_->front + k) % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+        size_t j = (_deque2_->front + k) % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+        size_t run = CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) - (i > j ? i : j);
+
+        if (run > _deque1_->count - k)
+            run = _deque1_->count - k;
+
+        if (memcmp(CMC_(PFX, _impl_at)(_deque1_, k), CMC_(PFX, _impl_at)(_deque2_, k), sizeof(V) * run) != 0)
+            return false;
+
+        k += run;
+    }
+#else
+    for (size_t i = 0; i < _deque1_->count; i++)
+    {
+        if (_deque1_->f_val->cmp(*CMC_(PFX, _impl_at)(_deque1_, i), *CMC_(PFX, _impl_at)(_deque2_, i)) != 0)
+            return false;
+    }
+#endif
+
+    return true;
+}
+
+/* Address of the element at index, counting from the front */
+static V *CMC_(PFX, _impl_at)(struct SNAME *_deque_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t position = _deque_->front + index;
+
+    return _deque_->map[position / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V))] +
+           position % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+}
+
+/* Amount of blocks from the front block to the back block */
+static size_t CMC_(PFX, _impl_used_blocks)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->count == 0)
+        return 0;
+
+    size_t first = _deque_->front / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+    size_t last = (_deque_->front + _deque_->count - 1) / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+
+    return last - first + 1;
+}
+
+/* Moves the pointers of the used blocks to the middle of a map of map_size */
+/* slots. Only the pointers are moved, never the elements. */
+static bool CMC_(PFX, _impl_remap)(struct SNAME *_deque_, size_t map_size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t first = _deque_->front / CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+    size_t used = CMC_(PFX, _impl_used_blocks)(_deque_);
+    size_t start = (map_size - used) / 2;
+
+    V **map = _deque_->map;
+
+    if (map_size != _deque_->map_size)
+    {
+        map = _deque_->alloc->calloc(map_size, sizeof(V *));
+
+        if (!map)
+            return false;
+
+        memcpy(map + start, _deque_->map + first, sizeof(V *) * used);
+
+        _deque_->alloc->free(_deque_->map);
+    }
+    else
+    {
+        memmove(map + start, map + first, sizeof(V *) * used);
+        memset(map, 0, sizeof(V *) * start);
+        memset(map + start + used, 0, sizeof(V *) * (map_size - start - used));
+    }
+
+    _deque_->map = map;
+    _deque_->map_size = map_size;
+
+    size_t offset = _deque_->front % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V));
+
+    if (_deque_->count == 0)
+        _deque_->front = map_size * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) / 2;
+    else
+        _deque_->front = start * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)) + offset;
+
+    return true;
+}
+
+/* Makes room for at least one more block at each end of the map. The map is */
+/* only grown if less than half of it is free, otherwise the used blocks are */
+/* just centered in it. */
+static bool CMC_(PFX, _impl_grow_map)(struct SNAME *_deque_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t required = CMC_(PFX, _impl_used_blocks)(_deque_) * 2 + 2;
+    size_t map_size = _deque_->map_size;
+
+    if (map_size < required)
+        map_size = cmc_growth_capacity(map_size, required, sizeof(V *));
+
+    if (!CMC_(PFX, _impl_remap)(_deque_, map_size))
+    {
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    return true;
+}
+
+/* Makes sure that map[block] points to a block, taking the spare one if */
+/* there is one */
+static bool CMC_(PFX, _impl_acquire_block)(struct SNAME *_deque_, size_t block)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_deque_->map[block])
+        return true;
+
+    if (_deque_->spare)
+    {
+        _deque_->map[block] = _deque_->spare;
+        _deque_->spare = NULL;
+
+        return true;
+    }
+
+    _deque_->map[block] = _deque_->alloc->calloc(CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(V)), sizeof(V));
+
+    if (!_deque_->map[block])
+    {
+        _deque_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    return true;
+}
+
+/* Removes an empty block from the map, keeping it as the spare block if */
+/* there isn't one already */
+static void CMC_(PFX, _impl_release_block)(struct SNAME *_deque_, size_t block)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!_deque_->spare)
+        _deque_->spare = _deque_->map[block];
+    else
+        _deque_->alloc->free(_deque_->map[block]);
+
+    _deque_->map[block] = NULL;
+}
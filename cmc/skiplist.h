@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * skiplist.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * SkipList
+ *
+ * A SkipList is a sorted map based on a linked list with additional express
+ * lanes. Every node is part of the bottom level and is promoted to each next
+ * level with a probability of 1/2, which gives an expected O(log n) search,
+ * insertion and removal. Like a TreeMap, it has only unique keys and can be
+ * iterated in order.
+ */
+
+#include "cor/core.h"
+#include "cor/skiplist.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - skiplist key data type
+ * V - skiplist value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/skiplist/struct.h"
+
+/* Function declaration */
+#include "cmc/skiplist/header.h"
+
+/* Function implementation */
+#include "cmc/skiplist/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - skiplist iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_SKIPLIST_PARTS ITER, STR
+/**/
+#include "cmc/skiplist/ext/struct.h"
+/**/
+#include "cmc/skiplist/ext/header.h"
+/**/
+#include "cmc/skiplist/ext/code.h"
+
+#include "cor/undef.h"
@@ -0,0 +1,618 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value, size_t level);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find)(struct SNAME *_map_, K key,
+                                                         struct CMC_DEF_NODE(SNAME) * *update);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key);
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, bool free_keys, bool free_values);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                     CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->alloc = alloc;
+    _map_->head = CMC_(PFX, _impl_new_node)(_map_, (K){ 0 }, (V){ 0 }, CMC_SKIPLIST_MAX_LEVEL);
+
+    if (!_map_->head)
+    {
+        alloc->free(_map_);
+        return NULL;
+    }
+
+    _map_->tail = NULL;
+    _map_->level = 1;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->rng = cmc_skiplist_seed((uint64_t)(uintptr_t)_map_);
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_map_, true, true);
+
+    _map_->tail = NULL;
+    _map_->level = 1;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _clear)(_map_);
+
+    _map_->alloc->free(_map_->head);
+    _map_->alloc->free(_map_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    _map_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *update[CMC_SKIPLIST_MAX_LEVEL];
+    struct CMC_DEF_NODE(SNAME) *next = CMC_(PFX, _impl_find)(_map_, key, update);
+
+    if (next != NULL && _map_->f_key->cmp(next->key, key) == 0)
+    {
+        _map_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    size_t level = cmc_skiplist_level(&_map_->rng);
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_map_, key, value, level);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    /* Levels that were not in use start at the head */
+    for (; _map_->level < level; _map_->level++)
+        update[_map_->level] = _map_->head;
+
+    for (size_t i = 0; i < level; i++)
+    {
+        node->next[i] = update[i]->next[i];
+        update[i]->next[i] = node;
+    }
+
+    node->prev = update[0] == _map_->head ? NULL : update[0];
+
+    if (node->next[0] != NULL)
+        node->next[0]->prev = node;
+    else
+        _map_->tail = node;
+
+    _map_->count++;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (old_value)
+        *old_value = node->value;
+
+    node->value = new_value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *update[CMC_SKIPLIST_MAX_LEVEL];
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find)(_map_, key, update);
+
+    if (node == NULL || _map_->f_key->cmp(node->key, key) != 0)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    for (size_t i = 0; i < node->level; i++)
+        update[i]->next[i] = node->next[i];
+
+    if (node->next[0] != NULL)
+        node->next[0]->prev = node->prev;
+    else
+        _map_->tail = node->prev;
+
+    while (_map_->level > 1 && _map_->head->next[_map_->level - 1] == NULL)
+        _map_->level--;
+
+    if (out_value)
+        *out_value = node->value;
+
+    _map_->alloc->free(node);
+
+    _map_->count--;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    if (key)
+        *key = _map_->tail->key;
+    if (value)
+        *value = _map_->tail->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    if (key)
+        *key = _map_->head->next[0]->key;
+    if (value)
+        *value = _map_->head->next[0]->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Greatest key that is less than or equal to the given key */
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *update[CMC_SKIPLIST_MAX_LEVEL];
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find)(_map_, key, update);
+
+    if (node == NULL || _map_->f_key->cmp(node->key, key) != 0)
+        node = update[0] == _map_->head ? NULL : update[0];
+
+    if (node == NULL)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Smallest key that is greater than or equal to the given key */
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find)(_map_, key, NULL);
+
+    if (node == NULL)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_value)
+        *out_value = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+V CMC_(PFX, _get)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (V){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->value;
+}
+
+V *CMC_(PFX, _get_ref)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return NULL;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return NULL;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return &(node->value);
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool result = CMC_(PFX, _impl_get_node)(_map_, key) != NULL;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->flag;
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Callback will be added later */
+    struct SNAME *result = CMC_(PFX, _new_custom)(_map_->f_key, _map_->f_val, _map_->alloc, NULL);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    for (struct CMC_DEF_NODE(SNAME) *scan = _map_->head->next[0]; scan != NULL; scan = scan->next[0])
+    {
+        K key = _map_->f_key->cpy ? _map_->f_key->cpy(scan->key) : scan->key;
+        V value = _map_->f_val->cpy ? _map_->f_val->cpy(scan->value) : scan->value;
+
+        if (!CMC_(PFX, _insert)(result, key, value))
+        {
+            /* Only copies are owned by the result and can be freed */
+            if (_map_->f_key->cpy && _map_->f_key->free)
+                _map_->f_key->free(key);
+            if (_map_->f_val->cpy && _map_->f_val->free)
+                _map_->f_val->free(value);
+
+            CMC_(PFX, _impl_free_nodes)(result, _map_->f_key->cpy != NULL, _map_->f_val->cpy != NULL);
+
+            result->alloc->free(result->head);
+            result->alloc->free(result);
+
+            _map_->flag = CMC_FLAG_ERROR;
+            return NULL;
+        }
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_ASSIGN(result, _map_->callbacks);
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map1_->flag = CMC_FLAG_OK;
+    _map2_->flag = CMC_FLAG_OK;
+
+    if (_map1_->count != _map2_->count)
+        return false;
+
+    /* Both maps are sorted by key so they can be compared side by side */
+    struct CMC_DEF_NODE(SNAME) *scan1 = _map1_->head->next[0];
+    struct CMC_DEF_NODE(SNAME) *scan2 = _map2_->head->next[0];
+
+    for (; scan1 != NULL && scan2 != NULL; scan1 = scan1->next[0], scan2 = scan2->next[0])
+    {
+        if (_map1_->f_key->cmp(scan1->key, scan2->key) != 0)
+            return false;
+
+        if (_map1_->f_val->cmp(scan1->value, scan2->value) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value, size_t level)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)) +
+                                                             sizeof(struct CMC_DEF_NODE(SNAME) *) * level);
+
+    if (!node)
+        return NULL;
+
+    node->key = key;
+    node->value = value;
+    node->prev = NULL;
+    node->level = level;
+
+    for (size_t i = 0; i < level; i++)
+        node->next[i] = NULL;
+
+    return node;
+}
+
+/* Returns the first node with a key greater than or equal to the given key. */
+/* If update is not NULL, it receives the last node before it at each level. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find)(struct SNAME *_map_, K key,
+                                                         struct CMC_DEF_NODE(SNAME) * *update)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->head;
+
+    for (size_t i = _map_->level; i > 0; i--)
+    {
+        while (scan->next[i - 1] != NULL && _map_->f_key->cmp(scan->next[i - 1]->key, key) < 0)
+            scan = scan->next[i - 1];
+
+        if (update)
+            update[i - 1] = scan;
+    }
+
+    return scan->next[0];
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find)(_map_, key, NULL);
+
+    if (node == NULL || _map_->f_key->cmp(node->key, key) != 0)
+        return NULL;
+
+    return node;
+}
+
+/* Frees every node, leaving the map empty. Keys and values are only freed */
+/* if requested and if their free function is set. */
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, bool free_keys, bool free_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->head->next[0];
+
+    while (scan != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *next = scan->next[0];
+
+        if (free_keys && _map_->f_key->free)
+            _map_->f_key->free(scan->key);
+        if (free_values && _map_->f_val->free)
+            _map_->f_val->free(scan->value);
+
+        _map_->alloc->free(scan);
+
+        scan = next;
+    }
+
+    for (size_t i = 0; i < CMC_SKIPLIST_MAX_LEVEL; i++)
+        _map_->head->next[i] = NULL;
+}
@@ -0,0 +1,76 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* SkipList Structure */
+struct SNAME
+{
+    /* Sentinel node before the first element, with every level */
+    struct CMC_DEF_NODE(SNAME) * head;
+
+    /* Last node of the bottom level */
+    struct CMC_DEF_NODE(SNAME) * tail;
+
+    /* Amount of levels currently in use */
+    size_t level;
+
+    /* Current amount of keys */
+    size_t count;
+
+    /* Flags indicating errors or success */
+    int flag;
+
+    /* Key function table */
+    struct CMC_DEF_FKEY(SNAME) * f_key;
+
+    /* Value function table */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+
+    /* Random generator state used to pick the level of new nodes */
+    uint64_t rng;
+
+    /* Custom allocation functions */
+    CMC_ALLOC_TYPE alloc;
+
+    /* Custom callback functions */
+    CMC_CALLBACKS_DECL;
+};
+
+/* SkipList Node */
+struct CMC_DEF_NODE(SNAME)
+{
+    /* Node Key */
+    K key;
+
+    /* Node Value */
+    V value;
+
+    /* Previous node in the bottom level */
+    struct CMC_DEF_NODE(SNAME) * prev;
+
+    /* Amount of levels this node is part of */
+    size_t level;
+
+    /* Next node in each level */
+    struct CMC_DEF_NODE(SNAME) * next[];
+};
@@ -39,11 +39,26 @@
  * as you like and when its capacity is full, the buffer is reallocated. The
  * elements are only sorted when a certain action requires that the array is
  * sorted like accessing min() or max(). This prevents the array from being
- * sorted after every insertion or removal. The array is sorted using a
- * variation of quick sort that uses insertion sort for small partitions.
+ * sorted after every insertion or removal. The list keeps track of how much
+ * of the array is already sorted, so only the elements inserted since the
+ * last sort are sorted and then merged into the sorted prefix. The array is
+ * sorted using a pattern-defeating quicksort, or a radix sort if CMC_SORT_KEY
+ * is defined (see cor/sort.h). stable_sort() keeps equal elements in the order
+ * they were inserted.
+ *
+ * Searches are branchless binary searches. A list that is mostly read can be
+ * frozen, which keeps a copy of the sorted array in Eytzinger (breadth-first)
+ * order that makes lookups far more cache friendly.
+ *
+ * When CMC_ARITHMETIC_V is defined, searches and the set functions compare the
+ * elements with the built-in operators instead of f_val->cmp.
  */
 
+#include "cor/algo.h"
 #include "cor/core.h"
+#include "cor/growth.h"
+#include "cor/setops.h"
+#include "cor/sort.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -52,6 +67,9 @@
 /**
  * Used values
  * V - sortedlist data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SORT_KEY - optional, radix sort key of V (see cor/sort.h)
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -62,17 +80,40 @@
 /* Function declaration */
 #include "cmc/sortedlist/header.h"
 
+/* Sorting algorithms */
+#ifdef CMC_EXT_PSORT
+#include "utl/thread.h"
+#endif
+
+#include "cor/sort/code.h"
+
+/* Set operation kernels */
+#ifdef CMC_ARITHMETIC_V
+#include "cor/setops/code.h"
+#endif
+
+/* Parallel algorithms */
+#ifdef CMC_EXT_ALGO
+#include "utl/thread.h"
+#include "cor/algo/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/sortedlist/code.h"
 
 /**
  * Extensions
  *
+ * ALGO - Parallel algorithms (requires cmc_thread)
  * INIT - Initializes the struct on the stack
  * ITER - List iterator
+ * PSORT - Parallel sort (requires cmc_thread)
+ * SETF - Set functions
  * STR - Print helper functions
+ * VIEW - Non-owning views of a range of the list
+ * XSORT - External sort that spills runs to temporary files
  */
-#define CMC_EXT_SORTEDLIST_PARTS INIT, ITER, STR
+#define CMC_EXT_SORTEDLIST_PARTS ALGO, INIT, ITER, PSORT, SETF, STR, VIEW, XSORT
 /**/
 #include "cmc/sortedlist/ext/struct.h"
 /**/
@@ -25,8 +25,15 @@
 /* Implementation Detail Functions */
 static size_t CMC_(PFX, _impl_binary_search_first)(struct SNAME *_list_, V value);
 static size_t CMC_(PFX, _impl_binary_search_last)(struct SNAME *_list_, V value);
-void CMC_(PFX, _impl_sort_quicksort)(V *array, int (*cmp)(V, V), size_t low, size_t high);
-void CMC_(PFX, _impl_sort_insertion)(V *array, int (*cmp)(V, V), size_t low, size_t high);
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_list_, V value);
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_list_, V value);
+static size_t CMC_(PFX, _impl_index_search)(struct SNAME *_list_, V value, bool upper);
+static bool CMC_(PFX, _impl_build_index)(struct SNAME *_list_);
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_list_);
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_list_, size_t size);
+static void CMC_(PFX, _impl_merge_values)(struct SNAME *_list_, V *values, size_t size, V (*cpy)(V));
+static bool CMC_(PFX, _impl_sort)(struct SNAME *_list_, size_t n_threads);
+static bool CMC_(PFX, _impl_sort_slice)(struct SNAME *_list_, V *array, size_t count, size_t n_threads);
 
 struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -67,11 +74,16 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
 
     _list_->capacity = capacity;
     _list_->count = 0;
-    _list_->is_sorted = false;
+    _list_->sorted = 0;
+    _list_->eytzinger = NULL;
+    _list_->indexed = false;
     _list_->flag = CMC_FLAG_OK;
     _list_->f_val = f_val;
     _list_->alloc = alloc;
     CMC_CALLBACKS_ASSIGN(_list_, callbacks);
+#ifdef CMC_DEV
+    _list_->generation = 0;
+#endif
 
     return _list_;
 }
@@ -82,15 +94,19 @@ void CMC_(PFX, _clear)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_list_->f_val->free)
     {
         for (size_t i = 0; i < _list_->count; i++)
             _list_->f_val->free(_list_->buffer[i]);
     }
+#endif
 
     memset(_list_->buffer, 0, sizeof(V) * _list_->capacity);
 
     _list_->count = 0;
+    _list_->sorted = 0;
+    _list_->indexed = false;
     _list_->flag = CMC_FLAG_OK;
 }
 
@@ -100,12 +116,15 @@ void CMC_(PFX, _free)(struct SNAME *_list_)
     CMC_DEV_FCALL;
 #endif
 
+#ifndef CMC_TRIVIAL_V
     if (_list_->f_val->free)
     {
         for (size_t i = 0; i < _list_->count; i++)
             _list_->f_val->free(_list_->buffer[i]);
     }
+#endif
 
+    _list_->alloc->free(_list_->eytzinger);
     _list_->alloc->free(_list_->buffer);
     _list_->alloc->free(_list_);
 }
@@ -136,13 +155,14 @@ bool CMC_(PFX, _insert)(struct SNAME *_list_, V value)
 
     if (CMC_(PFX, _full)(_list_))
     {
-        if (!CMC_(PFX, _resize)(_list_, _list_->capacity * 2))
+        if (!CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + 1, sizeof(V))))
             return false;
     }
 
+    /* The new element goes to the unsorted tail */
     _list_->buffer[_list_->count++] = value;
+    _list_->indexed = false;
 
-    _list_->is_sorted = false;
     _list_->flag = CMC_FLAG_OK;
 
     CMC_CALLBACKS_CALL(_list_);
@@ -168,10 +188,126 @@ bool CMC_(PFX, _remove)(struct SNAME *_list_, size_t index)
         return false;
     }
 
-    memmove(_list_->buffer + index, _list_->buffer + index + 1, (_list_->count - index) * sizeof(V));
+    memmove(_list_->buffer + index, _list_->buffer + index + 1, (_list_->count - index - 1) * sizeof(V));
 
     _list_->buffer[--_list_->count] = (V){ 0 };
 
+    if (index < _list_->sorted)
+        _list_->sorted--;
+
+    _list_->indexed = false;
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+/* Removes every element in the range [lower, upper) */
+size_t CMC_(PFX, _remove_range)(struct SNAME *_list_, V lower, V upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_list_) || _list_->f_val->cmp(lower, upper) >= 0)
+        return 0;
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t first = CMC_(PFX, _impl_lower_bound)(_list_, lower);
+    size_t last = CMC_(PFX, _impl_lower_bound)(_list_, upper);
+
+    if (first == last)
+        return 0;
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val->free)
+    {
+        for (size_t i = first; i < last; i++)
+            _list_->f_val->free(_list_->buffer[i]);
+    }
+#endif
+
+    memmove(_list_->buffer + first, _list_->buffer + last, (_list_->count - last) * sizeof(V));
+
+    size_t removed = last - first;
+
+    _list_->count -= removed;
+    _list_->sorted = _list_->count;
+    _list_->indexed = false;
+
+    memset(_list_->buffer + _list_->count, 0, removed * sizeof(V));
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return removed;
+}
+
+/* Inserts size values at once. If already_sorted is true the values must be */
+/* sorted and they are merged into the list in a single pass, otherwise */
+/* they are appended and sorted along with the rest of the list when needed */
+bool CMC_(PFX, _insert_many)(struct SNAME *_list_, V *values, size_t size, bool already_sorted)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* An empty batch leaves the list untouched */
+    if (size == 0)
+    {
+        _list_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (!CMC_(PFX, _impl_reserve)(_list_, size))
+        return false;
+
+    if (already_sorted)
+    {
+        CMC_(PFX, _sort)(_list_);
+        CMC_(PFX, _impl_merge_values)(_list_, values, size, NULL);
+    }
+    else
+    {
+        memcpy(_list_->buffer + _list_->count, values, size * sizeof(V));
+        _list_->count += size;
+    }
+
+    _list_->indexed = false;
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+/* Inserts a copy of every element of _other_ into _list_ */
+bool CMC_(PFX, _merge)(struct SNAME *_list_, struct SNAME *_other_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_other_))
+        return true;
+
+    /* Both buffers are only accessed after the resize since they might be */
+    /* the same */
+    if (!CMC_(PFX, _impl_reserve)(_list_, _other_->count))
+        return false;
+
+    CMC_(PFX, _sort)(_list_);
+    CMC_(PFX, _sort)(_other_);
+
+    CMC_(PFX, _impl_merge_values)(_list_, _other_->buffer, _other_->count, _list_->f_val->cpy);
+
+    _list_->indexed = false;
     _list_->flag = CMC_FLAG_OK;
 
     CMC_CALLBACKS_CALL(_list_);
@@ -179,6 +315,119 @@ bool CMC_(PFX, _remove)(struct SNAME *_list_, size_t index)
     return true;
 }
 
+/* Removes every element equal to one of the values. The list is compacted */
+/* in a single pass. Returns how many elements were removed. */
+size_t CMC_(PFX, _remove_many)(struct SNAME *_list_, V *values, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_list_) || size == 0)
+        return 0;
+
+    /* The values are sorted so that both sequences can be walked together */
+    V *keys = _list_->alloc->malloc(sizeof(V) * size);
+
+    if (!keys)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return 0;
+    }
+
+    memcpy(keys, values, sizeof(V) * size);
+
+    CMC_(PFX, _impl_sort_unstable)(keys, size, _list_->f_val->cmp, _list_->alloc);
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t j = 0;
+    size_t count = 0;
+
+    for (size_t i = 0; i < _list_->count; i++)
+    {
+        while (j < size && _list_->f_val->cmp(keys[j], _list_->buffer[i]) < 0)
+            j++;
+
+        if (j < size && _list_->f_val->cmp(keys[j], _list_->buffer[i]) == 0)
+        {
+#ifndef CMC_TRIVIAL_V
+            if (_list_->f_val->free)
+                _list_->f_val->free(_list_->buffer[i]);
+#endif
+        }
+        else
+            _list_->buffer[count++] = _list_->buffer[i];
+    }
+
+    _list_->alloc->free(keys);
+
+    size_t removed = _list_->count - count;
+
+    if (removed == 0)
+        return 0;
+
+    memset(_list_->buffer + count, 0, removed * sizeof(V));
+
+    _list_->count = count;
+    _list_->sorted = count;
+    _list_->indexed = false;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return removed;
+}
+
+/* Removes every element for which predicate returns true. The list is */
+/* compacted in a single pass. Returns how many elements were removed. */
+size_t CMC_(PFX, _remove_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    size_t count = 0;
+    size_t sorted = 0;
+
+    for (size_t i = 0; i < _list_->count; i++)
+    {
+        if (predicate(_list_->buffer[i], args))
+        {
+#ifndef CMC_TRIVIAL_V
+            if (_list_->f_val->free)
+                _list_->f_val->free(_list_->buffer[i]);
+#endif
+        }
+        else
+        {
+            /* The order is kept so the sorted prefix only shrinks */
+            if (i < _list_->sorted)
+                sorted++;
+
+            _list_->buffer[count++] = _list_->buffer[i];
+        }
+    }
+
+    size_t removed = _list_->count - count;
+
+    if (removed == 0)
+        return 0;
+
+    memset(_list_->buffer + count, 0, removed * sizeof(V));
+
+    _list_->count = count;
+    _list_->sorted = sorted;
+    _list_->indexed = false;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return removed;
+}
+
 V CMC_(PFX, _max)(struct SNAME *_list_)
 {
 #ifdef CMC_DEV
@@ -268,6 +517,137 @@ size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start)
     return CMC_(PFX, _impl_binary_search_last)(_list_, value);
 }
 
+/* Index of the first element greater than or equal to value or count if */
+/* there is no such element */
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_(PFX, _sort)(_list_);
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return CMC_(PFX, _impl_lower_bound)(_list_, value);
+}
+
+/* Index of the first element strictly greater than value or count if there */
+/* is no such element */
+size_t CMC_(PFX, _upper_bound)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_(PFX, _sort)(_list_);
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return CMC_(PFX, _impl_upper_bound)(_list_, value);
+}
+
+bool CMC_(PFX, _floor)(struct SNAME *_list_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t index = CMC_(PFX, _impl_upper_bound)(_list_, value);
+
+    if (index == 0)
+    {
+        _list_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = _list_->buffer[index - 1];
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_list_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_list_))
+    {
+        _list_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(_list_, value);
+
+    if (index == _list_->count)
+    {
+        _list_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = _list_->buffer[index];
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+/* Visits every element in the range [lower, upper) in order until visitor */
+/* returns false. Returns how many elements were visited. */
+size_t CMC_(PFX, _range)(struct SNAME *_list_, V lower, V upper, bool (*visitor)(V, void *), void *args)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_list_) || _list_->f_val->cmp(lower, upper) >= 0)
+        return 0;
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t visited = 0;
+
+    for (size_t i = CMC_(PFX, _impl_lower_bound)(_list_, lower); i < _list_->count; i++)
+    {
+        if (_list_->f_val->cmp(_list_->buffer[i], upper) >= 0)
+            break;
+
+        visited++;
+
+        if (!visitor(_list_->buffer[i], args))
+            break;
+    }
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return visited;
+}
+
 bool CMC_(PFX, _contains)(struct SNAME *_list_, V value)
 {
 #ifdef CMC_DEV
@@ -358,6 +738,9 @@ bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity)
 
     _list_->buffer = new_buffer;
     _list_->capacity = capacity;
+#ifdef CMC_DEV
+    _list_->generation++;
+#endif
 
 success:
 
@@ -368,21 +751,96 @@ success:
     return true;
 }
 
-void CMC_(PFX, _sort)(struct SNAME *_list_)
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_list_, size_t size)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    _list_->flag = CMC_FLAG_OK;
+    if (_list_->capacity - _list_->count >= size)
+    {
+        _list_->flag = CMC_FLAG_OK;
+        return true;
+    }
 
-    if (!_list_->is_sorted && _list_->count > 1)
+    if (size > SIZE_MAX / sizeof(V) - _list_->count)
     {
-        CMC_(PFX, _impl_sort_quicksort)
-        (_list_->buffer, _list_->f_val->cmp, 0, _list_->count - 1);
+        _list_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_list_, _list_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
 
-        _list_->is_sorted = true;
+    return CMC_(PFX, _resize)(_list_, _list_->count > 0 ? _list_->count : 1);
+}
+
+void CMC_(PFX, _sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_sort)(_list_, 0);
+}
+
+/* Sorts the list keeping equal elements in the order they were inserted. */
+/* Returns false if the memory needed could not be allocated. */
+bool CMC_(PFX, _stable_sort)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_sort)(_list_, 1);
+}
+
+/* Sorts the list and builds a search index over it in Eytzinger (BFS) */
+/* order. Lookups on a frozen list touch far fewer cache lines. The index */
+/* holds a copy of every element and is rebuilt by the next lookup after the */
+/* list is modified. */
+bool CMC_(PFX, _freeze)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_list_);
+
+    if (!_list_->indexed && !CMC_(PFX, _impl_build_index)(_list_))
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return false;
     }
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return true;
+}
+
+/* Releases the search index built by freeze() */
+void CMC_(PFX, _thaw)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->alloc->free(_list_->eytzinger);
+
+    _list_->eytzinger = NULL;
+    _list_->indexed = false;
+
+    _list_->flag = CMC_FLAG_OK;
 }
 
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
@@ -401,6 +859,9 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
 
     CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
 
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count);
+#else
     if (_list_->f_val->cpy)
     {
         for (size_t i = 0; i < _list_->count; i++)
@@ -408,8 +869,11 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_)
     }
     else
         memcpy(result->buffer, _list_->buffer, sizeof(V) * _list_->count);
+#endif
 
+    /* The copy is not frozen */
     result->count = _list_->count;
+    result->sorted = _list_->sorted;
 
     _list_->flag = CMC_FLAG_OK;
 
@@ -428,6 +892,9 @@ bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_)
     CMC_(PFX, _sort)(_list1_);
     CMC_(PFX, _sort)(_list2_);
 
+#ifdef CMC_TRIVIAL_V
+    return memcmp(_list1_->buffer, _list2_->buffer, sizeof(V) * _list1_->count) == 0;
+#else
     for (size_t i = 0; i < _list1_->count; i++)
     {
         if (_list1_->f_val->cmp(_list1_->buffer[i], _list2_->buffer[i]) != 0)
@@ -435,6 +902,7 @@ bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_)
     }
 
     return true;
+#endif
 }
 
 static size_t CMC_(PFX, _impl_binary_search_first)(struct SNAME *_list_, V value)
@@ -446,21 +914,10 @@ static size_t CMC_(PFX, _impl_binary_search_first)(struct SNAME *_list_, V value
     if (CMC_(PFX, _empty)(_list_))
         return 1;
 
-    size_t L = 0;
-    size_t R = _list_->count;
+    size_t index = CMC_(PFX, _impl_lower_bound)(_list_, value);
 
-    while (L < R)
-    {
-        size_t M = L + (R - L) / 2;
-
-        if (_list_->f_val->cmp(_list_->buffer[M], value) < 0)
-            L = M + 1;
-        else
-            R = M;
-    }
-
-    if (_list_->f_val->cmp(_list_->buffer[L], value) == 0)
-        return L;
+    if (index < _list_->count && _list_->f_val->cmp(_list_->buffer[index], value) == 0)
+        return index;
 
     /* Not found */
     return _list_->count;
@@ -475,104 +932,376 @@ static size_t CMC_(PFX, _impl_binary_search_last)(struct SNAME *_list_, V value)
     if (CMC_(PFX, _empty)(_list_))
         return 1;
 
-    size_t L = 0;
-    size_t R = _list_->count;
+    size_t index = CMC_(PFX, _impl_upper_bound)(_list_, value);
+
+    if (index > 0 && _list_->f_val->cmp(_list_->buffer[index - 1], value) == 0)
+        return index - 1;
+
+    /* Not found */
+    return _list_->count;
+}
+
+/* Both bound searches below have no data dependent branches. The search */
+/* window is halved while prefetching both of its possible halves. */
+/* When V is an arithmetic type (CMC_ARITHMETIC_V is defined) the last few */
+/* elements are counted with plain comparisons, which compilers vectorize. */
+static size_t CMC_(PFX, _impl_lower_bound)(struct SNAME *_list_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = _list_->count;
 
-    while (L < R)
+    if (_list_->indexed)
+        return CMC_(PFX, _impl_index_search)(_list_, value, false);
+
+    if (n == 0)
+        return 0;
+
+    V *base = _list_->buffer;
+
+#ifdef CMC_ARITHMETIC_V
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
     {
-        size_t M = L + (R - L) / 2;
+        size_t half = n / 2;
 
-        if (_list_->f_val->cmp(_list_->buffer[M], value) > 0)
-            R = M;
-        else
-            L = M + 1;
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _list_->f_val->cmp(base[half], value) < 0 ? base + half : base;
+        n -= half;
     }
 
-    if (L > 0 && _list_->f_val->cmp(_list_->buffer[L - 1], value) == 0)
-        return L - 1;
+#ifdef CMC_ARITHMETIC_V
+    size_t index = (size_t)(base - _list_->buffer);
 
-    /* Not found */
-    return _list_->count;
+    for (size_t i = 0; i < n; i++)
+        index += base[i] < value;
+
+    return index;
+#else
+    return (size_t)(base - _list_->buffer) + (_list_->f_val->cmp(base[0], value) < 0);
+#endif
 }
 
-/* Characteristics of this quicksort implementation: */
-/* - Hybrid: uses insertion sort for small arrays */
-/* - Partition: Lomuto's Method */
-/* - Tail recursion: minimize recursion depth */
-void CMC_(PFX, _impl_sort_quicksort)(V *array, int (*cmp)(V, V), size_t low, size_t high)
+static size_t CMC_(PFX, _impl_upper_bound)(struct SNAME *_list_, V value)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    while (low < high)
+    size_t n = _list_->count;
+
+    if (_list_->indexed)
+        return CMC_(PFX, _impl_index_search)(_list_, value, true);
+
+    if (n == 0)
+        return 0;
+
+    V *base = _list_->buffer;
+
+#ifdef CMC_ARITHMETIC_V
+    while (n > 16)
+#else
+    while (n > 1)
+#endif
     {
-        /* Quicksort performs poorly for smaller arrays so let */
-        /* insertion sort do the job */
-        if (high - low < 10)
+        size_t half = n / 2;
+
+        CMC_PREFETCH(base + (n - half) / 2);
+        CMC_PREFETCH(base + half + (n - half) / 2);
+
+        base = _list_->f_val->cmp(base[half], value) <= 0 ? base + half : base;
+        n -= half;
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    size_t index = (size_t)(base - _list_->buffer);
+
+    for (size_t i = 0; i < n; i++)
+        index += base[i] <= value;
+
+    return index;
+#else
+    return (size_t)(base - _list_->buffer) + (_list_->f_val->cmp(base[0], value) <= 0);
+#endif
+}
+
+/* Walks the search index from the root, prefetching the nodes four levels */
+/* down, which are contiguous in memory. Every time the search turns right */
+/* the node and its left subtree are counted, so at the bottom the count is */
+/* the amount of elements less than (or not greater than if upper is true) */
+/* value, which is their lower (or upper) bound in the buffer. */
+static size_t CMC_(PFX, _impl_index_search)(struct SNAME *_list_, V value, bool upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *eytzinger = _list_->eytzinger;
+    size_t n = _list_->count;
+    size_t k = 1;
+    size_t less = 0;
+
+    /* Levels below the current node */
+    size_t height = 0;
+
+    while (((size_t)2 << height) <= n)
+        height++;
+
+    for (; k <= n; height--)
+    {
+        /* The sixteen great-great-grandchildren fill two cache lines when */
+        /* elements are eight bytes wide */
+        size_t ahead = k * 16;
+
+        CMC_PREFETCH(eytzinger + (ahead <= n ? ahead : 0));
+        CMC_PREFETCH(eytzinger + (ahead + 8 <= n ? ahead + 8 : 0));
+
+        size_t left = 0;
+
+        if (height > 0)
         {
-            CMC_(PFX, _impl_sort_insertion)(array, cmp, low, high);
-            break;
+            /* The left subtree is full except for its last level */
+            size_t full = (size_t)1 << (height - 1);
+            size_t first = (2 * k) << (height - 1);
+            size_t last = first <= n ? n - first + 1 : 0;
+
+            left = full - 1 + (last < full ? last : full);
+        }
+
+        bool right = _list_->f_val->cmp(eytzinger[k], value) < (int)upper;
+
+        less += right ? left + 1 : 0;
+        k = 2 * k + right;
+    }
+
+    return less;
+}
+
+/* Copies the sorted buffer into the search index. The implicit tree is */
+/* visited in order so that the buffer is read sequentially. If memory for */
+/* the index can't be allocated the list is thawed and false is returned. */
+static bool CMC_(PFX, _impl_build_index)(struct SNAME *_list_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t n = _list_->count;
+
+    V *eytzinger = _list_->alloc->realloc(_list_->eytzinger, sizeof(V) * (n + 1));
+
+    if (!eytzinger)
+    {
+        CMC_(PFX, _thaw)(_list_);
+        return false;
+    }
+
+    _list_->eytzinger = eytzinger;
+
+    size_t k = n > 0 ? 1 : 0;
+
+    /* Leftmost node */
+    while (k != 0 && 2 * k <= n)
+        k = 2 * k;
+
+    for (size_t i = 0; k != 0; i++)
+    {
+        eytzinger[k] = _list_->buffer[i];
+
+        if (2 * k + 1 <= n)
+        {
+            /* Leftmost node of the right subtree */
+            k = 2 * k + 1;
+
+            while (2 * k <= n)
+                k = 2 * k;
         }
         else
         {
-            /* Partition */
-            V pivot = array[high];
-
-            size_t pindex = low;
-
-            for (size_t i = low; i < high; i++)
-            {
-                if (cmp(array[i], pivot) <= 0)
-                {
-                    V _tmp_ = array[i];
-                    array[i] = array[pindex];
-                    array[pindex] = _tmp_;
-
-                    pindex++;
-                }
-            }
-
-            V _tmp_ = array[pindex];
-            array[pindex] = array[high];
-            array[high] = _tmp_;
-
-            /* Tail recursion */
-            if (pindex - low < high - pindex)
-            {
-                CMC_(PFX, _impl_sort_quicksort)
-                (array, cmp, low, pindex - 1);
-
-                low = pindex + 1;
-            }
-            else
-            {
-                CMC_(PFX, _impl_sort_quicksort)
-                (array, cmp, pindex + 1, high);
+            /* First ancestor whose left subtree was just finished */
+            while (k & 1)
+                k >>= 1;
+            k >>= 1;
+        }
+    }
+
+    _list_->indexed = true;
+
+    return true;
+}
+
+/* Makes room for size more elements */
+static bool CMC_(PFX, _impl_reserve)(struct SNAME *_list_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_list_->capacity - _list_->count >= size)
+        return true;
+
+    return CMC_(PFX, _resize)(_list_, cmc_growth_capacity(_list_->capacity, _list_->count + size, sizeof(V)));
+}
+
+/* Merges size sorted values into the sorted list, which must have room for */
+/* them. Each value is copied with cpy, if given, when it is placed. */
+static void CMC_(PFX, _impl_merge_values)(struct SNAME *_list_, V *values, size_t size, V (*cpy)(V))
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V *buffer = _list_->buffer;
+
+    /* Merge from the back so that nothing is overwritten before it is read. */
+    /* On ties elements already in the list come first. */
+    size_t i = _list_->count;
+    size_t j = size;
+    size_t k = _list_->count + size;
 
-                high = pindex - 1;
-            }
+    while (j > 0)
+    {
+        if (i > 0 && _list_->f_val->cmp(buffer[i - 1], values[j - 1]) > 0)
+            buffer[--k] = buffer[--i];
+        else
+        {
+            --j;
+            buffer[--k] = cpy ? cpy(values[j]) : values[j];
         }
     }
+
+    _list_->count += size;
+    _list_->sorted = _list_->count;
+}
+
+/* Sorts the elements inserted since the last sort. With zero threads the */
+/* sort is not stable, with one it is and with more it is also parallel. */
+static bool CMC_(PFX, _impl_sort)(struct SNAME *_list_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    size_t tail = _list_->count - _list_->sorted;
+
+    /* When only a few elements were inserted since the last sort, they are */
+    /* sorted on their own and then merged into the sorted prefix */
+    if (tail > 0 && tail < _list_->sorted)
+    {
+        if (!CMC_(PFX, _impl_sort_slice)(_list_, _list_->buffer + _list_->sorted, tail, n_threads))
+            return false;
+
+        if (CMC_(PFX, _impl_merge_tail)(_list_))
+            _list_->sorted = _list_->count;
+    }
+
+    if (_list_->sorted < _list_->count)
+    {
+        if (!CMC_(PFX, _impl_sort_slice)(_list_, _list_->buffer, _list_->count, n_threads))
+            return false;
+
+        _list_->sorted = _list_->count;
+    }
+
+    /* A frozen list rebuilds its search index after being modified. If that */
+    /* fails the list is thawed and searches use the buffer directly. */
+    if (_list_->eytzinger && !_list_->indexed)
+        CMC_(PFX, _impl_build_index)(_list_);
+
+    return true;
+}
+
+static bool CMC_(PFX, _impl_sort_slice)(struct SNAME *_list_, V *array, size_t count, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool sorted = true;
+
+    if (n_threads == 0)
+        CMC_(PFX, _impl_sort_unstable)(array, count, _list_->f_val->cmp, _list_->alloc);
+#ifdef CMC_EXT_PSORT
+    else if (n_threads > 1)
+        sorted = CMC_(PFX, _impl_sort_parallel)(array, count, _list_->f_val->cmp, _list_->alloc, n_threads);
+#endif
+    else
+        sorted = CMC_(PFX, _impl_sort_stable)(array, count, _list_->f_val->cmp, _list_->alloc);
+
+    if (!sorted)
+        _list_->flag = CMC_FLAG_ALLOC;
+
+    return sorted;
 }
 
-void CMC_(PFX, _impl_sort_insertion)(V *array, int (*cmp)(V, V), size_t low, size_t high)
+/* Merges the sorted tail of the buffer into its sorted prefix. Returns */
+/* false if a scratch buffer for the tail could not be allocated. */
+static bool CMC_(PFX, _impl_merge_tail)(struct SNAME *_list_)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    for (size_t i = low + 1; i <= high; i++)
+    V *buffer = _list_->buffer;
+    size_t tail = _list_->count - _list_->sorted;
+
+    /* Every new element already belongs after the prefix */
+    if (_list_->f_val->cmp(buffer[_list_->sorted - 1], buffer[_list_->sorted]) <= 0)
+        return true;
+
+    /* A single element only needs to be shifted into place */
+    if (tail == 1)
     {
-        V _tmp_ = array[i];
-        size_t j = i;
+        V value = buffer[_list_->sorted];
+        size_t L = 0;
+        size_t R = _list_->sorted;
 
-        while (j > low && cmp(array[j - 1], _tmp_) > 0)
+        while (L < R)
         {
-            array[j] = array[j - 1];
-            j--;
+            size_t M = L + (R - L) / 2;
+
+            if (_list_->f_val->cmp(buffer[M], value) > 0)
+                R = M;
+            else
+                L = M + 1;
         }
 
-        array[j] = _tmp_;
+        memmove(buffer + L + 1, buffer + L, (_list_->sorted - L) * sizeof(V));
+        buffer[L] = value;
+
+        return true;
+    }
+
+    V *scratch = _list_->alloc->malloc(sizeof(V) * tail);
+
+    if (!scratch)
+        return false;
+
+    memcpy(scratch, buffer + _list_->sorted, sizeof(V) * tail);
+
+    /* Merge from the back so only the tail needs to be copied out. On ties */
+    /* elements from the prefix come first. */
+    size_t i = _list_->sorted;
+    size_t j = tail;
+    size_t k = _list_->count;
+
+    while (j > 0)
+    {
+        if (i > 0 && _list_->f_val->cmp(buffer[i - 1], scratch[j - 1]) > 0)
+            buffer[--k] = buffer[--i];
+        else
+            buffer[--k] = scratch[--j];
     }
+
+    _list_->alloc->free(scratch);
+
+    return true;
 }
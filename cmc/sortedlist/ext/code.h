@@ -22,6 +22,233 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the sorted list, in order. The list
+ * is sorted first and its buffer is then split in up to n_threads slices, each
+ * handled by a cmc_thread worker. Lists smaller than CMC_ALGO_PARALLEL_THRESHOLD
+ * are handled by the current thread alone. The functions passed to them must be
+ * safe to be called from many threads at once when n_threads is greater than 1.
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_list_, void (*visitor)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_list_);
+
+    CMC_(PFX, _impl_algo_for_each)(_list_->buffer, _list_->count, visitor, args, n_threads);
+
+    _list_->flag = CMC_FLAG_OK;
+}
+
+/* Replaces the elements of dest by the elements of the list passed through */
+/* mapper. If dest is the list itself, mapper takes ownership of them. The */
+/* new elements are sorted lazily, like any other insertion. */
+bool CMC_(PFX, _map_into)(struct SNAME *_list_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (dest != _list_)
+    {
+        if (dest->capacity < _list_->count && !CMC_(PFX, _resize)(dest, _list_->count))
+        {
+            _list_->flag = dest->flag;
+            return false;
+        }
+
+        CMC_(PFX, _clear)(dest);
+    }
+
+    CMC_(PFX, _impl_algo_map)(_list_->buffer, _list_->count, dest->buffer, mapper, args, n_threads);
+
+    dest->count = _list_->count;
+    dest->sorted = 0;
+    dest->indexed = false;
+
+    dest->flag = CMC_FLAG_OK;
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(dest);
+
+    return true;
+}
+
+/* Returns a new list with a copy of every element that satisfies predicate */
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _list_->alloc->malloc(sizeof(bool) * _list_->count);
+
+    if (!mask && _list_->count > 0)
+    {
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_list_->buffer, _list_->count, mask, predicate, args, n_threads);
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(matches > 0 ? matches : 1, _list_->f_val, _list_->alloc, NULL);
+
+    if (!result)
+    {
+        _list_->alloc->free(mask);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_list_->buffer, _list_->count, mask, result->buffer, NULL, n_threads);
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val->cpy)
+    {
+        for (size_t i = 0; i < matches; i++)
+            result->buffer[i] = _list_->f_val->cpy(result->buffer[i]);
+    }
+#endif
+
+    result->count = matches;
+    result->sorted = matches;
+
+    _list_->alloc->free(mask);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return result;
+}
+
+/* Combines every element, in order, starting from initial. When n_threads */
+/* is greater than 1, reducer must also be associative. */
+V CMC_(PFX, _reduce)(struct SNAME *_list_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_list_);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_reduce)(_list_->buffer, _list_->count, initial, reducer, args, n_threads);
+}
+
+/* Counting doesn't depend on the order so the list is not sorted */
+size_t CMC_(PFX, _count_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    return CMC_(PFX, _impl_algo_count)(_list_->buffer, _list_->count, predicate, args, n_threads);
+}
+
+/* Keeps in the list the elements that satisfy predicate and moves the rest */
+/* to a new list. Both remain sorted. */
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    bool *mask = _list_->alloc->malloc(sizeof(bool) * _list_->count);
+    V *kept = _list_->alloc->malloc(sizeof(V) * _list_->count);
+
+    if ((!mask || !kept) && _list_->count > 0)
+    {
+        _list_->alloc->free(mask);
+        _list_->alloc->free(kept);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_(PFX, _sort)(_list_);
+
+    size_t matches = CMC_(PFX, _impl_algo_mask)(_list_->buffer, _list_->count, mask, predicate, args, n_threads);
+    size_t rejected = _list_->count - matches;
+
+    struct SNAME *result = CMC_(PFX, _new_custom)(rejected > 0 ? rejected : 1, _list_->f_val, _list_->alloc, NULL);
+
+    if (!result)
+    {
+        _list_->alloc->free(mask);
+        _list_->alloc->free(kept);
+        _list_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    CMC_CALLBACKS_ASSIGN(result, _list_->callbacks);
+
+    CMC_(PFX, _impl_algo_scatter)(_list_->buffer, _list_->count, mask, kept, result->buffer, n_threads);
+
+    memcpy(_list_->buffer, kept, sizeof(V) * matches);
+    memset(_list_->buffer + matches, 0, sizeof(V) * rejected);
+
+    _list_->count = matches;
+    _list_->sorted = matches;
+    _list_->indexed = false;
+
+    result->count = rejected;
+    result->sorted = rejected;
+
+    _list_->alloc->free(mask);
+    _list_->alloc->free(kept);
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return result;
+}
+
+/* Overwrites every element with value, or a copy of it if the list has a */
+/* cpy function. The previous elements are freed. */
+void CMC_(PFX, _fill)(struct SNAME *_list_, V value, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_list_->f_val->free)
+    {
+        for (size_t i = 0; i < _list_->count; i++)
+            _list_->f_val->free(_list_->buffer[i]);
+    }
+#endif
+
+#ifdef CMC_TRIVIAL_V
+    CMC_(PFX, _impl_algo_fill)(_list_->buffer, _list_->count, value, NULL, n_threads);
+#else
+    CMC_(PFX, _impl_algo_fill)(_list_->buffer, _list_->count, value, _list_->f_val->cpy, n_threads);
+#endif
+
+    _list_->sorted = _list_->count;
+    _list_->indexed = false;
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+}
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -78,6 +305,54 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
     return iter;
 }
 
+/* Iterator starting at the first element greater than or equal to value or */
+/* at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(target);
+
+    size_t index = CMC_(PFX, _impl_lower_bound)(target, value);
+
+    if (index == target->count)
+        return CMC_(PFX, _iter_end)(target);
+
+    if (index > 0)
+    {
+        iter.cursor = index;
+        iter.start = false;
+    }
+
+    return iter;
+}
+
+/* Iterator starting at the first element strictly greater than value or at */
+/* the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(target);
+
+    size_t index = CMC_(PFX, _impl_upper_bound)(target, value);
+
+    if (index == target->count)
+        return CMC_(PFX, _iter_end)(target);
+
+    if (index > 0)
+    {
+        iter.cursor = index;
+        iter.start = false;
+    }
+
+    return iter;
+}
+
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter)
 {
 #ifdef CMC_DEV
@@ -270,6 +545,161 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort. The list is split between cmc_thread workers that sort
+ * their slices with a stable sort and then merge them in pairs.
+ */
+#ifdef CMC_EXT_PSORT
+
+/* Same as stable_sort() but using up to n_threads threads. Small lists are */
+/* sorted by the current thread alone. */
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_list_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_sort)(_list_, n_threads < 1 ? 1 : n_threads);
+}
+
+#endif /* CMC_EXT_PSORT */
+
+/**
+ * SETF
+ *
+ * Set functions. Both lists are sorted and merged into a new list. Equal
+ * elements are matched one to one, so an element repeated in both lists is
+ * kept as many times as in the list that has the fewest of them by the
+ * intersection and as many times as in the list that has the most of them by
+ * the union. If CMC_ARITHMETIC_V is defined the merge is done by the kernels
+ * of cor/setops/code.h.
+ */
+#ifdef CMC_EXT_SETF
+
+/* Implementation detail functions */
+static struct SNAME *CMC_(PFX, _impl_set_operation)(struct SNAME *_list1_, struct SNAME *_list2_, bool is_union);
+#ifndef CMC_ARITHMETIC_V
+static size_t CMC_(PFX, _impl_set_merge)(struct SNAME *_list_, V *A, size_t count_A, V *B, size_t count_B, V *result,
+                                         bool is_union);
+#endif
+
+struct SNAME *CMC_(PFX, _union)(struct SNAME *_list1_, struct SNAME *_list2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_list1_, _list2_, true);
+}
+
+struct SNAME *CMC_(PFX, _intersection)(struct SNAME *_list1_, struct SNAME *_list2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_list1_, _list2_, false);
+}
+
+static struct SNAME *CMC_(PFX, _impl_set_operation)(struct SNAME *_list1_, struct SNAME *_list2_, bool is_union)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _sort)(_list1_);
+    CMC_(PFX, _sort)(_list2_);
+
+    size_t capacity = _list1_->count < _list2_->count ? _list1_->count : _list2_->count;
+
+    if (is_union)
+        capacity = _list1_->count + _list2_->count;
+
+    struct SNAME *_list_r_ =
+        CMC_(PFX, _new_custom)(capacity > 0 ? capacity : 1, _list1_->f_val, _list1_->alloc, NULL);
+
+    if (!_list_r_)
+        return NULL;
+
+    V *A = _list1_->buffer;
+    V *B = _list2_->buffer;
+    V *R = _list_r_->buffer;
+
+#ifdef CMC_ARITHMETIC_V
+    size_t count = is_union ? CMC_(PFX, _impl_setops_union)(A, _list1_->count, B, _list2_->count, R)
+                            : CMC_(PFX, _impl_setops_intersection)(A, _list1_->count, B, _list2_->count, R);
+#else
+    size_t count = CMC_(PFX, _impl_set_merge)(_list1_, A, _list1_->count, B, _list2_->count, R, is_union);
+#endif
+
+#ifndef CMC_TRIVIAL_V
+    if (_list1_->f_val->cpy)
+    {
+        for (size_t i = 0; i < count; i++)
+            R[i] = _list1_->f_val->cpy(R[i]);
+    }
+#endif
+
+    _list_r_->count = count;
+    _list_r_->sorted = count;
+
+    CMC_CALLBACKS_ASSIGN(_list_r_, _list1_->callbacks);
+
+    return _list_r_;
+}
+
+#ifndef CMC_ARITHMETIC_V
+/* Merges two sorted arrays keeping the elements in both or in any of them */
+static size_t CMC_(PFX, _impl_set_merge)(struct SNAME *_list_, V *A, size_t count_A, V *B, size_t count_B, V *result,
+                                         bool is_union)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < count_A && j < count_B)
+    {
+        int c = _list_->f_val->cmp(A[i], B[j]);
+
+        if (c < 0)
+        {
+            if (is_union)
+                result[k++] = A[i];
+            i++;
+        }
+        else if (c > 0)
+        {
+            if (is_union)
+                result[k++] = B[j];
+            j++;
+        }
+        else
+        {
+            result[k++] = A[i];
+            i++;
+            j++;
+        }
+    }
+
+    if (is_union)
+    {
+        while (i < count_A)
+            result[k++] = A[i++];
+
+        while (j < count_B)
+            result[k++] = B[j++];
+    }
+
+    return k;
+}
+#endif
+
+#endif /* CMC_EXT_SETF */
+
 /**
  * STR
  *
@@ -291,13 +721,14 @@ bool CMC_(PFX, _to_string)(struct SNAME *_list_, FILE *fptr)
                         "buffer:%p, "
                         "capacity:%" PRIuMAX ", "
                         "count:%" PRIuMAX ", "
-                        "is_sorted:%s, "
+                        "sorted:%" PRIuMAX ", "
+                        "eytzinger:%p, "
                         "flag:%d, "
                         "f_val:%p, "
                         "alloc:%p, "
                         "callbacks:%p }",
                         CMC_TO_STRING(SNAME), CMC_TO_STRING(V), l_, l_->buffer, l_->capacity, l_->count,
-                        l_->is_sorted ? "true" : "false", l_->flag, l_->f_val, l_->alloc, CMC_CALLBACKS_GET(l_));
+                        l_->sorted, l_->eytzinger, l_->flag, l_->f_val, l_->alloc, CMC_CALLBACKS_GET(l_));
 }
 
 bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, const char *separator, const char *end)
@@ -325,3 +756,706 @@ bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, cons
 }
 
 #endif /* CMC_EXT_STR */
+
+/**
+ * VIEW
+ *
+ * Non-owning views of a range of the sorted list. The list is sorted when the
+ * view is taken and the view then points straight into its buffer, so it is
+ * invalidated by any function that modifies the list or may reallocate its
+ * buffer and by freeing the list. Since the view is sorted, searching it is a
+ * binary search. With CMC_DEV every view function logs an error when used on
+ * a view whose list buffer was reallocated.
+ */
+#ifdef CMC_EXT_VIEW
+
+/* Implementation Detail Functions */
+static size_t CMC_(PFX, _impl_view_bound)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool upper);
+
+/* Views the elements in [from, to] of the sorted list */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view)(struct SNAME *_list_, size_t from, size_t to)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (from > to)
+    {
+        _list_->flag = CMC_FLAG_INVALID;
+        return (struct CMC_DEF_VIEW(SNAME)){ 0 };
+    }
+
+    if (to >= _list_->count)
+    {
+        _list_->flag = CMC_FLAG_RANGE;
+        return (struct CMC_DEF_VIEW(SNAME)){ 0 };
+    }
+
+    CMC_(PFX, _sort)(_list_);
+
+    struct CMC_DEF_VIEW(SNAME) view = { 0 };
+
+    view.data = _list_->buffer + from;
+    view.count = to - from + 1;
+    view.f_val = _list_->f_val;
+#ifdef CMC_DEV
+    view.target = _list_;
+    view.generation = _list_->generation;
+#endif
+
+    _list_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_list_);
+
+    return view;
+}
+
+/* Views the elements in [from, to] of another view. Returns an empty view */
+/* if the range is not valid. */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view_slice)(struct CMC_DEF_VIEW(SNAME) * view, size_t from, size_t to)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    struct CMC_DEF_VIEW(SNAME) slice = *view;
+
+    if (from > to || to >= view->count)
+    {
+        slice.data = NULL;
+        slice.count = 0;
+        return slice;
+    }
+
+    slice.data = view->data + from;
+    slice.count = to - from + 1;
+
+    return slice;
+}
+
+V CMC_(PFX, _view_get)(struct CMC_DEF_VIEW(SNAME) * view, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    if (index >= view->count)
+        return (V){ 0 };
+
+    return view->data[index];
+}
+
+/* Returns the count of the view if the value is not found */
+size_t CMC_(PFX, _view_index_of)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool from_start)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    if (from_start)
+    {
+        size_t index = CMC_(PFX, _impl_view_bound)(view, value, false);
+
+        if (index < view->count && view->f_val->cmp(view->data[index], value) == 0)
+            return index;
+    }
+    else
+    {
+        size_t index = CMC_(PFX, _impl_view_bound)(view, value, true);
+
+        if (index > 0 && view->f_val->cmp(view->data[index - 1], value) == 0)
+            return index - 1;
+    }
+
+    return view->count;
+}
+
+size_t CMC_(PFX, _view_count_of)(struct CMC_DEF_VIEW(SNAME) * view, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _impl_view_bound)(view, value, true) - CMC_(PFX, _impl_view_bound)(view, value, false);
+}
+
+bool CMC_(PFX, _view_contains)(struct CMC_DEF_VIEW(SNAME) * view, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _view_index_of)(view, value, true) != view->count;
+}
+
+bool CMC_(PFX, _view_equals)(struct CMC_DEF_VIEW(SNAME) * view1, struct CMC_DEF_VIEW(SNAME) * view2)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view1);
+    CMC_DEV_VIEW_CHECK(view2);
+#endif
+
+    if (view1->count != view2->count)
+        return false;
+
+    for (size_t i = 0; i < view1->count; i++)
+    {
+        if (view1->f_val->cmp(view1->data[i], view2->data[i]) != 0)
+            return false;
+    }
+
+    return true;
+}
+
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _view_for_each)(struct CMC_DEF_VIEW(SNAME) * view, void (*visitor)(V, void *), void *args,
+                               size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    CMC_(PFX, _impl_algo_for_each)(view->data, view->count, visitor, args, n_threads);
+}
+
+V CMC_(PFX, _view_reduce)(struct CMC_DEF_VIEW(SNAME) * view, V initial, V (*reducer)(V, V, void *), void *args,
+                          size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _impl_algo_reduce)(view->data, view->count, initial, reducer, args, n_threads);
+}
+
+size_t CMC_(PFX, _view_count_if)(struct CMC_DEF_VIEW(SNAME) * view, bool (*predicate)(V, void *), void *args,
+                                 size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+    CMC_DEV_VIEW_CHECK(view);
+#endif
+
+    return CMC_(PFX, _impl_algo_count)(view->data, view->count, predicate, args, n_threads);
+}
+
+#endif /* CMC_EXT_ALGO */
+
+/* Index of the first element of the view greater than or equal to value, or */
+/* greater than value if upper is true */
+static size_t CMC_(PFX, _impl_view_bound)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool upper)
+{
+    size_t n = view->count;
+
+    if (n == 0)
+        return 0;
+
+    V *base = view->data;
+
+    while (n > 1)
+    {
+        size_t half = n / 2;
+        int cmp = view->f_val->cmp(base[half], value);
+
+        base = (upper ? cmp <= 0 : cmp < 0) ? base + half : base;
+        n -= half;
+    }
+
+    int cmp = view->f_val->cmp(base[0], value);
+
+    return (size_t)(base - view->data) + (upper ? cmp <= 0 : cmp < 0);
+}
+
+#endif /* CMC_EXT_VIEW */
+
+/**
+ * XSORT
+ *
+ * External sort, for when there are more values than what fits in memory.
+ * Values are pushed to a list with a fixed capacity. When it is full, the list
+ * is sorted and written to a temporary file as a run. When the input is
+ * finished, the runs are merged with a min-heap that keeps the current value of
+ * each run and reads the next one only after it was taken. If no run was
+ * spilled, the values are taken straight from the list.
+ *
+ * Values are written as raw bytes unless a serializer is given. The sorter
+ * owns every value pushed to it until it is returned by next(). Values written
+ * to a run or to the output of write() are freed with f_val->free.
+ */
+#ifdef CMC_EXT_XSORT
+
+/* Implementation Detail Functions */
+static bool CMC_(PFX, _impl_xsort_spill)(struct CMC_(SNAME, _xsort) * xsort);
+static bool CMC_(PFX, _impl_xsort_write)(struct CMC_(SNAME, _xsort) * xsort, FILE *fptr, V value);
+static bool CMC_(PFX, _impl_xsort_read)(struct CMC_(SNAME, _xsort) * xsort, size_t run);
+static bool CMC_(PFX, _impl_xsort_less)(struct CMC_(SNAME, _xsort) * xsort, size_t run1, size_t run2);
+static void CMC_(PFX, _impl_xsort_sift_up)(struct CMC_(SNAME, _xsort) * xsort, size_t index);
+static void CMC_(PFX, _impl_xsort_sift_down)(struct CMC_(SNAME, _xsort) * xsort, size_t index);
+
+struct CMC_(SNAME, _xsort) * CMC_(PFX, _xsort_new)(size_t run_capacity, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                                   struct CMC_(SNAME, _xsort_io) * io)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _xsort_new_custom)(run_capacity, f_val, io, NULL);
+}
+
+struct CMC_(SNAME, _xsort) * CMC_(PFX, _xsort_new_custom)(size_t run_capacity, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                                          struct CMC_(SNAME, _xsort_io) * io, CMC_ALLOC_TYPE alloc)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (run_capacity < 1 || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct CMC_(SNAME, _xsort) *xsort = alloc->malloc(sizeof(struct CMC_(SNAME, _xsort)));
+
+    if (!xsort)
+        return NULL;
+
+    xsort->run = CMC_(PFX, _new_custom)(run_capacity, f_val, alloc, NULL);
+
+    if (!xsort->run)
+    {
+        alloc->free(xsort);
+        return NULL;
+    }
+
+    xsort->files = NULL;
+    xsort->lengths = NULL;
+    xsort->runs = 0;
+    xsort->runs_capacity = 0;
+    xsort->heads = NULL;
+    xsort->heap = NULL;
+    xsort->heap_count = 0;
+    xsort->cursor = 0;
+    xsort->count = 0;
+    xsort->merging = false;
+    xsort->flag = CMC_FLAG_OK;
+    xsort->f_val = f_val;
+    xsort->io = io;
+    xsort->alloc = alloc;
+
+    return xsort;
+}
+
+/* Closes the temporary files, which deletes them, and frees every value that */
+/* was not returned by next() */
+void CMC_(PFX, _xsort_free)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    for (size_t i = 0; i < xsort->runs; i++)
+        fclose(xsort->files[i]);
+
+    struct SNAME *run = xsort->run;
+
+#ifndef CMC_TRIVIAL_V
+    if (xsort->f_val->free)
+    {
+        for (size_t i = 0; i < xsort->heap_count; i++)
+            xsort->f_val->free(xsort->heads[xsort->heap[i]]);
+
+        /* Values before the cursor were already returned */
+        for (size_t i = xsort->cursor; i < run->count; i++)
+            xsort->f_val->free(run->buffer[i]);
+    }
+#endif
+
+    run->count = 0;
+
+    CMC_(PFX, _free)(run);
+
+    xsort->alloc->free(xsort->files);
+    xsort->alloc->free(xsort->lengths);
+    xsort->alloc->free(xsort->heads);
+    xsort->alloc->free(xsort->heap);
+    xsort->alloc->free(xsort);
+}
+
+/* Adds a value to the current run, spilling the run first if it is full */
+bool CMC_(PFX, _xsort_push)(struct CMC_(SNAME, _xsort) * xsort, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (xsort->merging)
+    {
+        xsort->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    if (CMC_(PFX, _full)(xsort->run) && !CMC_(PFX, _impl_xsort_spill)(xsort))
+        return false;
+
+    if (!CMC_(PFX, _insert)(xsort->run, value))
+    {
+        xsort->flag = CMC_(PFX, _flag)(xsort->run);
+        return false;
+    }
+
+    xsort->count++;
+    xsort->flag = CMC_FLAG_OK;
+
+    return true;
+}
+
+/* Ends the input. The last run is spilled and the first value of each run is */
+/* read. Called by next() and write() if it wasn't called before. */
+bool CMC_(PFX, _xsort_finish)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (xsort->merging)
+    {
+        xsort->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    if (xsort->runs == 0)
+    {
+        CMC_(PFX, _sort)(xsort->run);
+
+        xsort->merging = true;
+        xsort->flag = CMC_FLAG_OK;
+
+        return true;
+    }
+
+    if (!CMC_(PFX, _empty)(xsort->run) && !CMC_(PFX, _impl_xsort_spill)(xsort))
+        return false;
+
+    xsort->heads = xsort->alloc->malloc(sizeof(V) * xsort->runs);
+    xsort->heap = xsort->alloc->malloc(sizeof(size_t) * xsort->runs);
+
+    if (!xsort->heads || !xsort->heap)
+    {
+        xsort->alloc->free(xsort->heads);
+        xsort->alloc->free(xsort->heap);
+        xsort->heads = NULL;
+        xsort->heap = NULL;
+        xsort->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    xsort->merging = true;
+
+    for (size_t i = 0; i < xsort->runs; i++)
+    {
+        if (fseek(xsort->files[i], 0, SEEK_SET) != 0 || !CMC_(PFX, _impl_xsort_read)(xsort, i))
+        {
+            xsort->flag = CMC_FLAG_IO;
+            return false;
+        }
+
+        xsort->heap[xsort->heap_count++] = i;
+
+        CMC_(PFX, _impl_xsort_sift_up)(xsort, xsort->heap_count - 1);
+    }
+
+    xsort->flag = CMC_FLAG_OK;
+
+    return true;
+}
+
+/* Takes the next value in sorted order. Returns false with the EMPTY flag */
+/* once every value was returned. */
+bool CMC_(PFX, _xsort_next)(struct CMC_(SNAME, _xsort) * xsort, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!xsort->merging && !CMC_(PFX, _xsort_finish)(xsort))
+        return false;
+
+    if (xsort->runs == 0)
+    {
+        if (xsort->cursor == xsort->run->count)
+        {
+            xsort->flag = CMC_FLAG_EMPTY;
+            return false;
+        }
+
+        *value = xsort->run->buffer[xsort->cursor++];
+        xsort->flag = CMC_FLAG_OK;
+
+        return true;
+    }
+
+    if (xsort->heap_count == 0)
+    {
+        xsort->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    size_t top = xsort->heap[0];
+    V result = xsort->heads[top];
+
+    if (xsort->lengths[top] > 0)
+    {
+        if (!CMC_(PFX, _impl_xsort_read)(xsort, top))
+        {
+            xsort->heads[top] = result;
+            xsort->flag = CMC_FLAG_IO;
+            return false;
+        }
+    }
+    else
+        xsort->heap[0] = xsort->heap[--xsort->heap_count];
+
+    if (xsort->heap_count > 1)
+        CMC_(PFX, _impl_xsort_sift_down)(xsort, 0);
+
+    *value = result;
+    xsort->flag = CMC_FLAG_OK;
+
+    return true;
+}
+
+/* Writes every value that is left, in sorted order, to fptr */
+bool CMC_(PFX, _xsort_write)(struct CMC_(SNAME, _xsort) * xsort, FILE *fptr)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    V value;
+
+    while (CMC_(PFX, _xsort_next)(xsort, &value))
+    {
+        bool written = CMC_(PFX, _impl_xsort_write)(xsort, fptr, value);
+
+#ifndef CMC_TRIVIAL_V
+        if (xsort->f_val->free)
+            xsort->f_val->free(value);
+#endif
+
+        if (!written)
+        {
+            xsort->flag = CMC_FLAG_IO;
+            return false;
+        }
+    }
+
+    if (xsort->flag != CMC_FLAG_EMPTY)
+        return false;
+
+    xsort->flag = CMC_FLAG_OK;
+
+    return true;
+}
+
+size_t CMC_(PFX, _xsort_count)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return xsort->count;
+}
+
+size_t CMC_(PFX, _xsort_runs)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return xsort->runs;
+}
+
+int CMC_(PFX, _xsort_flag)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return xsort->flag;
+}
+
+/* Sorts the current run and writes it to a new temporary file */
+static bool CMC_(PFX, _impl_xsort_spill)(struct CMC_(SNAME, _xsort) * xsort)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (xsort->runs == xsort->runs_capacity)
+    {
+        size_t capacity = xsort->runs_capacity == 0 ? 8 : xsort->runs_capacity * 2;
+
+        FILE **files = xsort->alloc->realloc(xsort->files, sizeof(FILE *) * capacity);
+
+        if (!files)
+        {
+            xsort->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        xsort->files = files;
+
+        size_t *lengths = xsort->alloc->realloc(xsort->lengths, sizeof(size_t) * capacity);
+
+        if (!lengths)
+        {
+            xsort->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        xsort->lengths = lengths;
+        xsort->runs_capacity = capacity;
+    }
+
+    FILE *file = tmpfile();
+
+    if (!file)
+    {
+        xsort->flag = CMC_FLAG_IO;
+        return false;
+    }
+
+    struct SNAME *run = xsort->run;
+
+    CMC_(PFX, _sort)(run);
+
+    for (size_t i = 0; i < run->count; i++)
+    {
+        if (!CMC_(PFX, _impl_xsort_write)(xsort, file, run->buffer[i]))
+        {
+            fclose(file);
+            xsort->flag = CMC_FLAG_IO;
+            return false;
+        }
+    }
+
+    if (fflush(file) != 0)
+    {
+        fclose(file);
+        xsort->flag = CMC_FLAG_IO;
+        return false;
+    }
+
+    xsort->files[xsort->runs] = file;
+    xsort->lengths[xsort->runs] = run->count;
+    xsort->runs++;
+
+    /* The values are on disk now */
+    CMC_(PFX, _clear)(run);
+
+    return true;
+}
+
+static bool CMC_(PFX, _impl_xsort_write)(struct CMC_(SNAME, _xsort) * xsort, FILE *fptr, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (xsort->io)
+        return xsort->io->write(fptr, value);
+
+    return fwrite(&value, sizeof(V), 1, fptr) == 1;
+}
+
+/* Reads the next value of a run into its head */
+static bool CMC_(PFX, _impl_xsort_read)(struct CMC_(SNAME, _xsort) * xsort, size_t run)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    FILE *file = xsort->files[run];
+    V *head = &xsort->heads[run];
+
+    bool read = xsort->io ? xsort->io->read(file, head) : fread(head, sizeof(V), 1, file) == 1;
+
+    if (read)
+        xsort->lengths[run]--;
+
+    return read;
+}
+
+static bool CMC_(PFX, _impl_xsort_less)(struct CMC_(SNAME, _xsort) * xsort, size_t run1, size_t run2)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifdef CMC_ARITHMETIC_V
+    return xsort->heads[run1] < xsort->heads[run2];
+#else
+    return xsort->f_val->cmp(xsort->heads[run1], xsort->heads[run2]) < 0;
+#endif
+}
+
+static void CMC_(PFX, _impl_xsort_sift_up)(struct CMC_(SNAME, _xsort) * xsort, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t *heap = xsort->heap;
+
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / 2;
+
+        if (!CMC_(PFX, _impl_xsort_less)(xsort, heap[index], heap[parent]))
+            break;
+
+        size_t tmp = heap[index];
+        heap[index] = heap[parent];
+        heap[parent] = tmp;
+
+        index = parent;
+    }
+}
+
+static void CMC_(PFX, _impl_xsort_sift_down)(struct CMC_(SNAME, _xsort) * xsort, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t *heap = xsort->heap;
+
+    while (2 * index + 1 < xsort->heap_count)
+    {
+        size_t child = 2 * index + 1;
+
+        if (child + 1 < xsort->heap_count && CMC_(PFX, _impl_xsort_less)(xsort, heap[child + 1], heap[child]))
+            child++;
+
+        if (!CMC_(PFX, _impl_xsort_less)(xsort, heap[child], heap[index]))
+            break;
+
+        size_t tmp = heap[index];
+        heap[index] = heap[child];
+        heap[child] = tmp;
+
+        index = child;
+    }
+}
+
+#endif /* CMC_EXT_XSORT */
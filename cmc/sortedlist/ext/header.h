@@ -22,6 +22,26 @@
  * SOFTWARE.
  */
 
+/**
+ * ALGO
+ *
+ * Algorithms that visit every element of the sorted list, in order. They can be
+ * split between up to n_threads cmc_thread workers (see cor/algo.h).
+ */
+#ifdef CMC_EXT_ALGO
+
+void CMC_(PFX, _for_each)(struct SNAME *_list_, void (*visitor)(V, void *), void *args, size_t n_threads);
+bool CMC_(PFX, _map_into)(struct SNAME *_list_, struct SNAME *dest, V (*mapper)(V, void *), void *args,
+                          size_t n_threads);
+struct SNAME *CMC_(PFX, _filter)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+V CMC_(PFX, _reduce)(struct SNAME *_list_, V initial, V (*reducer)(V, V, void *), void *args, size_t n_threads);
+size_t CMC_(PFX, _count_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args, size_t n_threads);
+struct SNAME *CMC_(PFX, _partition)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args,
+                                    size_t n_threads);
+void CMC_(PFX, _fill)(struct SNAME *_list_, V value, size_t n_threads);
+
+#endif /* CMC_EXT_ALGO */
+
 /**
  * INIT
  *
@@ -55,6 +75,8 @@ struct CMC_DEF_ITER(SNAME)
 /* Iterator Initialization */
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target);
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, V value);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, V value);
 /* Iterator State */
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter);
 bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter);
@@ -72,6 +94,30 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter);
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * PSORT
+ *
+ * Parallel sort.
+ */
+#ifdef CMC_EXT_PSORT
+
+bool CMC_(PFX, _sort_parallel)(struct SNAME *_list_, size_t n_threads);
+
+#endif /* CMC_EXT_PSORT */
+
+/**
+ * SETF
+ *
+ * Set functions
+ */
+#ifdef CMC_EXT_SETF
+
+/* Set Operations */
+struct SNAME *CMC_(PFX, _union)(struct SNAME *_list1_, struct SNAME *_list2_);
+struct SNAME *CMC_(PFX, _intersection)(struct SNAME *_list1_, struct SNAME *_list2_);
+
+#endif /* CMC_EXT_SETF */
+
 /**
  * STR
  *
@@ -83,3 +129,119 @@ bool CMC_(PFX, _to_string)(struct SNAME *_list_, FILE *fptr);
 bool CMC_(PFX, _print)(struct SNAME *_list_, FILE *fptr, const char *start, const char *separator, const char *end);
 
 #endif /* CMC_EXT_STR */
+
+/**
+ * VIEW
+ *
+ * Non-owning views of a range of the sorted list. A view is only valid while
+ * the list is not modified.
+ */
+#ifdef CMC_EXT_VIEW
+
+/* SortedList View */
+struct CMC_DEF_VIEW(SNAME)
+{
+    /* First element of the range, owned by the list */
+    V *data;
+    /* Amount of elements in the range */
+    size_t count;
+    /* Value function table of the list */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+#ifdef CMC_DEV
+    /* List the view was taken from */
+    struct SNAME *target;
+    /* Generation of the list buffer when the view was taken */
+    size_t generation;
+#endif
+};
+
+/* View Initialization */
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view)(struct SNAME *_list_, size_t from, size_t to);
+struct CMC_DEF_VIEW(SNAME) CMC_(PFX, _view_slice)(struct CMC_DEF_VIEW(SNAME) * view, size_t from, size_t to);
+/* View Access */
+V CMC_(PFX, _view_get)(struct CMC_DEF_VIEW(SNAME) * view, size_t index);
+size_t CMC_(PFX, _view_index_of)(struct CMC_DEF_VIEW(SNAME) * view, V value, bool from_start);
+size_t CMC_(PFX, _view_count_of)(struct CMC_DEF_VIEW(SNAME) * view, V value);
+bool CMC_(PFX, _view_contains)(struct CMC_DEF_VIEW(SNAME) * view, V value);
+bool CMC_(PFX, _view_equals)(struct CMC_DEF_VIEW(SNAME) * view1, struct CMC_DEF_VIEW(SNAME) * view2);
+#ifdef CMC_EXT_ALGO
+/* View Algorithms */
+void CMC_(PFX, _view_for_each)(struct CMC_DEF_VIEW(SNAME) * view, void (*visitor)(V, void *), void *args,
+                               size_t n_threads);
+V CMC_(PFX, _view_reduce)(struct CMC_DEF_VIEW(SNAME) * view, V initial, V (*reducer)(V, V, void *), void *args,
+                          size_t n_threads);
+size_t CMC_(PFX, _view_count_if)(struct CMC_DEF_VIEW(SNAME) * view, bool (*predicate)(V, void *), void *args,
+                                 size_t n_threads);
+#endif
+
+#endif /* CMC_EXT_VIEW */
+
+/**
+ * XSORT
+ *
+ * External sort.
+ */
+#ifdef CMC_EXT_XSORT
+
+/* Functions that write a value to a run file and read it back. Used when V */
+/* can't be copied byte by byte, like a pointer to a string. */
+struct CMC_(SNAME, _xsort_io)
+{
+    /* Writes value to the file */
+    bool (*write)(FILE *, V);
+    /* Reads the next value from the file into the given pointer */
+    bool (*read)(FILE *, V *);
+};
+
+/* External Sorter */
+struct CMC_(SNAME, _xsort)
+{
+    /* Bounded in-memory list where values are sorted before being spilled */
+    struct SNAME *run;
+    /* Temporary files, one for each spilled run */
+    FILE **files;
+    /* How many values are left to be read from each run */
+    size_t *lengths;
+    /* Amount of runs spilled to temporary files */
+    size_t runs;
+    /* Capacity of files and lengths */
+    size_t runs_capacity;
+    /* Current value of each run */
+    V *heads;
+    /* Min-heap of run indices ordered by their current value */
+    size_t *heap;
+    /* Amount of runs in the heap */
+    size_t heap_count;
+    /* Next value taken from run when nothing was spilled */
+    size_t cursor;
+    /* Amount of values pushed */
+    size_t count;
+    /* If the input was finished and values are being merged */
+    bool merging;
+    /* Flags indicating errors or success */
+    int flag;
+    /* Value function table */
+    struct CMC_DEF_FVAL(SNAME) * f_val;
+    /* Optional serializer, or NULL if V is trivially copyable */
+    struct CMC_(SNAME, _xsort_io) * io;
+    /* Custom allocation functions */
+    CMC_ALLOC_TYPE alloc;
+};
+
+/* External Sorter Allocation */
+struct CMC_(SNAME, _xsort) * CMC_(PFX, _xsort_new)(size_t run_capacity, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                                   struct CMC_(SNAME, _xsort_io) * io);
+struct CMC_(SNAME, _xsort) * CMC_(PFX, _xsort_new_custom)(size_t run_capacity, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                                          struct CMC_(SNAME, _xsort_io) * io, CMC_ALLOC_TYPE alloc);
+void CMC_(PFX, _xsort_free)(struct CMC_(SNAME, _xsort) * xsort);
+/* External Sorter Input and Output */
+bool CMC_(PFX, _xsort_push)(struct CMC_(SNAME, _xsort) * xsort, V value);
+bool CMC_(PFX, _xsort_finish)(struct CMC_(SNAME, _xsort) * xsort);
+bool CMC_(PFX, _xsort_next)(struct CMC_(SNAME, _xsort) * xsort, V *value);
+bool CMC_(PFX, _xsort_write)(struct CMC_(SNAME, _xsort) * xsort, FILE *fptr);
+/* External Sorter State */
+size_t CMC_(PFX, _xsort_count)(struct CMC_(SNAME, _xsort) * xsort);
+size_t CMC_(PFX, _xsort_runs)(struct CMC_(SNAME, _xsort) * xsort);
+int CMC_(PFX, _xsort_flag)(struct CMC_(SNAME, _xsort) * xsort);
+
+#endif /* CMC_EXT_XSORT */
@@ -50,11 +50,21 @@ void CMC_(PFX, _customize)(struct SNAME *_list_, CMC_ALLOC_TYPE alloc, CMC_CALLB
 /* Collection Input and Output */
 bool CMC_(PFX, _insert)(struct SNAME *_list_, V value);
 bool CMC_(PFX, _remove)(struct SNAME *_list_, size_t index);
+size_t CMC_(PFX, _remove_range)(struct SNAME *_list_, V lower, V upper);
+bool CMC_(PFX, _insert_many)(struct SNAME *_list_, V *values, size_t size, bool already_sorted);
+bool CMC_(PFX, _merge)(struct SNAME *_list_, struct SNAME *_other_);
+size_t CMC_(PFX, _remove_many)(struct SNAME *_list_, V *values, size_t size);
+size_t CMC_(PFX, _remove_if)(struct SNAME *_list_, bool (*predicate)(V, void *), void *args);
 /* Element Access */
 V CMC_(PFX, _max)(struct SNAME *_list_);
 V CMC_(PFX, _min)(struct SNAME *_list_);
 V CMC_(PFX, _get)(struct SNAME *_list_, size_t index);
 size_t CMC_(PFX, _index_of)(struct SNAME *_list_, V value, bool from_start);
+size_t CMC_(PFX, _lower_bound)(struct SNAME *_list_, V value);
+size_t CMC_(PFX, _upper_bound)(struct SNAME *_list_, V value);
+bool CMC_(PFX, _floor)(struct SNAME *_list_, V value, V *out_value);
+bool CMC_(PFX, _ceiling)(struct SNAME *_list_, V value, V *out_value);
+size_t CMC_(PFX, _range)(struct SNAME *_list_, V lower, V upper, bool (*visitor)(V, void *), void *args);
 /* Collection State */
 bool CMC_(PFX, _contains)(struct SNAME *_list_, V value);
 bool CMC_(PFX, _empty)(struct SNAME *_list_);
@@ -64,6 +74,11 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_list_);
 int CMC_(PFX, _flag)(struct SNAME *_list_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_list_, size_t capacity);
+bool CMC_(PFX, _reserve)(struct SNAME *_list_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_list_);
 void CMC_(PFX, _sort)(struct SNAME *_list_);
+bool CMC_(PFX, _stable_sort)(struct SNAME *_list_);
+bool CMC_(PFX, _freeze)(struct SNAME *_list_);
+void CMC_(PFX, _thaw)(struct SNAME *_list_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_list_);
 bool CMC_(PFX, _equals)(struct SNAME *_list1_, struct SNAME *_list2_);
@@ -30,8 +30,14 @@ struct SNAME
     size_t capacity;
     /* Current amount of elements */
     size_t count;
-    /* Flag if the list is sorted or not, used by lazy evaluation */
-    bool is_sorted;
+    /* Length of the sorted prefix of the buffer, used by lazy evaluation. */
+    /* Elements after it were inserted since the last sort. */
+    size_t sorted;
+    /* Optional search index with the sorted buffer in Eytzinger (BFS) order */
+    /* or NULL if the list is not frozen. It is indexed from 1. */
+    V *eytzinger;
+    /* If the search index matches the current contents of the buffer */
+    bool indexed;
     /* Flags indicating errors or success */
     int flag;
     /* Value function table */
@@ -40,4 +46,8 @@ struct SNAME
     CMC_ALLOC_TYPE alloc;
     /* Custom callback functions */
     CMC_CALLBACKS_DECL;
+#ifdef CMC_DEV
+    /* Incremented every time the buffer is reallocated, checked by views */
+    size_t generation;
+#endif
 };
@@ -50,6 +50,8 @@
  */
 
 #include "cor/core.h"
+#include "cor/growth.h"
+#include "cor/scan.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -58,6 +60,9 @@
 /**
  * Used values
  * V - stack data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
+ * CMC_TRIVIAL_V - optional, V is copied, compared and freed bitwise
+ * CMC_SBO - optional, amount of elements stored in the struct itself
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
  */
@@ -68,6 +73,11 @@
 /* Function declaration */
 #include "cmc/stack/header.h"
 
+/* Search and reduction kernels */
+#ifdef CMC_ARITHMETIC_V
+#include "cor/scan/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/stack/code.h"
 
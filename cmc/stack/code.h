@@ -22,8 +22,24 @@
  * SOFTWARE.
  */
 
+/* With CMC_SBO, the elements of a stack with a capacity of at most CMC_SBO */
+/* are stored in the struct itself. The struct can be moved, like when it is */
+/* returned by _init(), so the buffer is pointed back to it at every call. */
+#ifdef CMC_SBO
+#define CMC_SBO_ANCHOR(stack) \
+    do \
+    { \
+        if ((stack)->capacity <= CMC_SBO) \
+            (stack)->buffer = (stack)->sbo; \
+    } while (0)
+#else
+#define CMC_SBO_ANCHOR(stack)
+#endif
+
 /* Implementation Detail Functions */
-/* None */
+#ifdef CMC_SBO
+static V *CMC_(PFX, _impl_sbo_realloc)(struct SNAME *_stack_, size_t capacity);
+#endif
 
 struct SNAME *CMC_(PFX, _new)(size_t capacity, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -48,6 +64,11 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
     if (!f_val)
         return NULL;
 
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (!alloc)
         alloc = &cmc_alloc_node_default;
 
@@ -56,7 +77,14 @@ struct SNAME *CMC_(PFX, _new_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
     if (!_stack_)
         return NULL;
 
+#ifdef CMC_SBO
+    if (capacity == CMC_SBO)
+        _stack_->buffer = memset(_stack_->sbo, 0, sizeof(V) * CMC_SBO);
+    else
+        _stack_->buffer = alloc->calloc(capacity, sizeof(V));
+#else
     _stack_->buffer = alloc->calloc(capacity, sizeof(V));
+#endif
 
     if (!_stack_->buffer)
     {
@@ -80,11 +108,15 @@ void CMC_(PFX, _clear)(struct SNAME *_stack_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
+#ifndef CMC_TRIVIAL_V
     if (_stack_->f_val->free)
     {
         for (size_t i = 0; i < _stack_->count; i++)
             _stack_->f_val->free(_stack_->buffer[i]);
     }
+#endif
 
     memset(_stack_->buffer, 0, sizeof(V) * _stack_->capacity);
 
@@ -98,13 +130,22 @@ void CMC_(PFX, _free)(struct SNAME *_stack_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
+#ifndef CMC_TRIVIAL_V
     if (_stack_->f_val->free)
     {
         for (size_t i = 0; i < _stack_->count; i++)
             _stack_->f_val->free(_stack_->buffer[i]);
     }
+#endif
 
+#ifdef CMC_SBO
+    if (_stack_->capacity > CMC_SBO)
+        _stack_->alloc->free(_stack_->buffer);
+#else
     _stack_->alloc->free(_stack_->buffer);
+#endif
     _stack_->alloc->free(_stack_);
 }
 
@@ -132,9 +173,11 @@ bool CMC_(PFX, _push)(struct SNAME *_stack_, V value)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     if (CMC_(PFX, _full)(_stack_))
     {
-        if (!CMC_(PFX, _resize)(_stack_, _stack_->capacity * 2))
+        if (!CMC_(PFX, _resize)(_stack_, cmc_growth_capacity(_stack_->capacity, _stack_->count + 1, sizeof(V))))
             return false;
     }
 
@@ -153,6 +196,8 @@ bool CMC_(PFX, _pop)(struct SNAME *_stack_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     if (CMC_(PFX, _empty)(_stack_))
     {
         _stack_->flag = CMC_FLAG_EMPTY;
@@ -174,6 +219,8 @@ V CMC_(PFX, _top)(struct SNAME *_stack_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     if (CMC_(PFX, _empty)(_stack_))
     {
         _stack_->flag = CMC_FLAG_EMPTY;
@@ -187,14 +234,128 @@ V CMC_(PFX, _top)(struct SNAME *_stack_)
     return _stack_->buffer[_stack_->count - 1];
 }
 
+size_t CMC_(PFX, _count_of)(struct SNAME *_stack_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_stack_);
+
+#ifdef CMC_ARITHMETIC_V
+    size_t result = CMC_(PFX, _impl_scan_count)(_stack_->buffer, _stack_->count, value);
+#else
+    size_t result = 0;
+
+    for (size_t i = 0; i < _stack_->count; i++)
+        result += _stack_->f_val->cmp(_stack_->buffer[i], value) == 0;
+#endif
+
+    _stack_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_stack_);
+
+    return result;
+}
+
+V CMC_(PFX, _min)(struct SNAME *_stack_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_stack_);
+
+    if (CMC_(PFX, _empty)(_stack_))
+    {
+        _stack_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    V result = CMC_(PFX, _impl_scan_min)(_stack_->buffer, _stack_->count);
+#else
+    V result = _stack_->buffer[0];
+
+    for (size_t i = 1; i < _stack_->count; i++)
+    {
+        if (_stack_->f_val->cmp(_stack_->buffer[i], result) < 0)
+            result = _stack_->buffer[i];
+    }
+#endif
+
+    _stack_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_stack_);
+
+    return result;
+}
+
+V CMC_(PFX, _max)(struct SNAME *_stack_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_stack_);
+
+    if (CMC_(PFX, _empty)(_stack_))
+    {
+        _stack_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+#ifdef CMC_ARITHMETIC_V
+    V result = CMC_(PFX, _impl_scan_max)(_stack_->buffer, _stack_->count);
+#else
+    V result = _stack_->buffer[0];
+
+    for (size_t i = 1; i < _stack_->count; i++)
+    {
+        if (_stack_->f_val->cmp(_stack_->buffer[i], result) > 0)
+            result = _stack_->buffer[i];
+    }
+#endif
+
+    _stack_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_stack_);
+
+    return result;
+}
+
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_stack_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_SBO_ANCHOR(_stack_);
+
+    V result = CMC_(PFX, _impl_scan_sum)(_stack_->buffer, _stack_->count);
+
+    _stack_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_stack_);
+
+    return result;
+}
+#endif
+
 bool CMC_(PFX, _contains)(struct SNAME *_stack_, V value)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     _stack_->flag = CMC_FLAG_OK;
 
+#ifdef CMC_ARITHMETIC_V
+    bool result = CMC_(PFX, _impl_scan_find)(_stack_->buffer, _stack_->count, value) != _stack_->count;
+#else
     bool result = false;
 
     for (size_t i = 0; i < _stack_->count; i++)
@@ -205,6 +366,7 @@ bool CMC_(PFX, _contains)(struct SNAME *_stack_, V value)
             break;
         }
     }
+#endif
 
     CMC_CALLBACKS_CALL(_stack_);
 
@@ -262,6 +424,13 @@ bool CMC_(PFX, _resize)(struct SNAME *_stack_, size_t capacity)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (_stack_->capacity == capacity)
         goto success;
 
@@ -271,7 +440,11 @@ bool CMC_(PFX, _resize)(struct SNAME *_stack_, size_t capacity)
         return false;
     }
 
+#ifdef CMC_SBO
+    V *new_buffer = CMC_(PFX, _impl_sbo_realloc)(_stack_, capacity);
+#else
     V *new_buffer = _stack_->alloc->realloc(_stack_->buffer, sizeof(V) * capacity);
+#endif
 
     if (!new_buffer)
     {
@@ -293,12 +466,46 @@ success:
     return true;
 }
 
+/* Makes room for size more elements, growing the buffer only as needed */
+bool CMC_(PFX, _reserve)(struct SNAME *_stack_, size_t size)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_stack_->capacity - _stack_->count >= size)
+    {
+        _stack_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    if (size > SIZE_MAX / sizeof(V) - _stack_->count)
+    {
+        _stack_->flag = CMC_FLAG_INVALID;
+        return false;
+    }
+
+    return CMC_(PFX, _resize)(_stack_, _stack_->count + size);
+}
+
+/* Shrinks the buffer to the amount of elements in it */
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_stack_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _resize)(_stack_, _stack_->count > 0 ? _stack_->count : 1);
+}
+
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_stack_)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     struct SNAME *result = CMC_(PFX, _new_custom)(_stack_->capacity, _stack_->f_val, _stack_->alloc, NULL);
 
     if (!result)
@@ -309,6 +516,9 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_stack_)
 
     CMC_CALLBACKS_ASSIGN(result, _stack_->callbacks);
 
+#ifdef CMC_TRIVIAL_V
+    memcpy(result->buffer, _stack_->buffer, sizeof(V) * _stack_->count);
+#else
     if (_stack_->f_val->cpy)
     {
         for (size_t i = 0; i < _stack_->count; i++)
@@ -316,6 +526,7 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_stack_)
     }
     else
         memcpy(result->buffer, _stack_->buffer, sizeof(V) * _stack_->count);
+#endif
 
     result->count = _stack_->count;
 
@@ -330,12 +541,18 @@ bool CMC_(PFX, _equals)(struct SNAME *_stack1_, struct SNAME *_stack2_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack1_);
+    CMC_SBO_ANCHOR(_stack2_);
+
     _stack1_->flag = CMC_FLAG_OK;
     _stack2_->flag = CMC_FLAG_OK;
 
     if (_stack1_->count != _stack2_->count)
         return false;
 
+#ifdef CMC_TRIVIAL_V
+    return memcmp(_stack1_->buffer, _stack2_->buffer, sizeof(V) * _stack1_->count) == 0;
+#else
     for (size_t i = 0; i < _stack1_->count; i++)
     {
         if (_stack1_->f_val->cmp(_stack1_->buffer[i], _stack2_->buffer[i]) != 0)
@@ -343,4 +560,36 @@ bool CMC_(PFX, _equals)(struct SNAME *_stack1_, struct SNAME *_stack2_)
     }
 
     return true;
-}
\ No newline at end of file
+#endif
+}
+
+#ifdef CMC_SBO
+/* Moves the elements between the inline storage and the heap when the new */
+/* capacity is on the other side of CMC_SBO */
+static V *CMC_(PFX, _impl_sbo_realloc)(struct SNAME *_stack_, size_t capacity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (_stack_->capacity > CMC_SBO && capacity > CMC_SBO)
+        return _stack_->alloc->realloc(_stack_->buffer, sizeof(V) * capacity);
+
+    if (capacity <= CMC_SBO)
+    {
+        memcpy(_stack_->sbo, _stack_->buffer, sizeof(V) * _stack_->count);
+        _stack_->alloc->free(_stack_->buffer);
+
+        return _stack_->sbo;
+    }
+
+    V *new_buffer = _stack_->alloc->malloc(sizeof(V) * capacity);
+
+    if (!new_buffer)
+        return NULL;
+
+    memcpy(new_buffer, _stack_->sbo, sizeof(V) * _stack_->count);
+
+    return new_buffer;
+}
+#endif
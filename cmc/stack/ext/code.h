@@ -53,13 +53,26 @@ struct SNAME CMC_(PFX, _init_custom)(size_t capacity, struct CMC_DEF_FVAL(SNAME)
     if (capacity < 1)
         return _stack_;
 
+#ifdef CMC_SBO
+    if (capacity < CMC_SBO)
+        capacity = CMC_SBO;
+#endif
+
     if (!f_val)
         return _stack_;
 
     if (!alloc)
         alloc = &cmc_alloc_node_default;
 
+#ifdef CMC_SBO
+    /* The inline storage was zeroed with the struct */
+    if (capacity == CMC_SBO)
+        _stack_.buffer = _stack_.sbo;
+    else
+        _stack_.buffer = alloc->calloc(capacity, sizeof(V));
+#else
     _stack_.buffer = alloc->calloc(capacity, sizeof(V));
+#endif
 
     if (!_stack_.buffer)
         return _stack_;
@@ -80,13 +93,22 @@ void CMC_(PFX, _release)(struct SNAME _stack_)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(&_stack_);
+
+#ifndef CMC_TRIVIAL_V
     if (_stack_.f_val->free)
     {
         for (size_t i = 0; i < _stack_.count; i++)
             _stack_.f_val->free(_stack_.buffer[i]);
     }
+#endif
 
+#ifdef CMC_SBO
+    if (_stack_.capacity > CMC_SBO)
+        _stack_.alloc->free(_stack_.buffer);
+#else
     _stack_.alloc->free(_stack_.buffer);
+#endif
 }
 
 #endif /* CMC_EXT_INIT */
@@ -104,6 +126,8 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(target);
+
     struct CMC_DEF_ITER(SNAME) iter;
 
     iter.target = target;
@@ -123,6 +147,8 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(target);
+
     struct CMC_DEF_ITER(SNAME) iter;
 
     iter.target = target;
@@ -308,6 +334,8 @@ V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(iter->target);
+
     if (CMC_(PFX, _empty)(iter->target))
         return (V){ 0 };
 
@@ -320,6 +348,8 @@ V *CMC_(PFX, _iter_rvalue)(struct CMC_DEF_ITER(SNAME) * iter)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(iter->target);
+
     if (CMC_(PFX, _empty)(iter->target))
         return NULL;
 
@@ -353,6 +383,8 @@ bool CMC_(PFX, _to_string)(struct SNAME *_stack_, FILE *fptr)
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     struct SNAME *s_ = _stack_;
 
     return 0 <= fprintf(fptr,
@@ -375,6 +407,8 @@ bool CMC_(PFX, _print)(struct SNAME *_stack_, FILE *fptr, const char *start, con
     CMC_DEV_FCALL;
 #endif
 
+    CMC_SBO_ANCHOR(_stack_);
+
     fprintf(fptr, "%s", start);
 
     for (size_t i = _stack_->count; i > 0; i--)
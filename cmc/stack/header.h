@@ -52,6 +52,12 @@ bool CMC_(PFX, _push)(struct SNAME *_stack_, V value);
 bool CMC_(PFX, _pop)(struct SNAME *_stack_);
 /* Element Access */
 V CMC_(PFX, _top)(struct SNAME *_stack_);
+size_t CMC_(PFX, _count_of)(struct SNAME *_stack_, V value);
+V CMC_(PFX, _min)(struct SNAME *_stack_);
+V CMC_(PFX, _max)(struct SNAME *_stack_);
+#ifdef CMC_ARITHMETIC_V
+V CMC_(PFX, _sum)(struct SNAME *_stack_);
+#endif
 /* Collection State */
 bool CMC_(PFX, _contains)(struct SNAME *_stack_, V value);
 bool CMC_(PFX, _empty)(struct SNAME *_stack_);
@@ -61,5 +67,7 @@ size_t CMC_(PFX, _capacity)(struct SNAME *_stack_);
 int CMC_(PFX, _flag)(struct SNAME *_stack_);
 /* Collection Utility */
 bool CMC_(PFX, _resize)(struct SNAME *_stack_, size_t capacity);
+bool CMC_(PFX, _reserve)(struct SNAME *_stack_, size_t size);
+bool CMC_(PFX, _shrink_to_fit)(struct SNAME *_stack_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_stack_);
 bool CMC_(PFX, _equals)(struct SNAME *_stack1_, struct SNAME *_stack2_);
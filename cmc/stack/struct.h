@@ -29,6 +29,10 @@ struct SNAME
     V *buffer;
     /* Current array capacity */
     size_t capacity;
+#ifdef CMC_SBO
+    /* Inline storage used as the buffer while the capacity is CMC_SBO */
+    V sbo[CMC_SBO];
+#endif
     /* Current amount of elements */
     size_t count;
     /* Flags indicating errors or success */
@@ -0,0 +1,87 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * treebidimap.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * TreeBidiMap
+ *
+ * A sorted bidirectional map. Like the HashBidiMap it is a bijection between
+ * two sets of unique elements (K <-> V), but both keys and values are kept in
+ * sorted order, so the map can be iterated by either of them.
+ *
+ * Implementation
+ *
+ * Each mapping is a single node that belongs to two AVL trees at the same
+ * time, one sorted by keys and the other by values. A node carries the links
+ * of both trees, so there is only one allocation per mapping and updating the
+ * key or the value of a mapping only moves that node in one of the trees.
+ */
+
+#include "cor/core.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - treebidimap key data type
+ * V - treebidimap value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/treebidimap/struct.h"
+
+/* Function declaration */
+#include "cmc/treebidimap/header.h"
+
+/* Function implementation */
+#include "cmc/treebidimap/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - treebidimap iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_TREEBIDIMAP_PARTS ITER, STR
+/**/
+#include "cmc/treebidimap/ext/struct.h"
+/**/
+#include "cmc/treebidimap/ext/header.h"
+/**/
+#include "cmc/treebidimap/ext/code.h"
+
+#include "cor/undef.h"
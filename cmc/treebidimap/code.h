@@ -0,0 +1,975 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value);
+static int CMC_(PFX, _impl_cmp)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d, K key, V val);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, int d, K key, V val);
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node, int d);
+static void CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node, int d);
+static void CMC_(PFX, _impl_replace)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * old_node,
+                                     struct CMC_DEF_NODE(SNAME) * new_node, int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z,
+                                                                 int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z,
+                                                                int d);
+static void CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d);
+static void CMC_(PFX, _impl_link)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d);
+static void CMC_(PFX, _impl_unlink)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node, int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_last_node)(struct CMC_DEF_NODE(SNAME) * node, int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node, int d);
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, bool free_keys,
+                                        bool free_values);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                     CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->root[0] = NULL;
+    _map_->root[1] = NULL;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root[0], true, true);
+
+    _map_->root[0] = NULL;
+    _map_->root[1] = NULL;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root[0], true, true);
+
+    _map_->alloc->free(_map_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    _map_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _impl_get_node)(_map_, 0, key, value) || CMC_(PFX, _impl_get_node)(_map_, 1, key, value))
+    {
+        _map_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_map_, key, value);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    CMC_(PFX, _impl_link)(_map_, node, 0);
+    CMC_(PFX, _impl_link)(_map_, node, 1);
+
+    _map_->count++;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _update_key)(struct SNAME *_map_, V val, K new_key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 1, new_key, val);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    /* The mapping val -> new_key is already true */
+    if (_map_->f_key->cmp(new_key, node->key) != 0)
+    {
+        if (CMC_(PFX, _impl_get_node)(_map_, 0, new_key, val) != NULL)
+        {
+            _map_->flag = CMC_FLAG_DUPLICATE;
+            return false;
+        }
+
+        /* Only the tree sorted by keys needs to change */
+        CMC_(PFX, _impl_unlink)(_map_, node, 0);
+
+        node->key = new_key;
+
+        CMC_(PFX, _impl_link)(_map_, node, 0);
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _update_val)(struct SNAME *_map_, K key, V new_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 0, key, new_val);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    /* The mapping key -> new_val is already true */
+    if (_map_->f_val->cmp(new_val, node->value) != 0)
+    {
+        if (CMC_(PFX, _impl_get_node)(_map_, 1, key, new_val) != NULL)
+        {
+            _map_->flag = CMC_FLAG_DUPLICATE;
+            return false;
+        }
+
+        /* Only the tree sorted by values needs to change */
+        CMC_(PFX, _impl_unlink)(_map_, node, 1);
+
+        node->value = new_val;
+
+        CMC_(PFX, _impl_link)(_map_, node, 1);
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove_by_key)(struct SNAME *_map_, K key, K *out_key, V *out_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 0, key, (V){ 0 });
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_val)
+        *out_val = node->value;
+
+    CMC_(PFX, _impl_unlink)(_map_, node, 0);
+    CMC_(PFX, _impl_unlink)(_map_, node, 1);
+
+    _map_->alloc->free(node);
+
+    _map_->count--;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _remove_by_val)(struct SNAME *_map_, V val, K *out_key, V *out_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 1, (K){ 0 }, val);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = node->key;
+    if (out_val)
+        *out_val = node->value;
+
+    CMC_(PFX, _impl_unlink)(_map_, node, 0);
+    CMC_(PFX, _impl_unlink)(_map_, node, 1);
+
+    _map_->alloc->free(node);
+
+    _map_->count--;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min_by_key)(struct SNAME *_map_, K *key, V *val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_first_node)(_map_->root[0], 0);
+
+    if (key)
+        *key = node->key;
+    if (val)
+        *val = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max_by_key)(struct SNAME *_map_, K *key, V *val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_last_node)(_map_->root[0], 0);
+
+    if (key)
+        *key = node->key;
+    if (val)
+        *val = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min_by_val)(struct SNAME *_map_, K *key, V *val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_first_node)(_map_->root[1], 1);
+
+    if (key)
+        *key = node->key;
+    if (val)
+        *val = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _max_by_val)(struct SNAME *_map_, K *key, V *val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_last_node)(_map_->root[1], 1);
+
+    if (key)
+        *key = node->key;
+    if (val)
+        *val = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+K CMC_(PFX, _get_key)(struct SNAME *_map_, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 1, (K){ 0 }, val);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (K){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->key;
+}
+
+V CMC_(PFX, _get_val)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, 0, key, (V){ 0 });
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (V){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->value;
+}
+
+bool CMC_(PFX, _contains_key)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    bool result = CMC_(PFX, _impl_get_node)(_map_, 0, key, (V){ 0 }) != NULL;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _contains_val)(struct SNAME *_map_, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    bool result = CMC_(PFX, _impl_get_node)(_map_, 1, (K){ 0 }, val) != NULL;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->flag;
+}
+
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Callback will be added later */
+    struct SNAME *result = CMC_(PFX, _new_custom)(_map_->f_key, _map_->f_val, _map_->alloc, NULL);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first_node)(_map_->root[0], 0);
+
+    /* Nodes are visited in key order, so their values are the only ones */
+    /* that need to be searched for when linking them to the new map */
+    while (scan != NULL)
+    {
+        K key = _map_->f_key->cpy ? _map_->f_key->cpy(scan->key) : scan->key;
+        V value = _map_->f_val->cpy ? _map_->f_val->cpy(scan->value) : scan->value;
+
+        struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(result, key, value);
+
+        if (!node)
+        {
+            if (_map_->f_key->cpy && _map_->f_key->free)
+                _map_->f_key->free(key);
+            if (_map_->f_val->cpy && _map_->f_val->free)
+                _map_->f_val->free(value);
+
+            CMC_(PFX, _impl_free_nodes)(result, result->root[0], _map_->f_key->cpy != NULL,
+                                        _map_->f_val->cpy != NULL);
+
+            result->alloc->free(result);
+
+            _map_->flag = CMC_FLAG_ALLOC;
+            return NULL;
+        }
+
+        CMC_(PFX, _impl_link)(result, node, 0);
+        CMC_(PFX, _impl_link)(result, node, 1);
+
+        result->count++;
+
+        scan = CMC_(PFX, _impl_next_node)(scan, 0);
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_ASSIGN(result, _map_->callbacks);
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map1_->flag = CMC_FLAG_OK;
+    _map2_->flag = CMC_FLAG_OK;
+
+    if (_map1_->count != _map2_->count)
+        return false;
+
+    struct CMC_DEF_NODE(SNAME) *scan1 = CMC_(PFX, _impl_first_node)(_map1_->root[0], 0);
+    struct CMC_DEF_NODE(SNAME) *scan2 = CMC_(PFX, _impl_first_node)(_map2_->root[0], 0);
+
+    /* Keys are unique so both maps must have the same sequence of pairs */
+    while (scan1 != NULL && scan2 != NULL)
+    {
+        if (_map1_->f_key->cmp(scan1->key, scan2->key) != 0)
+            return false;
+
+        if (_map1_->f_val->cmp(scan1->value, scan2->value) != 0)
+            return false;
+
+        scan1 = CMC_(PFX, _impl_next_node)(scan1, 0);
+        scan2 = CMC_(PFX, _impl_next_node)(scan2, 0);
+    }
+
+    return scan1 == NULL && scan2 == NULL;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!node)
+        return NULL;
+
+    node->key = key;
+    node->value = value;
+
+    for (int d = 0; d < 2; d++)
+    {
+        node->height[d] = 0;
+        node->right[d] = NULL;
+        node->left[d] = NULL;
+        node->parent[d] = NULL;
+    }
+
+    return node;
+}
+
+/* Compares a node against a key (d == 0) or against a value (d == 1) */
+static int CMC_(PFX, _impl_cmp)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d, K key, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (d == 0)
+        return _map_->f_key->cmp(node->key, key);
+
+    return _map_->f_val->cmp(node->value, val);
+}
+
+/* Searches by key if d == 0 or by value if d == 1 */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, int d, K key, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root[d];
+
+    while (scan != NULL)
+    {
+        int c = CMC_(PFX, _impl_cmp)(_map_, scan, d, key, val);
+
+        if (c > 0)
+            scan = scan->left[d];
+        else if (c < 0)
+            scan = scan->right[d];
+        else
+            return scan;
+    }
+
+    return NULL;
+}
+
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->height[d];
+}
+
+static void CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    unsigned char h_l = CMC_(PFX, _impl_h)(node->left[d], d);
+    unsigned char h_r = CMC_(PFX, _impl_h)(node->right[d], d);
+
+    node->height[d] = 1 + (h_l > h_r ? h_l : h_r);
+}
+
+/* Puts new_node, which might be NULL, where old_node is in its parent */
+static void CMC_(PFX, _impl_replace)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * old_node,
+                                     struct CMC_DEF_NODE(SNAME) * new_node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *parent = old_node->parent[d];
+
+    if (parent == NULL)
+        _map_->root[d] = new_node;
+    else if (parent->left[d] == old_node)
+        parent->left[d] = new_node;
+    else
+        parent->right[d] = new_node;
+
+    if (new_node != NULL)
+        new_node->parent[d] = parent;
+}
+
+/* Returns the new root of the subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z,
+                                                                 int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *Y = Z->left[d];
+
+    Z->left[d] = Y->right[d];
+
+    if (Y->right[d] != NULL)
+        Y->right[d]->parent[d] = Z;
+
+    CMC_(PFX, _impl_replace)(_map_, Z, Y, d);
+
+    Y->right[d] = Z;
+    Z->parent[d] = Y;
+
+    CMC_(PFX, _impl_hupdate)(Z, d);
+    CMC_(PFX, _impl_hupdate)(Y, d);
+
+    return Y;
+}
+
+/* Returns the new root of the subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * Z,
+                                                                int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *Y = Z->right[d];
+
+    Z->right[d] = Y->left[d];
+
+    if (Y->left[d] != NULL)
+        Y->left[d]->parent[d] = Z;
+
+    CMC_(PFX, _impl_replace)(_map_, Z, Y, d);
+
+    Y->left[d] = Z;
+    Z->parent[d] = Y;
+
+    CMC_(PFX, _impl_hupdate)(Z, d);
+    CMC_(PFX, _impl_hupdate)(Y, d);
+
+    return Y;
+}
+
+/* Fixes heights and balance from node up to the root of one of the trees */
+static void CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL)
+    {
+        CMC_(PFX, _impl_hupdate)(node, d);
+
+        unsigned char h_l = CMC_(PFX, _impl_h)(node->left[d], d);
+        unsigned char h_r = CMC_(PFX, _impl_h)(node->right[d], d);
+
+        if (h_l > h_r + 1)
+        {
+            struct CMC_DEF_NODE(SNAME) *L = node->left[d];
+
+            if (CMC_(PFX, _impl_h)(L->left[d], d) < CMC_(PFX, _impl_h)(L->right[d], d))
+                CMC_(PFX, _impl_rotate_left)(_map_, L, d);
+
+            node = CMC_(PFX, _impl_rotate_right)(_map_, node, d);
+        }
+        else if (h_r > h_l + 1)
+        {
+            struct CMC_DEF_NODE(SNAME) *R = node->right[d];
+
+            if (CMC_(PFX, _impl_h)(R->right[d], d) < CMC_(PFX, _impl_h)(R->left[d], d))
+                CMC_(PFX, _impl_rotate_right)(_map_, R, d);
+
+            node = CMC_(PFX, _impl_rotate_left)(_map_, node, d);
+        }
+
+        node = node->parent[d];
+    }
+}
+
+/* Adds an unlinked node to one of the trees. The node must not be present */
+static void CMC_(PFX, _impl_link)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *parent = NULL, *scan = _map_->root[d];
+    int c = 0;
+
+    while (scan != NULL)
+    {
+        parent = scan;
+
+        c = CMC_(PFX, _impl_cmp)(_map_, scan, d, node->key, node->value);
+
+        if (c > 0)
+            scan = scan->left[d];
+        else
+            scan = scan->right[d];
+    }
+
+    node->height[d] = 1;
+    node->left[d] = NULL;
+    node->right[d] = NULL;
+    node->parent[d] = parent;
+
+    if (parent == NULL)
+        _map_->root[d] = node;
+    else if (c > 0)
+        parent->left[d] = node;
+    else
+        parent->right[d] = node;
+
+    if (parent != NULL)
+        CMC_(PFX, _impl_rebalance)(_map_, parent, d);
+}
+
+/* Takes a node out of one of the trees without touching the other one. */
+/* Nodes are never swapped by content since each of them is in two trees. */
+static void CMC_(PFX, _impl_unlink)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *unbalanced;
+
+    if (node->left[d] != NULL && node->right[d] != NULL)
+    {
+        /* The successor takes the place of node */
+        struct CMC_DEF_NODE(SNAME) *successor = CMC_(PFX, _impl_first_node)(node->right[d], d);
+
+        if (successor->parent[d] == node)
+            unbalanced = successor;
+        else
+        {
+            unbalanced = successor->parent[d];
+
+            CMC_(PFX, _impl_replace)(_map_, successor, successor->right[d], d);
+
+            successor->right[d] = node->right[d];
+            successor->right[d]->parent[d] = successor;
+        }
+
+        successor->left[d] = node->left[d];
+        successor->left[d]->parent[d] = successor;
+        successor->height[d] = node->height[d];
+
+        CMC_(PFX, _impl_replace)(_map_, node, successor, d);
+    }
+    else
+    {
+        unbalanced = node->parent[d];
+
+        CMC_(PFX, _impl_replace)(_map_, node, node->left[d] != NULL ? node->left[d] : node->right[d], d);
+    }
+
+    node->left[d] = NULL;
+    node->right[d] = NULL;
+    node->parent[d] = NULL;
+
+    CMC_(PFX, _impl_rebalance)(_map_, unbalanced, d);
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+    {
+        while (node->left[d] != NULL)
+            node = node->left[d];
+    }
+
+    return node;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_last_node)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+    {
+        while (node->right[d] != NULL)
+            node = node->right[d];
+    }
+
+    return node;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->right[d] != NULL)
+        return CMC_(PFX, _impl_first_node)(node->right[d], d);
+
+    while (node->parent[d] != NULL && node->parent[d]->right[d] == node)
+        node = node->parent[d];
+
+    return node->parent[d];
+}
+
+/* Frees every node by walking only the tree sorted by keys. Its left */
+/* subtrees are rotated to the right so no extra memory is needed. */
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, bool free_keys,
+                                        bool free_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL)
+    {
+        if (node->left[0] != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *left = node->left[0];
+
+            node->left[0] = left->right[0];
+            left->right[0] = node;
+            node = left;
+        }
+        else
+        {
+            struct CMC_DEF_NODE(SNAME) *right = node->right[0];
+
+            if (free_keys && _map_->f_key->free)
+                _map_->f_key->free(node->key);
+            if (free_values && _map_->f_val->free)
+                _map_->f_val->free(node->value);
+
+            _map_->alloc->free(node);
+
+            node = right;
+        }
+    }
+}
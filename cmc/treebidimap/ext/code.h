@@ -0,0 +1,484 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * INIT
+ *
+ * The part 'INIT' gives a new way of initializing a collection. The collection
+ * struct is not heap allocated, only its internal structure (nodes, buffers).
+ */
+#ifdef CMC_EXT_INIT
+
+#endif /* CMC_EXT_INIT */
+
+/**
+ * ITER
+ *
+ * Treebidimap bi-directional iterator.
+ */
+#ifdef CMC_EXT_ITER
+
+/* Implementation detail functions */
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_start)(struct SNAME *target, int d);
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_end)(struct SNAME *target, int d);
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node,
+                                                          int d);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, int d, K key, V val);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node, int d);
+
+/* Iterates over the mappings sorted by key */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_start)(target, 0);
+}
+
+/* Iterates over the mappings sorted by key */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_end)(target, 0);
+}
+
+/* Iterates over the mappings sorted by value */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start_by_val)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_start)(target, 1);
+}
+
+/* Iterates over the mappings sorted by value */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end_by_val)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_end)(target, 1);
+}
+
+/* Iterator sorted by key starting at the first key greater than or equal */
+/* to key or at the end of the iteration if there is no such key */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_lower_bound)(target, 0, key, (V){ 0 }), 0);
+}
+
+/* Iterator sorted by value starting at the first value greater than or */
+/* equal to val or at the end of the iteration if there is no such value */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound_by_val)(struct SNAME *target, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_lower_bound)(target, 1, (K){ 0 }, val), 1);
+}
+
+bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _empty)(iter->target) || iter->start;
+}
+
+bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _empty)(iter->target) || iter->end;
+}
+
+bool CMC_(PFX, _iter_to_start)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!CMC_(PFX, _empty)(iter->target))
+    {
+        iter->index = 0;
+        iter->start = true;
+        iter->end = false;
+        iter->cursor = iter->first;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool CMC_(PFX, _iter_to_end)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!CMC_(PFX, _empty)(iter->target))
+    {
+        iter->index = iter->target->count - 1;
+        iter->start = false;
+        iter->end = true;
+        iter->cursor = iter->last;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool CMC_(PFX, _iter_next)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->end)
+        return false;
+
+    if (iter->cursor == iter->last)
+    {
+        iter->end = true;
+        return false;
+    }
+
+    iter->start = CMC_(PFX, _empty)(iter->target);
+    iter->cursor = CMC_(PFX, _impl_next_node)(iter->cursor, iter->d);
+    iter->index++;
+
+    return true;
+}
+
+bool CMC_(PFX, _iter_prev)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->start)
+        return false;
+
+    if (iter->cursor == iter->first)
+    {
+        iter->start = true;
+        return false;
+    }
+
+    iter->end = CMC_(PFX, _empty)(iter->target);
+    iter->cursor = CMC_(PFX, _impl_prev_node)(iter->cursor, iter->d);
+    iter->index--;
+
+    return true;
+}
+
+/* Returns true only if the iterator moved */
+bool CMC_(PFX, _iter_advance)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->end)
+        return false;
+
+    if (iter->cursor == iter->last)
+    {
+        iter->end = true;
+        return false;
+    }
+
+    if (steps == 0 || iter->index + steps >= iter->target->count)
+        return false;
+
+    for (size_t i = 0; i < steps; i++)
+        CMC_(PFX, _iter_next)(iter);
+
+    return true;
+}
+
+/* Returns true only if the iterator moved */
+bool CMC_(PFX, _iter_rewind)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->start)
+        return false;
+
+    if (iter->cursor == iter->first)
+    {
+        iter->start = true;
+        return false;
+    }
+
+    if (steps == 0 || iter->index < steps)
+        return false;
+
+    for (size_t i = 0; i < steps; i++)
+        CMC_(PFX, _iter_prev)(iter);
+
+    return true;
+}
+
+/* Returns true only if the iterator was able to be positioned at the */
+/* given index */
+bool CMC_(PFX, _iter_go_to)(struct CMC_DEF_ITER(SNAME) * iter, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (index >= iter->target->count)
+        return false;
+
+    if (iter->index > index)
+        return CMC_(PFX, _iter_rewind)(iter, iter->index - index);
+    else if (iter->index < index)
+        return CMC_(PFX, _iter_advance)(iter, index - iter->index);
+
+    return true;
+}
+
+K CMC_(PFX, _iter_key)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(iter->target))
+        return (K){ 0 };
+
+    return iter->cursor->key;
+}
+
+V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(iter->target))
+        return (V){ 0 };
+
+    return iter->cursor->value;
+}
+
+size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return iter->index;
+}
+
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_start)(struct SNAME *target, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.d = d;
+    iter.first = CMC_(PFX, _impl_first_node)(target->root[d], d);
+    iter.last = CMC_(PFX, _impl_last_node)(target->root[d], d);
+    iter.cursor = iter.first;
+    iter.index = 0;
+    iter.start = true;
+    iter.end = CMC_(PFX, _empty)(target);
+
+    return iter;
+}
+
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_end)(struct SNAME *target, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.d = d;
+    iter.first = CMC_(PFX, _impl_first_node)(target->root[d], d);
+    iter.last = CMC_(PFX, _impl_last_node)(target->root[d], d);
+    iter.cursor = iter.last;
+    iter.index = 0;
+    iter.start = CMC_(PFX, _empty)(target);
+    iter.end = true;
+
+    if (!CMC_(PFX, _empty)(target))
+        iter.index = target->count - 1;
+
+    return iter;
+}
+
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node,
+                                                          int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return CMC_(PFX, _impl_iter_end)(target, d);
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _impl_iter_start)(target, d);
+
+    if (node == iter.first)
+        return iter;
+
+    iter.cursor = node;
+    iter.start = false;
+
+    /* Nodes don't keep the size of their subtrees so the index is found in O(n) */
+    for (struct CMC_DEF_NODE(SNAME) *scan = iter.first; scan != node; scan = CMC_(PFX, _impl_next_node)(scan, d))
+        iter.index++;
+
+    return iter;
+}
+
+/* First node greater than or equal to key (d == 0) or val (d == 1) */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, int d, K key, V val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root[d], *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (CMC_(PFX, _impl_cmp)(_map_, scan, d, key, val) >= 0)
+        {
+            result = scan;
+            scan = scan->left[d];
+        }
+        else
+            scan = scan->right[d];
+    }
+
+    return result;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node, int d)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->left[d] != NULL)
+        return CMC_(PFX, _impl_last_node)(node->left[d], d);
+
+    while (node->parent[d] != NULL && node->parent[d]->left[d] == node)
+        node = node->parent[d];
+
+    return node->parent[d];
+}
+
+#endif /* CMC_EXT_ITER */
+
+/**
+ * STR
+ *
+ * Print helper functions.
+ */
+#ifdef CMC_EXT_STR
+
+bool CMC_(PFX, _to_string)(struct SNAME *_map_, FILE *fptr)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *m_ = _map_;
+
+    return 0 <= fprintf(fptr,
+                        "struct %s<%s, %s> "
+                        "at %p { "
+                        "root:[%p, %p], "
+                        "count:%" PRIuMAX ", "
+                        "flag:%d, "
+                        "f_key:%p, "
+                        "f_val:%p, "
+                        "alloc:%p, "
+                        "callbacks:%p }",
+                        CMC_TO_STRING(SNAME), CMC_TO_STRING(K), CMC_TO_STRING(V), m_, m_->root[0], m_->root[1],
+                        (uintmax_t)m_->count, m_->flag, m_->f_key, m_->f_val, m_->alloc, CMC_CALLBACKS_GET(m_));
+}
+
+/* Prints the mappings sorted by key */
+bool CMC_(PFX, _print)(struct SNAME *_map_, FILE *fptr, const char *start, const char *separator, const char *end,
+                       const char *key_val_sep)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    fprintf(fptr, "%s", start);
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first_node)(_map_->root[0], 0);
+
+    while (scan != NULL)
+    {
+        if (!_map_->f_key->str(fptr, scan->key))
+            return false;
+
+        fprintf(fptr, "%s", key_val_sep);
+
+        if (!_map_->f_val->str(fptr, scan->value))
+            return false;
+
+        scan = CMC_(PFX, _impl_next_node)(scan, 0);
+
+        if (scan != NULL)
+            fprintf(fptr, "%s", separator);
+    }
+
+    fprintf(fptr, "%s", end);
+
+    return true;
+}
+
+#endif /* CMC_EXT_STR */
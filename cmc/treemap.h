@@ -52,6 +52,7 @@
  * V - treemap value data type
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
+ * AGG - subtree aggregate data type (optional)
  */
 
 /* Structs definition */
@@ -68,9 +69,10 @@
  *
  * INIT - Initializes the struct on the stack
  * ITER - treemap iterator
+ * RANK - Order statistics (rank, select and range counts)
  * STR - Print helper functions
  */
-#define CMC_EXT_TREEMAP_PARTS INIT, ITER, STR
+#define CMC_EXT_TREEMAP_PARTS INIT, ITER, RANK, STR
 /**/
 #include "cmc/treemap/ext/struct.h"
 /**/
@@ -27,9 +27,36 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map
 static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key);
 static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node);
 static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node);
-static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z);
-static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z);
-static void CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_augment)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * *Z);
+static void CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * *Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_map_, K key, int *c);
+static bool CMC_(PFX, _impl_hint_parent)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * hint, K key,
+                                         struct CMC_DEF_NODE(SNAME) * *parent, int *c);
+static bool CMC_(PFX, _impl_insert_at)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * parent, int c, K key, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, K key);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_join)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * left,
+                                                         struct CMC_DEF_NODE(SNAME) * node,
+                                                         struct CMC_DEF_NODE(SNAME) * right);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_merge)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * left,
+                                                          struct CMC_DEF_NODE(SNAME) * right);
+static void CMC_(PFX, _impl_split)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, K key,
+                                   struct CMC_DEF_NODE(SNAME) * *left, struct CMC_DEF_NODE(SNAME) * *right);
+static bool CMC_(PFX, _impl_build)(struct SNAME *_map_, K *keys, V *values, size_t count,
+                                   struct CMC_DEF_NODE(SNAME) * parent, struct CMC_DEF_NODE(SNAME) * *result);
+static void CMC_(PFX, _impl_free_node)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_link)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * nodes,
+                                                         size_t count, struct CMC_DEF_NODE(SNAME) * parent);
+static size_t CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                          bool free_elements);
+#ifdef CMC_EXT_RANK
+static size_t CMC_(PFX, _impl_s)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_map_, size_t index);
+static size_t CMC_(PFX, _impl_rank)(struct SNAME *_map_, K key);
+#endif
 
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -62,82 +89,68 @@ struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct
 
     _map_->count = 0;
     _map_->root = NULL;
+    _map_->finger = NULL;
+    _map_->block = NULL;
+    _map_->block_size = 0;
+    _map_->block_count = 0;
     _map_->flag = CMC_FLAG_OK;
     _map_->f_key = f_key;
     _map_->f_val = f_val;
     _map_->alloc = alloc;
+#ifdef AGG
+    _map_->f_agg = NULL;
+#endif
     CMC_CALLBACKS_ASSIGN(_map_, callbacks);
 
     return _map_;
 }
 
-void CMC_(PFX, _clear)(struct SNAME *_map_)
+/* Builds a perfectly balanced tree in O(n) from keys that must be in */
+/* strictly ascending order. Returns NULL if they are not or if an allocation */
+/* fails. */
+struct SNAME *CMC_(PFX, _from_sorted)(K *keys, V *values, size_t count, struct CMC_DEF_FKEY(SNAME) * f_key,
+                                      struct CMC_DEF_FVAL(SNAME) * f_val)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
-    struct CMC_DEF_NODE(SNAME) *up = NULL;
+    struct SNAME *_map_ = CMC_(PFX, _new)(f_key, f_val);
 
-    while (scan != NULL)
+    if (!_map_)
+        return NULL;
+
+    for (size_t i = 1; i < count; i++)
     {
-        if (scan->left != NULL)
+        if (_map_->f_key->cmp(keys[i - 1], keys[i]) >= 0)
         {
-            struct CMC_DEF_NODE(SNAME) *left = scan->left;
-
-            scan->left = up;
-            up = scan;
-            scan = left;
+            CMC_(PFX, _free)(_map_);
+            return NULL;
         }
-        else if (scan->right != NULL)
-        {
-            struct CMC_DEF_NODE(SNAME) *right = scan->right;
+    }
 
-            scan->left = up;
-            scan->right = NULL;
-            up = scan;
-            scan = right;
-        }
-        else
-        {
-            if (up == NULL)
-            {
-                if (_map_->f_key->free)
-                    _map_->f_key->free(scan->key);
-                if (_map_->f_val->free)
-                    _map_->f_val->free(scan->value);
+    if (!CMC_(PFX, _impl_build)(_map_, keys, values, count, NULL, &_map_->root))
+    {
+        CMC_(PFX, _free)(_map_);
+        return NULL;
+    }
 
-                _map_->alloc->free(scan);
-                scan = NULL;
-            }
+    _map_->count = count;
 
-            while (up != NULL)
-            {
-                if (_map_->f_key->free)
-                    _map_->f_key->free(scan->key);
-                if (_map_->f_val->free)
-                    _map_->f_val->free(scan->value);
+    return _map_;
+}
 
-                _map_->alloc->free(scan);
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
 
-                if (up->right != NULL)
-                {
-                    scan = up->right;
-                    up->right = NULL;
-                    break;
-                }
-                else
-                {
-                    scan = up;
-                    up = up->left;
-                }
-            }
-        }
-    }
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root, true);
 
     _map_->count = 0;
     _map_->root = NULL;
+    _map_->finger = NULL;
     _map_->flag = CMC_FLAG_OK;
 }
 
@@ -176,74 +189,14 @@ bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
     CMC_DEV_FCALL;
 #endif
 
-    if (CMC_(PFX, _empty)(_map_))
-    {
-        _map_->root = CMC_(PFX, _impl_new_node)(_map_, key, value);
-
-        if (!_map_->root)
-        {
-            _map_->flag = CMC_FLAG_ALLOC;
-            return false;
-        }
-    }
-    else
-    {
-        struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
-        struct CMC_DEF_NODE(SNAME) *parent = scan;
-
-        while (scan != NULL)
-        {
-            parent = scan;
-
-            if (_map_->f_key->cmp(scan->key, key) > 0)
-                scan = scan->left;
-            else if (_map_->f_key->cmp(scan->key, key) < 0)
-                scan = scan->right;
-            else
-            {
-                _map_->flag = CMC_FLAG_DUPLICATE;
-                return false;
-            }
-        }
-
-        struct CMC_DEF_NODE(SNAME) * node;
-
-        if (_map_->f_key->cmp(parent->key, key) > 0)
-        {
-            parent->left = CMC_(PFX, _impl_new_node)(_map_, key, value);
-
-            if (!parent->left)
-            {
-                _map_->flag = CMC_FLAG_ALLOC;
-                return false;
-            }
-
-            parent->left->parent = parent;
-            node = parent->left;
-        }
-        else
-        {
-            parent->right = CMC_(PFX, _impl_new_node)(_map_, key, value);
-
-            if (!parent->right)
-            {
-                _map_->flag = CMC_FLAG_ALLOC;
-                return false;
-            }
-
-            parent->right->parent = parent;
-            node = parent->right;
-        }
-
-        CMC_(PFX, _impl_rebalance)(_map_, node);
-    }
-
-    _map_->count++;
-    _map_->flag = CMC_FLAG_OK;
+    struct CMC_DEF_NODE(SNAME) *parent = NULL;
+    int c = 0;
 
-    CMC_CALLBACKS_CALL(_map_);
+    /* Inserting next to the previously inserted node avoids a full descent */
+    if (!_map_->finger || !CMC_(PFX, _impl_hint_parent)(_map_, _map_->finger, key, &parent, &c))
+        parent = CMC_(PFX, _impl_find_parent)(_map_, key, &c);
 
-    return true;
+    return CMC_(PFX, _impl_insert_at)(_map_, parent, c, key, value);
 }
 
 bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
@@ -265,6 +218,12 @@ bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
 
     node->value = new_value;
 
+#ifdef AGG
+    /* The aggregate of every ancestor depends on this value */
+    for (struct CMC_DEF_NODE(SNAME) *scan = node; scan != NULL; scan = scan->parent)
+        CMC_(PFX, _impl_augment)(_map_, scan);
+#endif
+
     _map_->flag = CMC_FLAG_OK;
 
     CMC_CALLBACKS_CALL(_map_);
@@ -299,6 +258,9 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
 
     bool is_root = node->parent == NULL;
 
+    /* The node holding the finger might be freed */
+    _map_->finger = NULL;
+
     if (node->left == NULL && node->right == NULL)
     {
         if (is_root)
@@ -313,7 +275,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
                 node->parent->left = NULL;
         }
 
-        _map_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_map_, node);
     }
     else if (node->left == NULL)
     {
@@ -334,7 +296,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
                 node->parent->left = node->right;
         }
 
-        _map_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_map_, node);
     }
     else if (node->right == NULL)
     {
@@ -355,7 +317,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
                 node->parent->left = node->left;
         }
 
-        _map_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_map_, node);
     }
     else
     {
@@ -394,14 +356,14 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
                 temp->parent->left = temp->left;
         }
 
-        _map_->alloc->free(temp);
+        CMC_(PFX, _impl_free_node)(_map_, temp);
 
         node->key = temp_key;
         node->value = temp_val;
     }
 
     if (unbalanced != NULL)
-        CMC_(PFX, _impl_rebalance)(_map_, unbalanced);
+        _map_->root = CMC_(PFX, _impl_rebalance)(_map_, unbalanced);
 
     if (_map_->count == 0)
         _map_->root = NULL;
@@ -414,6 +376,35 @@ bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
     return true;
 }
 
+size_t CMC_(PFX, _remove_range)(struct SNAME *_map_, K lower, K upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_map_) || _map_->f_key->cmp(lower, upper) >= 0)
+        return 0;
+
+    struct CMC_DEF_NODE(SNAME) *left = NULL, *middle = NULL, *right = NULL;
+
+    /* left < lower <= middle < upper <= right */
+    CMC_(PFX, _impl_split)(_map_, _map_->root, lower, &left, &right);
+    CMC_(PFX, _impl_split)(_map_, right, upper, &middle, &right);
+
+    size_t removed = CMC_(PFX, _impl_free_nodes)(_map_, middle, true);
+
+    _map_->finger = NULL;
+
+    _map_->root = CMC_(PFX, _impl_merge)(_map_, left, right);
+    _map_->count -= removed;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return removed;
+}
+
 bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
 {
 #ifdef CMC_DEV
@@ -472,6 +463,111 @@ bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
     return true;
 }
 
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) <= 0)
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = result->key;
+    if (out_value)
+        *out_value = result->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *result = CMC_(PFX, _impl_lower_bound)(_map_, key);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = result->key;
+    if (out_value)
+        *out_value = result->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+size_t CMC_(PFX, _range)(struct SNAME *_map_, K lower, K upper, bool (*visitor)(K, V, void *), void *args)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    if (_map_->f_key->cmp(lower, upper) >= 0)
+        return 0;
+
+    size_t visited = 0;
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_lower_bound)(_map_, lower);
+
+    while (scan != NULL && _map_->f_key->cmp(scan->key, upper) < 0)
+    {
+        visited++;
+
+        if (!visitor(scan->key, scan->value, args))
+            break;
+
+        scan = CMC_(PFX, _impl_next_node)(scan);
+    }
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return visited;
+}
+
 V CMC_(PFX, _get)(struct SNAME *_map_, K key)
 {
 #ifdef CMC_DEV
@@ -581,6 +677,10 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
         return NULL;
     }
 
+#ifdef AGG
+    result->f_agg = _map_->f_agg;
+#endif
+
     struct CMC_DEF_NODE(SNAME) *root = _map_->root;
 
     bool left_done = false;
@@ -636,6 +736,55 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
     return result;
 }
 
+/* Moves every node into a single contiguous block laid out in order, which */
+/* makes iteration cache friendly. The tree is rebuilt perfectly balanced. */
+/* Iterators and the previous node addresses are invalidated. */
+bool CMC_(PFX, _compact)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *nodes = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)) * _map_->count);
+
+    if (!nodes)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan->left != NULL)
+        scan = scan->left;
+
+    for (size_t i = 0; scan != NULL; scan = CMC_(PFX, _impl_next_node)(scan), i++)
+    {
+        nodes[i].key = scan->key;
+        nodes[i].value = scan->value;
+    }
+
+    /* Might also release a block from a previous compaction */
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root, false);
+
+    _map_->block = nodes;
+    _map_->block_size = _map_->count;
+    _map_->block_count = _map_->count;
+    _map_->root = CMC_(PFX, _impl_link)(_map_, nodes, _map_->count, NULL);
+    _map_->finger = NULL;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
 bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
 {
 #ifdef CMC_DEV
@@ -709,7 +858,9 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map
     node->right = NULL;
     node->left = NULL;
     node->parent = NULL;
-    node->height = 0;
+    node->height = 1;
+
+    CMC_(PFX, _impl_augment)(_map_, node);
 
     return node;
 }
@@ -724,9 +875,11 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map
 
     while (scan != NULL)
     {
-        if (_map_->f_key->cmp(scan->key, key) > 0)
+        int c = _map_->f_key->cmp(scan->key, key);
+
+        if (c > 0)
             scan = scan->left;
-        else if (_map_->f_key->cmp(scan->key, key) < 0)
+        else if (c < 0)
             scan = scan->right;
         else
             return scan;
@@ -762,7 +915,7 @@ static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node)
     return 1 + (h_l > h_r ? h_l : h_r);
 }
 
-static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
+static void CMC_(PFX, _impl_rotate_right)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * *Z)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
@@ -792,10 +945,13 @@ static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
     root->height = CMC_(PFX, _impl_hupdate)(root);
     new_root->height = CMC_(PFX, _impl_hupdate)(new_root);
 
+    CMC_(PFX, _impl_augment)(_map_, root);
+    CMC_(PFX, _impl_augment)(_map_, new_root);
+
     *Z = new_root;
 }
 
-static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
+static void CMC_(PFX, _impl_rotate_left)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * *Z)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
@@ -825,26 +981,26 @@ static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
     root->height = CMC_(PFX, _impl_hupdate)(root);
     new_root->height = CMC_(PFX, _impl_hupdate)(new_root);
 
+    CMC_(PFX, _impl_augment)(_map_, root);
+    CMC_(PFX, _impl_augment)(_map_, new_root);
+
     *Z = new_root;
 }
 
-static void CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL;
+    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL, *top = node;
 
     int balance;
-    bool is_root = false;
 
     while (scan != NULL)
     {
-        if (scan->parent == NULL)
-            is_root = true;
-
         scan->height = CMC_(PFX, _impl_hupdate)(scan);
+        CMC_(PFX, _impl_augment)(_map_, scan);
         balance = CMC_(PFX, _impl_h)(scan->right) - CMC_(PFX, _impl_h)(scan->left);
 
         if (balance >= 2)
@@ -852,26 +1008,645 @@ static void CMC_(PFX, _impl_rebalance)(struct SNAME *_map_, struct CMC_DEF_NODE(
             child = scan->right;
 
             if (CMC_(PFX, _impl_h)(child->right) < CMC_(PFX, _impl_h)(child->left))
-                CMC_(PFX, _impl_rotate_right)(&(scan->right));
+                CMC_(PFX, _impl_rotate_right)(_map_, &(scan->right));
 
-            CMC_(PFX, _impl_rotate_left)(&scan);
+            CMC_(PFX, _impl_rotate_left)(_map_, &scan);
         }
         else if (balance <= -2)
         {
             child = scan->left;
 
             if (CMC_(PFX, _impl_h)(child->left) < CMC_(PFX, _impl_h)(child->right))
-                CMC_(PFX, _impl_rotate_left)(&(scan->left));
-
-            CMC_(PFX, _impl_rotate_right)(&scan);
-        }
+                CMC_(PFX, _impl_rotate_left)(_map_, &(scan->left));
 
-        if (is_root)
-        {
-            _map_->root = scan;
-            is_root = false;
+            CMC_(PFX, _impl_rotate_right)(_map_, &scan);
         }
 
+        top = scan;
         scan = scan->parent;
     }
+
+    /* The root of the whole tree (or subtree) */
+    return top;
+}
+
+/* Recomputes the augmented data of a node from its children */
+static void CMC_(PFX, _impl_augment)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_UNUSED_PARAM(_map_);
+    CMC_UNUSED_PARAM(node);
+
+#ifdef CMC_EXT_RANK
+    node->size = 1 + CMC_(PFX, _impl_s)(node->left) + CMC_(PFX, _impl_s)(node->right);
+#endif
+
+#ifdef AGG
+    if (_map_->f_agg)
+    {
+        AGG agg = _map_->f_agg->lift(node->key, node->value);
+
+        if (node->left)
+            agg = _map_->f_agg->combine(node->left->agg, agg);
+        if (node->right)
+            agg = _map_->f_agg->combine(agg, node->right->agg);
+
+        node->agg = agg;
+    }
+#endif
+}
+
+#ifdef CMC_EXT_RANK
+
+static size_t CMC_(PFX, _impl_s)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->size;
+}
+
+/* Finds the node at the given in-order index in O(log n) */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_map_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan != NULL)
+    {
+        size_t left_size = CMC_(PFX, _impl_s)(scan->left);
+
+        if (index < left_size)
+            scan = scan->left;
+        else if (index > left_size)
+        {
+            index -= left_size + 1;
+            scan = scan->right;
+        }
+        else
+            return scan;
+    }
+
+    return NULL;
+}
+
+/* Counts how many elements are strictly less than the given one */
+static size_t CMC_(PFX, _impl_rank)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    size_t rank = 0;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) < 0)
+        {
+            rank += CMC_(PFX, _impl_s)(scan->left) + 1;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    return rank;
+}
+
+#endif /* CMC_EXT_RANK */
+
+/* In-order successor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->right != NULL)
+    {
+        node = node->right;
+
+        while (node->left != NULL)
+            node = node->left;
+
+        return node;
+    }
+
+    while (node->parent != NULL && node->parent->right == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* In-order predecessor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->left != NULL)
+    {
+        node = node->left;
+
+        while (node->right != NULL)
+            node = node->right;
+
+        return node;
+    }
+
+    while (node->parent != NULL && node->parent->left == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* Descends from the root doing a single three-way comparison per level. */
+/* Returns the node to which key would be attached (NULL if the tree is */
+/* empty) and sets c to the comparison of that node against key; if c is */
+/* 0 the key is already present at the returned node. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_map_, K key, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *parent = NULL;
+
+    *c = 0;
+
+    while (scan != NULL)
+    {
+        parent = scan;
+        *c = _map_->f_key->cmp(scan->key, key);
+
+        if (*c > 0)
+            scan = scan->left;
+        else if (*c < 0)
+            scan = scan->right;
+        else
+            break;
+    }
+
+    return parent;
+}
+
+/* Same as _impl_find_parent but only looks at hint and its in-order */
+/* neighbour, costing at most two comparisons. Returns false if key does */
+/* not belong right next to hint. */
+static bool CMC_(PFX, _impl_hint_parent)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * hint, K key,
+                                         struct CMC_DEF_NODE(SNAME) * *parent, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c_hint = _map_->f_key->cmp(hint->key, key);
+
+    if (c_hint == 0)
+    {
+        *parent = hint;
+        *c = 0;
+        return true;
+    }
+
+    if (c_hint < 0)
+    {
+        /* Must be between hint and its successor */
+        struct CMC_DEF_NODE(SNAME) *next = CMC_(PFX, _impl_next_node)(hint);
+
+        int c_next = next ? _map_->f_key->cmp(next->key, key) : 1;
+
+        if (c_next < 0)
+            return false;
+
+        /* If hint has a right subtree then next is its leftmost node */
+        if (c_next == 0 || hint->right != NULL)
+        {
+            *parent = next;
+            *c = c_next;
+        }
+        else
+        {
+            *parent = hint;
+            *c = c_hint;
+        }
+    }
+    else
+    {
+        /* Must be between the predecessor of hint and hint */
+        struct CMC_DEF_NODE(SNAME) *prev = CMC_(PFX, _impl_prev_node)(hint);
+
+        int c_prev = prev ? _map_->f_key->cmp(prev->key, key) : -1;
+
+        if (c_prev > 0)
+            return false;
+
+        /* If hint has a left subtree then prev is its rightmost node */
+        if (c_prev == 0 || hint->left != NULL)
+        {
+            *parent = prev;
+            *c = c_prev;
+        }
+        else
+        {
+            *parent = hint;
+            *c = c_hint;
+        }
+    }
+
+    return true;
+}
+
+/* Attaches a new node to parent (found by _impl_find_parent or */
+/* _impl_hint_parent) and rebalances the tree */
+static bool CMC_(PFX, _impl_insert_at)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * parent, int c, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (parent != NULL && c == 0)
+    {
+        _map_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_map_, key, value);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    if (parent == NULL)
+        _map_->root = node;
+    else
+    {
+        node->parent = parent;
+
+        if (c > 0)
+            parent->left = node;
+        else
+            parent->right = node;
+
+        _map_->root = CMC_(PFX, _impl_rebalance)(_map_, node);
+    }
+
+    _map_->finger = node;
+    _map_->count++;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* First node that is greater than or equal to the given key */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) >= 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    return result;
+}
+
+/* Joins two detached trees using node as the pivot, where every element of */
+/* left is less than node and every element of right is greater than node. */
+/* Runs in O(|h(left) - h(right)|) and returns the root of the new tree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_join)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * left,
+                                                         struct CMC_DEF_NODE(SNAME) * node,
+                                                         struct CMC_DEF_NODE(SNAME) * right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int h_l = CMC_(PFX, _impl_h)(left);
+    int h_r = CMC_(PFX, _impl_h)(right);
+
+    struct CMC_DEF_NODE(SNAME) *scan = NULL;
+
+    if (h_l > h_r + 1)
+    {
+        /* Attach node and right somewhere along the right spine of left */
+        scan = left;
+
+        while (CMC_(PFX, _impl_h)(scan->right) > h_r + 1)
+            scan = scan->right;
+
+        node->left = scan->right;
+        node->right = right;
+        scan->right = node;
+    }
+    else if (h_r > h_l + 1)
+    {
+        /* Attach left and node somewhere along the left spine of right */
+        scan = right;
+
+        while (CMC_(PFX, _impl_h)(scan->left) > h_l + 1)
+            scan = scan->left;
+
+        node->left = left;
+        node->right = scan->left;
+        scan->left = node;
+    }
+    else
+    {
+        node->left = left;
+        node->right = right;
+    }
+
+    node->parent = scan;
+
+    if (node->left)
+        node->left->parent = node;
+    if (node->right)
+        node->right->parent = node;
+
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+    CMC_(PFX, _impl_augment)(_map_, node);
+
+    if (scan == NULL)
+        return node;
+
+    return CMC_(PFX, _impl_rebalance)(_map_, scan);
+}
+
+/* Joins two detached trees where every element of left is less than every */
+/* element of right. Returns the root of the new tree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_merge)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * left,
+                                                          struct CMC_DEF_NODE(SNAME) * right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (left == NULL)
+        return right;
+    if (right == NULL)
+        return left;
+
+    /* Detach the minimum of right and use it as the pivot */
+    struct CMC_DEF_NODE(SNAME) *pivot = right;
+
+    while (pivot->left != NULL)
+        pivot = pivot->left;
+
+    if (pivot->parent != NULL)
+    {
+        pivot->parent->left = pivot->right;
+
+        if (pivot->right)
+            pivot->right->parent = pivot->parent;
+
+        right = CMC_(PFX, _impl_rebalance)(_map_, pivot->parent);
+    }
+    else
+    {
+        right = pivot->right;
+
+        if (right)
+            right->parent = NULL;
+    }
+
+    pivot->left = NULL;
+    pivot->right = NULL;
+    pivot->parent = NULL;
+
+    return CMC_(PFX, _impl_join)(_map_, left, pivot, right);
+}
+
+/* Splits a detached tree into two: one with every element less than the */
+/* given key and the other with every element greater than or equal to it */
+static void CMC_(PFX, _impl_split)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, K key,
+                                   struct CMC_DEF_NODE(SNAME) * *left, struct CMC_DEF_NODE(SNAME) * *right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node_l = node->left;
+    struct CMC_DEF_NODE(SNAME) *node_r = node->right;
+
+    if (node_l)
+        node_l->parent = NULL;
+    if (node_r)
+        node_r->parent = NULL;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = NULL;
+
+    struct CMC_DEF_NODE(SNAME) *middle = NULL;
+
+    if (_map_->f_key->cmp(node->key, key) < 0)
+    {
+        CMC_(PFX, _impl_split)(_map_, node_r, key, &middle, right);
+        *left = CMC_(PFX, _impl_join)(_map_, node_l, node, middle);
+    }
+    else
+    {
+        CMC_(PFX, _impl_split)(_map_, node_l, key, left, &middle);
+        *right = CMC_(PFX, _impl_join)(_map_, middle, node, node_r);
+    }
+}
+
+/* Builds a balanced tree out of sorted key-value pairs by always taking the middle */
+/* element as the root. No comparisons or rotations are needed. If an */
+/* allocation fails every node allocated so far is freed. */
+static bool CMC_(PFX, _impl_build)(struct SNAME *_map_, K *keys, V *values, size_t count,
+                                   struct CMC_DEF_NODE(SNAME) * parent, struct CMC_DEF_NODE(SNAME) * *result)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    *result = NULL;
+
+    if (count == 0)
+        return true;
+
+    size_t mid = count / 2;
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_map_, keys[mid], values[mid]);
+
+    if (!node)
+        return false;
+
+    node->parent = parent;
+
+    if (!CMC_(PFX, _impl_build)(_map_, keys, values, mid, node, &node->left) ||
+        !CMC_(PFX, _impl_build)(_map_, keys + mid + 1, values + mid + 1, count - mid - 1, node, &node->right))
+    {
+        CMC_(PFX, _impl_free_nodes)(_map_, node, false);
+        return false;
+    }
+
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+    CMC_(PFX, _impl_augment)(_map_, node);
+
+    *result = node;
+
+    return true;
+}
+
+/* Frees a single node. Nodes that live in the block allocated by _compact */
+/* are not freed individually; the whole block is freed once all of them are */
+/* released. */
+static void CMC_(PFX, _impl_free_node)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    uintptr_t address = (uintptr_t)node;
+    uintptr_t start = (uintptr_t)_map_->block;
+
+    if (_map_->block && address >= start &&
+        address < start + _map_->block_size * sizeof(struct CMC_DEF_NODE(SNAME)))
+    {
+        if (--_map_->block_count == 0)
+        {
+            _map_->alloc->free(_map_->block);
+            _map_->block = NULL;
+            _map_->block_size = 0;
+        }
+    }
+    else
+        _map_->alloc->free(node);
+}
+
+/* Links an array of nodes as a perfectly balanced tree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_link)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * nodes,
+                                                         size_t count, struct CMC_DEF_NODE(SNAME) * parent)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (count == 0)
+        return NULL;
+
+    size_t mid = count / 2;
+
+    struct CMC_DEF_NODE(SNAME) *node = &nodes[mid];
+
+    node->parent = parent;
+    node->left = CMC_(PFX, _impl_link)(_map_, nodes, mid, node);
+    node->right = CMC_(PFX, _impl_link)(_map_, nodes + mid + 1, count - mid - 1, node);
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+
+    CMC_(PFX, _impl_augment)(_map_, node);
+
+    return node;
+}
+
+/* Frees every node of a detached tree, returning how many were freed. The */
+/* elements themselves are only freed if free_elements is true. */
+static size_t CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node,
+                                          bool free_elements)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t count = 0;
+
+    struct CMC_DEF_NODE(SNAME) *scan = node;
+    struct CMC_DEF_NODE(SNAME) *up = NULL;
+
+    while (scan != NULL)
+    {
+        if (scan->left != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *left = scan->left;
+
+            scan->left = up;
+            up = scan;
+            scan = left;
+        }
+        else if (scan->right != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *right = scan->right;
+
+            scan->left = up;
+            scan->right = NULL;
+            up = scan;
+            scan = right;
+        }
+        else
+        {
+            if (up == NULL)
+            {
+                if (free_elements && _map_->f_key->free)
+                    _map_->f_key->free(scan->key);
+                if (free_elements && _map_->f_val->free)
+                    _map_->f_val->free(scan->value);
+
+                CMC_(PFX, _impl_free_node)(_map_, scan);
+                count++;
+                scan = NULL;
+            }
+
+            while (up != NULL)
+            {
+                if (free_elements && _map_->f_key->free)
+                    _map_->f_key->free(scan->key);
+                if (free_elements && _map_->f_val->free)
+                    _map_->f_val->free(scan->value);
+
+                CMC_(PFX, _impl_free_node)(_map_, scan);
+                count++;
+
+                if (up->right != NULL)
+                {
+                    scan = up->right;
+                    up->right = NULL;
+                    break;
+                }
+                else
+                {
+                    scan = up;
+                    up = up->left;
+                }
+            }
+        }
+    }
+
+    return count;
 }
@@ -39,6 +39,10 @@
  */
 #ifdef CMC_EXT_ITER
 
+/* Implementation detail functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_upper_bound)(struct SNAME *_map_, K key);
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node);
+
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
 {
 #ifdef CMC_DEV
@@ -103,6 +107,81 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
     return iter;
 }
 
+/* First node that is strictly greater than the given key */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_upper_bound)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) > 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    return result;
+}
+
+/* Positions an iterator at the given node, which must belong to target */
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return CMC_(PFX, _iter_end)(target);
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(target);
+
+    if (node == iter.first)
+        return iter;
+
+    iter.cursor = node;
+    iter.start = false;
+    iter.end = false;
+
+#ifdef CMC_EXT_RANK
+    iter.index = CMC_(PFX, _impl_rank)(target, node->key);
+#else
+    /* Without the RANK part the index can only be found in O(n) */
+    for (struct CMC_DEF_NODE(SNAME) *scan = iter.first; scan != node; scan = CMC_(PFX, _impl_next_node)(scan))
+        iter.index++;
+#endif
+
+    return iter;
+}
+
+/* Iterator starting at the first element greater than or equal to key or */
+/* at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_lower_bound)(target, key));
+}
+
+/* Iterator starting at the first element strictly greater than key or */
+/* at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_upper_bound)(target, key));
+}
+
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter)
 {
 #ifdef CMC_DEV
@@ -266,8 +345,14 @@ bool CMC_(PFX, _iter_advance)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
     if (steps == 0 || iter->index + steps >= iter->target->count)
         return false;
 
+#ifdef CMC_EXT_RANK
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index + steps);
+    iter->index += steps;
+    iter->start = false;
+#else
     for (size_t i = 0; i < steps; i++)
         CMC_(PFX, _iter_next)(iter);
+#endif
 
     return true;
 }
@@ -291,8 +376,14 @@ bool CMC_(PFX, _iter_rewind)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
     if (steps == 0 || iter->index < steps)
         return false;
 
+#ifdef CMC_EXT_RANK
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index - steps);
+    iter->index -= steps;
+    iter->end = false;
+#else
     for (size_t i = 0; i < steps; i++)
         CMC_(PFX, _iter_prev)(iter);
+#endif
 
     return true;
 }
@@ -361,8 +452,263 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
     return iter->index;
 }
 
+/* Inserts an element using the iterator's current position as a starting */
+/* point. If the element belongs right next to it this takes at most two */
+/* comparisons, otherwise it falls back to a regular insertion. The iterator */
+/* must be reset after a successful insertion. */
+bool CMC_(PFX, _insert_hint)(struct SNAME *_map_, struct CMC_DEF_ITER(SNAME) * iter, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *parent = NULL;
+    int c = 0;
+
+    if (iter->target != _map_ || !iter->cursor ||
+        !CMC_(PFX, _impl_hint_parent)(_map_, iter->cursor, key, &parent, &c))
+        parent = CMC_(PFX, _impl_find_parent)(_map_, key, &c);
+
+    return CMC_(PFX, _impl_insert_at)(_map_, parent, c, key, value);
+}
+
 #endif /* CMC_EXT_ITER */
 
+/**
+ * RANK
+ *
+ * Order statistics. Every node keeps the size of its subtree, allowing
+ * elements to be accessed by their sorted position in O(log n).
+ */
+#ifdef CMC_EXT_RANK
+
+/* Returns how many elements are strictly less than the given one */
+size_t CMC_(PFX, _rank)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t rank = CMC_(PFX, _impl_rank)(_map_, key);
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return rank;
+}
+
+/* Retrieves the element at the given position of the sorted sequence */
+bool CMC_(PFX, _select)(struct SNAME *_map_, size_t index, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    if (index >= _map_->count)
+    {
+        _map_->flag = CMC_FLAG_RANGE;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_select_node)(_map_, index);
+
+    if (key)
+        *key = node->key;
+    if (value)
+        *value = node->value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Counts the elements in the range [lower, upper) */
+size_t CMC_(PFX, _count_range)(struct SNAME *_map_, K lower, K upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t result = 0;
+
+    if (_map_->f_key->cmp(lower, upper) < 0)
+        result = CMC_(PFX, _impl_rank)(_map_, upper) - CMC_(PFX, _impl_rank)(_map_, lower);
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+#endif /* CMC_EXT_RANK */
+
+/**
+ * AGG
+ *
+ * User defined subtree aggregates. Available when the AGG data type is
+ * defined. Every node keeps the aggregate of its subtree, computed through the
+ * aggregate function table, allowing range aggregates in O(log n).
+ */
+#ifdef AGG
+
+/* Sets the aggregate function table and recomputes every node in O(n) */
+/* Passing NULL disables the maintenance of aggregates */
+void CMC_(PFX, _aggregate_with)(struct SNAME *_map_, struct CMC_DEF_FAGG(SNAME) * f_agg)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->f_agg = f_agg;
+    _map_->flag = CMC_FLAG_OK;
+
+    if (!f_agg)
+        return;
+
+    /* Post-order traversal so that children are updated before parents */
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+    struct CMC_DEF_NODE(SNAME) *prev = NULL;
+
+    while (scan != NULL)
+    {
+        if (prev == scan->parent)
+        {
+            prev = scan;
+
+            if (scan->left)
+            {
+                scan = scan->left;
+                continue;
+            }
+            else if (scan->right)
+            {
+                scan = scan->right;
+                continue;
+            }
+        }
+        else if (prev == scan->left && scan->right)
+        {
+            prev = scan;
+            scan = scan->right;
+            continue;
+        }
+
+        CMC_(PFX, _impl_augment)(_map_, scan);
+
+        prev = scan;
+        scan = scan->parent;
+    }
+}
+
+/* Returns the aggregate of every element */
+AGG CMC_(PFX, _aggregate)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!_map_->f_agg)
+    {
+        _map_->flag = CMC_FLAG_FTABLE;
+        return (AGG){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    if (CMC_(PFX, _empty)(_map_))
+        return _map_->f_agg->identity;
+
+    return _map_->root->agg;
+}
+
+/* Returns the aggregate of every element in the range [lower, upper) */
+AGG CMC_(PFX, _aggregate_range)(struct SNAME *_map_, K lower, K upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_FAGG(SNAME) *f_agg = _map_->f_agg;
+
+    if (!f_agg)
+    {
+        _map_->flag = CMC_FLAG_FTABLE;
+        return (AGG){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    /* Find the topmost node that is inside the range */
+    struct CMC_DEF_NODE(SNAME) *split = _map_->root;
+
+    while (split != NULL)
+    {
+        if (_map_->f_key->cmp(split->key, lower) < 0)
+            split = split->right;
+        else if (_map_->f_key->cmp(split->key, upper) >= 0)
+            split = split->left;
+        else
+            break;
+    }
+
+    if (!split)
+        return f_agg->identity;
+
+    /* Elements greater than or equal to lower in the left subtree */
+    AGG left = f_agg->identity;
+
+    for (struct CMC_DEF_NODE(SNAME) *scan = split->left; scan != NULL;)
+    {
+        if (_map_->f_key->cmp(scan->key, lower) >= 0)
+        {
+            AGG agg = _map_->f_agg->lift(scan->key, scan->value);
+
+            if (scan->right)
+                agg = f_agg->combine(agg, scan->right->agg);
+
+            left = f_agg->combine(agg, left);
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    /* Elements less than upper in the right subtree */
+    AGG right = f_agg->identity;
+
+    for (struct CMC_DEF_NODE(SNAME) *scan = split->right; scan != NULL;)
+    {
+        if (_map_->f_key->cmp(scan->key, upper) < 0)
+        {
+            if (scan->left)
+                right = f_agg->combine(right, scan->left->agg);
+
+            right = f_agg->combine(right, _map_->f_agg->lift(scan->key, scan->value));
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    return f_agg->combine(f_agg->combine(left, _map_->f_agg->lift(split->key, split->value)), right);
+}
+
+#endif /* AGG */
+
 /**
  * STR
  *
@@ -61,6 +61,8 @@ struct CMC_DEF_ITER(SNAME)
 /* Iterator Initialization */
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target);
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, K key);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, K key);
 /* Iterator State */
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter);
 bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter);
@@ -77,9 +79,40 @@ K CMC_(PFX, _iter_key)(struct CMC_DEF_ITER(SNAME) * iter);
 V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter);
 V *CMC_(PFX, _iter_rvalue)(struct CMC_DEF_ITER(SNAME) * iter);
 size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter);
+/* Hinted Insertion */
+bool CMC_(PFX, _insert_hint)(struct SNAME *_map_, struct CMC_DEF_ITER(SNAME) * iter, K key, V value);
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * RANK
+ *
+ * Order statistics. Every node keeps the size of its subtree, allowing
+ * elements to be accessed by their sorted position in O(log n).
+ */
+#ifdef CMC_EXT_RANK
+
+size_t CMC_(PFX, _rank)(struct SNAME *_map_, K key);
+bool CMC_(PFX, _select)(struct SNAME *_map_, size_t index, K *key, V *value);
+size_t CMC_(PFX, _count_range)(struct SNAME *_map_, K lower, K upper);
+
+#endif /* CMC_EXT_RANK */
+
+/**
+ * AGG
+ *
+ * User defined subtree aggregates. Available when the AGG data type is
+ * defined. Every node keeps the aggregate of its subtree, computed through the
+ * aggregate function table, allowing range aggregates in O(log n).
+ */
+#ifdef AGG
+
+void CMC_(PFX, _aggregate_with)(struct SNAME *_map_, struct CMC_DEF_FAGG(SNAME) * f_agg);
+AGG CMC_(PFX, _aggregate)(struct SNAME *_map_);
+AGG CMC_(PFX, _aggregate_range)(struct SNAME *_map_, K lower, K upper);
+
+#endif /* AGG */
+
 /**
  * STR
  *
@@ -56,11 +56,26 @@ struct CMC_DEF_FVAL(SNAME)
     CMC_DEF_FTAB_PRI(V);
 };
 
+#ifdef AGG
+/* Aggregate struct function table */
+struct CMC_DEF_FAGG(SNAME)
+{
+    /* Maps a single key-value pair to an aggregate */
+    AGG (*lift)(K, V);
+    /* Combines two aggregates (must be associative) */
+    AGG (*combine)(AGG, AGG);
+    /* Identity element of combine */
+    AGG identity;
+};
+#endif
+
 /* Collection Functions */
 /* Collection Allocation and Deallocation */
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val);
 struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
                                      CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks);
+struct SNAME *CMC_(PFX, _from_sorted)(K *keys, V *values, size_t count, struct CMC_DEF_FKEY(SNAME) * f_key,
+                                      struct CMC_DEF_FVAL(SNAME) * f_val);
 void CMC_(PFX, _clear)(struct SNAME *_map_);
 void CMC_(PFX, _free)(struct SNAME *_map_);
 /* Customization of Allocation and Callbacks */
@@ -69,9 +84,13 @@ void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBA
 bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value);
 bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value);
 bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value);
+size_t CMC_(PFX, _remove_range)(struct SNAME *_map_, K lower, K upper);
 /* Element Access */
 bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value);
 bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value);
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value);
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value);
+size_t CMC_(PFX, _range)(struct SNAME *_map_, K lower, K upper, bool (*visitor)(K, V, void *), void *args);
 V CMC_(PFX, _get)(struct SNAME *_map_, K key);
 V *CMC_(PFX, _get_ref)(struct SNAME *_map_, K key);
 /* Collection State */
@@ -80,5 +99,6 @@ bool CMC_(PFX, _empty)(struct SNAME *_map_);
 size_t CMC_(PFX, _count)(struct SNAME *_map_);
 int CMC_(PFX, _flag)(struct SNAME *_map_);
 /* Collection Utility */
+bool CMC_(PFX, _compact)(struct SNAME *_map_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_);
 bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_);
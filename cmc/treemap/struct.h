@@ -28,6 +28,9 @@ struct SNAME
     /* Root node */
     struct CMC_DEF_NODE(SNAME) * root;
 
+    /* Last inserted node, used as a starting point for the next insertion */
+    struct CMC_DEF_NODE(SNAME) * finger;
+
     /* Current amount of keys */
     size_t count;
 
@@ -40,6 +43,18 @@ struct SNAME
     /* Value function table */
     struct CMC_DEF_FVAL(SNAME) * f_val;
 
+#ifdef AGG
+    /* Aggregate function table (optional) */
+    struct CMC_DEF_FAGG(SNAME) * f_agg;
+#endif
+
+    /* Nodes allocated in a single block by _compact (optional) */
+    struct CMC_DEF_NODE(SNAME) * block;
+
+    /* Capacity of block and how many of its nodes are still in use */
+    size_t block_size;
+    size_t block_count;
+
     /* Custom allocation functions */
     CMC_ALLOC_TYPE alloc;
 
@@ -59,6 +74,16 @@ struct CMC_DEF_NODE(SNAME)
     /* Node height used by the AVL tree to keep it strictly balanced */
     unsigned char height;
 
+#ifdef CMC_EXT_RANK
+    /* Amount of nodes in the subtree rooted at this node */
+    size_t size;
+#endif
+
+#ifdef AGG
+    /* Aggregate of every element in the subtree rooted at this node */
+    AGG agg;
+#endif
+
     /* Right child node or subtree */
     struct CMC_DEF_NODE(SNAME) * right;
 
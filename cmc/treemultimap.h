@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * treemultimap.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * TreeMultiMap
+ *
+ * A TreeMultiMap is a sorted Multimap. Each distinct key is stored only once
+ * in a node of an AVL tree and its values are kept in a contiguous array in
+ * that node, in the order they were inserted. Adding or removing values of a
+ * key that is already present doesn't change the shape of the tree. Every node
+ * also keeps the total amount of values in its subtree, allowing iterators to
+ * be positioned by index in O(log n).
+ */
+
+#include "cor/core.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * K - treemultimap key data type
+ * V - treemultimap value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/treemultimap/struct.h"
+
+/* Function declaration */
+#include "cmc/treemultimap/header.h"
+
+/* Function implementation */
+#include "cmc/treemultimap/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - treemultimap iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_TREEMULTIMAP_PARTS ITER, STR
+/**/
+#include "cmc/treemultimap/ext/struct.h"
+/**/
+#include "cmc/treemultimap/ext/header.h"
+/**/
+#include "cmc/treemultimap/ext/code.h"
+
+#include "cor/undef.h"
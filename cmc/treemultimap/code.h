@@ -0,0 +1,1104 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_map_, K key, int *c);
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node);
+static size_t CMC_(PFX, _impl_c)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_augment)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_propagate)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z);
+static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct CMC_DEF_NODE(SNAME) * node);
+static bool CMC_(PFX, _impl_push)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, V value);
+static void CMC_(PFX, _impl_remove_node)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_copy_nodes)(struct SNAME *_map_, struct SNAME *_from_,
+                                                               struct CMC_DEF_NODE(SNAME) * node,
+                                                               struct CMC_DEF_NODE(SNAME) * parent, bool *ok);
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, bool free_keys,
+                                        bool free_values);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_key, f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FKEY(SNAME) * f_key, struct CMC_DEF_FVAL(SNAME) * f_val,
+                                     CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_key || !f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_map_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_map_)
+        return NULL;
+
+    _map_->root = NULL;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+    _map_->f_key = f_key;
+    _map_->f_val = f_val;
+    _map_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    return _map_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root, true, true);
+
+    _map_->root = NULL;
+    _map_->count = 0;
+    _map_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_map_, _map_->root, true, true);
+
+    _map_->alloc->free(_map_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_map_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _map_->alloc = &cmc_alloc_node_default;
+    else
+        _map_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_map_, callbacks);
+
+    _map_->flag = CMC_FLAG_OK;
+}
+
+/* Appends a value to the ones of key. A new node is only created for keys */
+/* that are not yet present; otherwise key is not kept by the collection. */
+bool CMC_(PFX, _insert)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c;
+
+    struct CMC_DEF_NODE(SNAME) *parent = CMC_(PFX, _impl_find_parent)(_map_, key, &c);
+
+    if (parent != NULL && c == 0)
+    {
+        if (!CMC_(PFX, _impl_push)(_map_, parent, value))
+            return false;
+
+        CMC_(PFX, _impl_propagate)(parent);
+    }
+    else
+    {
+        struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_map_, key, value);
+
+        if (!node)
+        {
+            _map_->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        if (parent == NULL)
+            _map_->root = node;
+        else
+        {
+            node->parent = parent;
+
+            if (c > 0)
+                parent->left = node;
+            else
+                parent->right = node;
+
+            _map_->root = CMC_(PFX, _impl_rebalance)(node);
+        }
+    }
+
+    _map_->count++;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Updates the first value of key */
+bool CMC_(PFX, _update)(struct SNAME *_map_, K key, V new_value, V *old_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (old_value)
+        *old_value = node->values[0];
+
+    node->values[0] = new_value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Updates every value of key. If old_values is not NULL it is set to a new */
+/* array, which must be freed by the user, with the previous values. */
+size_t CMC_(PFX, _update_all)(struct SNAME *_map_, K key, V new_value, V **old_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return 0;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return 0;
+    }
+
+    if (old_values)
+    {
+        *old_values = _map_->alloc->malloc(sizeof(V) * node->count);
+
+        if (!(*old_values))
+        {
+            _map_->flag = CMC_FLAG_ALLOC;
+            return 0;
+        }
+
+        memcpy(*old_values, node->values, sizeof(V) * node->count);
+    }
+
+    for (size_t i = 0; i < node->count; i++)
+        node->values[i] = new_value;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->count;
+}
+
+/* Removes the first value of key */
+bool CMC_(PFX, _remove)(struct SNAME *_map_, K key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = node->values[0];
+
+    if (node->count == 1)
+        CMC_(PFX, _impl_remove_node)(_map_, node);
+    else
+    {
+        node->count--;
+
+        memmove(node->values, node->values + 1, sizeof(V) * node->count);
+
+        CMC_(PFX, _impl_propagate)(node);
+    }
+
+    _map_->count--;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Removes every value of key. If out_values is not NULL it is set to an */
+/* array, which must be freed by the user, with the removed values. */
+size_t CMC_(PFX, _remove_all)(struct SNAME *_map_, K key, V **out_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return 0;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return 0;
+    }
+
+    size_t removed = node->count;
+
+    /* The values array is handed over as it is */
+    if (out_values)
+    {
+        *out_values = node->values;
+        node->values = NULL;
+    }
+
+    CMC_(PFX, _impl_remove_node)(_map_, node);
+
+    _map_->count -= removed;
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return removed;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root;
+
+    while (scan->right != NULL)
+        scan = scan->right;
+
+    if (key)
+        *key = scan->key;
+    if (value)
+        *value = scan->values[0];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_map_, K *key, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first_node)(_map_->root);
+
+    if (key)
+        *key = scan->key;
+    if (value)
+        *value = scan->values[0];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _floor)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) <= 0)
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = result->key;
+    if (out_value)
+        *out_value = result->values[0];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_map_, K key, K *out_key, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_map_->f_key->cmp(scan->key, key) >= 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_key)
+        *out_key = result->key;
+    if (out_value)
+        *out_value = result->values[0];
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return true;
+}
+
+/* Returns the first value of key */
+V CMC_(PFX, _get)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return (V){ 0 };
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return (V){ 0 };
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node->values[0];
+}
+
+/* Returns a reference to the first value of key, which is invalidated once */
+/* values of the same key are inserted or removed */
+V *CMC_(PFX, _get_ref)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_map_))
+    {
+        _map_->flag = CMC_FLAG_EMPTY;
+        return NULL;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    if (!node)
+    {
+        _map_->flag = CMC_FLAG_NOT_FOUND;
+        return NULL;
+    }
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return &(node->values[0]);
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->flag = CMC_FLAG_OK;
+
+    bool result = CMC_(PFX, _impl_get_node)(_map_, key) != NULL;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->count;
+}
+
+/* Amount of values associated with key */
+size_t CMC_(PFX, _key_count)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_map_, key);
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_map_);
+
+    return node ? node->count : 0;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _map_->flag;
+}
+
+/* Copies the tree node by node, keeping its shape */
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_map_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Callback will be added later */
+    struct SNAME *result = CMC_(PFX, _new_custom)(_map_->f_key, _map_->f_val, _map_->alloc, NULL);
+
+    if (!result)
+    {
+        _map_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    bool ok = true;
+
+    result->root = CMC_(PFX, _impl_copy_nodes)(result, _map_, _map_->root, NULL, &ok);
+
+    if (!ok)
+    {
+        /* Keys and values that were copied are freed along with the nodes */
+        CMC_(PFX, _impl_free_nodes)(result, result->root, _map_->f_key->cpy != NULL, _map_->f_val->cpy != NULL);
+        _map_->alloc->free(result);
+
+        _map_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    result->count = _map_->count;
+
+    _map_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_ASSIGN(result, _map_->callbacks);
+
+    return result;
+}
+
+/* Two maps are equal if they have the same keys and each key has the same */
+/* values in the same order */
+bool CMC_(PFX, _equals)(struct SNAME *_map1_, struct SNAME *_map2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map1_->flag = CMC_FLAG_OK;
+    _map2_->flag = CMC_FLAG_OK;
+
+    if (_map1_->count != _map2_->count)
+        return false;
+
+    struct CMC_DEF_NODE(SNAME) *scan1 = CMC_(PFX, _impl_first_node)(_map1_->root);
+    struct CMC_DEF_NODE(SNAME) *scan2 = CMC_(PFX, _impl_first_node)(_map2_->root);
+
+    /* Both trees are sorted so they can be compared with a single pass */
+    while (scan1 != NULL && scan2 != NULL)
+    {
+        if (scan1->count != scan2->count)
+            return false;
+
+        if (_map1_->f_key->cmp(scan1->key, scan2->key) != 0)
+            return false;
+
+        for (size_t i = 0; i < scan1->count; i++)
+        {
+            if (_map1_->f_val->cmp(scan1->values[i], scan2->values[i]) != 0)
+                return false;
+        }
+
+        scan1 = CMC_(PFX, _impl_next_node)(scan1);
+        scan2 = CMC_(PFX, _impl_next_node)(scan2);
+    }
+
+    return scan1 == NULL && scan2 == NULL;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_map_, K key, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!node)
+        return NULL;
+
+    node->values = _map_->alloc->malloc(sizeof(V));
+
+    if (!node->values)
+    {
+        _map_->alloc->free(node);
+        return NULL;
+    }
+
+    node->key = key;
+    node->values[0] = value;
+    node->count = 1;
+    node->capacity = 1;
+    node->cardinality = 1;
+    node->height = 1;
+    node->right = NULL;
+    node->left = NULL;
+    node->parent = NULL;
+
+    return node;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_map_, K key)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c;
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find_parent)(_map_, key, &c);
+
+    if (node == NULL || c != 0)
+        return NULL;
+
+    return node;
+}
+
+/* Descends from the root doing a single three-way comparison per level. */
+/* Returns the node to which key would be attached (NULL if the tree is */
+/* empty) and sets c to the comparison of that node against key; if c is */
+/* 0 the key is already present at the returned node. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_map_, K key, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _map_->root, *parent = NULL;
+
+    *c = 0;
+
+    while (scan != NULL)
+    {
+        parent = scan;
+        *c = _map_->f_key->cmp(scan->key, key);
+
+        if (*c > 0)
+            scan = scan->left;
+        else if (*c < 0)
+            scan = scan->right;
+        else
+            break;
+    }
+
+    return parent;
+}
+
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->height;
+}
+
+/* Total amount of values of a subtree */
+static size_t CMC_(PFX, _impl_c)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->cardinality;
+}
+
+/* Recomputes the height and cardinality of a node from its children */
+static void CMC_(PFX, _impl_augment)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    unsigned char h_l = CMC_(PFX, _impl_h)(node->left);
+    unsigned char h_r = CMC_(PFX, _impl_h)(node->right);
+
+    node->height = 1 + (h_l > h_r ? h_l : h_r);
+    node->cardinality = node->count + CMC_(PFX, _impl_c)(node->left) + CMC_(PFX, _impl_c)(node->right);
+}
+
+/* Updates the cardinality of every ancestor after the amount of values of a */
+/* node changed */
+static void CMC_(PFX, _impl_propagate)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    for (; node != NULL; node = node->parent)
+        CMC_(PFX, _impl_augment)(node);
+}
+
+static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *root = *Z;
+    struct CMC_DEF_NODE(SNAME) *new_root = root->left;
+
+    if (root->parent != NULL)
+    {
+        if (root->parent->left == root)
+            root->parent->left = new_root;
+        else
+            root->parent->right = new_root;
+    }
+
+    new_root->parent = root->parent;
+
+    root->parent = new_root;
+    root->left = new_root->right;
+
+    if (root->left)
+        root->left->parent = root;
+
+    new_root->right = root;
+
+    CMC_(PFX, _impl_augment)(root);
+    CMC_(PFX, _impl_augment)(new_root);
+
+    *Z = new_root;
+}
+
+static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *root = *Z;
+    struct CMC_DEF_NODE(SNAME) *new_root = root->right;
+
+    if (root->parent != NULL)
+    {
+        if (root->parent->right == root)
+            root->parent->right = new_root;
+        else
+            root->parent->left = new_root;
+    }
+
+    new_root->parent = root->parent;
+
+    root->parent = new_root;
+    root->right = new_root->left;
+
+    if (root->right)
+        root->right->parent = root;
+
+    new_root->left = root;
+
+    CMC_(PFX, _impl_augment)(root);
+    CMC_(PFX, _impl_augment)(new_root);
+
+    *Z = new_root;
+}
+
+/* Rebalances every node from node up to the root, returning the root */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL, *top = node;
+
+    int balance;
+
+    while (scan != NULL)
+    {
+        CMC_(PFX, _impl_augment)(scan);
+        balance = CMC_(PFX, _impl_h)(scan->right) - CMC_(PFX, _impl_h)(scan->left);
+
+        if (balance >= 2)
+        {
+            child = scan->right;
+
+            if (CMC_(PFX, _impl_h)(child->right) < CMC_(PFX, _impl_h)(child->left))
+                CMC_(PFX, _impl_rotate_right)(&(scan->right));
+
+            CMC_(PFX, _impl_rotate_left)(&scan);
+        }
+        else if (balance <= -2)
+        {
+            child = scan->left;
+
+            if (CMC_(PFX, _impl_h)(child->left) < CMC_(PFX, _impl_h)(child->right))
+                CMC_(PFX, _impl_rotate_left)(&(scan->left));
+
+            CMC_(PFX, _impl_rotate_right)(&scan);
+        }
+
+        top = scan;
+        scan = scan->parent;
+    }
+
+    return top;
+}
+
+/* Appends a value to a node, doubling its array when it is full */
+static bool CMC_(PFX, _impl_push)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->count == node->capacity)
+    {
+        size_t capacity = node->capacity * 2;
+
+        V *values = _map_->alloc->realloc(node->values, sizeof(V) * capacity);
+
+        if (!values)
+        {
+            _map_->flag = CMC_FLAG_ALLOC;
+            return false;
+        }
+
+        node->values = values;
+        node->capacity = capacity;
+    }
+
+    node->values[node->count++] = value;
+
+    return true;
+}
+
+/* Unlinks and frees a node along with its values array */
+static void CMC_(PFX, _impl_remove_node)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _map_->alloc->free(node->values);
+
+    /* A node with two children takes the place of its successor, which has */
+    /* at most one child */
+    if (node->left != NULL && node->right != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *successor = CMC_(PFX, _impl_first_node)(node->right);
+
+        node->key = successor->key;
+        node->values = successor->values;
+        node->count = successor->count;
+        node->capacity = successor->capacity;
+
+        node = successor;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *child = node->left != NULL ? node->left : node->right;
+    struct CMC_DEF_NODE(SNAME) *parent = node->parent;
+
+    if (child != NULL)
+        child->parent = parent;
+
+    if (parent == NULL)
+        _map_->root = child;
+    else
+    {
+        if (parent->left == node)
+            parent->left = child;
+        else
+            parent->right = child;
+
+        _map_->root = CMC_(PFX, _impl_rebalance)(parent);
+    }
+
+    _map_->alloc->free(node);
+}
+
+/* Leftmost node of a subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+    {
+        while (node->left != NULL)
+            node = node->left;
+    }
+
+    return node;
+}
+
+/* In-order successor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->right != NULL)
+        return CMC_(PFX, _impl_first_node)(node->right);
+
+    while (node->parent != NULL && node->parent->right == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* Copies a subtree of another map. On failure ok is set to false and the */
+/* nodes copied so far are still linked to the returned subtree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_copy_nodes)(struct SNAME *_map_, struct SNAME *_from_,
+                                                               struct CMC_DEF_NODE(SNAME) * node,
+                                                               struct CMC_DEF_NODE(SNAME) * parent, bool *ok)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL || !*ok)
+        return NULL;
+
+    struct CMC_DEF_NODE(SNAME) *copy = _map_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!copy)
+    {
+        *ok = false;
+        return NULL;
+    }
+
+    copy->values = _map_->alloc->malloc(sizeof(V) * node->count);
+
+    if (!copy->values)
+    {
+        _map_->alloc->free(copy);
+        *ok = false;
+        return NULL;
+    }
+
+    if (_from_->f_key->cpy)
+        copy->key = _from_->f_key->cpy(node->key);
+    else
+        copy->key = node->key;
+
+    if (_from_->f_val->cpy)
+    {
+        for (size_t i = 0; i < node->count; i++)
+            copy->values[i] = _from_->f_val->cpy(node->values[i]);
+    }
+    else
+        memcpy(copy->values, node->values, sizeof(V) * node->count);
+
+    copy->count = node->count;
+    copy->capacity = node->count;
+    copy->cardinality = node->cardinality;
+    copy->height = node->height;
+    copy->parent = parent;
+    copy->left = CMC_(PFX, _impl_copy_nodes)(_map_, _from_, node->left, copy, ok);
+    copy->right = CMC_(PFX, _impl_copy_nodes)(_map_, _from_, node->right, copy, ok);
+
+    return copy;
+}
+
+/* Frees every node of a subtree along with, optionally, their keys and */
+/* values */
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_map_, struct CMC_DEF_NODE(SNAME) * node, bool free_keys,
+                                        bool free_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL)
+    {
+        /* Rotates left children up until the node has none, then frees it */
+        /* and continues with its right subtree, using no extra memory */
+        if (node->left != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *left = node->left;
+
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else
+        {
+            struct CMC_DEF_NODE(SNAME) *right = node->right;
+
+            if (free_keys && _map_->f_key->free)
+                _map_->f_key->free(node->key);
+
+            if (free_values && _map_->f_val->free)
+            {
+                for (size_t i = 0; i < node->count; i++)
+                    _map_->f_val->free(node->values[i]);
+            }
+
+            _map_->alloc->free(node->values);
+            _map_->alloc->free(node);
+            node = right;
+        }
+    }
+}
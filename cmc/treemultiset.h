@@ -0,0 +1,81 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * treemultiset.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * TreeMultiSet
+ *
+ * A TreeMultiSet is a sorted Multiset. Each distinct element is stored only
+ * once in a node of an AVL tree together with its multiplicity, so adding or
+ * removing copies of an element that is already present doesn't change the
+ * shape of the tree. Every node also keeps the total multiplicity of its
+ * subtree, allowing iterators to be positioned by index in O(log n).
+ */
+
+#include "cor/core.h"
+
+#ifdef CMC_DEV
+#include "utl/log.h"
+#endif
+
+/**
+ * Used values
+ * V - treemultiset value data type
+ * SNAME - struct name and prefix of other related structs
+ * PFX - functions prefix
+ */
+
+/* Structs definition */
+#include "cmc/treemultiset/struct.h"
+
+/* Function declaration */
+#include "cmc/treemultiset/header.h"
+
+/* Function implementation */
+#include "cmc/treemultiset/code.h"
+
+/**
+ * Extensions
+ *
+ * ITER - treemultiset iterator
+ * STR - Print helper functions
+ */
+#define CMC_EXT_TREEMULTISET_PARTS ITER, STR
+/**/
+#include "cmc/treemultiset/ext/struct.h"
+/**/
+#include "cmc/treemultiset/ext/header.h"
+/**/
+#include "cmc/treemultiset/ext/code.h"
+
+#include "cor/undef.h"
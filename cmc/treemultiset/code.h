@@ -0,0 +1,948 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/* Implementation Detail Functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_set_, V value, size_t multiplicity);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_set_, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_set_, V value, int *c);
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node);
+static size_t CMC_(PFX, _impl_c)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_augment)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_propagate)(struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z);
+static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct CMC_DEF_NODE(SNAME) * node);
+static bool CMC_(PFX, _impl_add)(struct SNAME *_set_, V value, size_t count);
+static void CMC_(PFX, _impl_remove_node)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_copy_nodes)(struct SNAME *_set_, struct SNAME *_from_,
+                                                               struct CMC_DEF_NODE(SNAME) * node,
+                                                               struct CMC_DEF_NODE(SNAME) * parent, bool *ok);
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node, bool free_values);
+
+struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FVAL(SNAME) * f_val)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _new_custom)(f_val, NULL, NULL);
+}
+
+struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
+                                     CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!f_val)
+        return NULL;
+
+    if (!alloc)
+        alloc = &cmc_alloc_node_default;
+
+    struct SNAME *_set_ = alloc->malloc(sizeof(struct SNAME));
+
+    if (!_set_)
+        return NULL;
+
+    _set_->root = NULL;
+    _set_->count = 0;
+    _set_->cardinality = 0;
+    _set_->flag = CMC_FLAG_OK;
+    _set_->f_val = f_val;
+    _set_->alloc = alloc;
+    CMC_CALLBACKS_ASSIGN(_set_, callbacks);
+
+    return _set_;
+}
+
+void CMC_(PFX, _clear)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_set_, _set_->root, true);
+
+    _set_->root = NULL;
+    _set_->count = 0;
+    _set_->cardinality = 0;
+    _set_->flag = CMC_FLAG_OK;
+}
+
+void CMC_(PFX, _free)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_(PFX, _impl_free_nodes)(_set_, _set_->root, true);
+
+    _set_->alloc->free(_set_);
+}
+
+void CMC_(PFX, _customize)(struct SNAME *_set_, CMC_ALLOC_TYPE alloc, CMC_CALLBACK_TYPE callbacks)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_CALLBACKS_MAYBE_UNUSED(callbacks);
+
+    if (!alloc)
+        _set_->alloc = &cmc_alloc_node_default;
+    else
+        _set_->alloc = alloc;
+
+    CMC_CALLBACKS_ASSIGN(_set_, callbacks);
+
+    _set_->flag = CMC_FLAG_OK;
+}
+
+bool CMC_(PFX, _insert)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!CMC_(PFX, _impl_add)(_set_, value, 1))
+        return false;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _insert_many)(struct SNAME *_set_, V value, size_t count)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (count > 0 && !CMC_(PFX, _impl_add)(_set_, value, count))
+        return false;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Sets the multiplicity of an element, adding it if it is not present or */
+/* removing it if the new multiplicity is 0 */
+bool CMC_(PFX, _update)(struct SNAME *_set_, V value, size_t multiplicity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_set_, value);
+
+    if (!node)
+    {
+        if (multiplicity > 0 && !CMC_(PFX, _impl_add)(_set_, value, multiplicity))
+            return false;
+    }
+    else if (multiplicity == 0)
+        CMC_(PFX, _impl_remove_node)(_set_, node);
+    else
+    {
+        _set_->cardinality = _set_->cardinality - node->multiplicity + multiplicity;
+
+        node->multiplicity = multiplicity;
+
+        CMC_(PFX, _impl_propagate)(node);
+    }
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Removes a single copy of an element */
+bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_set_, value);
+
+    if (!node)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (node->multiplicity > 1)
+    {
+        node->multiplicity--;
+        _set_->cardinality--;
+
+        CMC_(PFX, _impl_propagate)(node);
+    }
+    else
+        CMC_(PFX, _impl_remove_node)(_set_, node);
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* Removes every copy of an element, returning how many were removed */
+size_t CMC_(PFX, _remove_all)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return 0;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_set_, value);
+
+    if (!node)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return 0;
+    }
+
+    size_t removed = node->multiplicity;
+
+    CMC_(PFX, _impl_remove_node)(_set_, node);
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return removed;
+}
+
+bool CMC_(PFX, _max)(struct SNAME *_set_, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    while (scan->right != NULL)
+        scan = scan->right;
+
+    if (value)
+        *value = scan->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _min)(struct SNAME *_set_, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first_node)(_set_->root);
+
+    if (value)
+        *value = scan->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _floor)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) <= 0)
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = result->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) >= 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = result->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+size_t CMC_(PFX, _multiplicity_of)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_get_node)(_set_, value);
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return node ? node->multiplicity : 0;
+}
+
+bool CMC_(PFX, _contains)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set_->flag = CMC_FLAG_OK;
+
+    bool result = CMC_(PFX, _impl_get_node)(_set_, value) != NULL;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return result;
+}
+
+bool CMC_(PFX, _empty)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->count == 0;
+}
+
+size_t CMC_(PFX, _count)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->count;
+}
+
+size_t CMC_(PFX, _cardinality)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->cardinality;
+}
+
+int CMC_(PFX, _flag)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return _set_->flag;
+}
+
+/* Copies the tree node by node, keeping its shape */
+struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Callback will be added later */
+    struct SNAME *result = CMC_(PFX, _new_custom)(_set_->f_val, _set_->alloc, NULL);
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_ERROR;
+        return NULL;
+    }
+
+    bool ok = true;
+
+    result->root = CMC_(PFX, _impl_copy_nodes)(result, _set_, _set_->root, NULL, &ok);
+
+    if (!ok)
+    {
+        /* Values that were copied are freed along with the nodes */
+        CMC_(PFX, _impl_free_nodes)(result, result->root, _set_->f_val->cpy != NULL);
+        _set_->alloc->free(result);
+
+        _set_->flag = CMC_FLAG_ALLOC;
+        return NULL;
+    }
+
+    result->count = _set_->count;
+    result->cardinality = _set_->cardinality;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_ASSIGN(result, _set_->callbacks);
+
+    return result;
+}
+
+bool CMC_(PFX, _equals)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set1_->flag = CMC_FLAG_OK;
+    _set2_->flag = CMC_FLAG_OK;
+
+    if (_set1_->count != _set2_->count || _set1_->cardinality != _set2_->cardinality)
+        return false;
+
+    struct CMC_DEF_NODE(SNAME) *scan1 = CMC_(PFX, _impl_first_node)(_set1_->root);
+    struct CMC_DEF_NODE(SNAME) *scan2 = CMC_(PFX, _impl_first_node)(_set2_->root);
+
+    /* Both trees are sorted so they can be compared with a single pass */
+    while (scan1 != NULL && scan2 != NULL)
+    {
+        if (scan1->multiplicity != scan2->multiplicity)
+            return false;
+
+        if (_set1_->f_val->cmp(scan1->value, scan2->value) != 0)
+            return false;
+
+        scan1 = CMC_(PFX, _impl_next_node)(scan1);
+        scan2 = CMC_(PFX, _impl_next_node)(scan2);
+    }
+
+    return true;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_set_, V value, size_t multiplicity)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *node = _set_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)));
+
+    if (!node)
+        return NULL;
+
+    node->value = value;
+    node->multiplicity = multiplicity;
+    node->cardinality = multiplicity;
+    node->height = 1;
+    node->right = NULL;
+    node->left = NULL;
+    node->parent = NULL;
+
+    return node;
+}
+
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c;
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_find_parent)(_set_, value, &c);
+
+    if (node == NULL || c != 0)
+        return NULL;
+
+    return node;
+}
+
+/* Descends from the root doing a single three-way comparison per level. */
+/* Returns the node to which value would be attached (NULL if the tree is */
+/* empty) and sets c to the comparison of that node against value; if c is */
+/* 0 the value is already present at the returned node. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_set_, V value, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *parent = NULL;
+
+    *c = 0;
+
+    while (scan != NULL)
+    {
+        parent = scan;
+        *c = _set_->f_val->cmp(scan->value, value);
+
+        if (*c > 0)
+            scan = scan->left;
+        else if (*c < 0)
+            scan = scan->right;
+        else
+            break;
+    }
+
+    return parent;
+}
+
+static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->height;
+}
+
+/* Total multiplicity of a subtree */
+static size_t CMC_(PFX, _impl_c)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->cardinality;
+}
+
+/* Recomputes the height and cardinality of a node from its children */
+static void CMC_(PFX, _impl_augment)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    unsigned char h_l = CMC_(PFX, _impl_h)(node->left);
+    unsigned char h_r = CMC_(PFX, _impl_h)(node->right);
+
+    node->height = 1 + (h_l > h_r ? h_l : h_r);
+    node->cardinality = node->multiplicity + CMC_(PFX, _impl_c)(node->left) + CMC_(PFX, _impl_c)(node->right);
+}
+
+/* Updates the cardinality of every ancestor after the multiplicity of a */
+/* node changed */
+static void CMC_(PFX, _impl_propagate)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    for (; node != NULL; node = node->parent)
+        CMC_(PFX, _impl_augment)(node);
+}
+
+static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *root = *Z;
+    struct CMC_DEF_NODE(SNAME) *new_root = root->left;
+
+    if (root->parent != NULL)
+    {
+        if (root->parent->left == root)
+            root->parent->left = new_root;
+        else
+            root->parent->right = new_root;
+    }
+
+    new_root->parent = root->parent;
+
+    root->parent = new_root;
+    root->left = new_root->right;
+
+    if (root->left)
+        root->left->parent = root;
+
+    new_root->right = root;
+
+    CMC_(PFX, _impl_augment)(root);
+    CMC_(PFX, _impl_augment)(new_root);
+
+    *Z = new_root;
+}
+
+static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *root = *Z;
+    struct CMC_DEF_NODE(SNAME) *new_root = root->right;
+
+    if (root->parent != NULL)
+    {
+        if (root->parent->right == root)
+            root->parent->right = new_root;
+        else
+            root->parent->left = new_root;
+    }
+
+    new_root->parent = root->parent;
+
+    root->parent = new_root;
+    root->right = new_root->left;
+
+    if (root->right)
+        root->right->parent = root;
+
+    new_root->left = root;
+
+    CMC_(PFX, _impl_augment)(root);
+    CMC_(PFX, _impl_augment)(new_root);
+
+    *Z = new_root;
+}
+
+/* Rebalances every node from node up to the root, returning the root */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL, *top = node;
+
+    int balance;
+
+    while (scan != NULL)
+    {
+        CMC_(PFX, _impl_augment)(scan);
+        balance = CMC_(PFX, _impl_h)(scan->right) - CMC_(PFX, _impl_h)(scan->left);
+
+        if (balance >= 2)
+        {
+            child = scan->right;
+
+            if (CMC_(PFX, _impl_h)(child->right) < CMC_(PFX, _impl_h)(child->left))
+                CMC_(PFX, _impl_rotate_right)(&(scan->right));
+
+            CMC_(PFX, _impl_rotate_left)(&scan);
+        }
+        else if (balance <= -2)
+        {
+            child = scan->left;
+
+            if (CMC_(PFX, _impl_h)(child->left) < CMC_(PFX, _impl_h)(child->right))
+                CMC_(PFX, _impl_rotate_left)(&(scan->left));
+
+            CMC_(PFX, _impl_rotate_right)(&scan);
+        }
+
+        top = scan;
+        scan = scan->parent;
+    }
+
+    return top;
+}
+
+/* Adds count copies of value. A new node is only created for values that */
+/* are not yet present; otherwise value is not kept by the collection. */
+static bool CMC_(PFX, _impl_add)(struct SNAME *_set_, V value, size_t count)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c;
+
+    struct CMC_DEF_NODE(SNAME) *parent = CMC_(PFX, _impl_find_parent)(_set_, value, &c);
+
+    if (parent != NULL && c == 0)
+    {
+        parent->multiplicity += count;
+        _set_->cardinality += count;
+
+        CMC_(PFX, _impl_propagate)(parent);
+
+        return true;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_set_, value, count);
+
+    if (!node)
+    {
+        _set_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    if (parent == NULL)
+        _set_->root = node;
+    else
+    {
+        node->parent = parent;
+
+        if (c > 0)
+            parent->left = node;
+        else
+            parent->right = node;
+
+        _set_->root = CMC_(PFX, _impl_rebalance)(node);
+    }
+
+    _set_->count++;
+    _set_->cardinality += count;
+
+    return true;
+}
+
+/* Unlinks and frees a node along with every copy of its element */
+static void CMC_(PFX, _impl_remove_node)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set_->count--;
+    _set_->cardinality -= node->multiplicity;
+
+    /* A node with two children takes the place of its successor, which has */
+    /* at most one child */
+    if (node->left != NULL && node->right != NULL)
+    {
+        struct CMC_DEF_NODE(SNAME) *successor = CMC_(PFX, _impl_first_node)(node->right);
+
+        node->value = successor->value;
+        node->multiplicity = successor->multiplicity;
+
+        node = successor;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *child = node->left != NULL ? node->left : node->right;
+    struct CMC_DEF_NODE(SNAME) *parent = node->parent;
+
+    if (child != NULL)
+        child->parent = parent;
+
+    if (parent == NULL)
+        _set_->root = child;
+    else
+    {
+        if (parent->left == node)
+            parent->left = child;
+        else
+            parent->right = child;
+
+        _set_->root = CMC_(PFX, _impl_rebalance)(parent);
+    }
+
+    _set_->alloc->free(node);
+}
+
+/* Leftmost node of a subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_first_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+    {
+        while (node->left != NULL)
+            node = node->left;
+    }
+
+    return node;
+}
+
+/* In-order successor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->right != NULL)
+        return CMC_(PFX, _impl_first_node)(node->right);
+
+    while (node->parent != NULL && node->parent->right == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* Copies a subtree of another set. On failure ok is set to false and the */
+/* nodes copied so far are still linked to the returned subtree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_copy_nodes)(struct SNAME *_set_, struct SNAME *_from_,
+                                                               struct CMC_DEF_NODE(SNAME) * node,
+                                                               struct CMC_DEF_NODE(SNAME) * parent, bool *ok)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL || !*ok)
+        return NULL;
+
+    struct CMC_DEF_NODE(SNAME) *copy = CMC_(PFX, _impl_new_node)(_set_, node->value, node->multiplicity);
+
+    if (!copy)
+    {
+        *ok = false;
+        return NULL;
+    }
+
+    if (_from_->f_val->cpy)
+        copy->value = _from_->f_val->cpy(node->value);
+
+    copy->cardinality = node->cardinality;
+    copy->height = node->height;
+    copy->parent = parent;
+    copy->left = CMC_(PFX, _impl_copy_nodes)(_set_, _from_, node->left, copy, ok);
+    copy->right = CMC_(PFX, _impl_copy_nodes)(_set_, _from_, node->right, copy, ok);
+
+    return copy;
+}
+
+/* Frees every node of a subtree and, if free_values is true, their elements */
+static void CMC_(PFX, _impl_free_nodes)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node, bool free_values)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    while (node != NULL)
+    {
+        /* Rotates left children up until the node has none, then frees it */
+        /* and continues with its right subtree, using no extra memory */
+        if (node->left != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *left = node->left;
+
+            node->left = left->right;
+            left->right = node;
+            node = left;
+        }
+        else
+        {
+            struct CMC_DEF_NODE(SNAME) *right = node->right;
+
+            if (free_values && _set_->f_val->free)
+                _set_->f_val->free(node->value);
+
+            _set_->alloc->free(node);
+            node = right;
+        }
+    }
+}
@@ -0,0 +1,532 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * INIT
+ *
+ * The part 'INIT' gives a new way of initializing a collection. The collection
+ * struct is not heap allocated, only its internal structure (nodes, buffers).
+ */
+#ifdef CMC_EXT_INIT
+
+#endif /* CMC_EXT_INIT */
+
+/**
+ * ITER
+ *
+ * Treemultiset bi-directional iterator.
+ */
+#ifdef CMC_EXT_ITER
+
+/* Implementation detail functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_last_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_bound)(struct SNAME *_set_, V value, bool strict);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_set_, size_t index, size_t *copy);
+static size_t CMC_(PFX, _impl_rank)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node);
+
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.first = CMC_(PFX, _impl_first_node)(target->root);
+    iter.last = CMC_(PFX, _impl_last_node)(target->root);
+    iter.cursor = iter.first;
+    iter.copy = 0;
+    iter.index = 0;
+    iter.start = true;
+    iter.end = CMC_(PFX, _empty)(target);
+
+    return iter;
+}
+
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_ITER(SNAME) iter;
+
+    iter.target = target;
+    iter.first = CMC_(PFX, _impl_first_node)(target->root);
+    iter.last = CMC_(PFX, _impl_last_node)(target->root);
+    iter.cursor = iter.last;
+    iter.copy = 0;
+    iter.index = 0;
+    iter.start = CMC_(PFX, _empty)(target);
+    iter.end = true;
+
+    if (!CMC_(PFX, _empty)(target))
+    {
+        iter.copy = iter.last->multiplicity - 1;
+        iter.index = target->cardinality - 1;
+    }
+
+    return iter;
+}
+
+/* Iterator at the first copy of the first element greater than or equal to */
+/* value or at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_bound)(target, value, false));
+}
+
+/* Iterator at the first copy of the first element strictly greater than */
+/* value or at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_bound)(target, value, true));
+}
+
+bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _empty)(iter->target) || iter->start;
+}
+
+bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _empty)(iter->target) || iter->end;
+}
+
+bool CMC_(PFX, _iter_to_start)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!CMC_(PFX, _empty)(iter->target))
+    {
+        iter->index = 0;
+        iter->copy = 0;
+        iter->start = true;
+        iter->end = false;
+        iter->cursor = iter->first;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool CMC_(PFX, _iter_to_end)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (!CMC_(PFX, _empty)(iter->target))
+    {
+        iter->index = iter->target->cardinality - 1;
+        iter->copy = iter->last->multiplicity - 1;
+        iter->start = false;
+        iter->end = true;
+        iter->cursor = iter->last;
+
+        return true;
+    }
+
+    return false;
+}
+
+bool CMC_(PFX, _iter_next)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->end)
+        return false;
+
+    if (iter->cursor == iter->last && iter->copy + 1 == iter->cursor->multiplicity)
+    {
+        iter->end = true;
+        return false;
+    }
+
+    iter->start = CMC_(PFX, _empty)(iter->target);
+
+    if (iter->copy + 1 < iter->cursor->multiplicity)
+        iter->copy++;
+    else
+    {
+        iter->cursor = CMC_(PFX, _impl_next_node)(iter->cursor);
+        iter->copy = 0;
+    }
+
+    iter->index++;
+
+    return true;
+}
+
+bool CMC_(PFX, _iter_prev)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->start)
+        return false;
+
+    if (iter->cursor == iter->first && iter->copy == 0)
+    {
+        iter->start = true;
+        return false;
+    }
+
+    iter->end = CMC_(PFX, _empty)(iter->target);
+
+    if (iter->copy > 0)
+        iter->copy--;
+    else
+    {
+        iter->cursor = CMC_(PFX, _impl_prev_node)(iter->cursor);
+        iter->copy = iter->cursor->multiplicity - 1;
+    }
+
+    iter->index--;
+
+    return true;
+}
+
+/* Returns true only if the iterator moved */
+bool CMC_(PFX, _iter_advance)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->end)
+        return false;
+
+    if (iter->index + 1 == iter->target->cardinality)
+    {
+        iter->end = true;
+        return false;
+    }
+
+    if (steps == 0 || iter->index + steps >= iter->target->cardinality)
+        return false;
+
+    iter->index += steps;
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index, &iter->copy);
+    iter->start = false;
+
+    return true;
+}
+
+/* Returns true only if the iterator moved */
+bool CMC_(PFX, _iter_rewind)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (iter->start)
+        return false;
+
+    if (iter->index == 0)
+    {
+        iter->start = true;
+        return false;
+    }
+
+    if (steps == 0 || iter->index < steps)
+        return false;
+
+    iter->index -= steps;
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index, &iter->copy);
+    iter->end = false;
+
+    return true;
+}
+
+/* Returns true only if the iterator was able to be positioned at the */
+/* given index */
+bool CMC_(PFX, _iter_go_to)(struct CMC_DEF_ITER(SNAME) * iter, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (index >= iter->target->cardinality)
+        return false;
+
+    if (iter->index > index)
+        return CMC_(PFX, _iter_rewind)(iter, iter->index - index);
+    else if (iter->index < index)
+        return CMC_(PFX, _iter_advance)(iter, index - iter->index);
+
+    return true;
+}
+
+V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(iter->target))
+        return (V){ 0 };
+
+    return iter->cursor->value;
+}
+
+size_t CMC_(PFX, _iter_multiplicity)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(iter->target))
+        return 0;
+
+    return iter->cursor->multiplicity;
+}
+
+size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return iter->index;
+}
+
+/* Rightmost node of a subtree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_last_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node != NULL)
+    {
+        while (node->right != NULL)
+            node = node->right;
+    }
+
+    return node;
+}
+
+/* In-order predecessor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->left != NULL)
+        return CMC_(PFX, _impl_last_node)(node->left);
+
+    while (node->parent != NULL && node->parent->left == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* First node greater than or equal to value (or strictly greater) */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_bound)(struct SNAME *_set_, V value, bool strict)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        int c = _set_->f_val->cmp(scan->value, value);
+
+        if (c > 0 || (c == 0 && !strict))
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    return result;
+}
+
+/* Node holding the element at the given index of the iteration, which must */
+/* be less than the cardinality. Also gives which copy of it is at index. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_set_, size_t index, size_t *copy)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    while (scan != NULL)
+    {
+        size_t left = CMC_(PFX, _impl_c)(scan->left);
+
+        if (index < left)
+            scan = scan->left;
+        else if (index < left + scan->multiplicity)
+        {
+            *copy = index - left;
+            break;
+        }
+        else
+        {
+            index -= left + scan->multiplicity;
+            scan = scan->right;
+        }
+    }
+
+    return scan;
+}
+
+/* Index of the first copy of a node's element in the iteration */
+static size_t CMC_(PFX, _impl_rank)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t rank = CMC_(PFX, _impl_c)(node->left);
+
+    for (; node->parent != NULL; node = node->parent)
+    {
+        if (node->parent->right == node)
+            rank += CMC_(PFX, _impl_c)(node->parent->left) + node->parent->multiplicity;
+    }
+
+    return rank;
+}
+
+/* Positions an iterator at the first copy of a node, which must belong to */
+/* target */
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return CMC_(PFX, _iter_end)(target);
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(target);
+
+    if (node == iter.first)
+        return iter;
+
+    iter.cursor = node;
+    iter.index = CMC_(PFX, _impl_rank)(node);
+    iter.start = false;
+
+    return iter;
+}
+
+#endif /* CMC_EXT_ITER */
+
+/**
+ * STR
+ *
+ * Print helper functions.
+ */
+#ifdef CMC_EXT_STR
+
+bool CMC_(PFX, _to_string)(struct SNAME *_set_, FILE *fptr)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *s_ = _set_;
+
+    return 0 <= fprintf(fptr,
+                        "struct %s<%s> "
+                        "at %p { "
+                        "root:%p, "
+                        "count:%" PRIuMAX ", "
+                        "cardinality:%" PRIuMAX ", "
+                        "flag:%d, "
+                        "f_val:%p, "
+                        "alloc:%p, "
+                        "callbacks:%p }",
+                        CMC_TO_STRING(SNAME), CMC_TO_STRING(V), s_, s_->root, (uintmax_t)s_->count,
+                        (uintmax_t)s_->cardinality, s_->flag, s_->f_val, s_->alloc, CMC_CALLBACKS_GET(s_));
+}
+
+bool CMC_(PFX, _print)(struct SNAME *_set_, FILE *fptr, const char *start, const char *separator, const char *end,
+                       const char *val_mul_sep)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    fprintf(fptr, "%s", start);
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_first_node)(_set_->root);
+
+    while (scan != NULL)
+    {
+        if (!_set_->f_val->str(fptr, scan->value))
+            return false;
+
+        fprintf(fptr, "%s", val_mul_sep);
+
+        if (fprintf(fptr, "%" PRIuMAX "", (uintmax_t)scan->multiplicity) < 0)
+            return false;
+
+        scan = CMC_(PFX, _impl_next_node)(scan);
+
+        if (scan != NULL)
+            fprintf(fptr, "%s", separator);
+    }
+
+    fprintf(fptr, "%s", end);
+
+    return true;
+}
+
+#endif /* CMC_EXT_STR */
@@ -38,9 +38,13 @@
  * A TreeSet is an implementation of a Set that keeps its elements sorted. Like
  * a Set it has only unique keys. This implementation uses a balanced binary
  * tree called AVL Tree that uses the height of nodes to keep its keys balanced.
+ *
+ * If CMC_ARITHMETIC_V is defined the set functions compare the values with the
+ * built-in operators and use the kernels of cor/setops/code.h.
  */
 
 #include "cor/core.h"
+#include "cor/setops.h"
 
 #ifdef CMC_DEV
 #include "utl/log.h"
@@ -49,8 +53,10 @@
 /**
  * Used values
  * V - treeset value data type
+ * CMC_ARITHMETIC_V - optional, V can be compared with the built-in operators
  * SNAME - struct name and prefix of other related structs
  * PFX - functions prefix
+ * AGG - subtree aggregate data type (optional)
  */
 
 /* Structs definition */
@@ -59,6 +65,11 @@
 /* Function declaration */
 #include "cmc/treeset/header.h"
 
+/* Set operation kernels */
+#ifdef CMC_ARITHMETIC_V
+#include "cor/setops/code.h"
+#endif
+
 /* Function implementation */
 #include "cmc/treeset/code.h"
 
@@ -67,10 +78,17 @@
  *
  * INIT - Initializes the struct on the stack
  * ITER - treeset iterator
+ * RANK - Order statistics (rank, select and range counts)
  * SETF - Set functions
+ * PSETF - Parallel set functions (requires cmc_thread)
  * STR - Print helper functions
  */
-#define CMC_EXT_TREESET_PARTS INIT, ITER, SETF, STR
+#define CMC_EXT_TREESET_PARTS INIT, ITER, RANK, SETF, PSETF, STR
+
+#ifdef CMC_EXT_PSETF
+#include "utl/thread.h"
+#endif
+
 /**/
 #include "cmc/treeset/ext/struct.h"
 /**/
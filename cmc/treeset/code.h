@@ -27,9 +27,36 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_set
 static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_set_, V value);
 static unsigned char CMC_(PFX, _impl_h)(struct CMC_DEF_NODE(SNAME) * node);
 static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node);
-static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z);
-static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z);
-static void CMC_(PFX, _impl_rebalance)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_augment)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node);
+static void CMC_(PFX, _impl_rotate_right)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * *Z);
+static void CMC_(PFX, _impl_rotate_left)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * *Z);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_set_, V value, int *c);
+static bool CMC_(PFX, _impl_hint_parent)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * hint, V value,
+                                         struct CMC_DEF_NODE(SNAME) * *parent, int *c);
+static bool CMC_(PFX, _impl_insert_at)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * parent, int c, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_set_, V value);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_join)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * left,
+                                                         struct CMC_DEF_NODE(SNAME) * node,
+                                                         struct CMC_DEF_NODE(SNAME) * right);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_merge)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * left,
+                                                          struct CMC_DEF_NODE(SNAME) * right);
+static void CMC_(PFX, _impl_split)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node, V value,
+                                   struct CMC_DEF_NODE(SNAME) * *left, struct CMC_DEF_NODE(SNAME) * *right);
+static bool CMC_(PFX, _impl_build)(struct SNAME *_set_, V *values, size_t count, struct CMC_DEF_NODE(SNAME) * parent,
+                                   struct CMC_DEF_NODE(SNAME) * *result);
+static void CMC_(PFX, _impl_free_node)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_link)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * nodes,
+                                                         size_t count, struct CMC_DEF_NODE(SNAME) * parent);
+static size_t CMC_(PFX, _impl_free_nodes)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node,
+                                          bool free_elements);
+#ifdef CMC_EXT_RANK
+static size_t CMC_(PFX, _impl_s)(struct CMC_DEF_NODE(SNAME) * node);
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_set_, size_t index);
+static size_t CMC_(PFX, _impl_rank)(struct SNAME *_set_, V value);
+#endif
 
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FVAL(SNAME) * f_val)
 {
@@ -62,77 +89,66 @@ struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALL
 
     _set_->count = 0;
     _set_->root = NULL;
+    _set_->finger = NULL;
+    _set_->block = NULL;
+    _set_->block_size = 0;
+    _set_->block_count = 0;
     _set_->flag = CMC_FLAG_OK;
     _set_->f_val = f_val;
     _set_->alloc = alloc;
+#ifdef AGG
+    _set_->f_agg = NULL;
+#endif
     CMC_CALLBACKS_ASSIGN(_set_, callbacks);
 
     return _set_;
 }
 
-void CMC_(PFX, _clear)(struct SNAME *_set_)
+/* Builds a perfectly balanced tree in O(n) from values that must be in */
+/* strictly ascending order. Returns NULL if they are not or if an allocation */
+/* fails. */
+struct SNAME *CMC_(PFX, _from_sorted)(V *values, size_t count, struct CMC_DEF_FVAL(SNAME) * f_val)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
-    struct CMC_DEF_NODE(SNAME) *up = NULL;
+    struct SNAME *_set_ = CMC_(PFX, _new)(f_val);
 
-    while (scan != NULL)
+    if (!_set_)
+        return NULL;
+
+    for (size_t i = 1; i < count; i++)
     {
-        if (scan->left != NULL)
+        if (_set_->f_val->cmp(values[i - 1], values[i]) >= 0)
         {
-            struct CMC_DEF_NODE(SNAME) *left = scan->left;
-
-            scan->left = up;
-            up = scan;
-            scan = left;
+            CMC_(PFX, _free)(_set_);
+            return NULL;
         }
-        else if (scan->right != NULL)
-        {
-            struct CMC_DEF_NODE(SNAME) *right = scan->right;
+    }
 
-            scan->left = up;
-            scan->right = NULL;
-            up = scan;
-            scan = right;
-        }
-        else
-        {
-            if (up == NULL)
-            {
-                if (_set_->f_val->free)
-                    _set_->f_val->free(scan->value);
+    if (!CMC_(PFX, _impl_build)(_set_, values, count, NULL, &_set_->root))
+    {
+        CMC_(PFX, _free)(_set_);
+        return NULL;
+    }
 
-                _set_->alloc->free(scan);
-                scan = NULL;
-            }
+    _set_->count = count;
 
-            while (up != NULL)
-            {
-                if (_set_->f_val->free)
-                    _set_->f_val->free(scan->value);
+    return _set_;
+}
 
-                _set_->alloc->free(scan);
+void CMC_(PFX, _clear)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
 
-                if (up->right != NULL)
-                {
-                    scan = up->right;
-                    up->right = NULL;
-                    break;
-                }
-                else
-                {
-                    scan = up;
-                    up = up->left;
-                }
-            }
-        }
-    }
+    CMC_(PFX, _impl_free_nodes)(_set_, _set_->root, true);
 
     _set_->count = 0;
     _set_->root = NULL;
+    _set_->finger = NULL;
     _set_->flag = CMC_FLAG_OK;
 }
 
@@ -171,77 +187,14 @@ bool CMC_(PFX, _insert)(struct SNAME *_set_, V value)
     CMC_DEV_FCALL;
 #endif
 
-    if (CMC_(PFX, _empty)(_set_))
-    {
-        _set_->root = CMC_(PFX, _impl_new_node)(_set_, value);
-
-        if (!_set_->root)
-        {
-            _set_->flag = CMC_FLAG_ALLOC;
-            CMC_CALLBACKS_CALL(_set_);
-            return false;
-        }
-    }
-    else
-    {
-        struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
-        struct CMC_DEF_NODE(SNAME) *parent = scan;
-
-        while (scan != NULL)
-        {
-            parent = scan;
-
-            if (_set_->f_val->cmp(scan->value, value) > 0)
-                scan = scan->left;
-            else if (_set_->f_val->cmp(scan->value, value) < 0)
-                scan = scan->right;
-            else
-            {
-                _set_->flag = CMC_FLAG_DUPLICATE;
-                return false;
-            }
-        }
-
-        struct CMC_DEF_NODE(SNAME) * node;
-
-        if (_set_->f_val->cmp(parent->value, value) > 0)
-        {
-            parent->left = CMC_(PFX, _impl_new_node)(_set_, value);
-
-            if (!parent->left)
-            {
-                _set_->flag = CMC_FLAG_ALLOC;
-                CMC_CALLBACKS_CALL(_set_);
-                return false;
-            }
-
-            parent->left->parent = parent;
-            node = parent->left;
-        }
-        else
-        {
-            parent->right = CMC_(PFX, _impl_new_node)(_set_, value);
-
-            if (!parent->right)
-            {
-                _set_->flag = CMC_FLAG_ALLOC;
-                CMC_CALLBACKS_CALL(_set_);
-                return false;
-            }
-
-            parent->right->parent = parent;
-            node = parent->right;
-        }
-
-        CMC_(PFX, _impl_rebalance)(_set_, node);
-    }
-
-    _set_->count++;
-    _set_->flag = CMC_FLAG_OK;
+    struct CMC_DEF_NODE(SNAME) *parent = NULL;
+    int c = 0;
 
-    CMC_CALLBACKS_CALL(_set_);
+    /* Inserting next to the previously inserted node avoids a full descent */
+    if (!_set_->finger || !CMC_(PFX, _impl_hint_parent)(_set_, _set_->finger, value, &parent, &c))
+        parent = CMC_(PFX, _impl_find_parent)(_set_, value, &c);
 
-    return true;
+    return CMC_(PFX, _impl_insert_at)(_set_, parent, c, value);
 }
 
 bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
@@ -270,6 +223,9 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
 
     bool is_root = node->parent == NULL;
 
+    /* The node holding the finger might be freed */
+    _set_->finger = NULL;
+
     if (node->left == NULL && node->right == NULL)
     {
         if (is_root)
@@ -284,7 +240,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
                 node->parent->left = NULL;
         }
 
-        _set_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_set_, node);
     }
     else if (node->left == NULL)
     {
@@ -305,7 +261,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
                 node->parent->left = node->right;
         }
 
-        _set_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_set_, node);
     }
     else if (node->right == NULL)
     {
@@ -326,7 +282,7 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
                 node->parent->left = node->left;
         }
 
-        _set_->alloc->free(node);
+        CMC_(PFX, _impl_free_node)(_set_, node);
     }
     else
     {
@@ -364,13 +320,13 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
                 temp->parent->left = temp->left;
         }
 
-        _set_->alloc->free(temp);
+        CMC_(PFX, _impl_free_node)(_set_, temp);
 
         node->value = temp_value;
     }
 
     if (unbalanced != NULL)
-        CMC_(PFX, _impl_rebalance)(_set_, unbalanced);
+        _set_->root = CMC_(PFX, _impl_rebalance)(_set_, unbalanced);
 
     if (_set_->count == 0)
         _set_->root = NULL;
@@ -383,6 +339,35 @@ bool CMC_(PFX, _remove)(struct SNAME *_set_, V value)
     return true;
 }
 
+size_t CMC_(PFX, _remove_range)(struct SNAME *_set_, V lower, V upper)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set_->flag = CMC_FLAG_OK;
+
+    if (CMC_(PFX, _empty)(_set_) || _set_->f_val->cmp(lower, upper) >= 0)
+        return 0;
+
+    struct CMC_DEF_NODE(SNAME) *left = NULL, *middle = NULL, *right = NULL;
+
+    /* left < lower <= middle < upper <= right */
+    CMC_(PFX, _impl_split)(_set_, _set_->root, lower, &left, &right);
+    CMC_(PFX, _impl_split)(_set_, right, upper, &middle, &right);
+
+    size_t removed = CMC_(PFX, _impl_free_nodes)(_set_, middle, true);
+
+    _set_->finger = NULL;
+
+    _set_->root = CMC_(PFX, _impl_merge)(_set_, left, right);
+    _set_->count -= removed;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return removed;
+}
+
 bool CMC_(PFX, _max)(struct SNAME *_set_, V *value)
 {
 #ifdef CMC_DEV
@@ -437,6 +422,107 @@ bool CMC_(PFX, _min)(struct SNAME *_set_, V *value)
     return true;
 }
 
+bool CMC_(PFX, _floor)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) <= 0)
+        {
+            result = scan;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = result->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+bool CMC_(PFX, _ceiling)(struct SNAME *_set_, V value, V *out_value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *result = CMC_(PFX, _impl_lower_bound)(_set_, value);
+
+    if (!result)
+    {
+        _set_->flag = CMC_FLAG_NOT_FOUND;
+        return false;
+    }
+
+    if (out_value)
+        *out_value = result->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+size_t CMC_(PFX, _range)(struct SNAME *_set_, V lower, V upper, bool (*visitor)(V, void *), void *args)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    _set_->flag = CMC_FLAG_OK;
+
+    if (_set_->f_val->cmp(lower, upper) >= 0)
+        return 0;
+
+    size_t visited = 0;
+
+    struct CMC_DEF_NODE(SNAME) *scan = CMC_(PFX, _impl_lower_bound)(_set_, lower);
+
+    while (scan != NULL && _set_->f_val->cmp(scan->value, upper) < 0)
+    {
+        visited++;
+
+        if (!visitor(scan->value, args))
+            break;
+
+        scan = CMC_(PFX, _impl_next_node)(scan);
+    }
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return visited;
+}
+
 bool CMC_(PFX, _contains)(struct SNAME *_set_, V value)
 {
 #ifdef CMC_DEV
@@ -492,6 +578,10 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_set_)
         return NULL;
     }
 
+#ifdef AGG
+    result->f_agg = _set_->f_agg;
+#endif
+
     struct CMC_DEF_NODE(SNAME) *root = _set_->root;
 
     bool left_done = false;
@@ -542,6 +632,54 @@ struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_set_)
     return result;
 }
 
+/* Moves every node into a single contiguous block laid out in order, which */
+/* makes iteration cache friendly. The tree is rebuilt perfectly balanced. */
+/* Iterators and the previous node addresses are invalidated. */
+bool CMC_(PFX, _compact)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+    {
+        _set_->flag = CMC_FLAG_OK;
+        return true;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *nodes = _set_->alloc->malloc(sizeof(struct CMC_DEF_NODE(SNAME)) * _set_->count);
+
+    if (!nodes)
+    {
+        _set_->flag = CMC_FLAG_ALLOC;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    while (scan->left != NULL)
+        scan = scan->left;
+
+    for (size_t i = 0; scan != NULL; scan = CMC_(PFX, _impl_next_node)(scan), i++)
+    {
+        nodes[i].value = scan->value;
+    }
+
+    /* Might also release a block from a previous compaction */
+    CMC_(PFX, _impl_free_nodes)(_set_, _set_->root, false);
+
+    _set_->block = nodes;
+    _set_->block_size = _set_->count;
+    _set_->block_count = _set_->count;
+    _set_->root = CMC_(PFX, _impl_link)(_set_, nodes, _set_->count, NULL);
+    _set_->finger = NULL;
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
 bool CMC_(PFX, _equals)(struct SNAME *_set1_, struct SNAME *_set2_)
 {
 #ifdef CMC_DEV
@@ -611,7 +749,9 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_new_node)(struct SNAME *_set
     node->right = NULL;
     node->left = NULL;
     node->parent = NULL;
-    node->height = 0;
+    node->height = 1;
+
+    CMC_(PFX, _impl_augment)(_set_, node);
 
     return node;
 }
@@ -626,9 +766,11 @@ static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_get_node)(struct SNAME *_set
 
     while (scan != NULL)
     {
-        if (_set_->f_val->cmp(scan->value, value) > 0)
+        int c = _set_->f_val->cmp(scan->value, value);
+
+        if (c > 0)
             scan = scan->left;
-        else if (_set_->f_val->cmp(scan->value, value) < 0)
+        else if (c < 0)
             scan = scan->right;
         else
             return scan;
@@ -664,7 +806,7 @@ static unsigned char CMC_(PFX, _impl_hupdate)(struct CMC_DEF_NODE(SNAME) * node)
     return 1 + (h_l > h_r ? h_l : h_r);
 }
 
-static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
+static void CMC_(PFX, _impl_rotate_right)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * *Z)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
@@ -694,10 +836,13 @@ static void CMC_(PFX, _impl_rotate_right)(struct CMC_DEF_NODE(SNAME) * *Z)
     root->height = CMC_(PFX, _impl_hupdate)(root);
     new_root->height = CMC_(PFX, _impl_hupdate)(new_root);
 
+    CMC_(PFX, _impl_augment)(_set_, root);
+    CMC_(PFX, _impl_augment)(_set_, new_root);
+
     *Z = new_root;
 }
 
-static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
+static void CMC_(PFX, _impl_rotate_left)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * *Z)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
@@ -727,26 +872,26 @@ static void CMC_(PFX, _impl_rotate_left)(struct CMC_DEF_NODE(SNAME) * *Z)
     root->height = CMC_(PFX, _impl_hupdate)(root);
     new_root->height = CMC_(PFX, _impl_hupdate)(new_root);
 
+    CMC_(PFX, _impl_augment)(_set_, root);
+    CMC_(PFX, _impl_augment)(_set_, new_root);
+
     *Z = new_root;
 }
 
-static void CMC_(PFX, _impl_rebalance)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node)
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_rebalance)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL;
+    struct CMC_DEF_NODE(SNAME) *scan = node, *child = NULL, *top = node;
 
     int balance;
-    bool is_root = false;
 
     while (scan != NULL)
     {
-        if (scan->parent == NULL)
-            is_root = true;
-
         scan->height = CMC_(PFX, _impl_hupdate)(scan);
+        CMC_(PFX, _impl_augment)(_set_, scan);
         balance = CMC_(PFX, _impl_h)(scan->right) - CMC_(PFX, _impl_h)(scan->left);
 
         if (balance >= 2)
@@ -754,26 +899,642 @@ static void CMC_(PFX, _impl_rebalance)(struct SNAME *_set_, struct CMC_DEF_NODE(
             child = scan->right;
 
             if (CMC_(PFX, _impl_h)(child->right) < CMC_(PFX, _impl_h)(child->left))
-                CMC_(PFX, _impl_rotate_right)(&(scan->right));
+                CMC_(PFX, _impl_rotate_right)(_set_, &(scan->right));
 
-            CMC_(PFX, _impl_rotate_left)(&scan);
+            CMC_(PFX, _impl_rotate_left)(_set_, &scan);
         }
         else if (balance <= -2)
         {
             child = scan->left;
 
             if (CMC_(PFX, _impl_h)(child->left) < CMC_(PFX, _impl_h)(child->right))
-                CMC_(PFX, _impl_rotate_left)(&(scan->left));
-
-            CMC_(PFX, _impl_rotate_right)(&scan);
-        }
+                CMC_(PFX, _impl_rotate_left)(_set_, &(scan->left));
 
-        if (is_root)
-        {
-            _set_->root = scan;
-            is_root = false;
+            CMC_(PFX, _impl_rotate_right)(_set_, &scan);
         }
 
+        top = scan;
         scan = scan->parent;
     }
+
+    /* The root of the whole tree (or subtree) */
+    return top;
+}
+
+/* Recomputes the augmented data of a node from its children */
+static void CMC_(PFX, _impl_augment)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    CMC_UNUSED_PARAM(_set_);
+    CMC_UNUSED_PARAM(node);
+
+#ifdef CMC_EXT_RANK
+    node->size = 1 + CMC_(PFX, _impl_s)(node->left) + CMC_(PFX, _impl_s)(node->right);
+#endif
+
+#ifdef AGG
+    if (_set_->f_agg)
+    {
+        AGG agg = _set_->f_agg->lift(node->value);
+
+        if (node->left)
+            agg = _set_->f_agg->combine(node->left->agg, agg);
+        if (node->right)
+            agg = _set_->f_agg->combine(agg, node->right->agg);
+
+        node->agg = agg;
+    }
+#endif
+}
+
+#ifdef CMC_EXT_RANK
+
+static size_t CMC_(PFX, _impl_s)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return 0;
+
+    return node->size;
+}
+
+/* Finds the node at the given in-order index in O(log n) */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_select_node)(struct SNAME *_set_, size_t index)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    while (scan != NULL)
+    {
+        size_t left_size = CMC_(PFX, _impl_s)(scan->left);
+
+        if (index < left_size)
+            scan = scan->left;
+        else if (index > left_size)
+        {
+            index -= left_size + 1;
+            scan = scan->right;
+        }
+        else
+            return scan;
+    }
+
+    return NULL;
+}
+
+/* Counts how many elements are strictly less than the given one */
+static size_t CMC_(PFX, _impl_rank)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    size_t rank = 0;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) < 0)
+        {
+            rank += CMC_(PFX, _impl_s)(scan->left) + 1;
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
+    }
+
+    return rank;
+}
+
+#endif /* CMC_EXT_RANK */
+
+/* In-order successor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_next_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->right != NULL)
+    {
+        node = node->right;
+
+        while (node->left != NULL)
+            node = node->left;
+
+        return node;
+    }
+
+    while (node->parent != NULL && node->parent->right == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* In-order predecessor of a node */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_prev_node)(struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node->left != NULL)
+    {
+        node = node->left;
+
+        while (node->right != NULL)
+            node = node->right;
+
+        return node;
+    }
+
+    while (node->parent != NULL && node->parent->left == node)
+        node = node->parent;
+
+    return node->parent;
+}
+
+/* Descends from the root doing a single three-way comparison per level. */
+/* Returns the node to which value would be attached (NULL if the tree is */
+/* empty) and sets c to the comparison of that node against value; if c is */
+/* 0 the value is already present at the returned node. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_find_parent)(struct SNAME *_set_, V value, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *parent = NULL;
+
+    *c = 0;
+
+    while (scan != NULL)
+    {
+        parent = scan;
+        *c = _set_->f_val->cmp(scan->value, value);
+
+        if (*c > 0)
+            scan = scan->left;
+        else if (*c < 0)
+            scan = scan->right;
+        else
+            break;
+    }
+
+    return parent;
+}
+
+/* Same as _impl_find_parent but only looks at hint and its in-order */
+/* neighbour, costing at most two comparisons. Returns false if value does */
+/* not belong right next to hint. */
+static bool CMC_(PFX, _impl_hint_parent)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * hint, V value,
+                                         struct CMC_DEF_NODE(SNAME) * *parent, int *c)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int c_hint = _set_->f_val->cmp(hint->value, value);
+
+    if (c_hint == 0)
+    {
+        *parent = hint;
+        *c = 0;
+        return true;
+    }
+
+    if (c_hint < 0)
+    {
+        /* Must be between hint and its successor */
+        struct CMC_DEF_NODE(SNAME) *next = CMC_(PFX, _impl_next_node)(hint);
+
+        int c_next = next ? _set_->f_val->cmp(next->value, value) : 1;
+
+        if (c_next < 0)
+            return false;
+
+        /* If hint has a right subtree then next is its leftmost node */
+        if (c_next == 0 || hint->right != NULL)
+        {
+            *parent = next;
+            *c = c_next;
+        }
+        else
+        {
+            *parent = hint;
+            *c = c_hint;
+        }
+    }
+    else
+    {
+        /* Must be between the predecessor of hint and hint */
+        struct CMC_DEF_NODE(SNAME) *prev = CMC_(PFX, _impl_prev_node)(hint);
+
+        int c_prev = prev ? _set_->f_val->cmp(prev->value, value) : -1;
+
+        if (c_prev > 0)
+            return false;
+
+        /* If hint has a left subtree then prev is its rightmost node */
+        if (c_prev == 0 || hint->left != NULL)
+        {
+            *parent = prev;
+            *c = c_prev;
+        }
+        else
+        {
+            *parent = hint;
+            *c = c_hint;
+        }
+    }
+
+    return true;
+}
+
+/* Attaches a new node to parent (found by _impl_find_parent or */
+/* _impl_hint_parent) and rebalances the tree */
+static bool CMC_(PFX, _impl_insert_at)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * parent, int c, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (parent != NULL && c == 0)
+    {
+        _set_->flag = CMC_FLAG_DUPLICATE;
+        return false;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_set_, value);
+
+    if (!node)
+    {
+        _set_->flag = CMC_FLAG_ALLOC;
+        CMC_CALLBACKS_CALL(_set_);
+        return false;
+    }
+
+    if (parent == NULL)
+        _set_->root = node;
+    else
+    {
+        node->parent = parent;
+
+        if (c > 0)
+            parent->left = node;
+        else
+            parent->right = node;
+
+        _set_->root = CMC_(PFX, _impl_rebalance)(_set_, node);
+    }
+
+    _set_->finger = node;
+    _set_->count++;
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
+}
+
+/* First node that is greater than or equal to the given value */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_lower_bound)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) >= 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    return result;
+}
+
+/* Joins two detached trees using node as the pivot, where every element of */
+/* left is less than node and every element of right is greater than node. */
+/* Runs in O(|h(left) - h(right)|) and returns the root of the new tree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_join)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * left,
+                                                         struct CMC_DEF_NODE(SNAME) * node,
+                                                         struct CMC_DEF_NODE(SNAME) * right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    int h_l = CMC_(PFX, _impl_h)(left);
+    int h_r = CMC_(PFX, _impl_h)(right);
+
+    struct CMC_DEF_NODE(SNAME) *scan = NULL;
+
+    if (h_l > h_r + 1)
+    {
+        /* Attach node and right somewhere along the right spine of left */
+        scan = left;
+
+        while (CMC_(PFX, _impl_h)(scan->right) > h_r + 1)
+            scan = scan->right;
+
+        node->left = scan->right;
+        node->right = right;
+        scan->right = node;
+    }
+    else if (h_r > h_l + 1)
+    {
+        /* Attach left and node somewhere along the left spine of right */
+        scan = right;
+
+        while (CMC_(PFX, _impl_h)(scan->left) > h_l + 1)
+            scan = scan->left;
+
+        node->left = left;
+        node->right = scan->left;
+        scan->left = node;
+    }
+    else
+    {
+        node->left = left;
+        node->right = right;
+    }
+
+    node->parent = scan;
+
+    if (node->left)
+        node->left->parent = node;
+    if (node->right)
+        node->right->parent = node;
+
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+    CMC_(PFX, _impl_augment)(_set_, node);
+
+    if (scan == NULL)
+        return node;
+
+    return CMC_(PFX, _impl_rebalance)(_set_, scan);
+}
+
+/* Joins two detached trees where every element of left is less than every */
+/* element of right. Returns the root of the new tree. */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_merge)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * left,
+                                                          struct CMC_DEF_NODE(SNAME) * right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (left == NULL)
+        return right;
+    if (right == NULL)
+        return left;
+
+    /* Detach the minimum of right and use it as the pivot */
+    struct CMC_DEF_NODE(SNAME) *pivot = right;
+
+    while (pivot->left != NULL)
+        pivot = pivot->left;
+
+    if (pivot->parent != NULL)
+    {
+        pivot->parent->left = pivot->right;
+
+        if (pivot->right)
+            pivot->right->parent = pivot->parent;
+
+        right = CMC_(PFX, _impl_rebalance)(_set_, pivot->parent);
+    }
+    else
+    {
+        right = pivot->right;
+
+        if (right)
+            right->parent = NULL;
+    }
+
+    pivot->left = NULL;
+    pivot->right = NULL;
+    pivot->parent = NULL;
+
+    return CMC_(PFX, _impl_join)(_set_, left, pivot, right);
+}
+
+/* Splits a detached tree into two: one with every element less than the */
+/* given value and the other with every element greater than or equal to it */
+static void CMC_(PFX, _impl_split)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node, V value,
+                                   struct CMC_DEF_NODE(SNAME) * *left, struct CMC_DEF_NODE(SNAME) * *right)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+    {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    struct CMC_DEF_NODE(SNAME) *node_l = node->left;
+    struct CMC_DEF_NODE(SNAME) *node_r = node->right;
+
+    if (node_l)
+        node_l->parent = NULL;
+    if (node_r)
+        node_r->parent = NULL;
+
+    node->left = NULL;
+    node->right = NULL;
+    node->parent = NULL;
+
+    struct CMC_DEF_NODE(SNAME) *middle = NULL;
+
+    if (_set_->f_val->cmp(node->value, value) < 0)
+    {
+        CMC_(PFX, _impl_split)(_set_, node_r, value, &middle, right);
+        *left = CMC_(PFX, _impl_join)(_set_, node_l, node, middle);
+    }
+    else
+    {
+        CMC_(PFX, _impl_split)(_set_, node_l, value, left, &middle);
+        *right = CMC_(PFX, _impl_join)(_set_, middle, node, node_r);
+    }
+}
+
+/* Builds a balanced tree out of sorted values by always taking the middle */
+/* element as the root. No comparisons or rotations are needed. If an */
+/* allocation fails every node allocated so far is freed. */
+static bool CMC_(PFX, _impl_build)(struct SNAME *_set_, V *values, size_t count, struct CMC_DEF_NODE(SNAME) * parent,
+                                   struct CMC_DEF_NODE(SNAME) * *result)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    *result = NULL;
+
+    if (count == 0)
+        return true;
+
+    size_t mid = count / 2;
+
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_new_node)(_set_, values[mid]);
+
+    if (!node)
+        return false;
+
+    node->parent = parent;
+
+    if (!CMC_(PFX, _impl_build)(_set_, values, mid, node, &node->left) ||
+        !CMC_(PFX, _impl_build)(_set_, values + mid + 1, count - mid - 1, node, &node->right))
+    {
+        CMC_(PFX, _impl_free_nodes)(_set_, node, false);
+        return false;
+    }
+
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+    CMC_(PFX, _impl_augment)(_set_, node);
+
+    *result = node;
+
+    return true;
+}
+
+/* Frees a single node. Nodes that live in the block allocated by _compact */
+/* are not freed individually; the whole block is freed once all of them are */
+/* released. */
+static void CMC_(PFX, _impl_free_node)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    uintptr_t address = (uintptr_t)node;
+    uintptr_t start = (uintptr_t)_set_->block;
+
+    if (_set_->block && address >= start &&
+        address < start + _set_->block_size * sizeof(struct CMC_DEF_NODE(SNAME)))
+    {
+        if (--_set_->block_count == 0)
+        {
+            _set_->alloc->free(_set_->block);
+            _set_->block = NULL;
+            _set_->block_size = 0;
+        }
+    }
+    else
+        _set_->alloc->free(node);
+}
+
+/* Links an array of nodes as a perfectly balanced tree */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_link)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * nodes,
+                                                         size_t count, struct CMC_DEF_NODE(SNAME) * parent)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (count == 0)
+        return NULL;
+
+    size_t mid = count / 2;
+
+    struct CMC_DEF_NODE(SNAME) *node = &nodes[mid];
+
+    node->parent = parent;
+    node->left = CMC_(PFX, _impl_link)(_set_, nodes, mid, node);
+    node->right = CMC_(PFX, _impl_link)(_set_, nodes + mid + 1, count - mid - 1, node);
+    node->height = CMC_(PFX, _impl_hupdate)(node);
+
+    CMC_(PFX, _impl_augment)(_set_, node);
+
+    return node;
+}
+
+/* Frees every node of a detached tree, returning how many were freed. The */
+/* elements themselves are only freed if free_elements is true. */
+static size_t CMC_(PFX, _impl_free_nodes)(struct SNAME *_set_, struct CMC_DEF_NODE(SNAME) * node,
+                                          bool free_elements)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t count = 0;
+
+    struct CMC_DEF_NODE(SNAME) *scan = node;
+    struct CMC_DEF_NODE(SNAME) *up = NULL;
+
+    while (scan != NULL)
+    {
+        if (scan->left != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *left = scan->left;
+
+            scan->left = up;
+            up = scan;
+            scan = left;
+        }
+        else if (scan->right != NULL)
+        {
+            struct CMC_DEF_NODE(SNAME) *right = scan->right;
+
+            scan->left = up;
+            scan->right = NULL;
+            up = scan;
+            scan = right;
+        }
+        else
+        {
+            if (up == NULL)
+            {
+                if (free_elements && _set_->f_val->free)
+                    _set_->f_val->free(scan->value);
+
+                CMC_(PFX, _impl_free_node)(_set_, scan);
+                count++;
+                scan = NULL;
+            }
+
+            while (up != NULL)
+            {
+                if (free_elements && _set_->f_val->free)
+                    _set_->f_val->free(scan->value);
+
+                CMC_(PFX, _impl_free_node)(_set_, scan);
+                count++;
+
+                if (up->right != NULL)
+                {
+                    scan = up->right;
+                    up->right = NULL;
+                    break;
+                }
+                else
+                {
+                    scan = up;
+                    up = up->left;
+                }
+            }
+        }
+    }
+
+    return count;
 }
@@ -39,6 +39,10 @@
  */
 #ifdef CMC_EXT_ITER
 
+/* Implementation detail functions */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_upper_bound)(struct SNAME *_set_, V value);
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node);
+
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target)
 {
 #ifdef CMC_DEV
@@ -103,6 +107,81 @@ struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target)
     return iter;
 }
 
+/* First node that is strictly greater than the given value */
+static struct CMC_DEF_NODE(SNAME) * CMC_(PFX, _impl_upper_bound)(struct SNAME *_set_, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root, *result = NULL;
+
+    while (scan != NULL)
+    {
+        if (_set_->f_val->cmp(scan->value, value) > 0)
+        {
+            result = scan;
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
+    }
+
+    return result;
+}
+
+/* Positions an iterator at the given node, which must belong to target */
+static struct CMC_DEF_ITER(SNAME) CMC_(PFX, _impl_iter_at)(struct SNAME *target, struct CMC_DEF_NODE(SNAME) * node)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (node == NULL)
+        return CMC_(PFX, _iter_end)(target);
+
+    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(target);
+
+    if (node == iter.first)
+        return iter;
+
+    iter.cursor = node;
+    iter.start = false;
+    iter.end = false;
+
+#ifdef CMC_EXT_RANK
+    iter.index = CMC_(PFX, _impl_rank)(target, node->value);
+#else
+    /* Without the RANK part the index can only be found in O(n) */
+    for (struct CMC_DEF_NODE(SNAME) *scan = iter.first; scan != node; scan = CMC_(PFX, _impl_next_node)(scan))
+        iter.index++;
+#endif
+
+    return iter;
+}
+
+/* Iterator starting at the first element greater than or equal to value or */
+/* at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_lower_bound)(target, value));
+}
+
+/* Iterator starting at the first element strictly greater than value or */
+/* at the end of the iteration if there is no such element */
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_iter_at)(target, CMC_(PFX, _impl_upper_bound)(target, value));
+}
+
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter)
 {
 #ifdef CMC_DEV
@@ -266,8 +345,14 @@ bool CMC_(PFX, _iter_advance)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
     if (steps == 0 || iter->index + steps >= iter->target->count)
         return false;
 
+#ifdef CMC_EXT_RANK
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index + steps);
+    iter->index += steps;
+    iter->start = false;
+#else
     for (size_t i = 0; i < steps; i++)
         CMC_(PFX, _iter_next)(iter);
+#endif
 
     return true;
 }
@@ -291,8 +376,14 @@ bool CMC_(PFX, _iter_rewind)(struct CMC_DEF_ITER(SNAME) * iter, size_t steps)
     if (steps == 0 || iter->index < steps)
         return false;
 
+#ifdef CMC_EXT_RANK
+    iter->cursor = CMC_(PFX, _impl_select_node)(iter->target, iter->index - steps);
+    iter->index -= steps;
+    iter->end = false;
+#else
     for (size_t i = 0; i < steps; i++)
         CMC_(PFX, _iter_prev)(iter);
+#endif
 
     return true;
 }
@@ -337,133 +428,309 @@ size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter)
     return iter->index;
 }
 
+/* Inserts an element using the iterator's current position as a starting */
+/* point. If the element belongs right next to it this takes at most two */
+/* comparisons, otherwise it falls back to a regular insertion. The iterator */
+/* must be reset after a successful insertion. */
+bool CMC_(PFX, _insert_hint)(struct SNAME *_set_, struct CMC_DEF_ITER(SNAME) * iter, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_DEF_NODE(SNAME) *parent = NULL;
+    int c = 0;
+
+    if (iter->target != _set_ || !iter->cursor ||
+        !CMC_(PFX, _impl_hint_parent)(_set_, iter->cursor, value, &parent, &c))
+        parent = CMC_(PFX, _impl_find_parent)(_set_, value, &c);
+
+    return CMC_(PFX, _impl_insert_at)(_set_, parent, c, value);
+}
+
 #endif /* CMC_EXT_ITER */
 
 /**
- * SETF
+ * RANK
  *
- * Set functions
+ * Order statistics. Every node keeps the size of its subtree, allowing
+ * elements to be accessed by their sorted position in O(log n).
  */
-#ifdef CMC_EXT_SETF
+#ifdef CMC_EXT_RANK
 
-struct SNAME *CMC_(PFX, _union)(struct SNAME *_set1_, struct SNAME *_set2_)
+/* Returns how many elements are strictly less than the given one */
+size_t CMC_(PFX, _rank)(struct SNAME *_set_, V value)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
+    size_t rank = CMC_(PFX, _impl_rank)(_set_, value);
 
-    if (!_set_r_)
-        return NULL;
+    _set_->flag = CMC_FLAG_OK;
 
-    struct CMC_DEF_ITER(SNAME) iter1 = CMC_(PFX, _iter_start)(_set1_);
-    struct CMC_DEF_ITER(SNAME) iter2 = CMC_(PFX, _iter_start)(_set2_);
+    CMC_CALLBACKS_CALL(_set_);
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter1); CMC_(PFX, _iter_next)(&iter1))
+    return rank;
+}
+
+/* Retrieves the element at the given position of the sorted sequence */
+bool CMC_(PFX, _select)(struct SNAME *_set_, size_t index, V *value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
     {
-        CMC_(PFX, _insert)(_set_r_, CMC_(PFX, _iter_value)(&iter1));
+        _set_->flag = CMC_FLAG_EMPTY;
+        return false;
     }
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter2); CMC_(PFX, _iter_next)(&iter2))
+    if (index >= _set_->count)
     {
-        CMC_(PFX, _insert)(_set_r_, CMC_(PFX, _iter_value)(&iter2));
+        _set_->flag = CMC_FLAG_RANGE;
+        return false;
     }
 
-    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+    struct CMC_DEF_NODE(SNAME) *node = CMC_(PFX, _impl_select_node)(_set_, index);
 
-    return _set_r_;
+    if (value)
+        *value = node->value;
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    return true;
 }
 
-struct SNAME *CMC_(PFX, _intersection)(struct SNAME *_set1_, struct SNAME *_set2_)
+/* Counts the elements in the range [lower, upper) */
+size_t CMC_(PFX, _count_range)(struct SNAME *_set_, V lower, V upper)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
-
-    if (!_set_r_)
-        return NULL;
+    size_t result = 0;
 
-    /** TODO Should this compare count or capacity? */
-    struct SNAME *_set_A_ = _set1_->count < _set2_->count ? _set1_ : _set2_;
-    struct SNAME *_set_B_ = _set_A_ == _set1_ ? _set2_ : _set1_;
+    if (_set_->f_val->cmp(lower, upper) < 0)
+        result = CMC_(PFX, _impl_rank)(_set_, upper) - CMC_(PFX, _impl_rank)(_set_, lower);
 
-    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(_set_A_);
+    _set_->flag = CMC_FLAG_OK;
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter); CMC_(PFX, _iter_next)(&iter))
-    {
-        V value = CMC_(PFX, _iter_value)(&iter);
+    CMC_CALLBACKS_CALL(_set_);
 
-        if (CMC_(PFX, _impl_get_node)(_set_B_, value) != NULL)
-            CMC_(PFX, _insert)(_set_r_, value);
-    }
+    return result;
+}
 
-    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+#endif /* CMC_EXT_RANK */
 
-    return _set_r_;
-}
+/**
+ * AGG
+ *
+ * User defined subtree aggregates. Available when the AGG data type is
+ * defined. Every node keeps the aggregate of its subtree, computed through the
+ * aggregate function table, allowing range aggregates in O(log n).
+ */
+#ifdef AGG
 
-struct SNAME *CMC_(PFX, _difference)(struct SNAME *_set1_, struct SNAME *_set2_)
+/* Sets the aggregate function table and recomputes every node in O(n) */
+/* Passing NULL disables the maintenance of aggregates */
+void CMC_(PFX, _aggregate_with)(struct SNAME *_set_, struct CMC_DEF_FAGG(SNAME) * f_agg)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
+    _set_->f_agg = f_agg;
+    _set_->flag = CMC_FLAG_OK;
 
-    if (!_set_r_)
-        return NULL;
+    if (!f_agg)
+        return;
 
-    struct CMC_DEF_ITER(SNAME) iter = CMC_(PFX, _iter_start)(_set1_);
+    /* Post-order traversal so that children are updated before parents */
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+    struct CMC_DEF_NODE(SNAME) *prev = NULL;
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter); CMC_(PFX, _iter_next)(&iter))
+    while (scan != NULL)
     {
-        V value = CMC_(PFX, _iter_value)(&iter);
+        if (prev == scan->parent)
+        {
+            prev = scan;
+
+            if (scan->left)
+            {
+                scan = scan->left;
+                continue;
+            }
+            else if (scan->right)
+            {
+                scan = scan->right;
+                continue;
+            }
+        }
+        else if (prev == scan->left && scan->right)
+        {
+            prev = scan;
+            scan = scan->right;
+            continue;
+        }
 
-        if (CMC_(PFX, _impl_get_node)(_set2_, value) == NULL)
-            CMC_(PFX, _insert)(_set_r_, value);
+        CMC_(PFX, _impl_augment)(_set_, scan);
+
+        prev = scan;
+        scan = scan->parent;
     }
+}
 
-    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+/* Returns the aggregate of every element */
+AGG CMC_(PFX, _aggregate)(struct SNAME *_set_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
 
-    return _set_r_;
+    if (!_set_->f_agg)
+    {
+        _set_->flag = CMC_FLAG_FTABLE;
+        return (AGG){ 0 };
+    }
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
+
+    if (CMC_(PFX, _empty)(_set_))
+        return _set_->f_agg->identity;
+
+    return _set_->root->agg;
 }
 
-struct SNAME *CMC_(PFX, _symmetric_difference)(struct SNAME *_set1_, struct SNAME *_set2_)
+/* Returns the aggregate of every element in the range [lower, upper) */
+AGG CMC_(PFX, _aggregate_range)(struct SNAME *_set_, V lower, V upper)
 {
 #ifdef CMC_DEV
     CMC_DEV_FCALL;
 #endif
 
-    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
+    struct CMC_DEF_FAGG(SNAME) *f_agg = _set_->f_agg;
 
-    if (!_set_r_)
-        return NULL;
+    if (!f_agg)
+    {
+        _set_->flag = CMC_FLAG_FTABLE;
+        return (AGG){ 0 };
+    }
+
+    _set_->flag = CMC_FLAG_OK;
+
+    CMC_CALLBACKS_CALL(_set_);
 
-    struct CMC_DEF_ITER(SNAME) iter1 = CMC_(PFX, _iter_start)(_set1_);
-    struct CMC_DEF_ITER(SNAME) iter2 = CMC_(PFX, _iter_start)(_set2_);
+    /* Find the topmost node that is inside the range */
+    struct CMC_DEF_NODE(SNAME) *split = _set_->root;
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter1); CMC_(PFX, _iter_next)(&iter1))
+    while (split != NULL)
     {
-        V value = CMC_(PFX, _iter_value)(&iter1);
+        if (_set_->f_val->cmp(split->value, lower) < 0)
+            split = split->right;
+        else if (_set_->f_val->cmp(split->value, upper) >= 0)
+            split = split->left;
+        else
+            break;
+    }
 
-        if (CMC_(PFX, _impl_get_node)(_set2_, value) == NULL)
-            CMC_(PFX, _insert)(_set_r_, value);
+    if (!split)
+        return f_agg->identity;
+
+    /* Elements greater than or equal to lower in the left subtree */
+    AGG left = f_agg->identity;
+
+    for (struct CMC_DEF_NODE(SNAME) *scan = split->left; scan != NULL;)
+    {
+        if (_set_->f_val->cmp(scan->value, lower) >= 0)
+        {
+            AGG agg = _set_->f_agg->lift(scan->value);
+
+            if (scan->right)
+                agg = f_agg->combine(agg, scan->right->agg);
+
+            left = f_agg->combine(agg, left);
+            scan = scan->left;
+        }
+        else
+            scan = scan->right;
     }
 
-    for (; !CMC_(PFX, _iter_at_end)(&iter2); CMC_(PFX, _iter_next)(&iter2))
+    /* Elements less than upper in the right subtree */
+    AGG right = f_agg->identity;
+
+    for (struct CMC_DEF_NODE(SNAME) *scan = split->right; scan != NULL;)
     {
-        V value = CMC_(PFX, _iter_value)(&iter2);
+        if (_set_->f_val->cmp(scan->value, upper) < 0)
+        {
+            if (scan->left)
+                right = f_agg->combine(right, scan->left->agg);
 
-        if (CMC_(PFX, _impl_get_node)(_set1_, value) == NULL)
-            CMC_(PFX, _insert)(_set_r_, value);
+            right = f_agg->combine(right, _set_->f_agg->lift(scan->value));
+            scan = scan->right;
+        }
+        else
+            scan = scan->left;
     }
 
-    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+    return f_agg->combine(f_agg->combine(left, _set_->f_agg->lift(split->value)), right);
+}
 
-    return _set_r_;
+#endif /* AGG */
+
+/**
+ * SETF
+ *
+ * Set functions
+ */
+#ifdef CMC_EXT_SETF
+
+/* Implementation detail functions */
+static size_t CMC_(PFX, _impl_flatten)(struct SNAME *_set_, V *buffer);
+static size_t CMC_(PFX, _impl_merge_values)(struct SNAME *_set_, V *A, size_t count_A, V *B, size_t count_B, V *result,
+                                            bool only_A, bool both, bool only_B);
+static struct SNAME *CMC_(PFX, _impl_set_operation)(struct SNAME *_set1_, struct SNAME *_set2_, bool only_A, bool both,
+                                                   bool only_B);
+
+struct SNAME *CMC_(PFX, _union)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_set1_, _set2_, true, true, true);
+}
+
+struct SNAME *CMC_(PFX, _intersection)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_set1_, _set2_, false, true, false);
+}
+
+struct SNAME *CMC_(PFX, _difference)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_set1_, _set2_, true, false, false);
+}
+
+struct SNAME *CMC_(PFX, _symmetric_difference)(struct SNAME *_set1_, struct SNAME *_set2_)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation)(_set1_, _set2_, true, false, true);
 }
 
 /* Is _set1_ a subset of _set2_ ? */
@@ -589,6 +856,364 @@ bool CMC_(PFX, _is_disjointset)(struct SNAME *_set1_, struct SNAME *_set2_)
 
 #endif /* CMC_EXT_SETF */
 
+/**
+ * SETF and PSETF
+ *
+ * Implementation details shared by the sequential and the parallel set
+ * functions. Set operations are a linear merge of the in-order sequences of
+ * both sets whose result is handed to _impl_build.
+ */
+#if defined(CMC_EXT_SETF) || defined(CMC_EXT_PSETF)
+
+/* Writes every value of the set in order to buffer */
+static size_t CMC_(PFX, _impl_flatten)(struct SNAME *_set_, V *buffer)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    if (CMC_(PFX, _empty)(_set_))
+        return 0;
+
+    struct CMC_DEF_NODE(SNAME) *scan = _set_->root;
+
+    while (scan->left != NULL)
+        scan = scan->left;
+
+    size_t count = 0;
+
+    for (; scan != NULL; scan = CMC_(PFX, _impl_next_node)(scan))
+        buffer[count++] = scan->value;
+
+    return count;
+}
+
+/* Merges two sorted sequences keeping the values that are only in A, in */
+/* both or only in B. Values found in both are taken from A. */
+static size_t CMC_(PFX, _impl_merge_values)(struct SNAME *_set_, V *A, size_t count_A, V *B, size_t count_B, V *result,
+                                            bool only_A, bool both, bool only_B)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+#ifdef CMC_ARITHMETIC_V
+    if (!only_A && both && !only_B)
+        return CMC_(PFX, _impl_setops_intersection)(A, count_A, B, count_B, result);
+    if (only_A && both && only_B)
+        return CMC_(PFX, _impl_setops_union)(A, count_A, B, count_B, result);
+#endif
+
+    size_t i = 0, j = 0, k = 0;
+
+    while (i < count_A && j < count_B)
+    {
+        int c = _set_->f_val->cmp(A[i], B[j]);
+
+        if (c < 0)
+        {
+            if (only_A)
+                result[k++] = A[i];
+            i++;
+        }
+        else if (c > 0)
+        {
+            if (only_B)
+                result[k++] = B[j];
+            j++;
+        }
+        else
+        {
+            if (both)
+                result[k++] = A[i];
+            i++;
+            j++;
+        }
+    }
+
+    if (only_A)
+    {
+        while (i < count_A)
+            result[k++] = A[i++];
+    }
+
+    if (only_B)
+    {
+        while (j < count_B)
+            result[k++] = B[j++];
+    }
+
+    return k;
+}
+
+static struct SNAME *CMC_(PFX, _impl_set_operation)(struct SNAME *_set1_, struct SNAME *_set2_, bool only_A, bool both,
+                                                   bool only_B)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
+
+    if (!_set_r_)
+        return NULL;
+
+    size_t total = _set1_->count + _set2_->count;
+
+    if (total != 0)
+    {
+        /* Both sets flattened followed by the merged values */
+        V *buffer = _set1_->alloc->malloc(sizeof(V) * total * 2);
+
+        if (!buffer)
+        {
+            CMC_(PFX, _free)(_set_r_);
+            return NULL;
+        }
+
+        V *A = buffer;
+        V *B = buffer + _set1_->count;
+        V *R = buffer + total;
+
+        CMC_(PFX, _impl_flatten)(_set1_, A);
+        CMC_(PFX, _impl_flatten)(_set2_, B);
+
+        size_t count =
+            CMC_(PFX, _impl_merge_values)(_set1_, A, _set1_->count, B, _set2_->count, R, only_A, both, only_B);
+
+        bool built = CMC_(PFX, _impl_build)(_set_r_, R, count, NULL, &_set_r_->root);
+
+        _set1_->alloc->free(buffer);
+
+        if (!built)
+        {
+            CMC_(PFX, _free)(_set_r_);
+            return NULL;
+        }
+
+        _set_r_->count = count;
+    }
+
+    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+
+    return _set_r_;
+}
+
+#endif /* CMC_EXT_SETF || CMC_EXT_PSETF */
+
+/**
+ * PSETF
+ *
+ * Parallel set functions. Both sets are split into slices that are merged and
+ * built into subtrees by cmc_thread workers. The subtrees are then joined
+ * together. Nodes are allocated concurrently so the allocator must be thread
+ * safe.
+ */
+#ifdef CMC_EXT_PSETF
+
+/* Implementation detail functions */
+static size_t CMC_(PFX, _impl_psetf_lower_bound)(struct SNAME *_set_, V *array, size_t count, V value);
+static int CMC_(PFX, _impl_psetf_worker)(void *args);
+static struct SNAME *CMC_(PFX, _impl_set_operation_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, bool only_A,
+                                                            bool both, bool only_B, size_t n_threads);
+
+struct SNAME *CMC_(PFX, _union_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation_parallel)(_set1_, _set2_, true, true, true, n_threads);
+}
+
+struct SNAME *CMC_(PFX, _intersection_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation_parallel)(_set1_, _set2_, false, true, false, n_threads);
+}
+
+struct SNAME *CMC_(PFX, _difference_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation_parallel)(_set1_, _set2_, true, false, false, n_threads);
+}
+
+struct SNAME *CMC_(PFX, _symmetric_difference_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    return CMC_(PFX, _impl_set_operation_parallel)(_set1_, _set2_, true, false, true, n_threads);
+}
+
+static size_t CMC_(PFX, _impl_psetf_lower_bound)(struct SNAME *_set_, V *array, size_t count, V value)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    size_t L = 0;
+    size_t R = count;
+
+    while (L < R)
+    {
+        size_t M = L + (R - L) / 2;
+
+        if (_set_->f_val->cmp(array[M], value) < 0)
+            L = M + 1;
+        else
+            R = M;
+    }
+
+    return L;
+}
+
+static int CMC_(PFX, _impl_psetf_worker)(void *args)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    struct CMC_(SNAME, _psetf_task) *task = args;
+
+    task->count = CMC_(PFX, _impl_merge_values)(task->target, task->A, task->count_A, task->B, task->count_B,
+                                                task->result, task->only_A, task->both, task->only_B);
+
+    task->built = CMC_(PFX, _impl_build)(task->target, task->result, task->count, NULL, &task->root);
+
+    return task->built ? CMC_FLAG_OK : CMC_FLAG_ALLOC;
+}
+
+static struct SNAME *CMC_(PFX, _impl_set_operation_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, bool only_A,
+                                                            bool both, bool only_B, size_t n_threads)
+{
+#ifdef CMC_DEV
+    CMC_DEV_FCALL;
+#endif
+
+    /* Not worth splitting the work */
+    if (n_threads < 2 || _set1_->count < n_threads)
+        return CMC_(PFX, _impl_set_operation)(_set1_, _set2_, only_A, both, only_B);
+
+    struct SNAME *_set_r_ = CMC_(PFX, _new_custom)(_set1_->f_val, _set1_->alloc, NULL);
+
+    if (!_set_r_)
+        return NULL;
+
+    size_t total = _set1_->count + _set2_->count;
+
+    V *buffer = _set1_->alloc->malloc(sizeof(V) * total * 2);
+    struct CMC_(SNAME, _psetf_task) *tasks =
+        _set1_->alloc->malloc(sizeof(struct CMC_(SNAME, _psetf_task)) * n_threads);
+
+    if (!buffer || !tasks)
+    {
+        if (buffer)
+            _set1_->alloc->free(buffer);
+        if (tasks)
+            _set1_->alloc->free(tasks);
+
+        CMC_(PFX, _free)(_set_r_);
+        return NULL;
+    }
+
+    V *A = buffer;
+    V *B = buffer + _set1_->count;
+
+    size_t count_A = CMC_(PFX, _impl_flatten)(_set1_, A);
+    size_t count_B = CMC_(PFX, _impl_flatten)(_set2_, B);
+
+    /* Slices are split at values of A and every value of B equal to a */
+    /* splitter goes to the same slice as it */
+    size_t start_B = 0;
+
+    for (size_t t = 0; t < n_threads; t++)
+    {
+        size_t start_A = count_A * t / n_threads;
+        size_t end_A = count_A * (t + 1) / n_threads;
+        size_t end_B = count_B;
+
+        if (t + 1 < n_threads)
+            end_B = CMC_(PFX, _impl_psetf_lower_bound)(_set1_, B, count_B, A[end_A]);
+
+        struct CMC_(SNAME, _psetf_task) *task = &tasks[t];
+
+        task->target = _set_r_;
+        task->A = A + start_A;
+        task->count_A = end_A - start_A;
+        task->B = B + start_B;
+        task->count_B = end_B - start_B;
+        task->result = buffer + total + start_A + start_B;
+        task->count = 0;
+        task->only_A = only_A;
+        task->both = both;
+        task->only_B = only_B;
+        task->root = NULL;
+        task->built = false;
+        task->spawned = false;
+
+        start_B = end_B;
+    }
+
+    /* The current thread takes the first slice */
+    for (size_t t = 1; t < n_threads; t++)
+    {
+        struct CMC_(SNAME, _psetf_task) *task = &tasks[t];
+
+        task->spawned = cmc_thrd_create(&task->thread, CMC_(PFX, _impl_psetf_worker), task);
+    }
+
+    CMC_(PFX, _impl_psetf_worker)(&tasks[0]);
+
+    for (size_t t = 1; t < n_threads; t++)
+    {
+        struct CMC_(SNAME, _psetf_task) *task = &tasks[t];
+
+        /* Could not spawn a thread so do the work here */
+        if (!task->spawned)
+            CMC_(PFX, _impl_psetf_worker)(task);
+        else if (!cmc_thrd_join(&task->thread, NULL))
+            task->built = false;
+    }
+
+    bool built = true;
+    size_t count = 0;
+    struct CMC_DEF_NODE(SNAME) *root = NULL;
+
+    for (size_t t = 0; t < n_threads; t++)
+    {
+        built = built && tasks[t].built;
+        count += tasks[t].count;
+        root = CMC_(PFX, _impl_merge)(_set_r_, root, tasks[t].root);
+    }
+
+    _set1_->alloc->free(buffer);
+    _set1_->alloc->free(tasks);
+
+    if (!built)
+    {
+        CMC_(PFX, _impl_free_nodes)(_set_r_, root, false);
+        CMC_(PFX, _free)(_set_r_);
+        return NULL;
+    }
+
+    _set_r_->root = root;
+    _set_r_->count = count;
+
+    CMC_CALLBACKS_ASSIGN(_set_r_, _set1_->callbacks);
+
+    return _set_r_;
+}
+
+#endif /* CMC_EXT_PSETF */
+
 /**
  * STR
  *
@@ -61,6 +61,8 @@ struct CMC_DEF_ITER(SNAME)
 /* Iterator Initialization */
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_start)(struct SNAME *target);
 struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_end)(struct SNAME *target);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_lower_bound)(struct SNAME *target, V value);
+struct CMC_DEF_ITER(SNAME) CMC_(PFX, _iter_upper_bound)(struct SNAME *target, V value);
 /* Iterator State */
 bool CMC_(PFX, _iter_at_start)(struct CMC_DEF_ITER(SNAME) * iter);
 bool CMC_(PFX, _iter_at_end)(struct CMC_DEF_ITER(SNAME) * iter);
@@ -75,9 +77,40 @@ bool CMC_(PFX, _iter_go_to)(struct CMC_DEF_ITER(SNAME) * iter, size_t index);
 /* Iterator Access */
 V CMC_(PFX, _iter_value)(struct CMC_DEF_ITER(SNAME) * iter);
 size_t CMC_(PFX, _iter_index)(struct CMC_DEF_ITER(SNAME) * iter);
+/* Hinted Insertion */
+bool CMC_(PFX, _insert_hint)(struct SNAME *_set_, struct CMC_DEF_ITER(SNAME) * iter, V value);
 
 #endif /* CMC_EXT_ITER */
 
+/**
+ * RANK
+ *
+ * Order statistics. Every node keeps the size of its subtree, allowing
+ * elements to be accessed by their sorted position in O(log n).
+ */
+#ifdef CMC_EXT_RANK
+
+size_t CMC_(PFX, _rank)(struct SNAME *_set_, V value);
+bool CMC_(PFX, _select)(struct SNAME *_set_, size_t index, V *value);
+size_t CMC_(PFX, _count_range)(struct SNAME *_set_, V lower, V upper);
+
+#endif /* CMC_EXT_RANK */
+
+/**
+ * AGG
+ *
+ * User defined subtree aggregates. Available when the AGG data type is
+ * defined. Every node keeps the aggregate of its subtree, computed through the
+ * aggregate function table, allowing range aggregates in O(log n).
+ */
+#ifdef AGG
+
+void CMC_(PFX, _aggregate_with)(struct SNAME *_set_, struct CMC_DEF_FAGG(SNAME) * f_agg);
+AGG CMC_(PFX, _aggregate)(struct SNAME *_set_);
+AGG CMC_(PFX, _aggregate_range)(struct SNAME *_set_, V lower, V upper);
+
+#endif /* AGG */
+
 /**
  * SETF
  *
@@ -98,6 +131,21 @@ bool CMC_(PFX, _is_disjointset)(struct SNAME *_set1_, struct SNAME *_set2_);
 
 #endif /* CMC_EXT_SETF */
 
+/**
+ * PSETF
+ *
+ * Parallel set functions
+ */
+#ifdef CMC_EXT_PSETF
+
+/* Parallel Set Operations */
+struct SNAME *CMC_(PFX, _union_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads);
+struct SNAME *CMC_(PFX, _intersection_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads);
+struct SNAME *CMC_(PFX, _difference_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads);
+struct SNAME *CMC_(PFX, _symmetric_difference_parallel)(struct SNAME *_set1_, struct SNAME *_set2_, size_t n_threads);
+
+#endif /* CMC_EXT_PSETF */
+
 /**
  * STR
  *
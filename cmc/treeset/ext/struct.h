@@ -21,3 +21,40 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+
+/**
+ * PSETF
+ *
+ * Parallel set functions
+ */
+#ifdef CMC_EXT_PSETF
+
+/* A slice of a parallel set operation */
+struct CMC_(SNAME, _psetf_task)
+{
+    /* Set that will own the nodes */
+    struct SNAME *target;
+    /* Slice of the first set */
+    V *A;
+    size_t count_A;
+    /* Slice of the second set */
+    V *B;
+    size_t count_B;
+    /* Where the merged values are written */
+    V *result;
+    size_t count;
+    /* Which values are kept */
+    bool only_A;
+    bool both;
+    bool only_B;
+    /* Subtree built from the merged values */
+    struct CMC_DEF_NODE(SNAME) * root;
+    /* If the subtree was successfully built */
+    bool built;
+    /* The worker thread running this task */
+    struct cmc_thread thread;
+    /* If the worker thread was successfully created */
+    bool spawned;
+};
+
+#endif /* CMC_EXT_PSETF */
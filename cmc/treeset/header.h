@@ -39,11 +39,25 @@ struct CMC_DEF_FVAL(SNAME)
     CMC_DEF_FTAB_PRI(V);
 };
 
+#ifdef AGG
+/* Aggregate struct function table */
+struct CMC_DEF_FAGG(SNAME)
+{
+    /* Maps a single element to an aggregate */
+    AGG (*lift)(V);
+    /* Combines two aggregates (must be associative) */
+    AGG (*combine)(AGG, AGG);
+    /* Identity element of combine */
+    AGG identity;
+};
+#endif
+
 /* Collection Functions */
 /* Collection Allocation and Deallocation */
 struct SNAME *CMC_(PFX, _new)(struct CMC_DEF_FVAL(SNAME) * f_val);
 struct SNAME *CMC_(PFX, _new_custom)(struct CMC_DEF_FVAL(SNAME) * f_val, CMC_ALLOC_TYPE alloc,
                                      CMC_CALLBACK_TYPE callbacks);
+struct SNAME *CMC_(PFX, _from_sorted)(V *values, size_t count, struct CMC_DEF_FVAL(SNAME) * f_val);
 void CMC_(PFX, _clear)(struct SNAME *_set_);
 void CMC_(PFX, _free)(struct SNAME *_set_);
 /* Customization of Allocation and Callbacks */
@@ -51,14 +65,19 @@ void CMC_(PFX, _customize)(struct SNAME *_set_, CMC_ALLOC_TYPE alloc, CMC_CALLBA
 /* Collection Input and Output */
 bool CMC_(PFX, _insert)(struct SNAME *_set_, V value);
 bool CMC_(PFX, _remove)(struct SNAME *_set_, V value);
+size_t CMC_(PFX, _remove_range)(struct SNAME *_set_, V lower, V upper);
 /* Element Access */
 bool CMC_(PFX, _max)(struct SNAME *_set_, V *value);
 bool CMC_(PFX, _min)(struct SNAME *_set_, V *value);
+bool CMC_(PFX, _floor)(struct SNAME *_set_, V value, V *out_value);
+bool CMC_(PFX, _ceiling)(struct SNAME *_set_, V value, V *out_value);
+size_t CMC_(PFX, _range)(struct SNAME *_set_, V lower, V upper, bool (*visitor)(V, void *), void *args);
 /* Collection State */
 bool CMC_(PFX, _contains)(struct SNAME *_set_, V value);
 bool CMC_(PFX, _empty)(struct SNAME *_set_);
 size_t CMC_(PFX, _count)(struct SNAME *_set_);
 int CMC_(PFX, _flag)(struct SNAME *_set_);
 /* Collection Utility */
+bool CMC_(PFX, _compact)(struct SNAME *_set_);
 struct SNAME *CMC_(PFX, _copy_of)(struct SNAME *_set_);
 bool CMC_(PFX, _equals)(struct SNAME *_set1_, struct SNAME *_set2_);
@@ -0,0 +1,245 @@
+/**
+ * Copyright (c) 2019 Leonardo Vencovsky
+ *
+ * This file is part of the C Macro Collections Library.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/**
+ * mremap.h
+ *
+ * Creation Date: 18/10/2026
+ *
+ * Authors:
+ * Leonardo Vencovsky (https://github.com/LeoVen)
+ *
+ */
+
+/**
+ * A custom allocation node for huge dynamic arrays
+ *
+ * Blocks of at least CMC_MREMAP_THRESHOLD bytes get their own memory mapping.
+ * Reallocating them asks the kernel to remap their pages with mremap(),
+ * which grows a buffer without copying it no matter how large it is. Smaller
+ * blocks use the standard library allocator. A block is copied only once,
+ * when it first grows past the threshold.
+ *
+ * Where mremap() is not available (anything but Linux) every block uses the
+ * standard library allocator.
+ *
+ * Variables
+ *  - cmc_alloc_node_mremap
+ */
+
+#ifndef CMC_UTL_MREMAP_H
+#define CMC_UTL_MREMAP_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "../cor/alloc.h"
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#if defined(MAP_ANONYMOUS)
+#define CMC_MREMAP_LINUX
+#endif
+#endif
+
+#if defined(CMC_MREMAP_LINUX) && !defined(MREMAP_MAYMOVE)
+/* Only declared by sys/mman.h with _GNU_SOURCE */
+#define MREMAP_MAYMOVE 1
+extern void *mremap(void *old_address, size_t old_size, size_t new_size, int flags, ...);
+#endif
+
+/**
+ * CMC_MREMAP_THRESHOLD
+ *
+ * Size in bytes from which a block gets its own memory mapping.
+ */
+#ifndef CMC_MREMAP_THRESHOLD
+#define CMC_MREMAP_THRESHOLD ((size_t)1 << 20)
+#endif
+
+/* Every block starts with the length of its mapping, or 0 if it doesn't have */
+/* one, and its size. The header keeps the block aligned like malloc(). */
+#define CMC_MREMAP_HEADER 16
+
+#ifdef CMC_MREMAP_LINUX
+/* Length of a mapping that fits a block of size bytes, or 0 if it overflows */
+static inline size_t cmc_mremap_length(size_t size)
+{
+    size_t page = (size_t)sysconf(_SC_PAGESIZE);
+
+    if (size > SIZE_MAX - CMC_MREMAP_HEADER - page)
+        return 0;
+
+    return (size + CMC_MREMAP_HEADER + page - 1) / page * page;
+}
+
+/* Maps a new block. Its pages are zeroed by the kernel. */
+static inline void *cmc_mremap_map(size_t size)
+{
+    size_t length = cmc_mremap_length(size);
+
+    if (length == 0)
+        return NULL;
+
+    char *base = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if (base == MAP_FAILED)
+        return NULL;
+
+    ((size_t *)base)[0] = length;
+    ((size_t *)base)[1] = size;
+
+    return base + CMC_MREMAP_HEADER;
+}
+#endif
+
+static inline void *cmc_mremap_malloc(size_t size)
+{
+#ifdef CMC_MREMAP_LINUX
+    if (size >= CMC_MREMAP_THRESHOLD)
+        return cmc_mremap_map(size);
+#endif
+
+    if (size > SIZE_MAX - CMC_MREMAP_HEADER)
+        return NULL;
+
+    char *base = malloc(size + CMC_MREMAP_HEADER);
+
+    if (!base)
+        return NULL;
+
+    ((size_t *)base)[0] = 0;
+    ((size_t *)base)[1] = size;
+
+    return base + CMC_MREMAP_HEADER;
+}
+
+static inline void *cmc_mremap_calloc(size_t count, size_t size)
+{
+    if (size != 0 && count > SIZE_MAX / size)
+        return NULL;
+
+    size *= count;
+
+#ifdef CMC_MREMAP_LINUX
+    if (size >= CMC_MREMAP_THRESHOLD)
+        return cmc_mremap_map(size);
+#endif
+
+    if (size > SIZE_MAX - CMC_MREMAP_HEADER)
+        return NULL;
+
+    char *base = calloc(1, size + CMC_MREMAP_HEADER);
+
+    if (!base)
+        return NULL;
+
+    ((size_t *)base)[1] = size;
+
+    return base + CMC_MREMAP_HEADER;
+}
+
+static inline void *cmc_mremap_realloc(void *block, size_t size)
+{
+    if (!block)
+        return cmc_mremap_malloc(size);
+
+    char *base = (char *)block - CMC_MREMAP_HEADER;
+
+#ifdef CMC_MREMAP_LINUX
+    size_t mapped = ((size_t *)base)[0];
+
+    if (mapped != 0)
+    {
+        size_t length = cmc_mremap_length(size);
+
+        if (length == 0)
+            return NULL;
+
+        if (length != mapped)
+        {
+            base = mremap(base, mapped, length, MREMAP_MAYMOVE);
+
+            if (base == MAP_FAILED)
+                return NULL;
+        }
+
+        ((size_t *)base)[0] = length;
+        ((size_t *)base)[1] = size;
+
+        return base + CMC_MREMAP_HEADER;
+    }
+
+    if (size >= CMC_MREMAP_THRESHOLD)
+    {
+        size_t old_size = ((size_t *)base)[1];
+        void *result = cmc_mremap_map(size);
+
+        if (!result)
+            return NULL;
+
+        memcpy(result, block, old_size < size ? old_size : size);
+        free(base);
+
+        return result;
+    }
+#endif
+
+    if (size > SIZE_MAX - CMC_MREMAP_HEADER)
+        return NULL;
+
+    base = realloc(base, size + CMC_MREMAP_HEADER);
+
+    if (!base)
+        return NULL;
+
+    ((size_t *)base)[1] = size;
+
+    return base + CMC_MREMAP_HEADER;
+}
+
+static inline void cmc_mremap_free(void *block)
+{
+    if (!block)
+        return;
+
+    char *base = (char *)block - CMC_MREMAP_HEADER;
+
+#ifdef CMC_MREMAP_LINUX
+    if (((size_t *)base)[0] != 0)
+    {
+        munmap(base, ((size_t *)base)[0]);
+        return;
+    }
+#endif
+
+    free(base);
+}
+
+static struct CMC_ALLOC_NODE_NAME CMC_UNUSED cmc_alloc_node_mremap = { cmc_mremap_malloc, cmc_mremap_calloc,
+                                                                        cmc_mremap_realloc, cmc_mremap_free };
+
+#endif /* CMC_UTL_MREMAP_H */
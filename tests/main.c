@@ -2,15 +2,25 @@
 #include <stdio.h>
 
 #define CMC_EXT_FALLTHROUGH
+#define CMC_EXT_ALGO
 #define CMC_EXT_INIT
 #define CMC_EXT_ITER
 #define CMC_EXT_NODE
+#define CMC_EXT_PSETF
+#define CMC_EXT_PSORT
+#define CMC_EXT_RANK
 #define CMC_EXT_SEQ
 #define CMC_EXT_SETF
 #define CMC_EXT_STR
+#define CMC_EXT_VIEW
+#define CMC_EXT_XSORT
 
 #include "unt_bitset.h"
+#include "unt_cskiplist.h"
 #include "unt_deque.h"
+#include "unt_flatmap.h"
+#include "unt_flatset.h"
+#include "unt_gaplist.h"
 #include "unt_hashbidimap.h"
 #include "unt_hashmap.h"
 #include "unt_hashmultimap.h"
@@ -20,10 +30,17 @@
 #include "unt_intervalheap.h"
 #include "unt_linkedlist.h"
 #include "unt_list.h"
+#include "unt_packedlist.h"
+#include "unt_ptreemap.h"
 #include "unt_queue.h"
+#include "unt_segdeque.h"
+#include "unt_skiplist.h"
 #include "unt_sortedlist.h"
 #include "unt_stack.h"
+#include "unt_treebidimap.h"
 #include "unt_treemap.h"
+#include "unt_treemultimap.h"
+#include "unt_treemultiset.h"
 #include "unt_treeset.h"
 
 #include "unt_foreach.h"
@@ -64,8 +81,16 @@ int main(void)
 
     cmc_run(CMCBitSet, units, tests);
     cmc_run(CMCBitSetIter, units, tests);
+    cmc_run(CMCCSkipList, units, tests);
+    cmc_run(CMCCSkipListIter, units, tests);
     cmc_run(CMCDeque, units, tests);
     cmc_run(CMCDequeIter, units, tests);
+    cmc_run(CMCFlatMap, units, tests);
+    cmc_run(CMCFlatMapIter, units, tests);
+    cmc_run(CMCFlatSet, units, tests);
+    cmc_run(CMCFlatSetIter, units, tests);
+    cmc_run(CMCGapList, units, tests);
+    cmc_run(CMCGapListIter, units, tests);
     cmc_run(CMCHashBidiMap, units, tests);
     cmc_run(CMCHashBidiMapIter, units, tests);
     cmc_run(CMCHashMap, units, tests);
@@ -84,14 +109,28 @@ int main(void)
     cmc_run(CMCLinkedListIter, units, tests);
     cmc_run(CMCList, units, tests);
     cmc_run(CMCListIter, units, tests);
+    cmc_run(CMCPackedList, units, tests);
+    cmc_run(CMCPackedListIter, units, tests);
+    cmc_run(CMCPTreeMap, units, tests);
+    cmc_run(CMCPTreeMapIter, units, tests);
     cmc_run(CMCQueue, units, tests);
     cmc_run(CMCQueueIter, units, tests);
+    cmc_run(CMCSegDeque, units, tests);
+    cmc_run(CMCSegDequeIter, units, tests);
+    cmc_run(CMCSkipList, units, tests);
+    cmc_run(CMCSkipListIter, units, tests);
     cmc_run(CMCSortedList, units, tests);
     cmc_run(CMCSortedListIter, units, tests);
     cmc_run(CMCStack, units, tests);
     cmc_run(CMCStackIter, units, tests);
+    cmc_run(CMCTreeBidiMap, units, tests);
+    cmc_run(CMCTreeBidiMapIter, units, tests);
     cmc_run(CMCTreeMap, units, tests);
     cmc_run(CMCTreeMapIter, units, tests);
+    cmc_run(CMCTreeMultiMap, units, tests);
+    cmc_run(CMCTreeMultiMapIter, units, tests);
+    cmc_run(CMCTreeMultiSet, units, tests);
+    cmc_run(CMCTreeMultiSetIter, units, tests);
     cmc_run(CMCTreeSet, units, tests);
     cmc_run(CMCTreeSetIter, units, tests);
 
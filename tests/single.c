@@ -5,15 +5,25 @@
 
 #define CMC_ARGS_FALLTHROUGH
 
+#define CMC_EXT_ALGO
 #define CMC_EXT_INIT
 #define CMC_EXT_ITER
 #define CMC_EXT_NODE
+#define CMC_EXT_PSETF
+#define CMC_EXT_PSORT
+#define CMC_EXT_RANK
 #define CMC_EXT_SEQ
 #define CMC_EXT_SETF
 #define CMC_EXT_STR
+#define CMC_EXT_VIEW
+#define CMC_EXT_XSORT
 
 #include "unt_bitset.h"
+#include "unt_cskiplist.h"
 #include "unt_deque.h"
+#include "unt_flatmap.h"
+#include "unt_flatset.h"
+#include "unt_gaplist.h"
 #include "unt_hashbidimap.h"
 #include "unt_hashmap.h"
 #include "unt_hashmultimap.h"
@@ -23,10 +33,17 @@
 #include "unt_intervalheap.h"
 #include "unt_linkedlist.h"
 #include "unt_list.h"
+#include "unt_packedlist.h"
+#include "unt_ptreemap.h"
 #include "unt_queue.h"
+#include "unt_segdeque.h"
+#include "unt_skiplist.h"
 #include "unt_sortedlist.h"
 #include "unt_stack.h"
+#include "unt_treebidimap.h"
 #include "unt_treemap.h"
+#include "unt_treemultimap.h"
+#include "unt_treemultiset.h"
 #include "unt_treeset.h"
 
 #define cmc_run(unit, unit_fails, test_fails) \
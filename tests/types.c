@@ -89,10 +89,56 @@ typedef int array_int[10];
 #define K struct_t *
 #define V struct_t *
 #include "cmc/treemap.h"
+#define PFX ptm0
+#define SNAME ptreemap0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/ptreemap.h"
+#define PFX skl0
+#define SNAME skiplist0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/skiplist.h"
+#define PFX csl0
+#define SNAME cskiplist0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/cskiplist.h"
+#define PFX tmm0
+#define SNAME treemultimap0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/treemultimap.h"
+#define PFX tms0
+#define SNAME treemultiset0
+#define V struct_t *
+#include "cmc/treemultiset.h"
+#define PFX tbm0
+#define SNAME treebidimap0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/treebidimap.h"
 #define PFX ts0
 #define SNAME treeset0
 #define V struct_t *
 #include "cmc/treeset.h"
+#define PFX fm0
+#define SNAME flatmap0
+#define K struct_t *
+#define V struct_t *
+#include "cmc/flatmap.h"
+#define PFX fs0
+#define SNAME flatset0
+#define V struct_t *
+#include "cmc/flatset.h"
+#define PFX gl0
+#define SNAME gaplist0
+#define V struct_t *
+#include "cmc/gaplist.h"
+#define PFX sd0
+#define SNAME segdeque0
+#define V struct_t *
+#include "cmc/segdeque.h"
 
 #define PFX b1
 #define SNAME bitset1
@@ -157,10 +203,56 @@ typedef int array_int[10];
 #define K struct_t
 #define V struct_t
 #include "cmc/treemap.h"
+#define PFX ptm1
+#define SNAME ptreemap1
+#define K struct_t
+#define V struct_t
+#include "cmc/ptreemap.h"
+#define PFX skl1
+#define SNAME skiplist1
+#define K struct_t
+#define V struct_t
+#include "cmc/skiplist.h"
+#define PFX csl1
+#define SNAME cskiplist1
+#define K struct_t
+#define V struct_t
+#include "cmc/cskiplist.h"
+#define PFX tmm1
+#define SNAME treemultimap1
+#define K struct_t
+#define V struct_t
+#include "cmc/treemultimap.h"
+#define PFX tms1
+#define SNAME treemultiset1
+#define V struct_t
+#include "cmc/treemultiset.h"
+#define PFX tbm1
+#define SNAME treebidimap1
+#define K struct_t
+#define V struct_t
+#include "cmc/treebidimap.h"
 #define PFX ts1
 #define SNAME treeset1
 #define V struct_t
 #include "cmc/treeset.h"
+#define PFX fm1
+#define SNAME flatmap1
+#define K struct_t
+#define V struct_t
+#include "cmc/flatmap.h"
+#define PFX fs1
+#define SNAME flatset1
+#define V struct_t
+#include "cmc/flatset.h"
+#define PFX gl1
+#define SNAME gaplist1
+#define V struct_t
+#include "cmc/gaplist.h"
+#define PFX sd1
+#define SNAME segdeque1
+#define V struct_t
+#include "cmc/segdeque.h"
 
 #define PFX b2
 #define SNAME bitset2
@@ -225,10 +317,56 @@ typedef int array_int[10];
 #define K int
 #define V int
 #include "cmc/treemap.h"
+#define PFX ptm2
+#define SNAME ptreemap2
+#define K int
+#define V int
+#include "cmc/ptreemap.h"
+#define PFX skl2
+#define SNAME skiplist2
+#define K int
+#define V int
+#include "cmc/skiplist.h"
+#define PFX csl2
+#define SNAME cskiplist2
+#define K int
+#define V int
+#include "cmc/cskiplist.h"
+#define PFX tmm2
+#define SNAME treemultimap2
+#define K int
+#define V int
+#include "cmc/treemultimap.h"
+#define PFX tms2
+#define SNAME treemultiset2
+#define V int
+#include "cmc/treemultiset.h"
+#define PFX tbm2
+#define SNAME treebidimap2
+#define K int
+#define V int
+#include "cmc/treebidimap.h"
 #define PFX ts2
 #define SNAME treeset2
 #define V int
 #include "cmc/treeset.h"
+#define PFX fm2
+#define SNAME flatmap2
+#define K int
+#define V int
+#include "cmc/flatmap.h"
+#define PFX fs2
+#define SNAME flatset2
+#define V int
+#include "cmc/flatset.h"
+#define PFX gl2
+#define SNAME gaplist2
+#define V int
+#include "cmc/gaplist.h"
+#define PFX sd2
+#define SNAME segdeque2
+#define V int
+#include "cmc/segdeque.h"
 
 #define PFX b3
 #define SNAME bitset3
@@ -293,10 +431,56 @@ typedef int array_int[10];
 #define K int *
 #define V int *
 #include "cmc/treemap.h"
+#define PFX ptm3
+#define SNAME ptreemap3
+#define K int *
+#define V int *
+#include "cmc/ptreemap.h"
+#define PFX skl3
+#define SNAME skiplist3
+#define K int *
+#define V int *
+#include "cmc/skiplist.h"
+#define PFX csl3
+#define SNAME cskiplist3
+#define K int *
+#define V int *
+#include "cmc/cskiplist.h"
+#define PFX tmm3
+#define SNAME treemultimap3
+#define K int *
+#define V int *
+#include "cmc/treemultimap.h"
+#define PFX tms3
+#define SNAME treemultiset3
+#define V int *
+#include "cmc/treemultiset.h"
+#define PFX tbm3
+#define SNAME treebidimap3
+#define K int *
+#define V int *
+#include "cmc/treebidimap.h"
 #define PFX ts3
 #define SNAME treeset3
 #define V int *
 #include "cmc/treeset.h"
+#define PFX fm3
+#define SNAME flatmap3
+#define K int *
+#define V int *
+#include "cmc/flatmap.h"
+#define PFX fs3
+#define SNAME flatset3
+#define V int *
+#include "cmc/flatset.h"
+#define PFX gl3
+#define SNAME gaplist3
+#define V int *
+#include "cmc/gaplist.h"
+#define PFX sd3
+#define SNAME segdeque3
+#define V int *
+#include "cmc/segdeque.h"
 
 #define PFX b4
 #define SNAME bitset4
@@ -361,10 +545,56 @@ typedef int array_int[10];
 #define K enum_t
 #define V enum_t
 #include "cmc/treemap.h"
+#define PFX ptm4
+#define SNAME ptreemap4
+#define K enum_t
+#define V enum_t
+#include "cmc/ptreemap.h"
+#define PFX skl4
+#define SNAME skiplist4
+#define K enum_t
+#define V enum_t
+#include "cmc/skiplist.h"
+#define PFX csl4
+#define SNAME cskiplist4
+#define K enum_t
+#define V enum_t
+#include "cmc/cskiplist.h"
+#define PFX tmm4
+#define SNAME treemultimap4
+#define K enum_t
+#define V enum_t
+#include "cmc/treemultimap.h"
+#define PFX tms4
+#define SNAME treemultiset4
+#define V enum_t
+#include "cmc/treemultiset.h"
+#define PFX tbm4
+#define SNAME treebidimap4
+#define K enum_t
+#define V enum_t
+#include "cmc/treebidimap.h"
 #define PFX ts4
 #define SNAME treeset4
 #define V enum_t
 #include "cmc/treeset.h"
+#define PFX fm4
+#define SNAME flatmap4
+#define K enum_t
+#define V enum_t
+#include "cmc/flatmap.h"
+#define PFX fs4
+#define SNAME flatset4
+#define V enum_t
+#include "cmc/flatset.h"
+#define PFX gl4
+#define SNAME gaplist4
+#define V enum_t
+#include "cmc/gaplist.h"
+#define PFX sd4
+#define SNAME segdeque4
+#define V enum_t
+#include "cmc/segdeque.h"
 
 #define PFX b5
 #define SNAME bitset5
@@ -429,10 +659,48 @@ typedef int array_int[10];
 #define K enum_t *
 #define V enum_t *
 #include "cmc/treemap.h"
+#define PFX ptm5
+#define SNAME ptreemap5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/ptreemap.h"
+#define PFX skl5
+#define SNAME skiplist5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/skiplist.h"
+#define PFX csl5
+#define SNAME cskiplist5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/cskiplist.h"
+#define PFX tmm5
+#define SNAME treemultimap5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/treemultimap.h"
+#define PFX tms5
+#define SNAME treemultiset5
+#define V enum_t *
+#include "cmc/treemultiset.h"
+#define PFX tbm5
+#define SNAME treebidimap5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/treebidimap.h"
 #define PFX ts5
 #define SNAME treeset5
 #define V enum_t *
 #include "cmc/treeset.h"
+#define PFX fm5
+#define SNAME flatmap5
+#define K enum_t *
+#define V enum_t *
+#include "cmc/flatmap.h"
+#define PFX fs5
+#define SNAME flatset5
+#define V enum_t *
+#include "cmc/flatset.h"
 
 #define PFX b6
 #define SNAME bitset6
@@ -497,10 +765,48 @@ typedef int array_int[10];
 #define K union_t
 #define V union_t
 #include "cmc/treemap.h"
+#define PFX ptm6
+#define SNAME ptreemap6
+#define K union_t
+#define V union_t
+#include "cmc/ptreemap.h"
+#define PFX skl6
+#define SNAME skiplist6
+#define K union_t
+#define V union_t
+#include "cmc/skiplist.h"
+#define PFX csl6
+#define SNAME cskiplist6
+#define K union_t
+#define V union_t
+#include "cmc/cskiplist.h"
+#define PFX tmm6
+#define SNAME treemultimap6
+#define K union_t
+#define V union_t
+#include "cmc/treemultimap.h"
+#define PFX tms6
+#define SNAME treemultiset6
+#define V union_t
+#include "cmc/treemultiset.h"
+#define PFX tbm6
+#define SNAME treebidimap6
+#define K union_t
+#define V union_t
+#include "cmc/treebidimap.h"
 #define PFX ts6
 #define SNAME treeset6
 #define V union_t
 #include "cmc/treeset.h"
+#define PFX fm6
+#define SNAME flatmap6
+#define K union_t
+#define V union_t
+#include "cmc/flatmap.h"
+#define PFX fs6
+#define SNAME flatset6
+#define V union_t
+#include "cmc/flatset.h"
 
 #define PFX b7
 #define SNAME bitset7
@@ -565,10 +871,48 @@ typedef int array_int[10];
 #define K union_t *
 #define V union_t *
 #include "cmc/treemap.h"
+#define PFX ptm7
+#define SNAME ptreemap7
+#define K union_t *
+#define V union_t *
+#include "cmc/ptreemap.h"
+#define PFX skl7
+#define SNAME skiplist7
+#define K union_t *
+#define V union_t *
+#include "cmc/skiplist.h"
+#define PFX csl7
+#define SNAME cskiplist7
+#define K union_t *
+#define V union_t *
+#include "cmc/cskiplist.h"
+#define PFX tmm7
+#define SNAME treemultimap7
+#define K union_t *
+#define V union_t *
+#include "cmc/treemultimap.h"
+#define PFX tms7
+#define SNAME treemultiset7
+#define V union_t *
+#include "cmc/treemultiset.h"
+#define PFX tbm7
+#define SNAME treebidimap7
+#define K union_t *
+#define V union_t *
+#include "cmc/treebidimap.h"
 #define PFX ts7
 #define SNAME treeset7
 #define V union_t *
 #include "cmc/treeset.h"
+#define PFX fm7
+#define SNAME flatmap7
+#define K union_t *
+#define V union_t *
+#include "cmc/flatmap.h"
+#define PFX fs7
+#define SNAME flatset7
+#define V union_t *
+#include "cmc/flatset.h"
 
 #define PFX b8
 #define SNAME bitset8
@@ -633,10 +977,48 @@ typedef int array_int[10];
 #define K func_t *
 #define V func_t *
 #include "cmc/treemap.h"
+#define PFX ptm8
+#define SNAME ptreemap8
+#define K func_t *
+#define V func_t *
+#include "cmc/ptreemap.h"
+#define PFX skl8
+#define SNAME skiplist8
+#define K func_t *
+#define V func_t *
+#include "cmc/skiplist.h"
+#define PFX csl8
+#define SNAME cskiplist8
+#define K func_t *
+#define V func_t *
+#include "cmc/cskiplist.h"
+#define PFX tmm8
+#define SNAME treemultimap8
+#define K func_t *
+#define V func_t *
+#include "cmc/treemultimap.h"
+#define PFX tms8
+#define SNAME treemultiset8
+#define V func_t *
+#include "cmc/treemultiset.h"
+#define PFX tbm8
+#define SNAME treebidimap8
+#define K func_t *
+#define V func_t *
+#include "cmc/treebidimap.h"
 #define PFX ts8
 #define SNAME treeset8
 #define V func_t *
 #include "cmc/treeset.h"
+#define PFX fm8
+#define SNAME flatmap8
+#define K func_t *
+#define V func_t *
+#include "cmc/flatmap.h"
+#define PFX fs8
+#define SNAME flatset8
+#define V func_t *
+#include "cmc/flatset.h"
 
 int main(void)
 {
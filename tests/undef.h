@@ -0,0 +1,12 @@
+/* Included by the unit tests right after a collection instantiated with a */
+/* value type or flags other than the defaults. tests/single.c defines */
+/* CMC_ARGS_FALLTHROUGH so these are not undefined by cmc/cor/undef.h and */
+/* would otherwise carry over to the next collection. */
+/* No include guard: this file is meant to be included many times. */
+
+#undef V
+#undef CMC_ARITHMETIC_V
+#undef CMC_TRIVIAL_V
+#undef CMC_SORT_KEY
+#undef CMC_SBO
+#undef CMC_GAPLIST_LIST
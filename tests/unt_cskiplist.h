@@ -0,0 +1,359 @@
+#ifndef CMC_TESTS_UNT_CSKIPLIST_H
+#define CMC_TESTS_UNT_CSKIPLIST_H
+
+#include "utl.h"
+
+#include "cmc/utl/thread.h"
+
+#define V size_t
+#define K size_t
+#define PFX csl
+#define SNAME cskiplist
+#include "cmc/cskiplist.h"
+
+struct cskiplist_fkey *csl_fkey = &(struct cskiplist_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct cskiplist_fval *csl_fval = &(struct cskiplist_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct csl_worker_args
+{
+    struct cskiplist *map;
+    size_t first;
+    size_t step;
+    size_t inserted;
+    size_t removed;
+};
+
+/* Inserts every key of its slice, removes the odd ones and reads the map */
+int csl_worker(void *args)
+{
+    struct csl_worker_args *w = args;
+
+    for (size_t i = w->first; i < 4000; i += w->step)
+        w->inserted += csl_insert(w->map, i, i * 2);
+
+    for (size_t i = w->first; i < 4000; i += w->step)
+    {
+        if (i % 2 == 1)
+            w->removed += csl_remove(w->map, i, NULL);
+    }
+
+    for (size_t i = 0; i < 4000; i += 2)
+    {
+        if (csl_contains(w->map, i) && csl_get(w->map, i) != i * 2)
+            return 1;
+    }
+
+    return 0;
+}
+
+/* Every thread fights over the same keys */
+int csl_contender(void *args)
+{
+    struct csl_worker_args *w = args;
+
+    for (size_t round = 0; round < 50; round++)
+    {
+        for (size_t i = 0; i < 100; i++)
+            w->inserted += csl_insert(w->map, i, i);
+
+        for (size_t i = 0; i < 100; i++)
+            w->removed += csl_remove(w->map, i, NULL);
+    }
+
+    return 0;
+}
+
+CMC_CREATE_UNIT(CMCCSkipList, true, {
+    CMC_CREATE_TEST(new, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_not_equals(ptr, NULL, map->head);
+        cmc_assert_equals(size_t, 0, csl_count(map));
+        cmc_assert(csl_empty(map));
+
+        csl_free(map);
+
+        cmc_assert_equals(ptr, NULL, csl_new(NULL, csl_fval));
+        cmc_assert_equals(ptr, NULL, csl_new(csl_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(insert, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(csl_insert(map, (i * 7919) % 1009, i));
+
+        cmc_assert_equals(size_t, 1000, csl_count(map));
+
+        cmc_assert(!csl_insert(map, 7919 % 1009, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, csl_flag(map));
+        cmc_assert_equals(size_t, 1, csl_get(map, 7919 % 1009));
+
+        size_t key;
+        cmc_assert(csl_min(map, &key, NULL));
+        cmc_assert_equals(size_t, 1, key);
+        cmc_assert(csl_max(map, &key, NULL));
+        cmc_assert_equals(size_t, 1008, key);
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(remove, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t value;
+
+        cmc_assert(!csl_remove(map, 1, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, csl_flag(map));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(csl_insert(map, i, i * 2));
+
+        cmc_assert(!csl_remove(map, 1001, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, csl_flag(map));
+
+        for (size_t i = 1; i <= 1000; i += 3)
+        {
+            cmc_assert(csl_remove(map, i, &value));
+            cmc_assert_equals(size_t, i * 2, value);
+        }
+
+        cmc_assert_equals(size_t, 666, csl_count(map));
+        cmc_assert(!csl_contains(map, 1));
+        cmc_assert(csl_contains(map, 2));
+
+        // Removed nodes are kept until they are reclaimed
+        cmc_assert_not_equals(ptr, NULL, map->retired);
+        csl_reclaim(map);
+        cmc_assert_equals(ptr, NULL, map->retired);
+
+        cmc_assert(!csl_contains(map, 1));
+        cmc_assert(csl_insert(map, 1, 1));
+        cmc_assert(csl_contains(map, 1));
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(floor_ceiling, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key;
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(csl_insert(map, i, i));
+
+        cmc_assert(csl_floor(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 50, key);
+        cmc_assert(csl_floor(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!csl_floor(map, 5, &key, NULL));
+
+        cmc_assert(csl_ceiling(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(csl_ceiling(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!csl_ceiling(map, 101, &key, NULL));
+
+        cmc_assert(csl_remove(map, 60, NULL));
+        cmc_assert(csl_ceiling(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 70, key);
+        cmc_assert(csl_floor(map, 65, &key, NULL));
+        cmc_assert_equals(size_t, 50, key);
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(threads, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct csl_worker_args args[4];
+        struct cmc_thread threads[4];
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            args[i] = (struct csl_worker_args){ 0 };
+            args[i].map = map;
+            args[i].first = i;
+            args[i].step = 4;
+            cmc_assert(cmc_thrd_create(&threads[i], csl_worker, &args[i]));
+        }
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            int result = 1;
+            cmc_assert(cmc_thrd_join(&threads[i], &result));
+            cmc_assert_equals(int32_t, 0, result);
+            cmc_assert_equals(size_t, 1000, args[i].inserted);
+            cmc_assert_equals(size_t, i % 2 == 1 ? 1000 : 0, args[i].removed);
+        }
+
+        cmc_assert_equals(size_t, 2000, csl_count(map));
+
+        size_t expected = 0;
+
+        for (struct cskiplist_iter it = csl_iter_start(map); !csl_iter_at_end(&it); csl_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, expected, csl_iter_key(&it));
+            expected += 2;
+        }
+
+        cmc_assert_equals(size_t, 4000, expected);
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(contention, {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct csl_worker_args args[4];
+        struct cmc_thread threads[4];
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            args[i] = (struct csl_worker_args){ 0 };
+            args[i].map = map;
+            args[i].first = 0;
+            args[i].step = 1;
+            cmc_assert(cmc_thrd_create(&threads[i], csl_contender, &args[i]));
+        }
+
+        size_t inserted = 0;
+        size_t removed = 0;
+
+        for (size_t i = 0; i < 4; i++)
+        {
+            cmc_assert(cmc_thrd_join(&threads[i], NULL));
+
+            inserted += args[i].inserted;
+            removed += args[i].removed;
+        }
+
+        // Each successful removal matches exactly one successful insertion
+        cmc_assert_equals(size_t, inserted - removed, csl_count(map));
+
+        size_t count = 0;
+
+        for (struct cskiplist_iter it = csl_iter_start(map); !csl_iter_at_end(&it); csl_iter_next(&it))
+            count++;
+
+        cmc_assert_equals(size_t, csl_count(map), count);
+
+        csl_free(map);
+    });
+});
+
+CMC_CREATE_UNIT(CMCCSkipListIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct cskiplist_iter it = csl_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert(csl_iter_at_end(&it));
+        cmc_assert(!csl_iter_next(&it));
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(csl_insert(map, i, i));
+
+        it = csl_iter_start(map);
+
+        cmc_assert_equals(size_t, 0, csl_iter_index(&it));
+        cmc_assert_equals(size_t, 1, csl_iter_key(&it));
+        cmc_assert(!csl_iter_at_end(&it));
+
+        cmc_assert(csl_iter_advance(&it, 2));
+        cmc_assert_equals(size_t, 3, csl_iter_value(&it));
+        cmc_assert(!csl_iter_next(&it));
+        cmc_assert(csl_iter_at_end(&it));
+        cmc_assert_equals(size_t, 3, csl_iter_key(&it));
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(csl_insert(map, i, i));
+
+        struct cskiplist_iter it = csl_iter_start(map);
+
+        // Removed keys ahead of the iterator are skipped
+        for (size_t i = 1; i < 100; i += 2)
+            cmc_assert(csl_remove(map, i, NULL));
+
+        size_t expected = 0;
+
+        for (; !csl_iter_at_end(&it); csl_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, expected, csl_iter_key(&it));
+            expected += 2;
+        }
+
+        cmc_assert_equals(size_t, 100, expected);
+
+        csl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct cskiplist *map = csl_new(csl_fkey, csl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(csl_insert(map, i, i));
+
+        struct cskiplist_iter it = csl_iter_lower_bound(map, 35);
+
+        cmc_assert_equals(size_t, 40, csl_iter_key(&it));
+        cmc_assert(csl_iter_next(&it));
+        cmc_assert_equals(size_t, 50, csl_iter_key(&it));
+
+        it = csl_iter_lower_bound(map, 100);
+        cmc_assert_equals(size_t, 100, csl_iter_key(&it));
+        cmc_assert(!csl_iter_at_end(&it));
+
+        it = csl_iter_lower_bound(map, 101);
+        cmc_assert(csl_iter_at_end(&it));
+
+        csl_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCCSkipList() + CMCCSkipListIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCCSkipList Suit : %-44s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_CSKIPLIST_H */
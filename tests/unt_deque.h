@@ -12,13 +12,53 @@ struct deque_fval *d_fval = &(struct deque_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* A deque of signed 32 bit integers with the arithmetic kernels */
+#undef V
+#define V int32_t
+#define PFX da
+#define SNAME deque_arith
+#define CMC_ARITHMETIC_V
+#include "cmc/deque.h"
+
+#include "undef.h"
+
+struct deque_arith_fval *da_fval = &(struct deque_arith_fval){
+    .cmp = cmc_i32_cmp, .cpy = NULL, .str = cmc_i32_str, .free = NULL, .hash = cmc_i32_hash, .pri = cmc_i32_cmp
+};
+
 struct deque_fval *d_fval_counter = &(struct deque_fval){
     .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
 };
 
+/* Copied, compared and freed bitwise, so the counters are never called */
+#define V size_t
+#define PFX dt
+#define SNAME deque_trivial
+#define CMC_TRIVIAL_V
+#include "cmc/deque.h"
+
+#include "undef.h"
+
+struct deque_trivial_fval *dt_fval_counter = &(struct deque_trivial_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
 struct cmc_alloc_node *d_alloc_node =
     &(struct cmc_alloc_node){ .malloc = malloc, .calloc = calloc, .realloc = realloc, .free = free };
 
+/* Used by the ALGO part and called from many threads at once */
+bool d_is_odd(size_t value, void *args)
+{
+    (void)args;
+    return value % 2 == 1;
+}
+
+size_t d_add(size_t a, size_t b, void *args)
+{
+    (void)args;
+    return a + b;
+}
+
 CMC_CREATE_UNIT(CMCDeque, true, {
     CMC_CREATE_TEST(PFX##_new(), {
         struct deque *d = d_new(1000000, d_fval);
@@ -1164,6 +1204,253 @@ CMC_CREATE_UNIT(CMCDeque, true, {
         d_free(d);
         d_free(d2);
     });
+
+    CMC_CREATE_TEST(PFX##_sort(), {
+        struct deque *d = d_new(100, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        d_sort(d);
+        cmc_assert(d_stable_sort(d));
+
+        /* The elements wrap around the end of the buffer */
+        for (size_t i = 0; i < 60; i++)
+        {
+            cmc_assert(d_push_back(d, (i * 37) % 101));
+            cmc_assert(d_push_front(d, (i * 53) % 101));
+        }
+
+        cmc_assert_equals(size_t, 200, d_capacity(d));
+        cmc_assert(d->front + d->count > d->capacity);
+
+        d_sort(d);
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, d_flag(d));
+        cmc_assert_equals(size_t, 0, d->front);
+        cmc_assert_equals(size_t, 120, d_count(d));
+
+        /* The deque still works after being linearized */
+        cmc_assert(d_push_back(d, 1000));
+        cmc_assert(d_push_front(d, 1000));
+        cmc_assert(d_pop_front(d));
+        cmc_assert(d_pop_back(d));
+
+        size_t prev = 0;
+
+        while (!d_empty(d))
+        {
+            cmc_assert(prev <= d_front(d));
+            prev = d_front(d);
+            cmc_assert(d_pop_front(d));
+        }
+
+        /* A full deque */
+        d_clear(d);
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert(d_push_front(d, i));
+
+        cmc_assert(d_full(d));
+
+        d_sort(d);
+
+        for (size_t i = 0; i < 200; i++)
+        {
+            cmc_assert_equals(size_t, i, d_front(d));
+            cmc_assert(d_pop_front(d));
+        }
+
+        d_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_sort_parallel(), {
+        struct deque *d = d_new(100, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 20000; i++)
+        {
+            cmc_assert(d_push_back(d, (i * 7919) % 20011));
+            cmc_assert(d_push_front(d, (i * 104729) % 20011));
+        }
+
+        cmc_assert(d_sort_parallel(d, 4));
+        cmc_assert_equals(size_t, 40000, d_count(d));
+
+        size_t prev = 0;
+
+        while (!d_empty(d))
+        {
+            cmc_assert(prev <= d_front(d));
+            prev = d_front(d);
+            cmc_assert(d_pop_front(d));
+        }
+
+        d_free(d);
+    });
+    CMC_CREATE_TEST(search and reductions[arithmetic], {
+        struct deque_arith *d = da_new(64, da_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert_equals(int32_t, 0, da_max(d));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, da_flag(d));
+
+        // Wraps around the end of the buffer
+        for (int32_t i = 0; i < 40; i++)
+            cmc_assert(da_push_back(d, i - 20));
+
+        for (int32_t i = 0; i < 30; i++)
+            cmc_assert(da_pop_front(d));
+
+        for (int32_t i = 0; i < 50; i++)
+            cmc_assert(da_push_back(d, (i % 7) * 1000 - 3000));
+
+        cmc_assert_equals(size_t, 64, da_capacity(d));
+        cmc_assert_not_equals(size_t, 0, d->front);
+
+        cmc_assert(da_contains(d, 10));
+        cmc_assert(da_contains(d, 19));
+        cmc_assert(da_contains(d, -3000));
+        cmc_assert(da_contains(d, 3000));
+        cmc_assert(!da_contains(d, 20));
+        cmc_assert(!da_contains(d, -20));
+
+        cmc_assert_equals(size_t, 8, da_count_of(d, -3000));
+        cmc_assert_equals(size_t, 7, da_count_of(d, 3000));
+        cmc_assert_equals(size_t, 1, da_count_of(d, 15));
+        cmc_assert_equals(size_t, 0, da_count_of(d, 20));
+
+        cmc_assert_equals(int32_t, -3000, da_min(d));
+        cmc_assert_equals(int32_t, 3000, da_max(d));
+
+        // 10 + 11 + ... + 19 and seven full cycles of -3000 ... 3000
+        cmc_assert_equals(int32_t, 145 - 3000, da_sum(d));
+
+        da_free(d);
+    });
+    CMC_CREATE_TEST(algorithms[parallel], {
+        v_total_free = 0;
+
+        struct deque *d = d_new(100000, d_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        // Wraps around the end of the buffer
+        for (size_t i = 50000; i < 100000; i++)
+            cmc_assert(d_push_back(d, i));
+        for (size_t i = 50000; i > 0; i--)
+            cmc_assert(d_push_front(d, i - 1));
+
+        cmc_assert_equals(size_t, 50000, d_count_if(d, d_is_odd, NULL, 4));
+        cmc_assert_equals(size_t, 4999950000, d_reduce(d, 0, d_add, NULL, 4));
+        cmc_assert_equals(size_t, 0, d_front(d));
+        cmc_assert_equals(size_t, 99999, d_back(d));
+
+        struct deque *odd = d_filter(d, d_is_odd, NULL, 4);
+
+        cmc_assert_not_equals(ptr, NULL, odd);
+        cmc_assert_equals(size_t, 50000, odd->count);
+        cmc_assert_equals(size_t, 1, d_front(odd));
+        cmc_assert_equals(size_t, 99999, d_back(odd));
+
+        struct deque *even = d_partition(d, d_is_odd, NULL, 4);
+
+        cmc_assert_not_equals(ptr, NULL, even);
+        cmc_assert_equals(size_t, 50000, d->count);
+        cmc_assert_equals(size_t, 50000, even->count);
+        cmc_assert_equals(size_t, 0, d_front(even));
+        cmc_assert_equals(size_t, 99998, d_back(even));
+        cmc_assert_equals(int32_t, 0, v_total_free);
+
+        // Elements are freed as they are replaced. The counters of the value
+        // functions are not thread safe.
+        d_fill(even, 1, 1);
+        cmc_assert_equals(int32_t, 50000, v_total_free);
+        cmc_assert_equals(size_t, 50000, d_reduce(even, 0, d_add, NULL, 1));
+
+        cmc_assert(d_push_back(d, 100001));
+        cmc_assert(d_push_back(odd, 100001));
+        cmc_assert(d_equals(d, odd));
+
+        d_free(d);
+        d_free(odd);
+        d_free(even);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct deque *d = d_new(4, d_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        /* The elements wrap around the end of the buffer when it grows */
+        cmc_assert(d_push_back(d, 2));
+        cmc_assert(d_push_back(d, 3));
+        cmc_assert(d_push_front(d, 1));
+        cmc_assert(d_push_front(d, 0));
+        cmc_assert(d_push_back(d, 4));
+        cmc_assert_equals(size_t, 8, d_capacity(d));
+
+        cmc_assert(d_reserve(d, 20));
+        cmc_assert_equals(size_t, 25, d_capacity(d));
+        cmc_assert(d_push_front(d, 100));
+        cmc_assert(d_pop_front(d));
+
+        cmc_assert(d_shrink_to_fit(d));
+        cmc_assert_equals(size_t, 5, d_capacity(d));
+        cmc_assert(d_full(d));
+        cmc_assert_equals(size_t, 4, d_back(d));
+
+        for (size_t i = 0; i < 5; i++)
+        {
+            cmc_assert_equals(size_t, i, d_front(d));
+            cmc_assert(d_pop_front(d));
+        }
+
+        d_free(d);
+    });
+
+    CMC_CREATE_TEST(trivial[copy_of equals], {
+        v_total_cmp = 0;
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct deque_trivial *d1 = dt_new(8, dt_fval_counter);
+        struct deque_trivial *d2 = dt_new(13, dt_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d1);
+        cmc_assert_not_equals(ptr, NULL, d2);
+
+        /* The elements of d1 wrap around the end of its buffer and the ones */
+        /* of d2 wrap around at another index */
+        for (size_t i = 3; i < 8; i++)
+            cmc_assert(dt_push_back(d1, i));
+        for (size_t i = 3; i > 0; i--)
+            cmc_assert(dt_push_front(d1, i - 1));
+
+        for (size_t i = 5; i < 8; i++)
+            cmc_assert(dt_push_back(d2, i));
+        for (size_t i = 5; i > 0; i--)
+            cmc_assert(dt_push_front(d2, i - 1));
+
+        cmc_assert(dt_equals(d1, d2));
+
+        struct deque_trivial *copy = dt_copy_of(d1);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert(dt_equals(copy, d2));
+
+        cmc_assert(dt_pop_back(d2));
+        cmc_assert(dt_push_back(d2, 100));
+        cmc_assert(!dt_equals(d1, d2));
+
+        dt_clear(d1);
+        dt_free(d1);
+        dt_free(d2);
+        dt_free(copy);
+
+        cmc_assert_equals(int32_t, 0, v_total_cmp);
+        cmc_assert_equals(int32_t, 0, v_total_cpy);
+        cmc_assert_equals(int32_t, 0, v_total_free);
+    });
 });
 
 CMC_CREATE_UNIT(CMCDequeIter, true, {
@@ -0,0 +1,399 @@
+#ifndef CMC_TESTS_UNT_FLATMAP_H
+#define CMC_TESTS_UNT_FLATMAP_H
+
+#include "utl.h"
+
+#define K size_t
+#define V size_t
+#define PFX fm
+#define SNAME flatmap
+#include "cmc/flatmap.h"
+
+struct flatmap_fkey *fm_fkey = &(struct flatmap_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct flatmap_fval *fm_fval = &(struct flatmap_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct flatmap_fkey *fm_fkey_counter = &(struct flatmap_fkey){
+    .cmp = k_c_cmp, .cpy = k_c_cpy, .str = k_c_str, .free = k_c_free, .hash = k_c_hash, .pri = k_c_pri
+};
+
+struct flatmap_fval *fm_fval_counter = &(struct flatmap_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+CMC_CREATE_UNIT(CMCFlatMap, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_not_equals(ptr, NULL, map->keys);
+        cmc_assert_not_equals(ptr, NULL, map->values);
+        cmc_assert_equals(size_t, 100, fm_capacity(map));
+        cmc_assert_equals(size_t, 0, fm_count(map));
+        cmc_assert(fm_empty(map));
+
+        fm_free(map);
+
+        cmc_assert_equals(ptr, NULL, fm_new(0, fm_fkey, fm_fval));
+        cmc_assert_equals(ptr, NULL, fm_new(100, NULL, fm_fval));
+        cmc_assert_equals(ptr, NULL, fm_new(100, fm_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(PFX##_insert(), {
+        struct flatmap *map = fm_new(1, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(fm_insert(map, (i * 7919) % 1009, i));
+
+        cmc_assert_equals(size_t, 1000, fm_count(map));
+
+        cmc_assert(!fm_insert(map, 7919 % 1009, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, fm_flag(map));
+        cmc_assert_equals(size_t, 1, fm_get(map, 7919 % 1009));
+
+        for (size_t i = 1; i < 1000; i++)
+            cmc_assert_lesser(size_t, map->keys[i], map->keys[i - 1]);
+
+        size_t key = 0;
+        cmc_assert(fm_min(map, &key, NULL));
+        cmc_assert_equals(size_t, 1, key);
+        cmc_assert(fm_max(map, &key, NULL));
+        cmc_assert_equals(size_t, 1008, key);
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_insert_many(), {
+        k_total_free = 0;
+        v_total_free = 0;
+
+        struct flatmap *map = fm_new(10, fm_fkey_counter, fm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t keys[400];
+        size_t values[400];
+
+        /* A few entries are inserted one by one */
+        for (size_t i = 0; i < 10; i++)
+        {
+            keys[i] = i * 3;
+            values[i] = i;
+        }
+
+        cmc_assert(fm_insert_many(map, keys, values, 10));
+        cmc_assert(fm_insert_many(map, keys, values, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, fm_flag(map));
+
+        cmc_assert_equals(size_t, 10, fm_count(map));
+        cmc_assert_equals(int32_t, 0, v_total_free);
+
+        /* Many entries are sorted and merged. Every key is repeated and */
+        /* some of them are already in the map. */
+        for (size_t i = 0; i < 400; i++)
+        {
+            keys[i] = (i * 7) % 200;
+            values[i] = 1000 + i;
+        }
+
+        cmc_assert(fm_insert_many(map, keys, values, 400));
+        cmc_assert_equals(size_t, 410, map->count);
+
+        cmc_assert_equals(size_t, 200, fm_count(map));
+        cmc_assert_equals(int32_t, 210, k_total_free);
+        cmc_assert_equals(int32_t, 210, v_total_free);
+
+        for (size_t i = 0; i < 200; i++)
+        {
+            cmc_assert_equals(size_t, i, map->keys[i]);
+
+            /* The first value of each key is kept */
+            if (i % 3 == 0 && i < 30)
+                cmc_assert_equals(size_t, i / 3, map->values[i]);
+            else
+                cmc_assert_equals(size_t, 1000 + (i * 143) % 200, map->values[i]);
+        }
+
+        /* Pending entries are merged before a single insertion */
+        keys[0] = 500;
+        keys[1] = 100;
+        values[0] = 1;
+        values[1] = 2;
+
+        cmc_assert(fm_insert_many(map, keys, values, 2));
+        cmc_assert(!fm_insert(map, 500, 0));
+        cmc_assert(fm_insert(map, 499, 0));
+        cmc_assert_equals(size_t, 202, fm_count(map));
+        cmc_assert_equals(int32_t, 211, v_total_free);
+
+        fm_free(map);
+
+        cmc_assert_equals(int32_t, 211 + 202, v_total_free);
+    });
+
+    CMC_CREATE_TEST(PFX##_remove() and _update(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t value = 0;
+
+        cmc_assert(!fm_remove(map, 1, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, fm_flag(map));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(fm_insert(map, i, i * 2));
+
+        cmc_assert(!fm_remove(map, 101, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fm_flag(map));
+
+        for (size_t i = 1; i <= 100; i += 3)
+        {
+            cmc_assert(fm_remove(map, i, &value));
+            cmc_assert_equals(size_t, i * 2, value);
+        }
+
+        cmc_assert_equals(size_t, 66, fm_count(map));
+        cmc_assert(!fm_contains(map, 1));
+        cmc_assert(fm_contains(map, 2));
+
+        cmc_assert(fm_update(map, 2, 40, &value));
+        cmc_assert_equals(size_t, 4, value);
+        cmc_assert_equals(size_t, 40, fm_get(map, 2));
+        cmc_assert(!fm_update(map, 1, 40, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fm_flag(map));
+
+        *fm_get_ref(map, 3) = 33;
+        cmc_assert_equals(size_t, 33, fm_get(map, 3));
+        cmc_assert_equals(ptr, NULL, fm_get_ref(map, 4));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fm_flag(map));
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_floor() and _ceiling(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key = 0;
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(fm_insert(map, i, i));
+
+        cmc_assert(fm_floor(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 50, key);
+        cmc_assert(fm_floor(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!fm_floor(map, 5, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fm_flag(map));
+
+        cmc_assert(fm_ceiling(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(fm_ceiling(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!fm_ceiling(map, 101, &key, NULL));
+
+        cmc_assert_equals(size_t, 5, fm_lower_bound(map, 55));
+        cmc_assert_equals(size_t, 10, fm_lower_bound(map, 101));
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(random, {
+        struct flatmap *map = fm_new(1, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t expected[300];
+        bool present[300];
+        size_t keys[50];
+        size_t values[50];
+
+        for (size_t i = 0; i < 300; i++)
+            present[i] = false;
+
+        size_t seed = 7;
+
+        for (size_t round = 0; round < 200; round++)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+            size_t size = (seed >> 33) % 50 + 1;
+
+            for (size_t i = 0; i < size; i++)
+            {
+                seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+                keys[i] = (seed >> 33) % 300;
+                values[i] = round * 100 + i;
+
+                if (!present[keys[i]])
+                {
+                    present[keys[i]] = true;
+                    expected[keys[i]] = values[i];
+                }
+            }
+
+            cmc_assert(fm_insert_many(map, keys, values, size));
+
+            /* Remove a key every other round */
+            if (round % 2 == 0)
+            {
+                size_t key = (seed >> 40) % 300;
+
+                cmc_assert_equals(bool, present[key], fm_remove(map, key, NULL));
+                present[key] = false;
+            }
+        }
+
+        size_t count = 0;
+
+        for (size_t i = 0; i < 300; i++)
+        {
+            if (present[i])
+            {
+                cmc_assert_equals(size_t, i, map->keys[count]);
+                cmc_assert_equals(size_t, expected[i], map->values[count]);
+                count++;
+            }
+        }
+
+        cmc_assert_equals(size_t, count, fm_count(map));
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_copy_of() and _equals(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t keys[100];
+
+        for (size_t i = 0; i < 100; i++)
+            keys[i] = 99 - i;
+
+        cmc_assert(fm_insert_many(map, keys, keys, 100));
+
+        struct flatmap *copy = fm_copy_of(map);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert_equals(size_t, 100, fm_count(copy));
+        cmc_assert(fm_equals(map, copy));
+
+        cmc_assert(fm_update(copy, 50, 0, NULL));
+        cmc_assert(!fm_equals(map, copy));
+
+        cmc_assert(fm_remove(copy, 50, NULL));
+        cmc_assert(!fm_equals(map, copy));
+
+        fm_free(map);
+        fm_free(copy);
+    });
+});
+
+CMC_CREATE_UNIT(CMCFlatMapIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct flatmap_iter it = fm_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(size_t, 0, it.cursor);
+        cmc_assert(fm_iter_at_start(&it));
+        cmc_assert(fm_iter_at_end(&it));
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next() and _iter_prev(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t keys[100];
+        size_t values[100];
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            keys[i] = (i * 37) % 100;
+            values[i] = keys[i] * 2;
+        }
+
+        cmc_assert(fm_insert_many(map, keys, values, 100));
+
+        size_t index = 0;
+
+        for (struct flatmap_iter it = fm_iter_start(map); !fm_iter_at_end(&it); fm_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, fm_iter_index(&it));
+            cmc_assert_equals(size_t, index, fm_iter_key(&it));
+            cmc_assert_equals(size_t, index * 2, fm_iter_value(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, index);
+
+        for (struct flatmap_iter it = fm_iter_end(map); !fm_iter_at_start(&it); fm_iter_prev(&it))
+        {
+            index--;
+            cmc_assert_equals(size_t, index, fm_iter_key(&it));
+            *fm_iter_rvalue(&it) = index;
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+        cmc_assert_equals(size_t, 42, fm_get(map, 42));
+
+        fm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct flatmap *map = fm_new(100, fm_fkey, fm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(fm_insert(map, i, i));
+
+        struct flatmap_iter it = fm_iter_lower_bound(map, 35);
+
+        cmc_assert_equals(size_t, 40, fm_iter_key(&it));
+        cmc_assert(fm_iter_next(&it));
+        cmc_assert_equals(size_t, 50, fm_iter_key(&it));
+
+        it = fm_iter_lower_bound(map, 100);
+        cmc_assert_equals(size_t, 100, fm_iter_key(&it));
+        cmc_assert(!fm_iter_at_end(&it));
+
+        it = fm_iter_lower_bound(map, 101);
+        cmc_assert(fm_iter_at_end(&it));
+
+        fm_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCFlatMap() + CMCFlatMapIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCFlatMap Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_FLATMAP_H */
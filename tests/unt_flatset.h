@@ -0,0 +1,263 @@
+#ifndef CMC_TESTS_UNT_FLATSET_H
+#define CMC_TESTS_UNT_FLATSET_H
+
+#include "utl.h"
+
+#define V size_t
+#define PFX fs
+#define SNAME flatset
+#define CMC_ARITHMETIC_V
+#include "cmc/flatset.h"
+
+#include "undef.h"
+
+struct flatset_fval *fs_fval = &(struct flatset_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct flatset_fval *fs_fval_counter = &(struct flatset_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+CMC_CREATE_UNIT(CMCFlatSet, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_not_equals(ptr, NULL, set->buffer);
+        cmc_assert_equals(size_t, 100, fs_capacity(set));
+        cmc_assert_equals(size_t, 0, fs_count(set));
+        cmc_assert(fs_empty(set));
+
+        fs_free(set);
+
+        cmc_assert_equals(ptr, NULL, fs_new(0, fs_fval));
+        cmc_assert_equals(ptr, NULL, fs_new(100, NULL));
+    });
+
+    CMC_CREATE_TEST(PFX##_insert() and _remove(), {
+        struct flatset *set = fs_new(1, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert(!fs_remove(set, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, fs_flag(set));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(fs_insert(set, (i * 7919) % 1009));
+
+        cmc_assert_equals(size_t, 1000, fs_count(set));
+
+        cmc_assert(!fs_insert(set, 7919 % 1009));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, fs_flag(set));
+
+        for (size_t i = 1; i < 1000; i++)
+            cmc_assert_lesser(size_t, set->buffer[i], set->buffer[i - 1]);
+
+        for (size_t i = 1; i <= 1000; i += 2)
+            cmc_assert(fs_remove(set, (i * 7919) % 1009));
+
+        cmc_assert(!fs_remove(set, 7919 % 1009));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fs_flag(set));
+        cmc_assert_equals(size_t, 500, fs_count(set));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert_equals(bool, i % 2 == 0, fs_contains(set, (i * 7919) % 1009));
+
+        fs_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_insert_many(), {
+        v_total_free = 0;
+
+        struct flatset *set = fs_new(10, fs_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t values[400];
+
+        /* A few elements are inserted one by one */
+        for (size_t i = 0; i < 10; i++)
+            values[i] = i * 3;
+
+        cmc_assert(fs_insert_many(set, values, 10));
+        cmc_assert(fs_insert_many(set, values, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, fs_flag(set));
+
+        cmc_assert_equals(size_t, 10, fs_count(set));
+        cmc_assert_equals(int32_t, 0, v_total_free);
+
+        /* Many elements are sorted and merged. Every element is repeated */
+        /* and some of them are already in the set. */
+        for (size_t i = 0; i < 400; i++)
+            values[i] = (i * 7) % 200;
+
+        cmc_assert(fs_insert_many(set, values, 400));
+        cmc_assert_equals(size_t, 410, set->count);
+
+        cmc_assert_equals(size_t, 200, fs_count(set));
+        cmc_assert_equals(int32_t, 210, v_total_free);
+
+        for (size_t i = 0; i < 200; i++)
+            cmc_assert_equals(size_t, i, set->buffer[i]);
+
+        size_t value = 0;
+
+        cmc_assert(fs_min(set, &value));
+        cmc_assert_equals(size_t, 0, value);
+        cmc_assert(fs_max(set, &value));
+        cmc_assert_equals(size_t, 199, value);
+
+        fs_free(set);
+
+        cmc_assert_equals(int32_t, 410, v_total_free);
+    });
+
+    CMC_CREATE_TEST(PFX##_floor() and _ceiling(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t value = 0;
+
+        cmc_assert(!fs_floor(set, 10, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, fs_flag(set));
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(fs_insert(set, i));
+
+        cmc_assert(fs_floor(set, 55, &value));
+        cmc_assert_equals(size_t, 50, value);
+        cmc_assert(fs_floor(set, 60, &value));
+        cmc_assert_equals(size_t, 60, value);
+        cmc_assert(!fs_floor(set, 5, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, fs_flag(set));
+
+        cmc_assert(fs_ceiling(set, 55, &value));
+        cmc_assert_equals(size_t, 60, value);
+        cmc_assert(fs_ceiling(set, 60, &value));
+        cmc_assert_equals(size_t, 60, value);
+        cmc_assert(!fs_ceiling(set, 101, &value));
+
+        cmc_assert_equals(size_t, 5, fs_lower_bound(set, 55));
+        cmc_assert_equals(size_t, 10, fs_lower_bound(set, 101));
+
+        fs_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_copy_of() and _equals(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t values[100];
+
+        for (size_t i = 0; i < 100; i++)
+            values[i] = 99 - i;
+
+        cmc_assert(fs_insert_many(set, values, 100));
+
+        struct flatset *copy = fs_copy_of(set);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert_equals(size_t, 100, fs_count(copy));
+        cmc_assert(fs_equals(set, copy));
+
+        cmc_assert(fs_remove(copy, 50));
+        cmc_assert(!fs_equals(set, copy));
+
+        cmc_assert(fs_insert(copy, 100));
+        cmc_assert(!fs_equals(set, copy));
+
+        fs_free(set);
+        fs_free(copy);
+    });
+});
+
+CMC_CREATE_UNIT(CMCFlatSetIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct flatset_iter it = fs_iter_start(set);
+
+        cmc_assert_equals(ptr, set, it.target);
+        cmc_assert_equals(size_t, 0, it.cursor);
+        cmc_assert(fs_iter_at_start(&it));
+        cmc_assert(fs_iter_at_end(&it));
+
+        fs_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next() and _iter_prev(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t values[100];
+
+        for (size_t i = 0; i < 100; i++)
+            values[i] = (i * 37) % 100;
+
+        cmc_assert(fs_insert_many(set, values, 100));
+
+        size_t index = 0;
+
+        for (struct flatset_iter it = fs_iter_start(set); !fs_iter_at_end(&it); fs_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, fs_iter_index(&it));
+            cmc_assert_equals(size_t, index, fs_iter_value(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, index);
+
+        for (struct flatset_iter it = fs_iter_end(set); !fs_iter_at_start(&it); fs_iter_prev(&it))
+        {
+            index--;
+            cmc_assert_equals(size_t, index, fs_iter_value(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        fs_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct flatset *set = fs_new(100, fs_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(fs_insert(set, i));
+
+        struct flatset_iter it = fs_iter_lower_bound(set, 35);
+
+        cmc_assert_equals(size_t, 40, fs_iter_value(&it));
+        cmc_assert(fs_iter_next(&it));
+        cmc_assert_equals(size_t, 50, fs_iter_value(&it));
+
+        it = fs_iter_lower_bound(set, 101);
+        cmc_assert(fs_iter_at_end(&it));
+
+        fs_free(set);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCFlatSet() + CMCFlatSetIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCFlatSet Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_FLATSET_H */
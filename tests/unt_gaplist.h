@@ -0,0 +1,451 @@
+#ifndef CMC_TESTS_UNT_GAPLIST_H
+#define CMC_TESTS_UNT_GAPLIST_H
+
+#include "utl.h"
+
+/* List that gaplists are converted from and to */
+#define V size_t
+#define PFX gll
+#define SNAME gaplist_list
+#include "cmc/list.h"
+
+struct gaplist_list_fval *gll_fval = &(struct gaplist_list_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+#define V size_t
+#define PFX gl
+#define SNAME gaplist
+#define CMC_GAPLIST_LIST gaplist_list
+#include "cmc/gaplist.h"
+
+#include "undef.h"
+
+struct gaplist_fval *gl_fval = &(struct gaplist_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct gaplist_fval *gl_fval_counter = &(struct gaplist_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Copied, compared and freed bitwise, so the counters are never called */
+#define V size_t
+#define PFX glt
+#define SNAME gaplist_trivial
+#define CMC_TRIVIAL_V
+#include "cmc/gaplist.h"
+
+#include "undef.h"
+
+struct gaplist_trivial_fval *glt_fval_counter = &(struct gaplist_trivial_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+CMC_CREATE_UNIT(CMCGapList, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_not_equals(ptr, NULL, l->buffer);
+        cmc_assert_equals(size_t, 100, gl_capacity(l));
+        cmc_assert_equals(size_t, 0, gl_count(l));
+        cmc_assert_equals(size_t, 0, gl_gap(l));
+        cmc_assert(gl_empty(l));
+
+        gl_free(l);
+
+        cmc_assert_equals(ptr, NULL, gl_new(0, gl_fval));
+    });
+
+    CMC_CREATE_TEST(push and pop[edits], {
+        struct gaplist *l = gl_new(1, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        size_t expected[1000];
+        size_t count = 0;
+
+        cmc_assert(!gl_pop_at(l, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, gl_flag(l));
+        cmc_assert(!gl_push_at(l, 1, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, gl_flag(l));
+
+        /* The same edits are done to an array and compared at every step */
+        for (size_t i = 0; i < 2000; i++)
+        {
+            size_t index = (i * 7919) % (count + 1);
+
+            if (i % 3 == 2 && count > 0)
+            {
+                index = index % count;
+
+                cmc_assert(gl_pop_at(l, index));
+
+                memmove(expected + index, expected + index + 1, (count - index - 1) * sizeof(size_t));
+                count--;
+            }
+            else if (count < 1000)
+            {
+                cmc_assert(gl_push_at(l, i, index));
+
+                memmove(expected + index + 1, expected + index, (count - index) * sizeof(size_t));
+                expected[index] = i;
+                count++;
+            }
+
+            cmc_assert_equals(size_t, count, gl_count(l));
+        }
+
+        for (size_t i = 0; i < count; i++)
+            cmc_assert_equals(size_t, expected[i], gl_get(l, i));
+
+        cmc_assert_equals(size_t, expected[0], gl_front(l));
+        cmc_assert_equals(size_t, expected[count - 1], gl_back(l));
+
+        cmc_assert(gl_pop_front(l));
+        cmc_assert(gl_pop_back(l));
+        cmc_assert_equals(size_t, expected[1], gl_front(l));
+        cmc_assert_equals(size_t, expected[count - 2], gl_back(l));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(push_at[gap], {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(gl_push_back(l, i));
+
+        /* Typing at a cursor only moves the gap on the first edit */
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(gl_push_at(l, 100 + i, 5 + i));
+            cmc_assert_equals(size_t, 6 + i, gl_gap(l));
+        }
+
+        cmc_assert(gl_pop_at(l, 14));
+        cmc_assert_equals(size_t, 14, gl_gap(l));
+        cmc_assert(gl_pop_at(l, 14));
+        cmc_assert_equals(size_t, 14, gl_gap(l));
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert_equals(size_t, i, gl_get(l, i));
+        for (size_t i = 5; i < 14; i++)
+            cmc_assert_equals(size_t, 95 + i, gl_get(l, i));
+        for (size_t i = 14; i < 18; i++)
+            cmc_assert_equals(size_t, i - 8, gl_get(l, i));
+
+        cmc_assert_equals(size_t, 18, gl_count(l));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_resize(), {
+        struct gaplist *l = gl_new(10, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 10; i++)
+            cmc_assert(gl_push_back(l, i));
+
+        cmc_assert(gl_pop_at(l, 3));
+        cmc_assert(gl_pop_at(l, 3));
+        cmc_assert_equals(size_t, 3, gl_gap(l));
+
+        cmc_assert(gl_resize(l, 100));
+        cmc_assert_equals(size_t, 100, gl_capacity(l));
+        cmc_assert_equals(size_t, 3, gl_gap(l));
+
+        cmc_assert(!gl_resize(l, 7));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, gl_flag(l));
+
+        cmc_assert(gl_resize(l, 8));
+        cmc_assert(gl_full(l));
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert_equals(size_t, i < 3 ? i : i + 2, gl_get(l, i));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(search, {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(gl_push_back(l, i % 10));
+
+        cmc_assert(gl_push_at(l, 100, 25));
+
+        cmc_assert_equals(size_t, 26, gl_gap(l));
+        cmc_assert_equals(size_t, 3, gl_index_of(l, 3, true));
+        cmc_assert_equals(size_t, 44, gl_index_of(l, 3, false));
+        cmc_assert_equals(size_t, 25, gl_index_of(l, 100, true));
+        cmc_assert_equals(size_t, 51, gl_index_of(l, 101, true));
+        cmc_assert_equals(size_t, 5, gl_count_of(l, 7));
+        cmc_assert(gl_contains(l, 9));
+        cmc_assert(!gl_contains(l, 10));
+        cmc_assert_equals(size_t, 0, gl_min(l));
+        cmc_assert_equals(size_t, 100, gl_max(l));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_copy_of() and _equals(), {
+        v_total_free = 0;
+
+        struct gaplist *l = gl_new(100, gl_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 20; i++)
+            cmc_assert(gl_push_at(l, i, i / 2));
+
+        struct gaplist *copy = gl_copy_of(l);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert_equals(size_t, 20, gl_count(copy));
+        cmc_assert_equals(size_t, 20, gl_gap(copy));
+        cmc_assert(gl_equals(l, copy));
+
+        cmc_assert(gl_pop_at(copy, 0));
+        cmc_assert(!gl_equals(l, copy));
+
+        gl_free(l);
+        gl_free(copy);
+
+        cmc_assert_equals(int32_t, 39, v_total_free);
+    });
+
+    CMC_CREATE_TEST(PFX##_sort(), {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(gl_push_at(l, (i * 37) % 100, i / 3));
+
+        gl_sort(l);
+
+        cmc_assert_equals(size_t, 100, gl_gap(l));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert_equals(size_t, i, gl_get(l, i));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_from_list() and _to_list(), {
+        struct gaplist_list *list = gll_new(100, gll_fval);
+
+        cmc_assert_not_equals(ptr, NULL, list);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(gll_push_back(list, i));
+
+        size_t *buffer = list->buffer;
+
+        struct gaplist *l = gl_from_list(list, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_equals(ptr, buffer, l->buffer);
+        cmc_assert_equals(size_t, 100, gl_capacity(l));
+        cmc_assert_equals(size_t, 50, gl_gap(l));
+
+        cmc_assert(gl_push_at(l, 1000, 10));
+        cmc_assert(gl_pop_at(l, 0));
+
+        list = gl_to_list(l, gll_fval);
+
+        cmc_assert_not_equals(ptr, NULL, list);
+        cmc_assert_equals(ptr, buffer, list->buffer);
+        cmc_assert_equals(size_t, 50, gll_count(list));
+        cmc_assert_equals(size_t, 1000, gll_get(list, 9));
+
+        for (size_t i = 0; i < 9; i++)
+            cmc_assert_equals(size_t, i + 1, gll_get(list, i));
+        for (size_t i = 10; i < 50; i++)
+            cmc_assert_equals(size_t, i, gll_get(list, i));
+
+        gll_free(list);
+    });
+
+    CMC_CREATE_TEST(PFX##_seq_push_at() and _seq_sublist(), {
+        struct gaplist *l = gl_new(10, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        size_t values[20];
+
+        for (size_t i = 0; i < 20; i++)
+            values[i] = i;
+
+        cmc_assert(gl_seq_push_back(l, values, 10));
+        cmc_assert(gl_seq_push_at(l, values + 10, 10, 5));
+        cmc_assert_equals(size_t, 20, gl_count(l));
+        cmc_assert_equals(size_t, 15, gl_gap(l));
+
+        cmc_assert(!gl_seq_push_at(l, values, 0, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, gl_flag(l));
+
+        struct gaplist *sub = gl_seq_sublist(l, 3, 7);
+
+        cmc_assert_not_equals(ptr, NULL, sub);
+        cmc_assert_equals(size_t, 5, gl_count(sub));
+        cmc_assert_equals(size_t, 3, gl_get(sub, 0));
+        cmc_assert_equals(size_t, 4, gl_get(sub, 1));
+        cmc_assert_equals(size_t, 10, gl_get(sub, 2));
+        cmc_assert_equals(size_t, 12, gl_get(sub, 4));
+
+        cmc_assert(gl_seq_pop_at(l, 0, 2));
+        cmc_assert(!gl_seq_pop_at(l, 2, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, gl_flag(l));
+        cmc_assert(!gl_seq_pop_at(l, 0, 12));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, gl_flag(l));
+
+        cmc_assert_equals(size_t, 12, gl_count(l));
+        cmc_assert_equals(size_t, 13, gl_front(l));
+        cmc_assert_equals(size_t, 9, gl_back(l));
+
+        gl_free(l);
+        gl_free(sub);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct gaplist *l = gl_new(10, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(gl_reserve(l, 100));
+        cmc_assert_equals(size_t, 100, gl_capacity(l));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(gl_push_at(l, i, i / 2));
+
+        cmc_assert(gl_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 30, gl_capacity(l));
+        cmc_assert(gl_push_front(l, 30));
+        cmc_assert_equals(size_t, 60, gl_capacity(l));
+        cmc_assert_equals(size_t, 30, gl_front(l));
+        cmc_assert_equals(size_t, 0, gl_back(l));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(trivial[copy_of equals], {
+        v_total_cmp = 0;
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct gaplist_trivial *l1 = glt_new(64, glt_fval_counter);
+        struct gaplist_trivial *l2 = glt_new(50, glt_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, l1);
+        cmc_assert_not_equals(ptr, NULL, l2);
+
+        for (size_t i = 0; i < 40; i++)
+        {
+            cmc_assert(glt_push_back(l1, i));
+            cmc_assert(glt_push_back(l2, i));
+        }
+
+        /* Same elements with the gap of each list at a different index */
+        cmc_assert(glt_push_at(l1, 100, 10));
+        cmc_assert(glt_pop_at(l1, 10));
+        cmc_assert(glt_push_at(l2, 100, 30));
+        cmc_assert(glt_pop_at(l2, 30));
+        cmc_assert_not_equals(size_t, glt_gap(l1), glt_gap(l2));
+
+        cmc_assert(glt_equals(l1, l2));
+
+        struct gaplist_trivial *copy = glt_copy_of(l1);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert(glt_equals(copy, l2));
+
+        cmc_assert(glt_pop_back(l2));
+        cmc_assert(glt_push_back(l2, 0));
+        cmc_assert(!glt_equals(l1, l2));
+
+        glt_clear(l1);
+        glt_free(l1);
+        glt_free(l2);
+        glt_free(copy);
+
+        cmc_assert_equals(int32_t, 0, v_total_cmp);
+        cmc_assert_equals(int32_t, 0, v_total_cpy);
+        cmc_assert_equals(int32_t, 0, v_total_free);
+    });
+});
+
+CMC_CREATE_UNIT(CMCGapListIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        struct gaplist_iter it = gl_iter_start(l);
+
+        cmc_assert_equals(ptr, l, it.target);
+        cmc_assert_equals(size_t, 0, it.cursor);
+        cmc_assert(gl_iter_at_start(&it));
+        cmc_assert(gl_iter_at_end(&it));
+
+        gl_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next() and _iter_prev(), {
+        struct gaplist *l = gl_new(100, gl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(gl_push_at(l, 99 - i, 0));
+
+        cmc_assert(gl_pop_at(l, 50));
+        cmc_assert(gl_push_at(l, 50, 50));
+        cmc_assert_equals(size_t, 51, gl_gap(l));
+
+        size_t index = 0;
+
+        for (struct gaplist_iter it = gl_iter_start(l); !gl_iter_at_end(&it); gl_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, gl_iter_index(&it));
+            cmc_assert_equals(size_t, index, gl_iter_value(&it));
+            cmc_assert_equals(size_t, index, *gl_iter_rvalue(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, index);
+
+        for (struct gaplist_iter it = gl_iter_end(l); !gl_iter_at_start(&it); gl_iter_prev(&it))
+        {
+            index--;
+            cmc_assert_equals(size_t, index, gl_iter_value(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        gl_free(l);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCGapList() + CMCGapListIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCGapList Suit : %-46s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_GAPLIST_H */
@@ -12,6 +12,24 @@ struct heap_fval *h_fval = &(struct heap_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* Used by the ALGO part and called from many threads at once */
+bool h_is_odd(size_t value, void *args)
+{
+    (void)args;
+    return value % 2 == 1;
+}
+
+size_t h_negate(size_t value, void *args)
+{
+    return *(size_t *)args - value;
+}
+
+size_t h_max(size_t a, size_t b, void *args)
+{
+    (void)args;
+    return a > b ? a : b;
+}
+
 CMC_CREATE_UNIT(CMCHeap, true, {
     CMC_CREATE_TEST(new, {
         struct heap *h = h_new(1000000, CMC_MAX_HEAP, h_fval);
@@ -220,6 +238,64 @@ CMC_CREATE_UNIT(CMCHeap, true, {
         h_free(h);
         h_free(h2);
     });
+    CMC_CREATE_TEST(algorithms[parallel], {
+        struct heap *h = h_new(100, CMC_MAX_HEAP, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        for (size_t i = 0; i < 100000; i++)
+            cmc_assert(h_insert(h, (i * 7919) % 100000));
+
+        cmc_assert_equals(size_t, 50000, h_count_if(h, h_is_odd, NULL, 4));
+        cmc_assert_equals(size_t, 99999, h_reduce(h, 0, h_max, NULL, 4));
+
+        // The heap is rebuilt after its elements change
+        size_t top = 100000;
+        cmc_assert(h_map_into(h, h, h_negate, &top, 4));
+        cmc_assert_equals(size_t, 100000, h_peek(h));
+
+        struct heap *even = h_partition(h, h_is_odd, NULL, 4);
+
+        cmc_assert_not_equals(ptr, NULL, even);
+        cmc_assert_equals(size_t, 50000, h_count(h));
+        cmc_assert_equals(size_t, 50000, h_count(even));
+
+        struct heap *odd = h_filter(h, h_is_odd, NULL, 4);
+
+        cmc_assert_not_equals(ptr, NULL, odd);
+        cmc_assert(h_equals(h, odd));
+
+        for (size_t i = 0; i < 50000; i++)
+        {
+            cmc_assert_equals(size_t, 99999 - i * 2, h_peek(odd));
+            cmc_assert_equals(size_t, 100000 - i * 2, h_peek(even));
+            cmc_assert(h_remove(odd));
+            cmc_assert(h_remove(even));
+        }
+
+        h_free(h);
+        h_free(odd);
+        h_free(even);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct heap *h = h_new(10, CMC_MAX_HEAP, h_fval);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+
+        cmc_assert(h_reserve(h, 100));
+        cmc_assert_equals(size_t, 100, h_capacity(h));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(h_insert(h, i));
+
+        cmc_assert(h_shrink_to_fit(h));
+        cmc_assert_equals(size_t, 30, h_capacity(h));
+        cmc_assert(h_insert(h, 30));
+        cmc_assert_equals(size_t, 60, h_capacity(h));
+        cmc_assert_equals(size_t, 30, h_peek(h));
+
+        h_free(h);
+    });
 });
 
 CMC_CREATE_UNIT(CMCHeapIter, true, {
@@ -253,6 +253,45 @@ CMC_CREATE_UNIT(CMCLinkedList, true, {
         ll_free(ll);
         ll_free(ll2);
     });
+
+    CMC_CREATE_TEST(PFX##_compact(), {
+        struct linkedlist *ll = ll_new(ll_fval);
+
+        cmc_assert_not_equals(ptr, NULL, ll);
+
+        cmc_assert(ll_compact(ll));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            ll_push_back(ll, i);
+            ll_push_front(ll, i);
+        }
+
+        for (size_t i = 0; i < 500; i++)
+            ll_pop_at(ll, i);
+
+        cmc_assert(ll_compact(ll));
+        cmc_assert_equals(size_t, 1500, ll_count(ll));
+
+        /* Nodes are laid out in list order */
+        struct linkedlist_node *node = ll->head;
+
+        for (size_t i = 0; i < ll_count(ll); i++, node = node->next)
+            cmc_assert_equals(ptr, &ll->block[i], node);
+
+        cmc_assert_equals(ptr, &ll->block[1499], ll->tail);
+
+        cmc_assert(ll_compact(ll));
+        cmc_assert(ll_push_back(ll, 10000));
+        cmc_assert_equals(size_t, 10000, ll_back(ll));
+
+        while (!ll_empty(ll))
+            ll_pop_back(ll);
+
+        cmc_assert_equals(ptr, NULL, ll->block);
+
+        ll_free(ll);
+    });
 });
 
 CMC_CREATE_UNIT(CMCLinkedListIter, true, {
@@ -3,6 +3,8 @@
 
 #include "utl.h"
 
+#include "cmc/utl/mremap.h"
+
 #define V size_t
 #define PFX l
 #define SNAME list
@@ -12,6 +14,103 @@ struct list_fval *l_fval = &(struct list_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* Same list but searched and reduced with the arithmetic kernels */
+#define V size_t
+#define PFX la
+#define SNAME list_arith
+#define CMC_ARITHMETIC_V
+#include "cmc/list.h"
+
+#include "undef.h"
+
+struct list_arith_fval *la_fval = &(struct list_arith_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+/* Same list storing up to 8 elements in the struct itself */
+#define V size_t
+#define PFX ls
+#define SNAME list_sbo
+#define CMC_SBO 8
+#include "cmc/list.h"
+
+#include "undef.h"
+
+struct list_sbo_fval *ls_fval = &(struct list_sbo_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+/* Copied, compared and freed bitwise, so the counters are never called */
+#define V size_t
+#define PFX lt
+#define SNAME list_trivial
+#define CMC_TRIVIAL_V
+#include "cmc/list.h"
+
+#include "undef.h"
+
+struct list_trivial_fval *lt_fval_counter = &(struct list_trivial_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Only compares the digits above the fifth so that the order of equal */
+/* elements can be checked by the rest of the value */
+int l_cmp_high(size_t a, size_t b)
+{
+    return (a / 100000 > b / 100000) - (a / 100000 < b / 100000);
+}
+
+struct list_fval *l_fval_high = &(struct list_fval){
+    .cmp = l_cmp_high, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+/* Fills the list with one of a few patterns that are hard on quicksorts */
+void l_fill_pattern(struct list *l, size_t pattern, size_t count)
+{
+    size_t x = 12345;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        if (pattern == 0)
+            l_push_back(l, x >> 33);
+        else if (pattern == 1)
+            l_push_back(l, i);
+        else if (pattern == 2)
+            l_push_back(l, count - i);
+        else if (pattern == 3)
+            l_push_back(l, 7);
+        else if (pattern == 4)
+            l_push_back(l, i < count / 2 ? i : count - i);
+        else
+            l_push_back(l, (x >> 33) % 4);
+    }
+}
+
+/* Used by the ALGO part and called from many threads at once */
+bool l_is_odd(size_t value, void *args)
+{
+    (void)args;
+    return value % 2 == 1;
+}
+
+size_t l_scale(size_t value, void *args)
+{
+    return value * *(size_t *)args;
+}
+
+size_t l_add(size_t a, size_t b, void *args)
+{
+    (void)args;
+    return a + b;
+}
+
+void l_mark(size_t value, void *args)
+{
+    ((bool *)args)[value] = true;
+}
+
 CMC_CREATE_UNIT(CMCList, true, {
     CMC_CREATE_TEST(PFX##_new, {
         struct list *l = l_new(1000000, l_fval);
@@ -510,6 +609,445 @@ CMC_CREATE_UNIT(CMCList, true, {
         l_free(l2);
         l_free(l3);
     });
+
+    CMC_CREATE_TEST(PFX##_sort(), {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        l_sort(l);
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, l_flag(l));
+
+        for (size_t pattern = 0; pattern < 6; pattern++)
+        {
+            l_clear(l);
+            l_fill_pattern(l, pattern, 20000);
+
+            size_t sum = 0;
+
+            for (size_t i = 0; i < l_count(l); i++)
+                sum += l_get(l, i);
+
+            l_sort(l);
+
+            cmc_assert_equals(size_t, 20000, l_count(l));
+
+            for (size_t i = 1; i < l_count(l); i++)
+                cmc_assert(l_get(l, i - 1) <= l_get(l, i));
+
+            for (size_t i = 0; i < l_count(l); i++)
+                sum -= l_get(l, i);
+
+            cmc_assert_equals(size_t, 0, sum);
+        }
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_stable_sort(), {
+        struct list *l = l_new(100, l_fval_high);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 5000; i++)
+            cmc_assert(l_push_back(l, ((i * 7919) % 50) * 100000 + i));
+
+        cmc_assert(l_stable_sort(l));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, l_flag(l));
+
+        /* Elements with the same key keep their original order */
+        for (size_t i = 1; i < l_count(l); i++)
+        {
+            size_t prev = l_get(l, i - 1);
+            size_t curr = l_get(l, i);
+
+            cmc_assert(prev / 100000 < curr / 100000 || prev < curr);
+        }
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(PFX##_sort_parallel(), {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t threads = 1; threads <= 5; threads += 2)
+        {
+            l_clear(l);
+            l_fill_pattern(l, 0, 50000);
+
+            cmc_assert(l_sort_parallel(l, threads));
+            cmc_assert_equals(size_t, 50000, l_count(l));
+
+            for (size_t i = 1; i < l_count(l); i++)
+                cmc_assert(l_get(l, i - 1) <= l_get(l, i));
+        }
+
+        l_free(l);
+
+        l = l_new(100, l_fval_high);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 50000; i++)
+            cmc_assert(l_push_back(l, ((i * 7919) % 50) * 100000 + i));
+
+        cmc_assert(l_sort_parallel(l, 4));
+
+        for (size_t i = 1; i < l_count(l); i++)
+        {
+            size_t prev = l_get(l, i - 1);
+            size_t curr = l_get(l, i);
+
+            cmc_assert(prev / 100000 < curr / 100000 || prev < curr);
+        }
+
+        l_free(l);
+    });
+    CMC_CREATE_TEST(search and reductions[arithmetic], {
+        struct list *l = l_new(100, l_fval);
+        struct list_arith *la = la_new(100, la_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_not_equals(ptr, NULL, la);
+
+        cmc_assert_equals(size_t, 0, la_min(la));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, la_flag(la));
+        cmc_assert_equals(size_t, 0, la_sum(la));
+        cmc_assert_equals(size_t, 0, la_index_of(la, 1, true));
+
+        size_t x = 3;
+        size_t sum = 0;
+
+        for (size_t i = 0; i < 1003; i++)
+        {
+            x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+
+            cmc_assert(l_push_back(l, 10 + (x >> 33) % 1000));
+            cmc_assert(la_push_back(la, 10 + (x >> 33) % 1000));
+
+            sum += 10 + (x >> 33) % 1000;
+        }
+
+        // Values below 10 and above 1009 are never found
+        for (size_t v = 0; v < 1020; v++)
+        {
+            cmc_assert_equals(bool, l_contains(l, v), la_contains(la, v));
+            cmc_assert_equals(size_t, l_index_of(l, v, true), la_index_of(la, v, true));
+            cmc_assert_equals(size_t, l_index_of(l, v, false), la_index_of(la, v, false));
+            cmc_assert_equals(size_t, l_count_of(l, v), la_count_of(la, v));
+        }
+
+        cmc_assert_equals(size_t, l_min(l), la_min(la));
+        cmc_assert_equals(size_t, l_max(l), la_max(la));
+        cmc_assert_equals(size_t, sum, la_sum(la));
+
+        // Extremes at both ends and in the tail
+        cmc_assert(la_push_front(la, 1));
+        cmc_assert(la_push_back(la, 5000));
+        cmc_assert_equals(size_t, 1, la_min(la));
+        cmc_assert_equals(size_t, 5000, la_max(la));
+        cmc_assert_equals(size_t, 0, la_index_of(la, 1, false));
+        cmc_assert_equals(size_t, 1004, la_index_of(la, 5000, true));
+        cmc_assert_equals(size_t, 1, la_count_of(la, 5000));
+
+        l_free(l);
+        la_free(la);
+    });
+    CMC_CREATE_TEST(algorithms[parallel], {
+        struct list *l = l_new(100, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert_equals(size_t, 7, l_reduce(l, 7, l_add, NULL, 4));
+        cmc_assert_equals(size_t, 0, l_count_if(l, l_is_odd, NULL, 4));
+
+        for (size_t i = 0; i < 100000; i++)
+            cmc_assert(l_push_back(l, i));
+
+        // One thread and many threads must give the same results
+        for (size_t n_threads = 1; n_threads <= 4; n_threads += 3)
+        {
+            bool *seen = calloc(100000, sizeof(bool));
+
+            l_for_each(l, l_mark, seen, n_threads);
+
+            size_t marked = 0;
+            for (size_t i = 0; i < 100000; i++)
+                marked += seen[i];
+
+            free(seen);
+
+            cmc_assert_equals(size_t, 100000, marked);
+            cmc_assert_equals(size_t, 50000, l_count_if(l, l_is_odd, NULL, n_threads));
+            cmc_assert_equals(size_t, 4999950007, l_reduce(l, 7, l_add, NULL, n_threads));
+
+            struct list *odd = l_filter(l, l_is_odd, NULL, n_threads);
+
+            cmc_assert_not_equals(ptr, NULL, odd);
+            cmc_assert_equals(size_t, 50000, l_count(odd));
+
+            for (size_t i = 0; i < l_count(odd); i++)
+                cmc_assert_equals(size_t, i * 2 + 1, l_get(odd, i));
+
+            size_t factor = 3;
+            struct list *dest = l_new(1, l_fval);
+
+            cmc_assert(l_map_into(l, dest, l_scale, &factor, n_threads));
+            cmc_assert_equals(size_t, 100000, l_count(dest));
+            cmc_assert_equals(size_t, 299997, l_get(dest, 99999));
+
+            // Mapped in place
+            cmc_assert(l_map_into(odd, odd, l_scale, &factor, n_threads));
+            cmc_assert_equals(size_t, 3, l_get(odd, 0));
+            cmc_assert_equals(size_t, 299997, l_get(odd, 49999));
+
+            l_free(odd);
+            l_free(dest);
+        }
+
+        struct list *even = l_partition(l, l_is_odd, NULL, 4);
+
+        cmc_assert_not_equals(ptr, NULL, even);
+        cmc_assert_equals(size_t, 50000, l_count(l));
+        cmc_assert_equals(size_t, 50000, l_count(even));
+
+        for (size_t i = 0; i < 50000; i++)
+        {
+            cmc_assert_equals(size_t, i * 2 + 1, l_get(l, i));
+            cmc_assert_equals(size_t, i * 2, l_get(even, i));
+        }
+
+        l_fill(even, 5, 4);
+        cmc_assert_equals(size_t, 250000, l_reduce(even, 0, l_add, NULL, 4));
+
+        l_free(l);
+        l_free(even);
+    });
+    CMC_CREATE_TEST(small buffer[sbo], {
+        alloc_total_calls = 0;
+
+        struct list_sbo l = ls_init_custom(4, ls_fval, counting_alloc, NULL);
+
+        cmc_assert_equals(ptr, ls_fval, l.f_val);
+        cmc_assert_equals(size_t, 8, ls_capacity(&l));
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(ls_push_back(&l, i));
+
+        cmc_assert(ls_full(&l));
+        cmc_assert_equals(int32_t, 0, alloc_total_calls);
+
+        // The elements move with the struct
+        struct list_sbo moved = l;
+
+        // Even when it is copied over the target of an iterator
+        struct list_sbo_iter it = ls_iter_start(&moved);
+
+        moved = l;
+
+        cmc_assert_equals(size_t, 0, ls_iter_value(&it));
+        cmc_assert_equals(ptr, moved.sbo, ls_iter_rvalue(&it));
+
+        cmc_assert_equals(size_t, 7, ls_back(&moved));
+        cmc_assert_equals(ptr, moved.sbo, moved.buffer);
+
+        // Spills to the heap when it grows past the inline storage
+        cmc_assert(ls_push_back(&moved, 8));
+        cmc_assert_equals(int32_t, 1, alloc_total_calls);
+        cmc_assert_equals(size_t, 16, ls_capacity(&moved));
+        cmc_assert_not_equals(ptr, moved.sbo, moved.buffer);
+
+        for (size_t i = 0; i < 9; i++)
+            cmc_assert_equals(size_t, i, ls_get(&moved, i));
+
+        // And goes back to it when shrunk. Smaller capacities are rounded up
+        // to the size of the inline storage.
+        cmc_assert(ls_pop_front(&moved));
+        cmc_assert(ls_resize(&moved, 4));
+        cmc_assert_equals(size_t, 8, ls_capacity(&moved));
+        cmc_assert_equals(ptr, moved.sbo, moved.buffer);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert_equals(size_t, i + 1, ls_get(&moved, i));
+
+        ls_release(moved);
+
+        // Only the struct is allocated
+        alloc_total_calls = 0;
+
+        struct list_sbo *h = ls_new_custom(1, ls_fval, counting_alloc, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, h);
+        cmc_assert_equals(int32_t, 1, alloc_total_calls);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ls_push_front(h, i));
+
+        struct list_sbo *copy = ls_copy_of(h);
+
+        cmc_assert(ls_equals(h, copy));
+
+        ls_free(h);
+        ls_free(copy);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct list *l = l_new(10, l_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(l_reserve(l, 10));
+        cmc_assert_equals(size_t, 10, l_capacity(l));
+        cmc_assert(l_reserve(l, 100));
+        cmc_assert_equals(size_t, 100, l_capacity(l));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 30, l_capacity(l));
+        cmc_assert(l_full(l));
+
+        cmc_assert(l_push_back(l, 30));
+        cmc_assert_equals(size_t, 60, l_capacity(l));
+
+        for (size_t i = 0; i < 31; i++)
+            cmc_assert_equals(size_t, i, l_get(l, i));
+
+        l_clear(l);
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 1, l_capacity(l));
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(growth[mremap], {
+        struct list *l = l_new_custom(1, l_fval, &cmc_alloc_node_mremap, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        /* The buffer crosses CMC_MREMAP_THRESHOLD and keeps growing after */
+        for (size_t i = 0; i < 1000000; i++)
+            cmc_assert(l_push_back(l, i));
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 1000000, l_capacity(l));
+        cmc_assert(l_reserve(l, 1000000));
+        cmc_assert_equals(size_t, 2000000, l_capacity(l));
+
+        size_t wrong = 0;
+
+        for (size_t i = 0; i < 1000000; i++)
+            wrong += l_get(l, i) != i;
+
+        cmc_assert_equals(size_t, 0, wrong);
+
+        for (size_t i = 0; i < 999990; i++)
+            cmc_assert(l_pop_back(l));
+
+        cmc_assert(l_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 9, l_back(l));
+
+        l_free(l);
+    });
+
+    CMC_CREATE_TEST(trivial[copy_of equals], {
+        v_total_cmp = 0;
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct list_trivial *l = lt_new(100, lt_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(lt_push_back(l, i));
+
+        struct list_trivial *copy = lt_copy_of(l);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert(lt_equals(l, copy));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(size_t, i, lt_get(copy, i));
+
+        cmc_assert(lt_pop_back(copy));
+        cmc_assert(lt_push_back(copy, 0));
+        cmc_assert(!lt_equals(l, copy));
+
+        lt_clear(l);
+        cmc_assert(lt_empty(l));
+
+        lt_free(l);
+        lt_free(copy);
+
+        cmc_assert_equals(int32_t, 0, v_total_cmp);
+        cmc_assert_equals(int32_t, 0, v_total_cpy);
+        cmc_assert_equals(int32_t, 0, v_total_free);
+    });
+
+    CMC_CREATE_TEST(views, {
+        struct list *l = l_new(100, l_fval);
+        struct list_arith *la = la_new(100, la_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+        cmc_assert_not_equals(ptr, NULL, la);
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(l_push_back(l, i % 50));
+            cmc_assert(la_push_back(la, i % 50));
+        }
+
+        struct list_view view = l_view(l, 30, 79);
+
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, l_flag(l));
+        cmc_assert_equals(size_t, 50, view.count);
+        cmc_assert_equals(size_t, 30, l_view_get(&view, 0));
+        cmc_assert_equals(size_t, 29, l_view_get(&view, 49));
+        cmc_assert_equals(size_t, 0, l_view_get(&view, 50));
+
+        cmc_assert_equals(size_t, 20, l_view_index_of(&view, 0, true));
+        cmc_assert_equals(size_t, 5, l_view_index_of(&view, 35, false));
+        cmc_assert_equals(size_t, 50, l_view_index_of(&view, 50, true));
+        cmc_assert_equals(size_t, 1, l_view_count_of(&view, 40));
+        cmc_assert(l_view_contains(&view, 29));
+        cmc_assert(!l_view_contains(&view, 99));
+
+        struct list_arith_view aview = la_view(la, 30, 79);
+
+        cmc_assert_equals(size_t, 20, la_view_index_of(&aview, 0, true));
+        cmc_assert_equals(size_t, 5, la_view_index_of(&aview, 35, false));
+        cmc_assert_equals(size_t, 1, la_view_count_of(&aview, 40));
+        cmc_assert(!la_view_contains(&aview, 99));
+
+        /* Both halves of the list hold the same elements */
+        struct list_view first = l_view(l, 0, 49);
+        struct list_view second = l_view(l, 50, 99);
+        struct list_view slice = l_view_slice(&view, 20, 69);
+
+        cmc_assert_equals(size_t, 0, slice.count);
+
+        slice = l_view_slice(&view, 20, 49);
+
+        cmc_assert_equals(size_t, 30, slice.count);
+        cmc_assert(l_view_equals(&first, &second));
+        cmc_assert(!l_view_equals(&first, &view));
+        cmc_assert_equals(size_t, 435, l_view_reduce(&slice, 0, l_add, NULL, 2));
+        cmc_assert_equals(size_t, 25, l_view_count_if(&view, l_is_odd, NULL, 4));
+
+        view = l_view(l, 10, 5);
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, l_flag(l));
+        cmc_assert_equals(size_t, 0, view.count);
+        view = l_view(l, 10, 100);
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, l_flag(l));
+        cmc_assert_equals(ptr, NULL, view.data);
+
+        l_free(l);
+        la_free(la);
+    });
 })
 
 CMC_CREATE_UNIT(CMCListIter, true, {
@@ -0,0 +1,311 @@
+#ifndef CMC_TESTS_UNT_PACKEDLIST_H
+#define CMC_TESTS_UNT_PACKEDLIST_H
+
+#include "utl.h"
+
+#undef V
+#define V uint64_t
+#define PFX pl
+#define SNAME packedlist
+#include "cmc/packedlist.h"
+
+#include "undef.h"
+
+/* Sorted values with gaps that grow with the index and some duplicates */
+uint64_t *pl_values(size_t count)
+{
+    uint64_t *values = malloc(sizeof(uint64_t) * (count > 0 ? count : 1));
+
+    uint64_t current = 7;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i % 5 != 0)
+            current += (i * i) % 1000;
+
+        values[i] = current;
+    }
+
+    return values;
+}
+
+CMC_CREATE_UNIT(CMCPackedList, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct packedlist *pl = pl_new(NULL, 0);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+        cmc_assert(pl_empty(pl));
+        cmc_assert_equals(size_t, 0, pl_count(pl));
+        cmc_assert_equals(size_t, 0, pl->blocks);
+
+        pl_min(pl);
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, pl_flag(pl));
+        cmc_assert(!pl_contains(pl, 0));
+        cmc_assert_equals(size_t, 0, pl_lower_bound(pl, 10));
+
+        pl_free(pl);
+
+        uint64_t values[3];
+        values[0] = 1;
+        values[1] = 3;
+        values[2] = 2;
+
+        cmc_assert_equals(ptr, NULL, pl_new(NULL, 3));
+        cmc_assert_equals(ptr, NULL, pl_new(values, 3));
+
+        pl = pl_new(values, 2);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+        cmc_assert_equals(size_t, 2, pl_count(pl));
+        cmc_assert_equals(uint64_t, 1, pl_min(pl));
+        cmc_assert_equals(uint64_t, 3, pl_max(pl));
+
+        pl_free(pl);
+    });
+
+    CMC_CREATE_TEST(PFX##_get(), {
+        for (size_t count = 0; count <= 300; count += 37)
+        {
+            uint64_t *values = pl_values(count);
+
+            struct packedlist *pl = pl_new(values, count);
+
+            cmc_assert_not_equals(ptr, NULL, pl);
+            cmc_assert_equals(size_t, (count + 127) / 128, pl->blocks);
+
+            for (size_t i = 0; i < count; i++)
+                cmc_assert_equals(uint64_t, values[i], pl_get(pl, i));
+
+            pl_get(pl, count);
+            cmc_assert_equals(int32_t, count == 0 ? CMC_FLAG_EMPTY : CMC_FLAG_RANGE, pl_flag(pl));
+
+            pl_free(pl);
+            free(values);
+        }
+    });
+
+    CMC_CREATE_TEST(PFX##_decode(), {
+        uint64_t *values = pl_values(1000);
+        uint64_t *buffer = malloc(sizeof(uint64_t) * 1000);
+
+        struct packedlist *pl = pl_new(values, 1000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        cmc_assert_equals(size_t, 1000, pl_decode(pl, 0, 999, buffer));
+        cmc_assert_equals(int32_t, 0, memcmp(values, buffer, sizeof(uint64_t) * 1000));
+
+        size_t bounds[6];
+        bounds[0] = 0;
+        bounds[1] = 5;
+        bounds[2] = 127;
+        bounds[3] = 256;
+        bounds[4] = 384;
+        bounds[5] = 1000;
+
+        for (size_t r = 0; r + 1 < 6; r++)
+        {
+            size_t from = bounds[r];
+            size_t to = bounds[r + 1] - 1;
+
+            memset(buffer, 0, sizeof(uint64_t) * 1000);
+
+            cmc_assert_equals(size_t, to - from + 1, pl_decode(pl, from, to, buffer));
+            cmc_assert_equals(int32_t, CMC_FLAG_OK, pl_flag(pl));
+            cmc_assert_equals(int32_t, 0, memcmp(values + from, buffer, sizeof(uint64_t) * (to - from + 1)));
+        }
+
+        cmc_assert_equals(size_t, 1, pl_decode(pl, 999, 999, buffer));
+        cmc_assert_equals(size_t, values[999], buffer[0]);
+        cmc_assert_equals(size_t, 0, pl_decode(pl, 10, 1000, buffer));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, pl_flag(pl));
+        cmc_assert_equals(size_t, 0, pl_decode(pl, 11, 10, buffer));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, pl_flag(pl));
+
+        pl_free(pl);
+        free(buffer);
+        free(values);
+    });
+
+    CMC_CREATE_TEST(PFX##_lower_bound() and _contains(), {
+        uint64_t *values = pl_values(1000);
+
+        struct packedlist *pl = pl_new(values, 1000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            size_t expected = i;
+
+            while (expected > 0 && values[expected - 1] == values[i])
+                expected--;
+
+            cmc_assert_equals(size_t, expected, pl_lower_bound(pl, values[i]));
+            cmc_assert(pl_contains(pl, values[i]));
+
+            if (i > 0 && values[i] - values[i - 1] > 1)
+            {
+                cmc_assert_equals(size_t, i, pl_lower_bound(pl, values[i] - 1));
+                cmc_assert(!pl_contains(pl, values[i] - 1));
+            }
+        }
+
+        cmc_assert_equals(size_t, 0, pl_lower_bound(pl, 0));
+        cmc_assert(!pl_contains(pl, 0));
+        cmc_assert_equals(size_t, 1000, pl_lower_bound(pl, values[999] + 1));
+        cmc_assert(!pl_contains(pl, values[999] + 1));
+
+        pl_free(pl);
+        free(values);
+    });
+
+    CMC_CREATE_TEST(widths, {
+        uint64_t *values = malloc(sizeof(uint64_t) * 1000);
+
+        /* Every block with the same width */
+        for (size_t width = 0; width <= 33; width++)
+        {
+            for (size_t i = 0; i < 1000; i++)
+                values[i] = width == 0 ? 42 : (uint64_t)i << (width - 1);
+
+            struct packedlist *pl = pl_new(values, 1000);
+
+            cmc_assert_not_equals(ptr, NULL, pl);
+
+            for (size_t i = 0; i < 1000; i++)
+                cmc_assert_equals(uint64_t, values[i], pl_get(pl, i));
+
+            cmc_assert_equals(uint64_t, values[999], pl_max(pl));
+
+            pl_free(pl);
+        }
+
+        /* Differences that need all 64 bits */
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = i < 500 ? i : UINT64_MAX - (999 - i);
+
+        struct packedlist *pl = pl_new(values, 1000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(uint64_t, values[i], pl_get(pl, i));
+
+        cmc_assert_equals(uint64_t, UINT64_MAX, pl_max(pl));
+        cmc_assert_equals(size_t, 500, pl_lower_bound(pl, 500));
+        cmc_assert(pl_contains(pl, UINT64_MAX - 10));
+
+        pl_free(pl);
+        free(values);
+    });
+
+    CMC_CREATE_TEST(PFX##_memory(), {
+        uint64_t *values = malloc(sizeof(uint64_t) * 100000);
+
+        for (size_t i = 0; i < 100000; i++)
+            values[i] = 1000000 + i * 3 + (i % 2);
+
+        struct packedlist *pl = pl_new(values, 100000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        /* Differences of at most 4 fit in 3 bits */
+        cmc_assert_lesser(size_t, sizeof(uint64_t) * 100000 / 8, pl_memory(pl));
+
+        pl_free(pl);
+        free(values);
+    });
+});
+
+CMC_CREATE_UNIT(CMCPackedListIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct packedlist *pl = pl_new(NULL, 0);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        struct packedlist_iter it = pl_iter_start(pl);
+
+        cmc_assert_equals(ptr, pl, it.target);
+        cmc_assert_equals(size_t, 0, it.cursor);
+        cmc_assert(pl_iter_at_start(&it));
+        cmc_assert(pl_iter_at_end(&it));
+
+        pl_free(pl);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next() and _iter_prev(), {
+        uint64_t *values = pl_values(1000);
+
+        struct packedlist *pl = pl_new(values, 1000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        size_t index = 0;
+
+        for (struct packedlist_iter it = pl_iter_start(pl); !pl_iter_at_end(&it); pl_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, pl_iter_index(&it));
+            cmc_assert_equals(uint64_t, values[index], pl_iter_value(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 1000, index);
+
+        for (struct packedlist_iter it = pl_iter_end(pl); !pl_iter_at_start(&it); pl_iter_prev(&it))
+        {
+            index--;
+            cmc_assert_equals(uint64_t, values[index], pl_iter_value(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        pl_free(pl);
+        free(values);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound() and _iter_go_to(), {
+        uint64_t *values = pl_values(1000);
+
+        struct packedlist *pl = pl_new(values, 1000);
+
+        cmc_assert_not_equals(ptr, NULL, pl);
+
+        struct packedlist_iter it = pl_iter_lower_bound(pl, values[600]);
+
+        cmc_assert_equals(size_t, pl_lower_bound(pl, values[600]), pl_iter_index(&it));
+        cmc_assert_equals(uint64_t, values[600], pl_iter_value(&it));
+
+        cmc_assert(pl_iter_go_to(&it, 10));
+        cmc_assert_equals(uint64_t, values[10], pl_iter_value(&it));
+        cmc_assert(pl_iter_advance(&it, 500));
+        cmc_assert_equals(uint64_t, values[510], pl_iter_value(&it));
+        cmc_assert(pl_iter_rewind(&it, 300));
+        cmc_assert_equals(uint64_t, values[210], pl_iter_value(&it));
+        cmc_assert(!pl_iter_go_to(&it, 1000));
+
+        it = pl_iter_lower_bound(pl, values[999] + 1);
+
+        cmc_assert(pl_iter_at_end(&it));
+
+        pl_free(pl);
+        free(values);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCPackedList() + CMCPackedListIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCPackedList Suit : %-43s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_PACKEDLIST_H */
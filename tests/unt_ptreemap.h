@@ -0,0 +1,442 @@
+#ifndef CMC_TESTS_UNT_PTREEMAP_H
+#define CMC_TESTS_UNT_PTREEMAP_H
+
+#include "utl.h"
+
+#define V size_t
+#define K size_t
+#define PFX ptm
+#define SNAME ptreemap
+#include "cmc/ptreemap.h"
+
+struct ptreemap_fkey *ptm_fkey = &(struct ptreemap_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct ptreemap_fval *ptm_fval = &(struct ptreemap_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+/* Returns the height of a valid AVL subtree with keys in (lower, upper) or -1 */
+int ptm_check(struct ptreemap_node *node, size_t lower, size_t upper)
+{
+    if (node == NULL)
+        return 0;
+
+    if (node->key <= lower || node->key >= upper || node->refs == 0)
+        return -1;
+
+    int l = ptm_check(node->left, lower, node->key);
+    int r = ptm_check(node->right, node->key, upper);
+
+    if (l < 0 || r < 0 || l - r > 1 || r - l > 1)
+        return -1;
+
+    int h = 1 + (l > r ? l : r);
+
+    return h == node->height ? h : -1;
+}
+
+bool ptm_valid(struct ptreemap *map)
+{
+    return ptm_check(map->root, 0, SIZE_MAX) >= 0;
+}
+
+/* Nodes that are not shared with any other version of the map */
+size_t ptm_unshared(struct ptreemap_node *node)
+{
+    if (node == NULL || node->refs > 1)
+        return 0;
+
+    return 1 + ptm_unshared(node->left) + ptm_unshared(node->right);
+}
+
+CMC_CREATE_UNIT(CMCPTreeMap, true, {
+    CMC_CREATE_TEST(new, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(ptr, NULL, map->root);
+        cmc_assert_equals(size_t, 0, ptm_count(map));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, ptm_flag(map));
+
+        ptm_free(map);
+
+        cmc_assert_equals(ptr, NULL, ptm_new(NULL, ptm_fval));
+        cmc_assert_equals(ptr, NULL, ptm_new(ptm_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(insert, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(ptm_insert(map, (i * 7919) % 1009, i));
+
+        cmc_assert_equals(size_t, 1000, ptm_count(map));
+        cmc_assert(ptm_valid(map));
+
+        cmc_assert(!ptm_insert(map, 7919 % 1009, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, ptm_flag(map));
+        cmc_assert_equals(size_t, 1, ptm_get(map, 7919 % 1009));
+
+        size_t key = 0;
+        cmc_assert(ptm_min(map, &key, NULL));
+        cmc_assert_equals(size_t, 1, key);
+        cmc_assert(ptm_max(map, &key, NULL));
+        cmc_assert_equals(size_t, 1008, key);
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(update, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t old;
+
+        cmc_assert(!ptm_update(map, 1, 1, &old));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, ptm_flag(map));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        cmc_assert(ptm_update(map, 50, 500, &old));
+        cmc_assert_equals(size_t, 50, old);
+        cmc_assert_equals(size_t, 500, ptm_get(map, 50));
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t value;
+
+        cmc_assert(!ptm_remove(map, 1, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, ptm_flag(map));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(ptm_insert(map, i, i * 2));
+
+        cmc_assert(!ptm_remove(map, 1001, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, ptm_flag(map));
+
+        for (size_t i = 1; i <= 1000; i += 3)
+        {
+            cmc_assert(ptm_remove(map, i, &value));
+            cmc_assert_equals(size_t, i * 2, value);
+        }
+
+        cmc_assert_equals(size_t, 666, ptm_count(map));
+        cmc_assert(ptm_valid(map));
+        cmc_assert(!ptm_contains(map, 1));
+        cmc_assert(ptm_contains(map, 2));
+
+        for (size_t i = 1; i <= 1000; i++)
+            ptm_remove(map, i, NULL);
+
+        cmc_assert(ptm_empty(map));
+        cmc_assert_equals(ptr, NULL, map->root);
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(snapshot, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap *snap = ptm_snapshot(map);
+
+        cmc_assert_not_equals(ptr, NULL, snap);
+        cmc_assert_equals(ptr, map->root, snap->root);
+        cmc_assert_equals(size_t, 2, map->root->refs);
+        cmc_assert(ptm_equals(map, snap));
+
+        // Only the path to the new key is copied
+        cmc_assert(ptm_insert(map, 5000, 5000));
+        cmc_assert(ptm_unshared(map->root) <= 2 * map->root->height);
+
+        for (size_t i = 1; i <= 1000; i += 2)
+            cmc_assert(ptm_remove(map, i, NULL));
+        for (size_t i = 2; i <= 1000; i += 2)
+            cmc_assert(ptm_update(map, i, 0, NULL));
+
+        cmc_assert(ptm_valid(map));
+        cmc_assert(ptm_valid(snap));
+        cmc_assert(!ptm_equals(map, snap));
+        cmc_assert_equals(size_t, 501, ptm_count(map));
+        cmc_assert_equals(size_t, 1000, ptm_count(snap));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert_equals(size_t, i, ptm_get(snap, i));
+        cmc_assert(!ptm_contains(snap, 5000));
+
+        // The snapshot outlives the map it came from
+        ptm_free(map);
+
+        cmc_assert(ptm_valid(snap));
+        cmc_assert_equals(size_t, 500, ptm_get(snap, 500));
+
+        ptm_free(snap);
+    });
+
+    CMC_CREATE_TEST(restore, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap *snap = ptm_snapshot(map);
+
+        cmc_assert_not_equals(ptr, NULL, snap);
+
+        ptm_clear(map);
+
+        cmc_assert(ptm_empty(map));
+        cmc_assert_equals(size_t, 100, ptm_count(snap));
+
+        cmc_assert(ptm_insert(map, 200, 200));
+
+        ptm_restore(map, snap);
+
+        cmc_assert(ptm_equals(map, snap));
+        cmc_assert(!ptm_contains(map, 200));
+
+        // Restoring the same version keeps every node alive
+        ptm_restore(map, map);
+
+        cmc_assert_equals(size_t, 100, ptm_count(map));
+        cmc_assert(ptm_valid(map));
+
+        ptm_free(map);
+        ptm_free(snap);
+    });
+
+    CMC_CREATE_TEST(copy_of, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap *copy = ptm_copy_of(map);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert(ptm_equals(map, copy));
+
+        cmc_assert(ptm_update(copy, 1, 2, NULL));
+
+        cmc_assert(!ptm_equals(map, copy));
+        cmc_assert_equals(size_t, 1, ptm_get(map, 1));
+
+        ptm_free(map);
+        ptm_free(copy);
+    });
+
+    CMC_CREATE_TEST(equals, {
+        struct ptreemap *map1 = ptm_new(ptm_fkey, ptm_fval);
+        struct ptreemap *map2 = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map1);
+        cmc_assert_not_equals(ptr, NULL, map2);
+
+        cmc_assert(ptm_equals(map1, map2));
+
+        // Same elements inserted in a different order
+        for (size_t i = 1; i <= 100; i++)
+        {
+            cmc_assert(ptm_insert(map1, i, i));
+            cmc_assert(ptm_insert(map2, 101 - i, 101 - i));
+        }
+
+        cmc_assert(ptm_equals(map1, map2));
+
+        cmc_assert(ptm_update(map2, 50, 0, NULL));
+
+        cmc_assert(!ptm_equals(map1, map2));
+
+        ptm_free(map1);
+        ptm_free(map2);
+    });
+});
+
+CMC_CREATE_UNIT(CMCPTreeMapIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct ptreemap_iter it = ptm_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(size_t, 0, it.depth);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert(ptm_iter_at_start(&it));
+        cmc_assert(ptm_iter_at_end(&it));
+        cmc_assert(!ptm_iter_next(&it));
+        cmc_assert(!ptm_iter_to_start(&it));
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        it = ptm_iter_start(map);
+
+        cmc_assert_equals(size_t, 1, ptm_iter_key(&it));
+        cmc_assert(ptm_iter_at_start(&it));
+        cmc_assert(!ptm_iter_at_end(&it));
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_end(), {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap_iter it = ptm_iter_end(map);
+
+        cmc_assert_equals(size_t, 2, ptm_iter_index(&it));
+        cmc_assert_equals(size_t, 3, ptm_iter_key(&it));
+        cmc_assert(ptm_iter_at_end(&it));
+        cmc_assert(!ptm_iter_at_start(&it));
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(ptm_insert(map, (i * 7919) % 1009, i));
+
+        size_t sum = 0;
+        size_t index = 0;
+        size_t last = 0;
+
+        for (struct ptreemap_iter it = ptm_iter_start(map); !ptm_iter_at_end(&it); ptm_iter_next(&it))
+        {
+            cmc_assert(ptm_iter_key(&it) > last);
+            cmc_assert_equals(size_t, index, ptm_iter_index(&it));
+
+            last = ptm_iter_key(&it);
+            sum += ptm_iter_value(&it);
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 1000, index);
+        cmc_assert_equals(size_t, 500500, sum);
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(ptm_insert(map, (i * 7919) % 1009, i));
+
+        size_t index = 1000;
+        size_t last = SIZE_MAX;
+
+        for (struct ptreemap_iter it = ptm_iter_end(map); !ptm_iter_at_start(&it); ptm_iter_prev(&it))
+        {
+            index--;
+
+            cmc_assert(ptm_iter_key(&it) < last);
+            cmc_assert_equals(size_t, index, ptm_iter_index(&it));
+
+            last = ptm_iter_key(&it);
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap_iter it = ptm_iter_start(map);
+
+        cmc_assert(ptm_iter_go_to(&it, 50));
+        cmc_assert_equals(size_t, 50, ptm_iter_key(&it));
+        cmc_assert(ptm_iter_advance(&it, 49));
+        cmc_assert_equals(size_t, 99, ptm_iter_key(&it));
+        cmc_assert(!ptm_iter_advance(&it, 1));
+        cmc_assert(ptm_iter_rewind(&it, 99));
+        cmc_assert_equals(size_t, 0, ptm_iter_key(&it));
+        cmc_assert(!ptm_iter_go_to(&it, 100));
+
+        ptm_free(map);
+    });
+
+    CMC_CREATE_TEST(snapshot, {
+        struct ptreemap *map = ptm_new(ptm_fkey, ptm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ptm_insert(map, i, i));
+
+        struct ptreemap *snap = ptm_snapshot(map);
+
+        cmc_assert_not_equals(ptr, NULL, snap);
+
+        struct ptreemap_iter it = ptm_iter_start(snap);
+
+        // Modifying the map does not affect an iterator over a snapshot
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ptm_remove(map, i, NULL));
+
+        size_t count = 0;
+
+        for (; !ptm_iter_at_end(&it); ptm_iter_next(&it))
+            cmc_assert_equals(size_t, count++, ptm_iter_key(&it));
+
+        cmc_assert_equals(size_t, 100, count);
+
+        ptm_free(map);
+        ptm_free(snap);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCPTreeMap() + CMCPTreeMapIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCPTreeMap Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_PTREEMAP_H */
@@ -472,6 +472,37 @@ CMC_CREATE_UNIT(CMCQueue, true, {
         q_free(q);
         q_free(q2);
     });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct queue *q = q_new(4, q_fval);
+
+        cmc_assert_not_equals(ptr, NULL, q);
+
+        for (size_t i = 0; i < 4; i++)
+            cmc_assert(q_enqueue(q, i));
+
+        /* The elements wrap around the end of the buffer when it grows */
+        cmc_assert(q_dequeue(q));
+        cmc_assert(q_dequeue(q));
+        cmc_assert(q_enqueue(q, 4));
+        cmc_assert(q_enqueue(q, 5));
+        cmc_assert(q_enqueue(q, 6));
+        cmc_assert_equals(size_t, 8, q_capacity(q));
+
+        cmc_assert(q_reserve(q, 10));
+        cmc_assert_equals(size_t, 15, q_capacity(q));
+
+        cmc_assert(q_shrink_to_fit(q));
+        cmc_assert_equals(size_t, 5, q_capacity(q));
+        cmc_assert(q_full(q));
+
+        for (size_t i = 2; i < 7; i++)
+        {
+            cmc_assert_equals(size_t, i, q_peek(q));
+            cmc_assert(q_dequeue(q));
+        }
+
+        q_free(q);
+    });
 });
 
 CMC_CREATE_UNIT(CMCQueueIter, true, {
@@ -0,0 +1,333 @@
+#ifndef CMC_TESTS_UNT_SEGDEQUE_H
+#define CMC_TESTS_UNT_SEGDEQUE_H
+
+#include "utl.h"
+
+#define V size_t
+#define PFX sd
+#define SNAME segdeque
+#include "cmc/segdeque.h"
+
+struct segdeque_fval *sd_fval = &(struct segdeque_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct segdeque_fval *sd_fval_counter = &(struct segdeque_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+CMC_CREATE_UNIT(CMCSegDeque, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct segdeque *d = sd_new(1000, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+        cmc_assert_not_equals(ptr, NULL, d->map);
+        cmc_assert_equals(ptr, NULL, d->spare);
+        cmc_assert_greater_equals(size_t, 1000, sd_capacity(d));
+        cmc_assert_equals(size_t, 0, sd_count(d));
+        cmc_assert(sd_empty(d));
+
+        /* No block is allocated before the first push */
+        for (size_t i = 0; i < d->map_size; i++)
+            cmc_assert_equals(ptr, NULL, d->map[i]);
+
+        sd_free(d);
+
+        cmc_assert_equals(ptr, NULL, sd_new(0, sd_fval));
+        cmc_assert_equals(ptr, NULL, sd_new(100, NULL));
+    });
+
+    CMC_CREATE_TEST(push and pop[both ends], {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert(!sd_pop_front(d));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, sd_flag(d));
+        cmc_assert(!sd_pop_back(d));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, sd_flag(d));
+        cmc_assert_equals(size_t, 0, sd_front(d));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, sd_flag(d));
+
+        /* Front is 4999, ..., 0 and back is 0, ..., 4999 */
+        for (size_t i = 0; i < 5000; i++)
+        {
+            cmc_assert(sd_push_back(d, 10000 + i));
+            cmc_assert(sd_push_front(d, 9999 - i));
+        }
+
+        cmc_assert_equals(size_t, 10000, sd_count(d));
+        cmc_assert_equals(size_t, 5000, sd_front(d));
+        cmc_assert_equals(size_t, 14999, sd_back(d));
+
+        for (size_t i = 0; i < 10000; i++)
+            cmc_assert_equals(size_t, 5000 + i, sd_get(d, i));
+
+        cmc_assert_equals(size_t, 0, sd_get(d, 10000));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, sd_flag(d));
+        cmc_assert_equals(ptr, NULL, sd_get_ref(d, 10000));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, sd_flag(d));
+
+        for (size_t i = 0; i < 4000; i++)
+        {
+            cmc_assert(sd_pop_front(d));
+            cmc_assert(sd_pop_back(d));
+        }
+
+        cmc_assert_equals(size_t, 2000, sd_count(d));
+        cmc_assert_equals(size_t, 9000, sd_front(d));
+        cmc_assert_equals(size_t, 10999, sd_back(d));
+
+        while (!sd_empty(d))
+            cmc_assert(sd_pop_back(d));
+
+        /* Every block is released and one of them is kept as the spare */
+        for (size_t i = 0; i < d->map_size; i++)
+            cmc_assert_equals(ptr, NULL, d->map[i]);
+
+        cmc_assert_not_equals(ptr, NULL, d->spare);
+
+        cmc_assert(sd_push_front(d, 1));
+        cmc_assert_equals(ptr, NULL, d->spare);
+        cmc_assert_equals(size_t, 1, sd_back(d));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(stable addresses, {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        cmc_assert(sd_push_back(d, 100));
+
+        size_t *first = sd_get_ref(d, 0);
+        size_t map_size = d->map_size;
+
+        cmc_assert_not_equals(ptr, NULL, first);
+
+        /* The map is grown many times but the elements never move */
+        for (size_t i = 0; i < 20000; i++)
+        {
+            cmc_assert(sd_push_back(d, 200));
+            cmc_assert(sd_push_front(d, 0));
+        }
+
+        cmc_assert_greater(size_t, map_size, d->map_size);
+        cmc_assert_equals(ptr, first, sd_get_ref(d, 20000));
+        cmc_assert_equals(size_t, 100, *first);
+
+        size_t *last = sd_get_ref(d, sd_count(d) - 1);
+
+        for (size_t i = 0; i < 15000; i++)
+            cmc_assert(sd_pop_front(d));
+
+        for (size_t i = 0; i < 20000; i++)
+            cmc_assert(sd_push_front(d, 0));
+
+        cmc_assert_equals(ptr, last, sd_get_ref(d, sd_count(d) - 1));
+        cmc_assert_equals(size_t, 200, *last);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(blocks are recycled, {
+        struct segdeque *d = sd_new(100, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        /* Used as a work queue the window of elements drifts to the back. */
+        /* Once the map is large enough it is only centered again. */
+        for (size_t i = 100; i < 10000; i++)
+        {
+            cmc_assert(sd_pop_front(d));
+            cmc_assert(sd_push_back(d, i));
+        }
+
+        size_t capacity = sd_capacity(d);
+
+        for (size_t i = 10000; i < 100000; i++)
+        {
+            cmc_assert_equals(size_t, i - 100, sd_front(d));
+            cmc_assert(sd_pop_front(d));
+            cmc_assert(sd_push_back(d, i));
+        }
+
+        cmc_assert_equals(size_t, capacity, sd_capacity(d));
+        cmc_assert_equals(size_t, 100, sd_count(d));
+
+        size_t blocks = 0;
+
+        for (size_t i = 0; i < d->map_size; i++)
+            blocks += d->map[i] != NULL;
+
+        cmc_assert_lesser_equals(size_t, 2, blocks);
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_clear() and _shrink_to_fit(), {
+        v_total_free = 0;
+
+        struct segdeque *d = sd_new(1, sd_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 10000; i++)
+            cmc_assert(sd_push_front(d, i));
+
+        sd_clear(d);
+
+        cmc_assert_equals(int32_t, 10000, v_total_free);
+        cmc_assert(sd_empty(d));
+        cmc_assert_not_equals(ptr, NULL, d->spare);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sd_push_back(d, i));
+
+        cmc_assert(sd_shrink_to_fit(d));
+        cmc_assert_equals(ptr, NULL, d->spare);
+        cmc_assert_lesser_equals(size_t, 1000 + 4 * CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(size_t)), sd_capacity(d));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(size_t, i, sd_get(d, i));
+
+        cmc_assert(sd_push_front(d, 1000));
+        cmc_assert(sd_push_back(d, 1001));
+        cmc_assert_equals(size_t, 1000, sd_front(d));
+        cmc_assert_equals(size_t, 1001, sd_back(d));
+
+        sd_free(d);
+
+        cmc_assert_equals(int32_t, 11002, v_total_free);
+    });
+
+    CMC_CREATE_TEST(search, {
+        struct segdeque *d = sd_new(100, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 3000; i++)
+            cmc_assert(sd_push_front(d, i % 10));
+
+        cmc_assert_equals(size_t, 300, sd_count_of(d, 7));
+        cmc_assert_equals(size_t, 0, sd_count_of(d, 10));
+        cmc_assert(sd_contains(d, 9));
+        cmc_assert(!sd_contains(d, 10));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_copy_of() and _equals(), {
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct segdeque *d = sd_new(1, sd_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 1500; i++)
+        {
+            cmc_assert(sd_push_back(d, i));
+            cmc_assert(sd_push_front(d, i));
+        }
+
+        struct segdeque *copy = sd_copy_of(d);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert_equals(int32_t, 3000, v_total_cpy);
+        cmc_assert_equals(size_t, 3000, sd_count(copy));
+        cmc_assert(sd_equals(d, copy));
+
+        /* Both have the same elements at different positions of the blocks */
+        cmc_assert_not_equals(size_t, d->front % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(size_t)),
+                              copy->front % CMC_SEGDEQUE_BLOCK_LENGTH(sizeof(size_t)));
+
+        cmc_assert(sd_pop_back(copy));
+        cmc_assert(!sd_equals(d, copy));
+
+        cmc_assert(sd_push_back(copy, 1500));
+        cmc_assert(!sd_equals(d, copy));
+
+        sd_free(d);
+        sd_free(copy);
+
+        cmc_assert_equals(int32_t, 6000, v_total_free);
+    });
+});
+
+CMC_CREATE_UNIT(CMCSegDequeIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct segdeque *d = sd_new(100, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        struct segdeque_iter it = sd_iter_start(d);
+
+        cmc_assert_equals(ptr, d, it.target);
+        cmc_assert_equals(size_t, 0, it.cursor);
+        cmc_assert(sd_iter_at_start(&it));
+        cmc_assert(sd_iter_at_end(&it));
+
+        sd_free(d);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next() and _iter_prev(), {
+        struct segdeque *d = sd_new(1, sd_fval);
+
+        cmc_assert_not_equals(ptr, NULL, d);
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert(sd_push_back(d, 1000 + i));
+            cmc_assert(sd_push_front(d, 999 - i));
+        }
+
+        size_t index = 0;
+
+        for (struct segdeque_iter it = sd_iter_start(d); !sd_iter_at_end(&it); sd_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, sd_iter_index(&it));
+            cmc_assert_equals(size_t, index, sd_iter_value(&it));
+            cmc_assert_equals(ptr, sd_get_ref(d, index), sd_iter_rvalue(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 2000, index);
+
+        for (struct segdeque_iter it = sd_iter_end(d); !sd_iter_at_start(&it); sd_iter_prev(&it))
+        {
+            index--;
+            cmc_assert_equals(size_t, index, sd_iter_value(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        struct segdeque_iter it = sd_iter_start(d);
+
+        cmc_assert(sd_iter_go_to(&it, 1500));
+        cmc_assert_equals(size_t, 1500, sd_iter_value(&it));
+
+        sd_free(d);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCSegDeque() + CMCSegDequeIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCSegDeque Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_SEGDEQUE_H */
@@ -0,0 +1,393 @@
+#ifndef CMC_TESTS_UNT_SKIPLIST_H
+#define CMC_TESTS_UNT_SKIPLIST_H
+
+#include "utl.h"
+
+#define V size_t
+#define K size_t
+#define PFX skl
+#define SNAME skiplist
+#include "cmc/skiplist.h"
+
+struct skiplist_fkey *skl_fkey = &(struct skiplist_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct skiplist_fval *skl_fval = &(struct skiplist_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+/* Checks that every level is sorted and is a subset of the level below it */
+bool skl_valid(struct skiplist *map)
+{
+    size_t count = 0;
+
+    for (struct skiplist_node *scan = map->head->next[0]; scan != NULL; scan = scan->next[0])
+    {
+        if (scan->next[0] && scan->next[0]->key <= scan->key)
+            return false;
+        if (scan->next[0] && scan->next[0]->prev != scan)
+            return false;
+        if (scan->level > map->level)
+            return false;
+
+        count++;
+    }
+
+    for (size_t i = 1; i < map->level; i++)
+    {
+        struct skiplist_node *below = map->head->next[i - 1];
+
+        for (struct skiplist_node *scan = map->head->next[i]; scan != NULL; scan = scan->next[i])
+        {
+            while (below != NULL && below != scan)
+                below = below->next[i - 1];
+
+            if (below == NULL)
+                return false;
+        }
+    }
+
+    return count == map->count;
+}
+
+CMC_CREATE_UNIT(CMCSkipList, true, {
+    CMC_CREATE_TEST(new, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_not_equals(ptr, NULL, map->head);
+        cmc_assert_equals(ptr, NULL, map->tail);
+        cmc_assert_equals(size_t, 0, skl_count(map));
+        cmc_assert_equals(size_t, 1, map->level);
+
+        skl_free(map);
+
+        cmc_assert_equals(ptr, NULL, skl_new(NULL, skl_fval));
+        cmc_assert_equals(ptr, NULL, skl_new(skl_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(clear, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        skl_clear(map);
+
+        cmc_assert(skl_empty(map));
+        cmc_assert_equals(ptr, NULL, map->head->next[0]);
+        cmc_assert(skl_insert(map, 1, 1));
+        cmc_assert(skl_valid(map));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(insert, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(skl_insert(map, (i * 7919) % 1009, i));
+
+        cmc_assert_equals(size_t, 1000, skl_count(map));
+        cmc_assert(map->level > 1);
+        cmc_assert(skl_valid(map));
+
+        cmc_assert(!skl_insert(map, 7919 % 1009, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, skl_flag(map));
+        cmc_assert_equals(size_t, 1, skl_get(map, 7919 % 1009));
+
+        size_t key = 0;
+        cmc_assert(skl_min(map, &key, NULL));
+        cmc_assert_equals(size_t, 1, key);
+        cmc_assert(skl_max(map, &key, NULL));
+        cmc_assert_equals(size_t, 1008, key);
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(update, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t old = 0;
+
+        cmc_assert(!skl_update(map, 1, 1, &old));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, skl_flag(map));
+
+        cmc_assert(skl_insert(map, 1, 10));
+        cmc_assert(skl_update(map, 1, 20, &old));
+        cmc_assert_equals(size_t, 10, old);
+        cmc_assert_equals(size_t, 20, skl_get(map, 1));
+
+        *skl_get_ref(map, 1) = 30;
+        cmc_assert_equals(size_t, 30, skl_get(map, 1));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(remove, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t value;
+
+        cmc_assert(!skl_remove(map, 1, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, skl_flag(map));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(skl_insert(map, i, i * 2));
+
+        cmc_assert(!skl_remove(map, 1001, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, skl_flag(map));
+
+        for (size_t i = 1; i <= 1000; i += 3)
+        {
+            cmc_assert(skl_remove(map, i, &value));
+            cmc_assert_equals(size_t, i * 2, value);
+        }
+
+        cmc_assert_equals(size_t, 666, skl_count(map));
+        cmc_assert(skl_valid(map));
+        cmc_assert(!skl_contains(map, 1));
+        cmc_assert(skl_contains(map, 2));
+
+        cmc_assert(skl_remove(map, 999, NULL));
+        cmc_assert_equals(size_t, 998, map->tail->key);
+
+        for (size_t i = 1; i <= 1000; i++)
+            skl_remove(map, i, NULL);
+
+        cmc_assert(skl_empty(map));
+        cmc_assert_equals(ptr, NULL, map->tail);
+        cmc_assert_equals(size_t, 1, map->level);
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(floor_ceiling, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key;
+
+        cmc_assert(!skl_floor(map, 1, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, skl_flag(map));
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(skl_insert(map, i, i));
+
+        cmc_assert(skl_floor(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 50, key);
+        cmc_assert(skl_floor(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!skl_floor(map, 5, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, skl_flag(map));
+
+        cmc_assert(skl_ceiling(map, 55, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(skl_ceiling(map, 60, &key, NULL));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert(!skl_ceiling(map, 101, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, skl_flag(map));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(copy_of, {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        struct skiplist *copy = skl_copy_of(map);
+
+        cmc_assert_not_equals(ptr, NULL, copy);
+        cmc_assert(skl_valid(copy));
+        cmc_assert(skl_equals(map, copy));
+
+        cmc_assert(skl_update(copy, 50, 0, NULL));
+        cmc_assert(!skl_equals(map, copy));
+
+        cmc_assert(skl_remove(copy, 50, NULL));
+        cmc_assert(!skl_equals(map, copy));
+
+        skl_free(map);
+        skl_free(copy);
+    });
+});
+
+CMC_CREATE_UNIT(CMCSkipListIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct skiplist_iter it = skl_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert(skl_iter_at_start(&it));
+        cmc_assert(skl_iter_at_end(&it));
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        it = skl_iter_start(map);
+
+        cmc_assert_equals(size_t, 0, skl_iter_index(&it));
+        cmc_assert_equals(size_t, 1, skl_iter_key(&it));
+        cmc_assert(!skl_iter_at_end(&it));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_end(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        struct skiplist_iter it = skl_iter_end(map);
+
+        cmc_assert_equals(size_t, 2, skl_iter_index(&it));
+        cmc_assert_equals(size_t, 3, skl_iter_key(&it));
+        cmc_assert(!skl_iter_at_start(&it));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(skl_insert(map, (i * 7919) % 1009, i));
+
+        size_t sum = 0;
+        size_t index = 0;
+        size_t last = 0;
+
+        for (struct skiplist_iter it = skl_iter_start(map); !skl_iter_at_end(&it); skl_iter_next(&it))
+        {
+            cmc_assert(skl_iter_key(&it) > last);
+            cmc_assert_equals(size_t, index, skl_iter_index(&it));
+
+            last = skl_iter_key(&it);
+            sum += skl_iter_value(&it);
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 1000, index);
+        cmc_assert_equals(size_t, 500500, sum);
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        size_t index = 1000;
+
+        for (struct skiplist_iter it = skl_iter_end(map); !skl_iter_at_start(&it); skl_iter_prev(&it))
+        {
+            index--;
+
+            cmc_assert_equals(size_t, index, skl_iter_index(&it));
+            cmc_assert_equals(size_t, index + 1, skl_iter_key(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(skl_insert(map, i, i));
+
+        struct skiplist_iter it = skl_iter_start(map);
+
+        cmc_assert(skl_iter_go_to(&it, 50));
+        cmc_assert_equals(size_t, 50, skl_iter_key(&it));
+        cmc_assert(skl_iter_advance(&it, 49));
+        cmc_assert_equals(size_t, 99, skl_iter_key(&it));
+        cmc_assert(!skl_iter_advance(&it, 1));
+        cmc_assert(skl_iter_rewind(&it, 99));
+        cmc_assert_equals(size_t, 0, skl_iter_key(&it));
+        cmc_assert(!skl_iter_go_to(&it, 100));
+
+        *skl_iter_rvalue(&it) = 1000;
+        cmc_assert_equals(size_t, 1000, skl_get(map, 0));
+
+        skl_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct skiplist *map = skl_new(skl_fkey, skl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(skl_insert(map, i, i));
+
+        struct skiplist_iter it = skl_iter_lower_bound(map, 35);
+
+        cmc_assert_equals(size_t, 40, skl_iter_key(&it));
+        cmc_assert_equals(size_t, 3, skl_iter_index(&it));
+
+        it = skl_iter_lower_bound(map, 40);
+        cmc_assert_equals(size_t, 40, skl_iter_key(&it));
+
+        it = skl_iter_upper_bound(map, 40);
+        cmc_assert_equals(size_t, 50, skl_iter_key(&it));
+        cmc_assert_equals(size_t, 4, skl_iter_index(&it));
+
+        it = skl_iter_lower_bound(map, 5);
+        cmc_assert(skl_iter_at_start(&it));
+        cmc_assert_equals(size_t, 10, skl_iter_key(&it));
+
+        it = skl_iter_upper_bound(map, 100);
+        cmc_assert(skl_iter_at_end(&it));
+
+        skl_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCSkipList() + CMCSkipListIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCSkipList Suit : %-45s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_SKIPLIST_H */
@@ -12,6 +12,74 @@ struct sortedlist_fval *sl_fval = &(struct sortedlist_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* Same list but searched with the arithmetic fast path and radix sorted */
+#define V size_t
+#define PFX sla
+#define SNAME sortedlist_arith
+#define CMC_ARITHMETIC_V
+#define CMC_SORT_KEY cmc_sort_key_u64
+#include "cmc/sortedlist.h"
+
+#include "undef.h"
+
+struct sortedlist_arith_fval *sla_fval = &(struct sortedlist_arith_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct sortedlist_fval *sl_fval_counter = &(struct sortedlist_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Serializer that writes the runs as text */
+bool sl_text_write(FILE *fptr, size_t value)
+{
+    return fprintf(fptr, "%zu\n", value) > 0;
+}
+
+bool sl_text_read(FILE *fptr, size_t *value)
+{
+    return fscanf(fptr, "%zu", value) == 1;
+}
+
+struct sortedlist_xsort_io *sl_text_io = &(struct sortedlist_xsort_io){ .write = sl_text_write, .read = sl_text_read };
+
+bool sl_range_count(size_t value, void *args)
+{
+    (void)value;
+    *(size_t *)args += 1;
+    return true;
+}
+
+bool sl_is_multiple(size_t value, void *args)
+{
+    return value % *(size_t *)args == 0;
+}
+
+/* Keeps the last of the values that it is given */
+size_t sl_last(size_t a, size_t b, void *args)
+{
+    (void)a;
+    (void)args;
+    return b;
+}
+
+size_t sl_mod(size_t value, void *args)
+{
+    return value % *(size_t *)args;
+}
+
+/* Inserts the same pseudo-random values in both lists */
+void sl_fill_random(struct sortedlist *sl, struct sortedlist_arith *sla, size_t count, size_t range, size_t *seed)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        *seed = *seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+        sl_insert(sl, (*seed >> 33) % range);
+        sla_insert(sla, (*seed >> 33) % range);
+    }
+}
+
 CMC_CREATE_UNIT(CMCSortedList, true, {
     CMC_CREATE_TEST(new, {
         struct sortedlist *sl = sl_new(1000000, sl_fval);
@@ -232,6 +300,742 @@ CMC_CREATE_UNIT(CMCSortedList, true, {
         sl_free(sl);
         sl_free(sl2);
     });
+
+    CMC_CREATE_TEST(PFX##_lower_bound() and _upper_bound(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        cmc_assert_equals(size_t, 0, sl_lower_bound(sl, 10));
+
+        for (size_t i = 100; i > 0; i--)
+        {
+            sl_insert(sl, i);
+            sl_insert(sl, i);
+        }
+
+        cmc_assert_equals(size_t, 0, sl_lower_bound(sl, 0));
+        cmc_assert_equals(size_t, 0, sl_lower_bound(sl, 1));
+        cmc_assert_equals(size_t, 2, sl_upper_bound(sl, 1));
+        cmc_assert_equals(size_t, 98, sl_lower_bound(sl, 50));
+        cmc_assert_equals(size_t, 100, sl_upper_bound(sl, 50));
+        cmc_assert_equals(size_t, 200, sl_lower_bound(sl, 101));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(PFX##_floor() and _ceiling(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t value = 0;
+
+        cmc_assert(!sl_floor(sl, 10, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, sl_flag(sl));
+
+        for (size_t i = 1; i <= 100; i++)
+            sl_insert(sl, i * 10);
+
+        cmc_assert(!sl_floor(sl, 5, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, sl_flag(sl));
+        cmc_assert(sl_floor(sl, 555, &value));
+        cmc_assert_equals(size_t, 550, value);
+
+        cmc_assert(!sl_ceiling(sl, 1001, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, sl_flag(sl));
+        cmc_assert(sl_ceiling(sl, 555, &value));
+        cmc_assert_equals(size_t, 560, value);
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(PFX##_range() and _remove_range(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t total = 0;
+
+        for (size_t i = 0; i < 1000; i++)
+            sl_insert(sl, 999 - i);
+
+        cmc_assert_equals(size_t, 100, sl_range(sl, 100, 200, sl_range_count, &total));
+        cmc_assert_equals(size_t, 100, total);
+
+        cmc_assert_equals(size_t, 100, sl_remove_range(sl, 100, 200));
+        cmc_assert_equals(size_t, 900, sl_count(sl));
+        cmc_assert_equals(size_t, 99, sl_get(sl, 99));
+        cmc_assert_equals(size_t, 200, sl_get(sl, 100));
+        cmc_assert_equals(size_t, 0, sl_remove_range(sl, 100, 200));
+        cmc_assert_equals(size_t, 0, sl_remove_range(sl, 200, 100));
+
+        cmc_assert_equals(size_t, 900, sl_remove_range(sl, 0, 1000));
+        cmc_assert(sl_empty(sl));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(PFX##_insert_many(), {
+        struct sortedlist *sl = sl_new(10, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = i * 2;
+
+        cmc_assert(sl_insert_many(sl, values, 0, true));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, sl_flag(sl));
+        cmc_assert_equals(size_t, 0, sl_count(sl));
+
+        for (size_t i = 0; i < 500; i++)
+            cmc_assert(sl_insert(sl, 1999 - i * 4));
+
+        cmc_assert(sl_insert_many(sl, values, 1000, true));
+        cmc_assert_equals(size_t, 1500, sl_count(sl));
+        cmc_assert_equals(size_t, 1500, sl->sorted);
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert(sl_get(sl, i - 1) <= sl_get(sl, i));
+
+        /* Unsorted values are sorted lazily */
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = (i * 7919) % 1000;
+
+        cmc_assert(sl_insert_many(sl, values, 1000, false));
+        cmc_assert_equals(size_t, 2500, sl_count(sl));
+        cmc_assert_equals(size_t, 1500, sl->sorted);
+        cmc_assert_equals(size_t, 0, sl_min(sl));
+        cmc_assert_equals(size_t, 1999, sl_max(sl));
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert(sl_get(sl, i - 1) <= sl_get(sl, i));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(PFX##_merge(), {
+        struct sortedlist *sl1 = sl_new(100, sl_fval);
+        struct sortedlist *sl2 = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl1);
+        cmc_assert_not_equals(ptr, NULL, sl2);
+
+        cmc_assert(sl_merge(sl1, sl2));
+        cmc_assert_equals(size_t, 0, sl_count(sl1));
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert(sl_insert(i % 2 == 0 ? sl1 : sl2, 300 - i));
+
+        cmc_assert(sl_merge(sl1, sl2));
+        cmc_assert_equals(size_t, 300, sl_count(sl1));
+        cmc_assert_equals(size_t, 150, sl_count(sl2));
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert_equals(size_t, i + 1, sl_get(sl1, i));
+
+        /* Merging a list with itself duplicates every element */
+        cmc_assert(sl_merge(sl2, sl2));
+        cmc_assert_equals(size_t, 300, sl_count(sl2));
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert_equals(size_t, (i / 2) * 2 + 1, sl_get(sl2, i));
+
+        sl_free(sl1);
+        sl_free(sl2);
+    });
+
+    CMC_CREATE_TEST(PFX##_remove_many() and _remove_if(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t values[6];
+
+        values[0] = 50;
+        values[1] = 7;
+        values[2] = 1000;
+        values[3] = 7;
+        values[4] = 0;
+        values[5] = 99;
+
+        cmc_assert_equals(size_t, 0, sl_remove_many(sl, values, 6));
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(sl_insert(sl, i));
+            cmc_assert(sl_insert(sl, i));
+        }
+
+        cmc_assert_equals(size_t, 8, sl_remove_many(sl, values, 6));
+        cmc_assert_equals(size_t, 192, sl_count(sl));
+        cmc_assert(!sl_contains(sl, 7));
+        cmc_assert(!sl_contains(sl, 99));
+        cmc_assert_equals(size_t, 1, sl_min(sl));
+        cmc_assert_equals(size_t, 98, sl_max(sl));
+        cmc_assert_equals(size_t, 0, sl_remove_many(sl, values, 6));
+
+        /* The sorted prefix is kept */
+        for (size_t i = 200; i > 100; i--)
+            cmc_assert(sl_insert(sl, i));
+
+        size_t divisor = 3;
+
+        cmc_assert_equals(size_t, 64 + 33, sl_remove_if(sl, sl_is_multiple, &divisor));
+        cmc_assert_equals(size_t, 128, sl->sorted);
+        cmc_assert_equals(size_t, 128 + 67, sl_count(sl));
+
+        for (size_t i = 0; i < sl_count(sl); i++)
+            cmc_assert(sl_get(sl, i) % 3 != 0);
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert(sl_get(sl, i - 1) <= sl_get(sl, i));
+
+        divisor = 1;
+
+        cmc_assert_equals(size_t, 195, sl_remove_if(sl, sl_is_multiple, &divisor));
+        cmc_assert(sl_empty(sl));
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(PFX##_stable_sort() and _sort_parallel(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+        struct sortedlist_arith *sla = sla_new(100, sla_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+        cmc_assert_not_equals(ptr, NULL, sla);
+
+        cmc_assert(sl_stable_sort(sl));
+
+        for (size_t i = 0; i < 30000; i++)
+        {
+            cmc_assert(sl_insert(sl, (i * 7919) % 30011));
+            cmc_assert(sla_insert(sla, (i * 7919) % 30011));
+        }
+
+        cmc_assert(sl_stable_sort(sl));
+        cmc_assert_equals(size_t, 30000, sl->sorted);
+
+        /* Radix sorted */
+        sla_sort(sla);
+
+        for (size_t i = 1; i < 30000; i++)
+        {
+            cmc_assert(sl_get(sl, i - 1) < sl_get(sl, i));
+            cmc_assert_equals(size_t, sl_get(sl, i), sla_get(sla, i));
+        }
+
+        /* Only the new elements are sorted and then merged */
+        for (size_t i = 0; i < 10000; i++)
+            cmc_assert(sl_insert(sl, (i * 104729) % 40009));
+
+        cmc_assert(sl_sort_parallel(sl, 4));
+        cmc_assert_equals(size_t, 40000, sl->sorted);
+
+        for (size_t i = 1; i < 40000; i++)
+            cmc_assert(sl_get(sl, i - 1) <= sl_get(sl, i));
+
+        sl_clear(sl);
+
+        for (size_t i = 0; i < 40000; i++)
+            cmc_assert(sl_insert(sl, (i * 104729) % 40009));
+
+        cmc_assert(sl_sort_parallel(sl, 3));
+
+        for (size_t i = 1; i < 40000; i++)
+            cmc_assert(sl_get(sl, i - 1) < sl_get(sl, i));
+
+        sl_free(sl);
+        sla_free(sla);
+    });
+
+    CMC_CREATE_TEST(search[every size], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+        struct sortedlist_arith *sla = sla_new(100, sla_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+        cmc_assert_not_equals(ptr, NULL, sla);
+
+        for (size_t n = 0; n <= 70; n++)
+        {
+            for (size_t frozen = 0; frozen < 2; frozen++)
+            {
+                if (frozen)
+                    cmc_assert(sl_freeze(sl));
+
+                for (size_t value = 0; value <= n + 1; value++)
+                {
+                    /* Every value i appears at indexes 3 * (i / 2) and so on */
+                    size_t lower = value % 2 == 1 ? (value + 1) / 2 * 3 : value / 2 * 3;
+                    size_t upper = value % 2 == 1 ? lower : lower + 3;
+
+                    lower = lower > n ? n : lower;
+                    upper = upper > n ? n : upper;
+
+                    cmc_assert_equals(size_t, lower, sl_lower_bound(sl, value));
+                    cmc_assert_equals(size_t, upper, sl_upper_bound(sl, value));
+                    cmc_assert_equals(size_t, lower, sla_lower_bound(sla, value));
+                    cmc_assert_equals(size_t, upper, sla_upper_bound(sla, value));
+                    cmc_assert_equals(bool, lower < upper, sl_contains(sl, value));
+
+                    if (n > 0)
+                    {
+                        cmc_assert_equals(size_t, lower < upper ? lower : n, sl_index_of(sl, value, true));
+                        cmc_assert_equals(size_t, lower < upper ? upper - 1 : n, sl_index_of(sl, value, false));
+                    }
+                }
+
+                sl_thaw(sl);
+            }
+
+            cmc_assert(sl_insert(sl, n / 3 * 2));
+            cmc_assert(sla_insert(sla, n / 3 * 2));
+        }
+
+        sl_free(sl);
+        sla_free(sla);
+    });
+
+    CMC_CREATE_TEST(PFX##_freeze() and _thaw(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        cmc_assert(sl_freeze(sl));
+        cmc_assert(sl->indexed);
+        cmc_assert_equals(size_t, 0, sl_lower_bound(sl, 10));
+        cmc_assert(!sl_contains(sl, 10));
+
+        for (size_t i = 1000; i > 0; i--)
+            cmc_assert(sl_insert(sl, i * 10));
+
+        /* The index is rebuilt by the next search */
+        cmc_assert(!sl->indexed);
+        cmc_assert(sl_contains(sl, 10));
+        cmc_assert(sl->indexed);
+        cmc_assert_equals(size_t, 0, sl_lower_bound(sl, 10));
+        cmc_assert_equals(size_t, 500, sl_lower_bound(sl, 5005));
+        cmc_assert_equals(size_t, 1000, sl_upper_bound(sl, 10000));
+
+        cmc_assert(sl_remove(sl, 0));
+        cmc_assert(!sl->indexed);
+        cmc_assert(!sl_contains(sl, 10));
+        cmc_assert_equals(size_t, 0, sl_index_of(sl, 20, true));
+
+        cmc_assert_equals(size_t, 100, sl_remove_range(sl, 20, 1020));
+        cmc_assert(!sl_contains(sl, 1010));
+        cmc_assert_equals(size_t, 0, sl_index_of(sl, 1020, false));
+
+        size_t floor = 0;
+        cmc_assert(sl_floor(sl, 1025, &floor));
+        cmc_assert_equals(size_t, 1020, floor);
+        cmc_assert(!sl_floor(sl, 1019, &floor));
+
+        sl_clear(sl);
+        cmc_assert(!sl_contains(sl, 1020));
+        cmc_assert_not_equals(ptr, NULL, sl->eytzinger);
+
+        sl_thaw(sl);
+        cmc_assert_equals(ptr, NULL, sl->eytzinger);
+        cmc_assert(!sl->indexed);
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(sort[incremental], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        size_t state = 7;
+
+        // Reads interleaved with small and large batches of insertions
+        for (size_t round = 0; round < 200; round++)
+        {
+            size_t batch = round % 10 == 0 ? 100 : round % 4;
+
+            for (size_t i = 0; i < batch; i++)
+            {
+                state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+                cmc_assert(sl_insert(sl, (state >> 33) % 1000));
+            }
+
+            cmc_assert_equals(size_t, sl_count(sl) - batch, sl->sorted);
+
+            sl_min(sl);
+
+            cmc_assert_equals(size_t, sl_count(sl), sl->sorted);
+
+            for (size_t i = 1; i < sl_count(sl); i++)
+                cmc_assert(sl->buffer[i - 1] <= sl->buffer[i]);
+        }
+
+        // Removing from the sorted prefix keeps it sorted
+        cmc_assert(sl_insert(sl, 0));
+        cmc_assert(sl_remove(sl, 0));
+        cmc_assert_equals(size_t, sl_count(sl) - 1, sl->sorted);
+
+        sl_free(sl);
+    });
+
+    CMC_CREATE_TEST(sort[adversarial], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        // Few distinct values degrade Lomuto's partition to heapsort
+        for (size_t i = 0; i < 20000; i++)
+            cmc_assert(sl_insert(sl, i % 3));
+
+        sl_sort(sl);
+
+        for (size_t i = 1; i < sl_count(sl); i++)
+            cmc_assert(sl->buffer[i - 1] <= sl->buffer[i]);
+
+        sl_clear(sl);
+
+        for (size_t i = 0; i < 20000; i++)
+            cmc_assert(sl_insert(sl, i));
+
+        sl_sort(sl);
+
+        for (size_t i = 0; i < 20000; i++)
+            cmc_assert(sl_insert(sl, 40000 - i));
+
+        for (size_t i = 0; i < 20000; i++)
+            cmc_assert_equals(size_t, i, sl_get(sl, i));
+
+        cmc_assert_equals(size_t, 40000, sl_max(sl));
+
+        sl_free(sl);
+    });
+    CMC_CREATE_TEST(PFX##_union() and _intersection(), {
+        struct sortedlist *sl1 = sl_new(100, sl_fval);
+        struct sortedlist *sl2 = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl1);
+        cmc_assert_not_equals(ptr, NULL, sl2);
+
+        /* { 1, 2, 2, 2, 5 } and { 2, 2, 3, 5, 5 } */
+        cmc_assert(sl_insert(sl1, 5));
+        cmc_assert(sl_insert(sl1, 2));
+        cmc_assert(sl_insert(sl1, 1));
+        cmc_assert(sl_insert(sl1, 2));
+        cmc_assert(sl_insert(sl1, 2));
+        cmc_assert(sl_insert(sl2, 5));
+        cmc_assert(sl_insert(sl2, 3));
+        cmc_assert(sl_insert(sl2, 2));
+        cmc_assert(sl_insert(sl2, 5));
+        cmc_assert(sl_insert(sl2, 2));
+
+        struct sortedlist *sl_r = sl_intersection(sl1, sl2);
+
+        cmc_assert_not_equals(ptr, NULL, sl_r);
+        cmc_assert_equals(size_t, 3, sl_count(sl_r));
+        cmc_assert_equals(size_t, 2, sl_get(sl_r, 0));
+        cmc_assert_equals(size_t, 2, sl_get(sl_r, 1));
+        cmc_assert_equals(size_t, 5, sl_get(sl_r, 2));
+
+        sl_free(sl_r);
+
+        sl_r = sl_union(sl1, sl2);
+
+        cmc_assert_not_equals(ptr, NULL, sl_r);
+        cmc_assert_equals(size_t, 7, sl_count(sl_r));
+        cmc_assert_equals(size_t, 1, sl_get(sl_r, 0));
+        cmc_assert_equals(size_t, 2, sl_get(sl_r, 3));
+        cmc_assert_equals(size_t, 3, sl_get(sl_r, 4));
+        cmc_assert_equals(size_t, 5, sl_get(sl_r, 6));
+
+        sl_free(sl_r);
+        sl_free(sl1);
+        sl_free(sl2);
+
+        /* The arithmetic kernels must agree with the comparator based merge */
+        size_t seed = 42;
+
+        for (size_t round = 0; round < 8; round++)
+        {
+            size_t count1 = round % 2 == 0 ? 1000 : 20;
+            size_t count2 = round < 4 ? 1000 : 40000;
+            size_t range = round % 3 == 0 ? 100 : 50000;
+
+            sl1 = sl_new(16, sl_fval);
+            sl2 = sl_new(16, sl_fval);
+
+            struct sortedlist_arith *sla1 = sla_new(16, sla_fval);
+            struct sortedlist_arith *sla2 = sla_new(16, sla_fval);
+
+            sl_fill_random(sl1, sla1, count1, range, &seed);
+            sl_fill_random(sl2, sla2, count2, range, &seed);
+
+            for (size_t op = 0; op < 2; op++)
+            {
+                sl_r = op == 0 ? sl_union(sl1, sl2) : sl_intersection(sl2, sl1);
+
+                struct sortedlist_arith *sla_r = op == 0 ? sla_union(sla1, sla2) : sla_intersection(sla2, sla1);
+
+                cmc_assert_not_equals(ptr, NULL, sl_r);
+                cmc_assert_not_equals(ptr, NULL, sla_r);
+                cmc_assert_equals(size_t, sl_count(sl_r), sla_count(sla_r));
+
+                for (size_t i = 0; i < sl_count(sl_r) && i < sla_count(sla_r); i++)
+                    cmc_assert_equals(size_t, sl_r->buffer[i], sla_r->buffer[i]);
+
+                sl_free(sl_r);
+                sla_free(sla_r);
+            }
+
+            sl_free(sl1);
+            sl_free(sl2);
+            sla_free(sla1);
+            sla_free(sla2);
+        }
+    });
+
+    CMC_CREATE_TEST(PFX##_xsort[spill], {
+        struct sortedlist_xsort *xs = sl_xsort_new(100, sl_fval, NULL);
+        struct sortedlist_arith_xsort *xsa = sla_xsort_new(100, sla_fval, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, xs);
+        cmc_assert_not_equals(ptr, NULL, xsa);
+
+        size_t seed = 11;
+        size_t sum = 0;
+
+        for (size_t i = 0; i < 10007; i++)
+        {
+            seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+
+            cmc_assert(sl_xsort_push(xs, (seed >> 33) % 5000));
+            cmc_assert(sla_xsort_push(xsa, (seed >> 33) % 5000));
+
+            sum += (seed >> 33) % 5000;
+        }
+
+        cmc_assert_equals(size_t, 10007, sl_xsort_count(xs));
+        cmc_assert_equals(size_t, 100, sl_xsort_runs(xs));
+
+        size_t count = 0;
+        size_t prev = 0;
+        size_t value;
+        size_t value_a;
+
+        while (sl_xsort_next(xs, &value))
+        {
+            cmc_assert(sla_xsort_next(xsa, &value_a));
+            cmc_assert_equals(size_t, value, value_a);
+            cmc_assert(prev <= value);
+
+            prev = value;
+            sum -= value;
+            count++;
+        }
+
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, sl_xsort_flag(xs));
+        cmc_assert(!sla_xsort_next(xsa, &value_a));
+        cmc_assert_equals(size_t, 10007, count);
+        cmc_assert_equals(size_t, 0, sum);
+        cmc_assert_equals(size_t, 101, sl_xsort_runs(xs));
+
+        cmc_assert(!sl_xsort_push(xs, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, sl_xsort_flag(xs));
+
+        sl_xsort_free(xs);
+        sla_xsort_free(xsa);
+    });
+
+    CMC_CREATE_TEST(PFX##_xsort[memory], {
+        v_total_free = 0;
+
+        struct sortedlist_xsort *xs = sl_xsort_new(100, sl_fval_counter, NULL);
+
+        cmc_assert_not_equals(ptr, NULL, xs);
+
+        // Nothing is spilled if every value fits in the run
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(sl_xsort_push(xs, 49 - i));
+
+        size_t value;
+
+        for (size_t i = 0; i < 10; i++)
+        {
+            cmc_assert(sl_xsort_next(xs, &value));
+            cmc_assert_equals(size_t, i, value);
+        }
+
+        cmc_assert_equals(size_t, 0, sl_xsort_runs(xs));
+
+        // Only the values that were not taken are freed
+        sl_xsort_free(xs);
+
+        cmc_assert_equals(int32_t, 40, v_total_free);
+    });
+
+    CMC_CREATE_TEST(PFX##_xsort[serializer], {
+        v_total_free = 0;
+
+        struct sortedlist_xsort *xs = sl_xsort_new(64, sl_fval_counter, sl_text_io);
+
+        cmc_assert_not_equals(ptr, NULL, xs);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sl_xsort_push(xs, 999 - i));
+
+        cmc_assert(sl_xsort_finish(xs));
+        cmc_assert(!sl_xsort_finish(xs));
+        cmc_assert_equals(int32_t, CMC_FLAG_INVALID, sl_xsort_flag(xs));
+        cmc_assert_equals(size_t, 16, sl_xsort_runs(xs));
+
+        // Every value was spilled and freed
+        cmc_assert_equals(int32_t, 1000, v_total_free);
+
+        FILE *output = tmpfile();
+
+        cmc_assert_not_equals(ptr, NULL, output);
+
+        cmc_assert(sl_xsort_write(xs, output));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, sl_xsort_flag(xs));
+        cmc_assert_equals(int32_t, 2000, v_total_free);
+
+        rewind(output);
+
+        size_t value;
+
+        // The output is written with the serializer too
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert(sl_text_read(output, &value));
+            cmc_assert_equals(size_t, i, value);
+        }
+
+        sl_xsort_free(xs);
+        fclose(output);
+
+        cmc_assert_equals(int32_t, 2000, v_total_free);
+    });
+    CMC_CREATE_TEST(algorithms[parallel], {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        for (size_t i = 0; i < 100000; i++)
+            cmc_assert(sl_insert(sl, (i * 7919) % 100000));
+
+        cmc_assert(sl_freeze(sl));
+
+        // Elements are visited in order
+        cmc_assert_equals(size_t, 99999, sl_reduce(sl, 0, sl_last, NULL, 4));
+
+        size_t three = 3;
+        cmc_assert_equals(size_t, 33334, sl_count_if(sl, sl_is_multiple, &three, 4));
+
+        struct sortedlist *multiples = sl_filter(sl, sl_is_multiple, &three, 4);
+
+        cmc_assert_not_equals(ptr, NULL, multiples);
+        cmc_assert_equals(size_t, 33334, sl_count(multiples));
+        cmc_assert_equals(size_t, 99999, sl_max(multiples));
+
+        struct sortedlist *others = sl_partition(sl, sl_is_multiple, &three, 4);
+
+        cmc_assert_not_equals(ptr, NULL, others);
+        cmc_assert(sl_equals(sl, multiples));
+        cmc_assert_equals(size_t, 66666, sl_count(others));
+        cmc_assert(sl_contains(others, 99998));
+        cmc_assert(!sl_contains(sl, 99998));
+        cmc_assert(sl_contains(sl, 99999));
+
+        // Mapped elements are sorted again
+        size_t ten = 10;
+        cmc_assert(sl_map_into(sl, others, sl_mod, &ten, 4));
+        cmc_assert_equals(size_t, 33334, sl_count(others));
+        cmc_assert_equals(size_t, 0, sl_min(others));
+        cmc_assert_equals(size_t, 9, sl_max(others));
+        cmc_assert_equals(size_t, 9, sl_get(others, 33333));
+
+        sl_fill(sl, 42, 4);
+        cmc_assert_equals(size_t, 0, sl_index_of(sl, 42, true));
+        cmc_assert_equals(size_t, 33333, sl_index_of(sl, 42, false));
+
+        sl_free(sl);
+        sl_free(multiples);
+        sl_free(others);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct sortedlist *l = sl_new(10, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, l);
+
+        cmc_assert(sl_reserve(l, 100));
+        cmc_assert_equals(size_t, 100, sl_capacity(l));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(sl_insert(l, 29 - i));
+
+        cmc_assert(sl_shrink_to_fit(l));
+        cmc_assert_equals(size_t, 30, sl_capacity(l));
+        cmc_assert(sl_insert(l, 30));
+        cmc_assert_equals(size_t, 60, sl_capacity(l));
+
+        for (size_t i = 0; i < 31; i++)
+            cmc_assert_equals(size_t, i, sl_get(l, i));
+
+        sl_free(l);
+    });
+
+    CMC_CREATE_TEST(views, {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        /* Every value in [0, 50) is inserted twice */
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(sl_insert(sl, 49 - i % 50));
+
+        struct sortedlist_view view = sl_view(sl, 20, 79);
+
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, sl_flag(sl));
+        cmc_assert_equals(size_t, 60, view.count);
+        cmc_assert_equals(size_t, 10, sl_view_get(&view, 0));
+        cmc_assert_equals(size_t, 39, sl_view_get(&view, 59));
+
+        cmc_assert_equals(size_t, 10, sl_view_index_of(&view, 15, true));
+        cmc_assert_equals(size_t, 11, sl_view_index_of(&view, 15, false));
+        cmc_assert_equals(size_t, 60, sl_view_index_of(&view, 40, true));
+        cmc_assert_equals(size_t, 60, sl_view_index_of(&view, 9, false));
+        cmc_assert_equals(size_t, 2, sl_view_count_of(&view, 39));
+        cmc_assert_equals(size_t, 0, sl_view_count_of(&view, 45));
+        cmc_assert(sl_view_contains(&view, 10));
+        cmc_assert(!sl_view_contains(&view, 0));
+
+        struct sortedlist_view slice = sl_view_slice(&view, 1, 2);
+
+        cmc_assert_equals(size_t, 2, slice.count);
+        cmc_assert_equals(size_t, 1, sl_view_count_of(&slice, 10));
+        cmc_assert_equals(size_t, 1, sl_view_count_of(&slice, 11));
+
+        struct sortedlist_view first = sl_view(sl, 0, 1);
+        struct sortedlist_view second = sl_view(sl, 1, 2);
+
+        cmc_assert(!sl_view_equals(&first, &second));
+        second = sl_view_slice(&first, 1, 1);
+        first = sl_view_slice(&first, 0, 0);
+        cmc_assert(sl_view_equals(&first, &second));
+
+        size_t three = 3;
+
+        cmc_assert_equals(size_t, 39, sl_view_reduce(&view, 0, sl_last, NULL, 2));
+        cmc_assert_equals(size_t, 20, sl_view_count_if(&view, sl_is_multiple, &three, 4));
+
+        view = sl_view(sl, 0, 100);
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, sl_flag(sl));
+        cmc_assert_equals(size_t, 0, view.count);
+
+        sl_free(sl);
+    });
 });
 
 CMC_CREATE_UNIT(CMCSortedListIter, true, {
@@ -619,6 +1423,39 @@ CMC_CREATE_UNIT(CMCSortedListIter, true, {
 
         sl_free(sl);
     });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound() and _iter_upper_bound(), {
+        struct sortedlist *sl = sl_new(100, sl_fval);
+
+        cmc_assert_not_equals(ptr, NULL, sl);
+
+        struct sortedlist_iter it = sl_iter_lower_bound(sl, 10);
+
+        cmc_assert(sl_iter_at_end(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            sl_insert(sl, i * 2);
+
+        it = sl_iter_lower_bound(sl, 1);
+
+        cmc_assert(sl_iter_at_start(&it));
+        cmc_assert_equals(size_t, 2, sl_iter_value(&it));
+
+        it = sl_iter_lower_bound(sl, 51);
+
+        cmc_assert_equals(size_t, 52, sl_iter_value(&it));
+        cmc_assert_equals(size_t, 25, sl_iter_index(&it));
+
+        it = sl_iter_upper_bound(sl, 52);
+
+        cmc_assert_equals(size_t, 54, sl_iter_value(&it));
+
+        it = sl_iter_upper_bound(sl, 200);
+
+        cmc_assert(sl_iter_at_end(&it));
+
+        sl_free(sl);
+    });
 });
 
 #ifdef CMC_TEST_MAIN
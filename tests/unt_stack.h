@@ -12,6 +12,36 @@ struct stack_fval *s_fval = &(struct stack_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* A stack of doubles with the arithmetic kernels */
+#undef V
+#define V double
+#define PFX sa
+#define SNAME stack_arith
+#define CMC_ARITHMETIC_V
+#include "cmc/stack.h"
+
+#include "undef.h"
+
+struct stack_arith_fval *sa_fval = &(struct stack_arith_fval){ .cmp = cmc_double_cmp,
+                                                                .cpy = NULL,
+                                                                .str = cmc_double_str,
+                                                                .free = NULL,
+                                                                .hash = cmc_double_hash,
+                                                                .pri = cmc_double_cmp };
+
+/* Same stack storing up to 8 elements in the struct itself */
+#define V size_t
+#define PFX ss
+#define SNAME stack_sbo
+#define CMC_SBO 8
+#include "cmc/stack.h"
+
+#include "undef.h"
+
+struct stack_sbo_fval *ss_fval = &(struct stack_sbo_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
 CMC_CREATE_UNIT(CMCStack, true, {
     CMC_CREATE_TEST(new, {
         struct stack *s = s_new(1000000, s_fval);
@@ -338,6 +368,81 @@ CMC_CREATE_UNIT(CMCStack, true, {
         s_free(s);
         s_free(s2);
     });
+    CMC_CREATE_TEST(search and reductions[arithmetic], {
+        struct stack_arith *s = sa_new(100, sa_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(sa_push(s, (double)(i % 100) / 4.0));
+
+        cmc_assert(sa_contains(s, 0.25));
+        cmc_assert(sa_contains(s, 24.75));
+        cmc_assert(!sa_contains(s, 0.3));
+        cmc_assert(!sa_contains(s, 25.0));
+
+        cmc_assert_equals(size_t, 10, sa_count_of(s, 12.5));
+        cmc_assert_equals(size_t, 0, sa_count_of(s, -1.0));
+
+        cmc_assert_equals(double, 0.0, sa_min(s));
+        cmc_assert_equals(double, 24.75, sa_max(s));
+
+        // Quarters add up exactly
+        cmc_assert_equals(double, 12375.0, sa_sum(s));
+
+        sa_free(s);
+    });
+    CMC_CREATE_TEST(small buffer[sbo], {
+        alloc_total_calls = 0;
+
+        struct stack_sbo s = ss_init_custom(8, ss_fval, counting_alloc, NULL);
+
+        for (size_t i = 0; i < 8; i++)
+            cmc_assert(ss_push(&s, i));
+
+        cmc_assert_equals(int32_t, 0, alloc_total_calls);
+
+        struct stack_sbo moved = s;
+
+        // Even when it is copied over the target of an iterator
+        struct stack_sbo_iter it = ss_iter_start(&moved);
+
+        moved = s;
+
+        cmc_assert_equals(size_t, 7, ss_iter_value(&it));
+        cmc_assert_equals(ptr, moved.sbo + 7, ss_iter_rvalue(&it));
+
+        cmc_assert_equals(size_t, 7, ss_top(&moved));
+        cmc_assert(ss_push(&moved, 8));
+        cmc_assert_equals(int32_t, 1, alloc_total_calls);
+
+        for (size_t i = 9; i > 0; i--)
+        {
+            cmc_assert_equals(size_t, i - 1, ss_top(&moved));
+            cmc_assert(ss_pop(&moved));
+        }
+
+        ss_release(moved);
+    });
+    CMC_CREATE_TEST(PFX##_reserve() and _shrink_to_fit(), {
+        struct stack *s = s_new(10, s_fval);
+
+        cmc_assert_not_equals(ptr, NULL, s);
+
+        cmc_assert(s_reserve(s, 100));
+        cmc_assert_equals(size_t, 100, s_capacity(s));
+
+        for (size_t i = 0; i < 30; i++)
+            cmc_assert(s_push(s, i));
+
+        cmc_assert(s_shrink_to_fit(s));
+        cmc_assert_equals(size_t, 30, s_capacity(s));
+        cmc_assert(s_push(s, 30));
+        cmc_assert_equals(size_t, 60, s_capacity(s));
+        cmc_assert_equals(size_t, 30, s_top(s));
+
+        s_free(s);
+    });
 });
 
 CMC_CREATE_UNIT(CMCStackIter, true, {
@@ -0,0 +1,462 @@
+#ifndef CMC_TESTS_UNT_TREEBIDIMAP_H
+#define CMC_TESTS_UNT_TREEBIDIMAP_H
+
+#include "utl.h"
+
+#define K size_t
+#define V size_t
+#define PFX tbm
+#define SNAME treebidimap
+#include "cmc/treebidimap.h"
+
+struct treebidimap_fkey *tbm_fkey = &(struct treebidimap_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treebidimap_fval *tbm_fval = &(struct treebidimap_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treebidimap_fkey *tbm_fkey_counter = &(struct treebidimap_fkey){
+    .cmp = k_c_cmp, .cpy = k_c_cpy, .str = k_c_str, .free = k_c_free, .hash = k_c_hash, .pri = k_c_pri
+};
+
+struct treebidimap_fval *tbm_fval_counter = &(struct treebidimap_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Checks links, order and balance of one of the trees and returns its size */
+size_t tbm_check(struct treebidimap *map, struct treebidimap_node *node, struct treebidimap_node *parent, int d,
+                 size_t *height, bool *ok)
+{
+    if (node == NULL)
+    {
+        *height = 0;
+        return 0;
+    }
+
+    size_t h_l, h_r;
+
+    size_t c_l = tbm_check(map, node->left[d], node, d, &h_l, ok);
+    size_t c_r = tbm_check(map, node->right[d], node, d, &h_r, ok);
+
+    if (node->parent[d] != parent)
+        *ok = false;
+    if (node->left[d] && (d == 0 ? node->left[d]->key >= node->key : node->left[d]->value >= node->value))
+        *ok = false;
+    if (node->right[d] && (d == 0 ? node->right[d]->key <= node->key : node->right[d]->value <= node->value))
+        *ok = false;
+    if (h_l > h_r + 1 || h_r > h_l + 1)
+        *ok = false;
+
+    *height = 1 + (h_l > h_r ? h_l : h_r);
+
+    if (node->height[d] != *height)
+        *ok = false;
+
+    return c_l + c_r + 1;
+}
+
+bool tbm_valid(struct treebidimap *map)
+{
+    bool ok = true;
+    size_t height;
+
+    for (int d = 0; d < 2; d++)
+    {
+        if (tbm_check(map, map->root[d], NULL, d, &height, &ok) != map->count)
+            return false;
+    }
+
+    return ok;
+}
+
+CMC_CREATE_UNIT(CMCTreeBidiMap, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(ptr, NULL, map->root[0]);
+        cmc_assert_equals(ptr, NULL, map->root[1]);
+        cmc_assert_equals(size_t, 0, tbm_count(map));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, tbm_flag(map));
+        cmc_assert_equals(ptr, &cmc_alloc_node_default, map->alloc);
+
+        tbm_free(map);
+
+        cmc_assert_equals(ptr, NULL, tbm_new(NULL, tbm_fval));
+        cmc_assert_equals(ptr, NULL, tbm_new(tbm_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(PFX##_clear(), {
+        k_total_free = 0;
+        v_total_free = 0;
+
+        struct treebidimap *map = tbm_new(tbm_fkey_counter, tbm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map, i, 1000 - i));
+
+        tbm_clear(map);
+
+        cmc_assert_equals(int32_t, 100, k_total_free);
+        cmc_assert_equals(int32_t, 100, v_total_free);
+        cmc_assert_equals(size_t, 0, tbm_count(map));
+        cmc_assert_equals(ptr, NULL, map->root[0]);
+        cmc_assert_equals(ptr, NULL, map->root[1]);
+
+        tbm_free(map);
+
+        k_total_free = 0;
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(insert, {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tbm_insert(map, (i * 7919) % 1009, i));
+
+        cmc_assert_equals(size_t, 1000, tbm_count(map));
+        cmc_assert(tbm_valid(map));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert_equals(size_t, i, tbm_get_val(map, (i * 7919) % 1009));
+            cmc_assert_equals(size_t, (i * 7919) % 1009, tbm_get_key(map, i));
+        }
+
+        // Both keys and values are unique
+        cmc_assert(!tbm_insert(map, 7919 % 1009, 5000));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tbm_flag(map));
+        cmc_assert(!tbm_insert(map, 5000, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tbm_flag(map));
+        cmc_assert_equals(size_t, 1000, tbm_count(map));
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(update_key, {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert(!tbm_update_key(map, 1, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tbm_flag(map));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map, i, i + 1000));
+
+        cmc_assert(!tbm_update_key(map, 2000, 500));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tbm_flag(map));
+        cmc_assert(!tbm_update_key(map, 1000, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tbm_flag(map));
+        cmc_assert(tbm_update_key(map, 1000, 0));
+
+        // Move every key so the tree sorted by keys gets reversed
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_update_key(map, i + 1000, 1000 - i));
+
+        cmc_assert(tbm_valid(map));
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert_equals(size_t, i + 1000, tbm_get_val(map, 1000 - i));
+            cmc_assert(!tbm_contains_key(map, i));
+        }
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(update_val, {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert(!tbm_update_val(map, 1, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tbm_flag(map));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map, i, i));
+
+        cmc_assert(!tbm_update_val(map, 100, 500));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tbm_flag(map));
+        cmc_assert(!tbm_update_val(map, 0, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tbm_flag(map));
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_update_val(map, i, 1000 - i));
+
+        cmc_assert(tbm_valid(map));
+
+        size_t key = 0;
+        size_t val = 0;
+
+        cmc_assert(tbm_min_by_val(map, &key, &val));
+        cmc_assert_equals(size_t, 99, key);
+        cmc_assert_equals(size_t, 901, val);
+        cmc_assert(tbm_max_by_val(map, &key, &val));
+        cmc_assert_equals(size_t, 0, key);
+        cmc_assert_equals(size_t, 1000, val);
+        cmc_assert(tbm_min_by_key(map, &key, &val));
+        cmc_assert_equals(size_t, 0, key);
+        cmc_assert(tbm_max_by_key(map, &key, &val));
+        cmc_assert_equals(size_t, 99, key);
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove, {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key;
+        size_t val;
+
+        cmc_assert(!tbm_remove_by_key(map, 1, &key, &val));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tbm_flag(map));
+        cmc_assert(!tbm_remove_by_val(map, 1, &key, &val));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tbm_flag(map));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tbm_insert(map, i, (i * 7919) % 1009));
+
+        cmc_assert(!tbm_remove_by_key(map, 1000, &key, &val));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tbm_flag(map));
+
+        for (size_t i = 0; i < 1000; i += 2)
+        {
+            cmc_assert(tbm_remove_by_key(map, i, &key, &val));
+            cmc_assert_equals(size_t, i, key);
+            cmc_assert_equals(size_t, (i * 7919) % 1009, val);
+        }
+
+        cmc_assert_equals(size_t, 500, tbm_count(map));
+        cmc_assert(tbm_valid(map));
+
+        for (size_t i = 1; i < 1000; i += 4)
+        {
+            cmc_assert(tbm_remove_by_val(map, (i * 7919) % 1009, &key, &val));
+            cmc_assert_equals(size_t, i, key);
+        }
+
+        cmc_assert_equals(size_t, 250, tbm_count(map));
+        cmc_assert(tbm_valid(map));
+        cmc_assert(!tbm_contains_key(map, 1));
+        cmc_assert(tbm_contains_key(map, 3));
+        cmc_assert(!tbm_contains_val(map, 7919 % 1009));
+        cmc_assert(tbm_contains_val(map, (3 * 7919) % 1009));
+
+        for (size_t i = 3; i < 1000; i += 4)
+            cmc_assert(tbm_remove_by_key(map, i, NULL, NULL));
+
+        cmc_assert(tbm_empty(map));
+        cmc_assert_equals(ptr, NULL, map->root[0]);
+        cmc_assert_equals(ptr, NULL, map->root[1]);
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(get, {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert(tbm_insert(map, 1, 2));
+
+        cmc_assert_equals(size_t, 2, tbm_get_val(map, 1));
+        cmc_assert_equals(size_t, 1, tbm_get_key(map, 2));
+        cmc_assert_equals(size_t, 0, tbm_get_val(map, 2));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tbm_flag(map));
+        cmc_assert_equals(size_t, 0, tbm_get_key(map, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tbm_flag(map));
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(copy_of_equals, {
+        k_total_cpy = 0;
+        v_total_cpy = 0;
+        k_total_free = 0;
+        v_total_free = 0;
+
+        struct treebidimap *map1 = tbm_new(tbm_fkey_counter, tbm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map1);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map1, i, (i * 31) % 101));
+
+        struct treebidimap *map2 = tbm_copy_of(map1);
+
+        cmc_assert_not_equals(ptr, NULL, map2);
+        cmc_assert_equals(int32_t, 100, k_total_cpy);
+        cmc_assert_equals(int32_t, 100, v_total_cpy);
+        cmc_assert(tbm_valid(map2));
+        cmc_assert(tbm_equals(map1, map2));
+
+        cmc_assert(tbm_update_val(map2, 0, 500));
+        cmc_assert(!tbm_equals(map1, map2));
+        cmc_assert(tbm_update_val(map2, 0, 0));
+        cmc_assert(tbm_equals(map1, map2));
+
+        tbm_free(map1);
+        tbm_free(map2);
+
+        cmc_assert_equals(int32_t, 200, k_total_free);
+        cmc_assert_equals(int32_t, 200, v_total_free);
+
+        k_total_cpy = 0;
+        v_total_cpy = 0;
+        k_total_free = 0;
+        v_total_free = 0;
+    });
+});
+
+CMC_CREATE_UNIT(CMCTreeBidiMapIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treebidimap_iter it = tbm_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert(tbm_iter_at_start(&it));
+        cmc_assert(tbm_iter_at_end(&it));
+
+        for (size_t i = 1; i <= 3; i++)
+            cmc_assert(tbm_insert(map, i, 10 - i));
+
+        it = tbm_iter_start(map);
+
+        cmc_assert_equals(size_t, 0, tbm_iter_index(&it));
+        cmc_assert_equals(size_t, 1, tbm_iter_key(&it));
+        cmc_assert_equals(size_t, 9, tbm_iter_value(&it));
+
+        it = tbm_iter_start_by_val(map);
+
+        cmc_assert_equals(size_t, 0, tbm_iter_index(&it));
+        cmc_assert_equals(size_t, 3, tbm_iter_key(&it));
+        cmc_assert_equals(size_t, 7, tbm_iter_value(&it));
+
+        it = tbm_iter_end_by_val(map);
+
+        cmc_assert_equals(size_t, 2, tbm_iter_index(&it));
+        cmc_assert_equals(size_t, 1, tbm_iter_key(&it));
+        cmc_assert(tbm_iter_at_end(&it));
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next_prev(), {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map, i, 1000 - i));
+
+        size_t index = 0;
+
+        for (struct treebidimap_iter it = tbm_iter_start(map); !tbm_iter_at_end(&it); tbm_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index, tbm_iter_key(&it));
+            cmc_assert_equals(size_t, index, tbm_iter_index(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, index);
+
+        // Values are visited in increasing order, so keys are decreasing
+        for (struct treebidimap_iter it = tbm_iter_start_by_val(map); !tbm_iter_at_end(&it); tbm_iter_next(&it))
+        {
+            index--;
+            cmc_assert_equals(size_t, index, tbm_iter_key(&it));
+            cmc_assert_equals(size_t, 1000 - index, tbm_iter_value(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        for (struct treebidimap_iter it = tbm_iter_end_by_val(map); !tbm_iter_at_start(&it); tbm_iter_prev(&it))
+        {
+            cmc_assert_equals(size_t, index, tbm_iter_key(&it));
+            cmc_assert_equals(size_t, 99 - index, tbm_iter_index(&it));
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, index);
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tbm_insert(map, i, 1000 - i));
+
+        struct treebidimap_iter it = tbm_iter_start_by_val(map);
+
+        cmc_assert(tbm_iter_go_to(&it, 50));
+        cmc_assert_equals(size_t, 49, tbm_iter_key(&it));
+        cmc_assert(tbm_iter_go_to(&it, 10));
+        cmc_assert_equals(size_t, 89, tbm_iter_key(&it));
+        cmc_assert(!tbm_iter_go_to(&it, 100));
+
+        tbm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct treebidimap *map = tbm_new(tbm_fkey, tbm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(tbm_insert(map, i, 1000 - i));
+
+        struct treebidimap_iter it = tbm_iter_lower_bound(map, 35);
+
+        cmc_assert_equals(size_t, 40, tbm_iter_key(&it));
+        cmc_assert_equals(size_t, 3, tbm_iter_index(&it));
+
+        it = tbm_iter_lower_bound_by_val(map, 935);
+
+        cmc_assert_equals(size_t, 940, tbm_iter_value(&it));
+        cmc_assert_equals(size_t, 60, tbm_iter_key(&it));
+        cmc_assert_equals(size_t, 4, tbm_iter_index(&it));
+        cmc_assert(tbm_iter_next(&it));
+        cmc_assert_equals(size_t, 50, tbm_iter_key(&it));
+
+        it = tbm_iter_lower_bound(map, 101);
+
+        cmc_assert(tbm_iter_at_end(&it));
+
+        tbm_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCTreeBidiMap() + CMCTreeBidiMapIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCTreeBidiMap Suit : %-42s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_TREEBIDIMAP_H */
@@ -17,6 +17,41 @@ struct treemap_fval *tm_fval = &(struct treemap_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+#define V size_t
+#define K size_t
+#define AGG size_t
+#define PFX tma
+#define SNAME treemap_agg
+#include "cmc/treemap.h"
+
+size_t tma_lift(size_t key, size_t value)
+{
+    (void)key;
+    return value;
+}
+
+size_t tma_sum(size_t a, size_t b)
+{
+    return a + b;
+}
+
+struct treemap_agg_fkey *tma_fkey = &(struct treemap_agg_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treemap_agg_fval *tma_fval = &(struct treemap_agg_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treemap_agg_fagg *tma_fagg = &(struct treemap_agg_fagg){ .lift = tma_lift, .combine = tma_sum, .identity = 0 };
+
+bool tm_range_sum(size_t key, size_t value, void *args)
+{
+    (void)value;
+    *(size_t *)args += key;
+    return key < 150;
+}
+
 CMC_CREATE_UNIT(CMCTreeMap, true, {
     CMC_CREATE_TEST(new, {
         struct treemap *map = tm_new(tm_fkey, tm_fval);
@@ -139,6 +174,370 @@ CMC_CREATE_UNIT(CMCTreeMap, true, {
         tm_free(map);
         tm_free(map2);
     });
+
+    CMC_CREATE_TEST(PFX##_rank(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert_equals(size_t, 0, tm_rank(map, 10));
+
+        for (size_t i = 1; i <= 1000; i++)
+            cmc_assert(tm_insert(map, (i * 7919) % 1009 * 2, i));
+
+        cmc_assert_equals(size_t, 1000, tm_count(map));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            size_t key = 0;
+            cmc_assert(tm_select(map, i, &key, NULL));
+            cmc_assert_equals(size_t, i, tm_rank(map, key));
+            cmc_assert_equals(size_t, i + 1, tm_rank(map, key + 1));
+        }
+
+        for (size_t i = 0; i < 2018; i += 3)
+            tm_remove(map, i, NULL);
+
+        size_t expected = 0;
+        struct treemap_iter it = tm_iter_start(map);
+
+        for (; !tm_iter_at_end(&it); tm_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, expected, tm_rank(map, tm_iter_key(&it)));
+            expected++;
+        }
+
+        cmc_assert_equals(size_t, tm_count(map), expected);
+        cmc_assert_equals(size_t, tm_count(map), tm_rank(map, 5000));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_select(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert(!tm_select(map, 0, NULL, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tm_flag(map));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, 999 - i, i));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            size_t key = 0;
+            size_t value = 0;
+            cmc_assert(tm_select(map, i, &key, &value));
+            cmc_assert_equals(size_t, i, key);
+            cmc_assert_equals(size_t, 999 - i, value);
+        }
+
+        cmc_assert(!tm_select(map, 1000, NULL, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, tm_flag(map));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_count_range(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tm_insert(map, i * 2, i));
+
+        cmc_assert_equals(size_t, 1000, tm_count_range(map, 0, 2000));
+        cmc_assert_equals(size_t, 5, tm_count_range(map, 10, 20));
+        cmc_assert_equals(size_t, 5, tm_count_range(map, 11, 21));
+        cmc_assert_equals(size_t, 0, tm_count_range(map, 20, 10));
+        cmc_assert_equals(size_t, 0, tm_count_range(map, 10, 10));
+        cmc_assert_equals(size_t, 0, tm_count_range(map, 5000, 6000));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_aggregate_range(), {
+        struct treemap_agg *map = tma_new(tma_fkey, tma_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        tma_aggregate(map);
+        cmc_assert_equals(int32_t, CMC_FLAG_FTABLE, tma_flag(map));
+
+        for (size_t i = 0; i < 500; i++)
+            cmc_assert(tma_insert(map, (i * 7919) % 1009, i));
+
+        /* Aggregates are computed for the nodes that already exist */
+        tma_aggregate_with(map, tma_fagg);
+
+        for (size_t i = 500; i < 1000; i++)
+            cmc_assert(tma_insert(map, (i * 7919) % 1009, i));
+
+        for (size_t i = 0; i < 1009; i += 5)
+            tma_remove(map, i, NULL);
+
+        for (size_t i = 1; i < 1009; i += 7)
+            tma_update(map, i, i, NULL);
+
+        size_t total = 0;
+        struct treemap_agg_iter it = tma_iter_start(map);
+
+        for (; !tma_iter_at_end(&it); tma_iter_next(&it))
+            total += tma_iter_value(&it);
+
+        cmc_assert_equals(size_t, total, tma_aggregate(map));
+        cmc_assert_equals(size_t, 0, tma_aggregate_range(map, 10, 10));
+
+        for (size_t lower = 0; lower < 1010; lower += 37)
+        {
+            for (size_t upper = lower; upper < 1100; upper += 53)
+            {
+                size_t expected = 0;
+
+                for (size_t k = lower; k < upper; k++)
+                {
+                    if (tma_contains(map, k))
+                        expected += tma_get(map, k);
+                }
+
+                cmc_assert_equals(size_t, expected, tma_aggregate_range(map, lower, upper));
+            }
+        }
+
+        struct treemap_agg *map2 = tma_copy_of(map);
+        cmc_assert_equals(size_t, total, tma_aggregate(map2));
+
+        tma_free(map);
+        tma_free(map2);
+    });
+
+    CMC_CREATE_TEST(PFX##_floor(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key = 0;
+
+        cmc_assert(!tm_floor(map, 10, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tm_flag(map));
+
+        for (size_t i = 1; i <= 100; i++)
+            tm_insert(map, i * 10, i);
+
+        cmc_assert(!tm_floor(map, 9, &key, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tm_flag(map));
+
+        cmc_assert(tm_floor(map, 10, &key, NULL));
+        cmc_assert_equals(size_t, 10, key);
+        cmc_assert(tm_floor(map, 555, &key, NULL));
+        cmc_assert_equals(size_t, 550, key);
+        cmc_assert(tm_floor(map, 5000, &key, NULL));
+        cmc_assert_equals(size_t, 1000, key);
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_ceiling(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key = 0;
+        size_t value = 0;
+
+        cmc_assert(!tm_ceiling(map, 10, &key, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tm_flag(map));
+
+        for (size_t i = 1; i <= 100; i++)
+            tm_insert(map, i * 10, i);
+
+        cmc_assert(!tm_ceiling(map, 1001, &key, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tm_flag(map));
+
+        cmc_assert(tm_ceiling(map, 0, &key, &value));
+        cmc_assert_equals(size_t, 10, key);
+        cmc_assert(tm_ceiling(map, 555, &key, &value));
+        cmc_assert_equals(size_t, 560, key);
+        cmc_assert_equals(size_t, 56, value);
+        cmc_assert(tm_ceiling(map, 1000, &key, &value));
+        cmc_assert_equals(size_t, 1000, key);
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_range(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t sum = 0;
+
+        cmc_assert_equals(size_t, 0, tm_range(map, 0, 100, tm_range_sum, &sum));
+
+        for (size_t i = 0; i < 200; i++)
+            tm_insert(map, i, i);
+
+        cmc_assert_equals(size_t, 10, tm_range(map, 10, 20, tm_range_sum, &sum));
+        cmc_assert_equals(size_t, 145, sum);
+
+        cmc_assert_equals(size_t, 0, tm_range(map, 20, 10, tm_range_sum, &sum));
+
+        /* Visitor stops after key 150 */
+        sum = 0;
+        cmc_assert_equals(size_t, 11, tm_range(map, 140, 1000, tm_range_sum, &sum));
+        cmc_assert_equals(size_t, 1595, sum);
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_remove_range(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 0, 100));
+
+        for (size_t i = 0; i < 1000; i++)
+            tm_insert(map, i, i);
+
+        cmc_assert_equals(size_t, 200, tm_remove_range(map, 100, 300));
+        cmc_assert_equals(size_t, 800, tm_count(map));
+        cmc_assert(tm_contains(map, 99));
+        cmc_assert(!tm_contains(map, 100));
+        cmc_assert(!tm_contains(map, 299));
+        cmc_assert(tm_contains(map, 300));
+
+        cmc_assert_equals(size_t, 0, tm_remove_range(map, 100, 300));
+        cmc_assert_equals(size_t, 100, tm_remove_range(map, 0, 200));
+        cmc_assert_equals(size_t, 50, tm_remove_range(map, 950, 5000));
+        cmc_assert_equals(size_t, 650, tm_count(map));
+
+        /* Ranks stay consistent after splitting and joining */
+        for (size_t i = 0; i < tm_count(map); i++)
+            cmc_assert_equals(size_t, i, tm_rank(map, i + 300));
+
+        cmc_assert_equals(size_t, 650, tm_remove_range(map, 0, 1000));
+        cmc_assert(tm_empty(map));
+
+        cmc_assert(tm_insert(map, 1, 1));
+        cmc_assert_equals(size_t, 1, tm_count(map));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_remove_range() aggregate, {
+        struct treemap_agg *map = tma_new(tma_fkey, tma_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        tma_aggregate_with(map, tma_fagg);
+
+        for (size_t i = 0; i < 100; i++)
+            tma_insert(map, i, i);
+
+        cmc_assert_equals(size_t, 40, tma_remove_range(map, 30, 70));
+        cmc_assert_equals(size_t, 4950 - 1980, tma_aggregate(map));
+
+        tma_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_from_sorted(), {
+        size_t keys[500];
+        size_t values[500];
+
+        for (size_t i = 0; i < 500; i++)
+        {
+            keys[i] = i * 2;
+            values[i] = i;
+        }
+
+        struct treemap *map = tm_from_sorted(keys, values, 500, tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(size_t, 500, tm_count(map));
+
+        for (size_t i = 0; i < 500; i++)
+            cmc_assert_equals(size_t, i, tm_get(map, i * 2));
+
+        cmc_assert(tm_insert(map, 1, 1));
+        cmc_assert_equals(size_t, 2, tm_rank(map, 2));
+
+        tm_free(map);
+
+        keys[0] = 10;
+
+        cmc_assert_equals(ptr, NULL, tm_from_sorted(keys, values, 500, tm_fkey, tm_fval));
+    });
+
+    CMC_CREATE_TEST(PFX##_insert() finger, {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        /* Nearly ascending keys */
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert(tm_insert(map, i * 4 + 2, i));
+            cmc_assert(tm_insert(map, i * 4, i));
+        }
+
+        cmc_assert(!tm_insert(map, 3996, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tm_flag(map));
+        cmc_assert(!tm_insert(map, 0, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tm_flag(map));
+
+        /* Far away from the finger */
+        cmc_assert(tm_insert(map, 1, 1));
+        cmc_assert(tm_insert(map, 5000, 1));
+        cmc_assert(tm_remove(map, 5000, NULL));
+        cmc_assert(tm_insert(map, 5001, 1));
+
+        cmc_assert_equals(size_t, 2002, tm_count(map));
+
+        for (size_t i = 0; i < 2000; i++)
+            cmc_assert_equals(size_t, i + (i > 0), tm_rank(map, i * 2));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_compact(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert(tm_compact(map));
+
+        for (size_t i = 0; i < 1000; i++)
+            tm_insert(map, (i * 7919) % 1000, i);
+
+        for (size_t i = 0; i < 1000; i += 3)
+            tm_remove(map, i, NULL);
+
+        cmc_assert(tm_compact(map));
+        cmc_assert_equals(size_t, 666, tm_count(map));
+        cmc_assert_not_equals(ptr, NULL, map->block);
+
+        /* Nodes are laid out in order */
+        struct treemap_node *node = map->block;
+
+        for (size_t i = 1; i < tm_count(map); i++)
+            cmc_assert(node[i - 1].key < node[i].key);
+
+        /* Compacting twice releases the first block */
+        cmc_assert(tm_compact(map));
+
+        cmc_assert(tm_insert(map, 3000, 0));
+
+        for (size_t i = 0; i < 1000; i++)
+            tm_remove(map, i, NULL);
+
+        cmc_assert_equals(ptr, NULL, map->block);
+        cmc_assert_equals(size_t, 1, tm_count(map));
+        cmc_assert(tm_contains(map, 3000));
+
+        tm_free(map);
+    });
 });
 
 CMC_CREATE_UNIT(CMCTreeMapIter, true, {
@@ -580,6 +979,98 @@ CMC_CREATE_UNIT(CMCTreeMapIter, true, {
 
         tm_free(map);
     });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemap_iter it = tm_iter_lower_bound(map, 10);
+
+        cmc_assert(tm_iter_at_end(&it));
+
+        for (size_t i = 1; i <= 100; i++)
+            tm_insert(map, i * 2, i);
+
+        it = tm_iter_lower_bound(map, 1);
+
+        cmc_assert(tm_iter_at_start(&it));
+        cmc_assert_equals(size_t, 2, tm_iter_key(&it));
+
+        it = tm_iter_lower_bound(map, 51);
+
+        cmc_assert_equals(size_t, 52, tm_iter_key(&it));
+        cmc_assert_equals(size_t, 25, tm_iter_index(&it));
+
+        it = tm_iter_lower_bound(map, 52);
+
+        cmc_assert_equals(size_t, 52, tm_iter_key(&it));
+
+        cmc_assert(tm_iter_next(&it));
+        cmc_assert_equals(size_t, 54, tm_iter_key(&it));
+
+        it = tm_iter_lower_bound(map, 201);
+
+        cmc_assert(tm_iter_at_end(&it));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_upper_bound(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 1; i <= 100; i++)
+            tm_insert(map, i * 2, i);
+
+        struct treemap_iter it = tm_iter_upper_bound(map, 52);
+
+        cmc_assert_equals(size_t, 54, tm_iter_key(&it));
+        cmc_assert_equals(size_t, 26, tm_iter_index(&it));
+
+        cmc_assert(tm_iter_prev(&it));
+        cmc_assert_equals(size_t, 52, tm_iter_key(&it));
+
+        it = tm_iter_upper_bound(map, 200);
+
+        cmc_assert(tm_iter_at_end(&it));
+
+        tm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_insert_hint(), {
+        struct treemap *map = tm_new(tm_fkey, tm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemap_iter it = tm_iter_start(map);
+
+        cmc_assert(tm_insert_hint(map, &it, 10, 10));
+
+        for (size_t i = 1; i < 100; i++)
+        {
+            it = tm_iter_end(map);
+            cmc_assert(tm_insert_hint(map, &it, 10 + i * 10, i));
+        }
+
+        it = tm_iter_lower_bound(map, 500);
+
+        cmc_assert(tm_insert_hint(map, &it, 495, 0));
+        cmc_assert(tm_insert_hint(map, &it, 505, 0));
+        cmc_assert(!tm_insert_hint(map, &it, 500, 0));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, tm_flag(map));
+
+        /* A bad hint still inserts */
+        cmc_assert(tm_insert_hint(map, &it, 5, 0));
+
+        cmc_assert_equals(size_t, 103, tm_count(map));
+        cmc_assert_equals(size_t, 0, tm_rank(map, 5));
+        cmc_assert_equals(size_t, 50, tm_rank(map, 495));
+        cmc_assert_equals(size_t, 52, tm_rank(map, 505));
+
+        tm_free(map);
+    });
 });
 
 #ifdef CMC_TEST_MAIN
@@ -0,0 +1,473 @@
+#ifndef CMC_TESTS_UNT_TREEMULTIMAP_H
+#define CMC_TESTS_UNT_TREEMULTIMAP_H
+
+#include "utl.h"
+
+#define K size_t
+#define V size_t
+#define PFX tmm
+#define SNAME treemultimap
+#include "cmc/treemultimap.h"
+
+struct treemultimap_fkey *tmm_fkey = &(struct treemultimap_fkey){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treemultimap_fval *tmm_fval = &(struct treemultimap_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treemultimap_fkey *tmm_fkey_counter = &(struct treemultimap_fkey){
+    .cmp = k_c_cmp, .cpy = k_c_cpy, .str = k_c_str, .free = k_c_free, .hash = k_c_hash, .pri = k_c_pri
+};
+
+struct treemultimap_fval *tmm_fval_counter = &(struct treemultimap_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Checks links, order, balance and the cardinality of every subtree */
+size_t tmm_check(struct treemultimap *map, struct treemultimap_node *node, struct treemultimap_node *parent,
+                 size_t *height, bool *ok)
+{
+    if (node == NULL)
+    {
+        *height = 0;
+        return 0;
+    }
+
+    size_t h_l, h_r;
+
+    size_t c_l = tmm_check(map, node->left, node, &h_l, ok);
+    size_t c_r = tmm_check(map, node->right, node, &h_r, ok);
+
+    if (node->parent != parent || node->count == 0 || node->count > node->capacity)
+        *ok = false;
+    if (node->left && map->f_key->cmp(node->left->key, node->key) >= 0)
+        *ok = false;
+    if (node->right && map->f_key->cmp(node->right->key, node->key) <= 0)
+        *ok = false;
+    if (h_l > h_r + 1 || h_r > h_l + 1)
+        *ok = false;
+
+    *height = 1 + (h_l > h_r ? h_l : h_r);
+
+    if (node->height != *height || node->cardinality != c_l + c_r + node->count)
+        *ok = false;
+
+    return node->cardinality;
+}
+
+bool tmm_valid(struct treemultimap *map)
+{
+    bool ok = true;
+    size_t height;
+
+    if (tmm_check(map, map->root, NULL, &height, &ok) != map->count)
+        return false;
+
+    return ok;
+}
+
+CMC_CREATE_UNIT(CMCTreeMultiMap, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+        cmc_assert_equals(ptr, NULL, map->root);
+        cmc_assert_equals(size_t, 0, tmm_count(map));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, tmm_flag(map));
+        cmc_assert_equals(ptr, &cmc_alloc_node_default, map->alloc);
+
+        tmm_free(map);
+
+        cmc_assert_equals(ptr, NULL, tmm_new(NULL, tmm_fval));
+        cmc_assert_equals(ptr, NULL, tmm_new(tmm_fkey, NULL));
+    });
+
+    CMC_CREATE_TEST(PFX##_clear(), {
+        k_total_free = 0;
+        v_total_free = 0;
+
+        struct treemultimap *map = tmm_new(tmm_fkey_counter, tmm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert(tmm_insert(map, i % 100, i));
+
+        tmm_clear(map);
+
+        // Keys are freed once per node and values once per pair
+        cmc_assert_equals(int32_t, 100, k_total_free);
+        cmc_assert_equals(int32_t, 300, v_total_free);
+        cmc_assert_equals(size_t, 0, tmm_count(map));
+        cmc_assert_equals(ptr, NULL, map->root);
+
+        tmm_free(map);
+
+        k_total_free = 0;
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(insert[count key_count order], {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(tmm_insert(map, (i * 7) % 50, i));
+
+        cmc_assert_equals(size_t, 1000, tmm_count(map));
+        cmc_assert(tmm_valid(map));
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert_equals(size_t, 20, tmm_key_count(map, i));
+
+        cmc_assert_equals(size_t, 0, tmm_key_count(map, 50));
+
+        // Values of the same key keep their insertion order
+        cmc_assert_equals(size_t, 0, tmm_get(map, 0));
+        cmc_assert_equals(size_t, 50, tmm_get_ref(map, 0)[1]);
+        cmc_assert_equals(size_t, 1, tmm_get(map, 7));
+        cmc_assert_equals(ptr, NULL, tmm_get_ref(map, 50));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tmm_flag(map));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(update, {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t old = 0;
+
+        cmc_assert(!tmm_update(map, 1, 1, &old));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tmm_flag(map));
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert(tmm_insert(map, 1, i));
+
+        cmc_assert(tmm_update(map, 1, 10, &old));
+        cmc_assert_equals(size_t, 0, old);
+        cmc_assert_equals(size_t, 10, tmm_get(map, 1));
+        cmc_assert(!tmm_update(map, 2, 10, &old));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tmm_flag(map));
+
+        size_t *old_values = NULL;
+
+        cmc_assert_equals(size_t, 5, tmm_update_all(map, 1, 20, &old_values));
+        cmc_assert_not_equals(ptr, NULL, old_values);
+        cmc_assert_equals(size_t, 10, old_values[0]);
+        cmc_assert_equals(size_t, 4, old_values[4]);
+
+        for (size_t i = 0; i < 5; i++)
+            cmc_assert_equals(size_t, 20, tmm_get_ref(map, 1)[i]);
+
+        free(old_values);
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove[count key_count order], {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t value;
+
+        cmc_assert(!tmm_remove(map, 1, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tmm_flag(map));
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert(tmm_insert(map, i % 100, i));
+
+        cmc_assert(!tmm_remove(map, 100, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tmm_flag(map));
+
+        // The first value inserted is the first to be removed
+        for (size_t i = 0; i < 100; i++)
+        {
+            cmc_assert(tmm_remove(map, i, &value));
+            cmc_assert_equals(size_t, i, value);
+            cmc_assert_equals(size_t, i + 100, tmm_get(map, i));
+        }
+
+        cmc_assert_equals(size_t, 200, tmm_count(map));
+        cmc_assert(tmm_valid(map));
+
+        for (size_t i = 0; i < 100; i += 2)
+        {
+            cmc_assert(tmm_remove(map, i, NULL));
+            cmc_assert(tmm_remove(map, i, &value));
+            cmc_assert_equals(size_t, i + 200, value);
+            cmc_assert(!tmm_contains(map, i));
+        }
+
+        cmc_assert_equals(size_t, 100, tmm_count(map));
+        cmc_assert(tmm_valid(map));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(remove_all, {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        cmc_assert_equals(size_t, 0, tmm_remove_all(map, 1, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tmm_flag(map));
+
+        for (size_t i = 0; i < 100; i++)
+        {
+            for (size_t j = 0; j <= i % 4; j++)
+                cmc_assert(tmm_insert(map, i, j));
+        }
+
+        cmc_assert_equals(size_t, 250, tmm_count(map));
+
+        size_t *values = NULL;
+
+        cmc_assert_equals(size_t, 4, tmm_remove_all(map, 3, &values));
+        cmc_assert_not_equals(ptr, NULL, values);
+
+        for (size_t j = 0; j < 4; j++)
+            cmc_assert_equals(size_t, j, values[j]);
+
+        free(values);
+
+        size_t count = 246;
+
+        for (size_t i = 0; i < 100; i += 5)
+        {
+            if (i == 3)
+                continue;
+
+            cmc_assert_equals(size_t, i % 4 + 1, tmm_remove_all(map, i, NULL));
+
+            count -= i % 4 + 1;
+
+            cmc_assert_equals(size_t, count, tmm_count(map));
+        }
+
+        cmc_assert_equals(size_t, 0, tmm_remove_all(map, 0, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tmm_flag(map));
+        cmc_assert(tmm_valid(map));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(min_max_floor_ceiling, {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        size_t key = 0;
+        size_t value = 0;
+
+        cmc_assert(!tmm_min(map, &key, &value));
+        cmc_assert(!tmm_max(map, &key, &value));
+
+        for (size_t i = 10; i <= 100; i += 10)
+        {
+            cmc_assert(tmm_insert(map, i, i + 1));
+            cmc_assert(tmm_insert(map, i, i + 2));
+        }
+
+        cmc_assert(tmm_min(map, &key, &value));
+        cmc_assert_equals(size_t, 10, key);
+        cmc_assert_equals(size_t, 11, value);
+        cmc_assert(tmm_max(map, &key, &value));
+        cmc_assert_equals(size_t, 100, key);
+        cmc_assert_equals(size_t, 101, value);
+
+        cmc_assert(tmm_floor(map, 55, &key, &value));
+        cmc_assert_equals(size_t, 50, key);
+        cmc_assert(tmm_ceiling(map, 55, &key, &value));
+        cmc_assert_equals(size_t, 60, key);
+        cmc_assert_equals(size_t, 61, value);
+        cmc_assert(!tmm_floor(map, 5, &key, &value));
+        cmc_assert(!tmm_ceiling(map, 101, &key, &value));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(copy_of_equals, {
+        k_total_cpy = 0;
+        v_total_cpy = 0;
+        k_total_free = 0;
+        v_total_free = 0;
+
+        struct treemultimap *map1 = tmm_new(tmm_fkey_counter, tmm_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, map1);
+
+        for (size_t i = 0; i < 150; i++)
+            cmc_assert(tmm_insert(map1, i % 50, i));
+
+        struct treemultimap *map2 = tmm_copy_of(map1);
+
+        cmc_assert_not_equals(ptr, NULL, map2);
+        cmc_assert_equals(int32_t, 50, k_total_cpy);
+        cmc_assert_equals(int32_t, 150, v_total_cpy);
+        cmc_assert(tmm_valid(map2));
+        cmc_assert(tmm_equals(map1, map2));
+
+        // Same pairs in a different order
+        cmc_assert(tmm_remove(map2, 10, NULL));
+        cmc_assert(tmm_insert(map2, 10, 10));
+        cmc_assert(!tmm_equals(map1, map2));
+
+        tmm_free(map1);
+        tmm_free(map2);
+
+        cmc_assert_equals(int32_t, 100, k_total_free);
+        cmc_assert_equals(int32_t, 300, v_total_free);
+
+        k_total_cpy = 0;
+        v_total_cpy = 0;
+        k_total_free = 0;
+        v_total_free = 0;
+    });
+});
+
+CMC_CREATE_UNIT(CMCTreeMultiMapIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        struct treemultimap_iter it = tmm_iter_start(map);
+
+        cmc_assert_equals(ptr, map, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert(tmm_iter_at_start(&it));
+        cmc_assert(tmm_iter_at_end(&it));
+
+        cmc_assert(tmm_insert(map, 1, 10));
+        cmc_assert(tmm_insert(map, 1, 11));
+        cmc_assert(tmm_insert(map, 2, 20));
+
+        it = tmm_iter_start(map);
+
+        cmc_assert_equals(size_t, 0, tmm_iter_index(&it));
+        cmc_assert_equals(size_t, 1, tmm_iter_key(&it));
+        cmc_assert_equals(size_t, 10, tmm_iter_value(&it));
+        cmc_assert(!tmm_iter_at_end(&it));
+
+        it = tmm_iter_end(map);
+
+        cmc_assert_equals(size_t, 2, tmm_iter_index(&it));
+        cmc_assert_equals(size_t, 2, tmm_iter_key(&it));
+        cmc_assert_equals(size_t, 20, *tmm_iter_rvalue(&it));
+        cmc_assert(tmm_iter_at_end(&it));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next_prev(), {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert(tmm_insert(map, i % 100, i));
+
+        size_t index = 0;
+
+        // Sorted by key and then by insertion order
+        for (struct treemultimap_iter it = tmm_iter_start(map); !tmm_iter_at_end(&it); tmm_iter_next(&it))
+        {
+            cmc_assert_equals(size_t, index / 3, tmm_iter_key(&it));
+            cmc_assert_equals(size_t, index / 3 + (index % 3) * 100, tmm_iter_value(&it));
+            cmc_assert_equals(size_t, index, tmm_iter_index(&it));
+
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 300, index);
+
+        for (struct treemultimap_iter it = tmm_iter_end(map); !tmm_iter_at_start(&it); tmm_iter_prev(&it))
+        {
+            index--;
+
+            cmc_assert_equals(size_t, index / 3 + (index % 3) * 100, tmm_iter_value(&it));
+            cmc_assert_equals(size_t, index, tmm_iter_index(&it));
+        }
+
+        cmc_assert_equals(size_t, 0, index);
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 0; i < 300; i++)
+            cmc_assert(tmm_insert(map, i % 100, i));
+
+        struct treemultimap_iter it = tmm_iter_start(map);
+
+        for (size_t i = 299; i > 0; i -= 7)
+        {
+            cmc_assert(tmm_iter_go_to(&it, i));
+            cmc_assert_equals(size_t, i / 3, tmm_iter_key(&it));
+            cmc_assert_equals(size_t, i / 3 + (i % 3) * 100, tmm_iter_value(&it));
+
+            if (i < 7)
+                break;
+        }
+
+        cmc_assert(!tmm_iter_go_to(&it, 300));
+
+        tmm_free(map);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct treemultimap *map = tmm_new(tmm_fkey, tmm_fval);
+
+        cmc_assert_not_equals(ptr, NULL, map);
+
+        for (size_t i = 10; i <= 100; i += 10)
+        {
+            cmc_assert(tmm_insert(map, i, i));
+            cmc_assert(tmm_insert(map, i, i + 1));
+        }
+
+        struct treemultimap_iter it = tmm_iter_lower_bound(map, 30);
+
+        cmc_assert_equals(size_t, 30, tmm_iter_key(&it));
+        cmc_assert_equals(size_t, 30, tmm_iter_value(&it));
+        cmc_assert_equals(size_t, 4, tmm_iter_index(&it));
+
+        it = tmm_iter_upper_bound(map, 30);
+
+        cmc_assert_equals(size_t, 40, tmm_iter_key(&it));
+        cmc_assert_equals(size_t, 6, tmm_iter_index(&it));
+
+        it = tmm_iter_upper_bound(map, 100);
+
+        cmc_assert(tmm_iter_at_end(&it));
+
+        tmm_free(map);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCTreeMultiMap() + CMCTreeMultiMapIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCTreeMultiMap Suit : %-41s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_TREEMULTIMAP_H */
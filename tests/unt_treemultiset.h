@@ -0,0 +1,552 @@
+#ifndef CMC_TESTS_UNT_TREEMULTISET_H
+#define CMC_TESTS_UNT_TREEMULTISET_H
+
+#include "utl.h"
+
+#define V size_t
+#define PFX tms
+#define SNAME treemultiset
+#include "cmc/treemultiset.h"
+
+struct treemultiset_fval *tms_fval = &(struct treemultiset_fval){
+    .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
+};
+
+struct treemultiset_fval *tms_fval_counter = &(struct treemultiset_fval){
+    .cmp = v_c_cmp, .cpy = v_c_cpy, .str = v_c_str, .free = v_c_free, .hash = v_c_hash, .pri = v_c_pri
+};
+
+/* Checks links, order, balance and the cardinality of every subtree */
+size_t tms_check(struct treemultiset *set, struct treemultiset_node *node, struct treemultiset_node *parent,
+                 size_t *height, bool *ok)
+{
+    if (node == NULL)
+    {
+        *height = 0;
+        return 0;
+    }
+
+    size_t h_l, h_r;
+
+    size_t c_l = tms_check(set, node->left, node, &h_l, ok);
+    size_t c_r = tms_check(set, node->right, node, &h_r, ok);
+
+    if (node->parent != parent || node->multiplicity == 0)
+        *ok = false;
+    if (node->left && set->f_val->cmp(node->left->value, node->value) >= 0)
+        *ok = false;
+    if (node->right && set->f_val->cmp(node->right->value, node->value) <= 0)
+        *ok = false;
+    if (h_l > h_r + 1 || h_r > h_l + 1)
+        *ok = false;
+
+    *height = 1 + (h_l > h_r ? h_l : h_r);
+
+    if (node->height != *height || node->cardinality != c_l + c_r + node->multiplicity)
+        *ok = false;
+
+    return node->cardinality;
+}
+
+bool tms_valid(struct treemultiset *set)
+{
+    bool ok = true;
+    size_t height;
+
+    if (tms_check(set, set->root, NULL, &height, &ok) != set->cardinality)
+        return false;
+
+    return ok;
+}
+
+CMC_CREATE_UNIT(CMCTreeMultiSet, true, {
+    CMC_CREATE_TEST(PFX##_new(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(ptr, NULL, set->root);
+        cmc_assert_equals(size_t, 0, tms_count(set));
+        cmc_assert_equals(size_t, 0, tms_cardinality(set));
+        cmc_assert_equals(int32_t, CMC_FLAG_OK, tms_flag(set));
+        cmc_assert_equals(ptr, tms_fval, set->f_val);
+        cmc_assert_equals(ptr, &cmc_alloc_node_default, set->alloc);
+
+        tms_free(set);
+
+        cmc_assert_equals(ptr, NULL, tms_new(NULL));
+    });
+
+    CMC_CREATE_TEST(PFX##_clear(), {
+        v_total_free = 0;
+
+        struct treemultiset *set = tms_new(tms_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(tms_insert_many(set, i, i % 3 + 1));
+
+        cmc_assert_equals(size_t, 100, tms_count(set));
+        cmc_assert_equals(size_t, 199, tms_cardinality(set));
+
+        tms_clear(set);
+
+        // Each distinct element is freed once
+        cmc_assert_equals(int32_t, 100, v_total_free);
+        cmc_assert_equals(size_t, 0, tms_count(set));
+        cmc_assert_equals(size_t, 0, tms_cardinality(set));
+        cmc_assert_equals(ptr, NULL, set->root);
+
+        tms_free(set);
+
+        v_total_free = 0;
+    });
+
+    CMC_CREATE_TEST(insert[count cardinality multiplicity], {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 1; i <= 100; i++)
+        {
+            for (size_t j = 0; j < i; j++)
+                cmc_assert(tms_insert(set, i));
+        }
+
+        cmc_assert_equals(size_t, 100, tms_count(set));
+        cmc_assert_equals(size_t, 5050, tms_cardinality(set));
+        cmc_assert(tms_valid(set));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert_equals(size_t, i, tms_multiplicity_of(set, i));
+
+        cmc_assert_equals(size_t, 0, tms_multiplicity_of(set, 0));
+        cmc_assert_equals(size_t, 0, tms_multiplicity_of(set, 101));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(insert_many, {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert(tms_insert_many(set, 10, 5));
+        cmc_assert(tms_insert_many(set, 10, 5));
+        cmc_assert(tms_insert_many(set, 20, 0));
+
+        cmc_assert_equals(size_t, 1, tms_count(set));
+        cmc_assert_equals(size_t, 10, tms_cardinality(set));
+        cmc_assert_equals(size_t, 10, tms_multiplicity_of(set, 10));
+        cmc_assert(!tms_contains(set, 20));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(update, {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert(tms_update(set, 5, 3));
+        cmc_assert(tms_update(set, 6, 0));
+        cmc_assert_equals(size_t, 1, tms_count(set));
+        cmc_assert_equals(size_t, 3, tms_cardinality(set));
+
+        cmc_assert(tms_update(set, 5, 10));
+        cmc_assert_equals(size_t, 10, tms_multiplicity_of(set, 5));
+        cmc_assert_equals(size_t, 10, tms_cardinality(set));
+
+        cmc_assert(tms_update(set, 5, 0));
+        cmc_assert(tms_empty(set));
+        cmc_assert_equals(size_t, 0, tms_cardinality(set));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(remove[count cardinality multiplicity], {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert(!tms_remove(set, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tms_flag(set));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_insert_many(set, i, 2));
+
+        cmc_assert(!tms_remove(set, 101));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tms_flag(set));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_remove(set, i));
+
+        cmc_assert_equals(size_t, 100, tms_count(set));
+        cmc_assert_equals(size_t, 100, tms_cardinality(set));
+        cmc_assert(tms_valid(set));
+
+        for (size_t i = 1; i <= 100; i += 2)
+            cmc_assert(tms_remove(set, i));
+
+        cmc_assert_equals(size_t, 50, tms_count(set));
+        cmc_assert_equals(size_t, 50, tms_cardinality(set));
+        cmc_assert(!tms_contains(set, 1));
+        cmc_assert(tms_contains(set, 2));
+        cmc_assert(tms_valid(set));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(remove_all[count cardinality multiplicity], {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert_equals(size_t, 0, tms_remove_all(set, 1));
+        cmc_assert_equals(int32_t, CMC_FLAG_EMPTY, tms_flag(set));
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_insert_many(set, i, i));
+
+        cmc_assert_equals(size_t, 0, tms_remove_all(set, 101));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tms_flag(set));
+
+        size_t cardinality = 5050;
+
+        for (size_t i = 1; i <= 100; i += 3)
+        {
+            cmc_assert_equals(size_t, i, tms_remove_all(set, i));
+
+            cardinality -= i;
+
+            cmc_assert_equals(size_t, cardinality, tms_cardinality(set));
+        }
+
+        cmc_assert_equals(size_t, 66, tms_count(set));
+        cmc_assert(tms_valid(set));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(min_max_floor_ceiling, {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t value = 0;
+
+        cmc_assert(!tms_min(set, &value));
+        cmc_assert(!tms_max(set, &value));
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(tms_insert_many(set, i, 3));
+
+        cmc_assert(tms_min(set, &value));
+        cmc_assert_equals(size_t, 10, value);
+        cmc_assert(tms_max(set, &value));
+        cmc_assert_equals(size_t, 100, value);
+
+        cmc_assert(tms_floor(set, 55, &value));
+        cmc_assert_equals(size_t, 50, value);
+        cmc_assert(tms_ceiling(set, 55, &value));
+        cmc_assert_equals(size_t, 60, value);
+        cmc_assert(tms_ceiling(set, 60, &value));
+        cmc_assert_equals(size_t, 60, value);
+        cmc_assert(!tms_floor(set, 5, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, tms_flag(set));
+        cmc_assert(!tms_ceiling(set, 101, &value));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(random, {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t model[64] = { 0 };
+        size_t count = 0;
+        size_t cardinality = 0;
+        size_t state = 12345;
+
+        for (size_t i = 0; i < 5000; i++)
+        {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+
+            size_t value = (state >> 33) % 64;
+            size_t op = (state >> 20) % 4;
+
+            if (op == 0 || op == 1)
+            {
+                cmc_assert(tms_insert(set, value));
+
+                count += model[value] == 0;
+                cardinality++;
+                model[value]++;
+            }
+            else if (op == 2)
+            {
+                bool removed = tms_remove(set, value);
+
+                cmc_assert_equals(bool, model[value] > 0, removed);
+
+                if (removed)
+                {
+                    count -= model[value] == 1;
+                    cardinality--;
+                    model[value]--;
+                }
+            }
+            else
+            {
+                cmc_assert_equals(size_t, model[value], tms_remove_all(set, value));
+
+                count -= model[value] > 0;
+                cardinality -= model[value];
+                model[value] = 0;
+            }
+        }
+
+        cmc_assert(tms_valid(set));
+        cmc_assert_equals(size_t, count, tms_count(set));
+        cmc_assert_equals(size_t, cardinality, tms_cardinality(set));
+
+        for (size_t i = 0; i < 64; i++)
+            cmc_assert_equals(size_t, model[i], tms_multiplicity_of(set, i));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(copy_of_equals, {
+        v_total_cpy = 0;
+        v_total_free = 0;
+
+        struct treemultiset *set1 = tms_new(tms_fval_counter);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+
+        for (size_t i = 0; i < 50; i++)
+            cmc_assert(tms_insert_many(set1, i, i + 1));
+
+        struct treemultiset *set2 = tms_copy_of(set1);
+
+        cmc_assert_not_equals(ptr, NULL, set2);
+        cmc_assert_equals(int32_t, 50, v_total_cpy);
+        cmc_assert(tms_valid(set2));
+        cmc_assert(tms_equals(set1, set2));
+
+        cmc_assert(tms_remove(set2, 10));
+        cmc_assert(!tms_equals(set1, set2));
+        cmc_assert(tms_insert(set2, 10));
+        cmc_assert(tms_equals(set1, set2));
+
+        // Same cardinality but different multiplicities
+        cmc_assert(tms_remove(set2, 10));
+        cmc_assert(tms_insert(set2, 11));
+        cmc_assert(!tms_equals(set1, set2));
+
+        tms_free(set1);
+        tms_free(set2);
+
+        cmc_assert_equals(int32_t, 100, v_total_free);
+
+        v_total_cpy = 0;
+        v_total_free = 0;
+    });
+});
+
+CMC_CREATE_UNIT(CMCTreeMultiSetIter, true, {
+    CMC_CREATE_TEST(PFX##_iter_start(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        struct treemultiset_iter it = tms_iter_start(set);
+
+        cmc_assert_equals(ptr, set, it.target);
+        cmc_assert_equals(ptr, NULL, it.cursor);
+        cmc_assert_equals(size_t, 0, it.index);
+        cmc_assert(tms_iter_at_start(&it));
+        cmc_assert(tms_iter_at_end(&it));
+
+        cmc_assert(tms_insert_many(set, 1, 2));
+        cmc_assert(tms_insert_many(set, 2, 3));
+
+        it = tms_iter_start(set);
+
+        cmc_assert_equals(size_t, 0, tms_iter_index(&it));
+        cmc_assert_equals(size_t, 1, tms_iter_value(&it));
+        cmc_assert_equals(size_t, 2, tms_iter_multiplicity(&it));
+        cmc_assert(tms_iter_at_start(&it));
+        cmc_assert(!tms_iter_at_end(&it));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_end(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        cmc_assert(tms_insert_many(set, 1, 2));
+        cmc_assert(tms_insert_many(set, 2, 3));
+
+        struct treemultiset_iter it = tms_iter_end(set);
+
+        cmc_assert_equals(size_t, 4, tms_iter_index(&it));
+        cmc_assert_equals(size_t, 2, tms_iter_value(&it));
+        cmc_assert(!tms_iter_at_start(&it));
+        cmc_assert(tms_iter_at_end(&it));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_next(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_insert_many(set, i, i));
+
+        size_t value = 1;
+        size_t copies = 0;
+        size_t index = 0;
+
+        // Every value is repeated by its multiplicity
+        for (struct treemultiset_iter it = tms_iter_start(set); !tms_iter_at_end(&it); tms_iter_next(&it))
+        {
+            if (copies == value)
+            {
+                value++;
+                copies = 0;
+            }
+
+            cmc_assert_equals(size_t, value, tms_iter_value(&it));
+            cmc_assert_equals(size_t, index, tms_iter_index(&it));
+
+            copies++;
+            index++;
+        }
+
+        cmc_assert_equals(size_t, 100, value);
+        cmc_assert_equals(size_t, 5050, index);
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_prev(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_insert_many(set, i, i));
+
+        size_t value = 100;
+        size_t copies = 0;
+        size_t index = 5050;
+
+        for (struct treemultiset_iter it = tms_iter_end(set); !tms_iter_at_start(&it); tms_iter_prev(&it))
+        {
+            if (copies == value)
+            {
+                value--;
+                copies = 0;
+            }
+
+            index--;
+
+            cmc_assert_equals(size_t, value, tms_iter_value(&it));
+            cmc_assert_equals(size_t, index, tms_iter_index(&it));
+
+            copies++;
+        }
+
+        cmc_assert_equals(size_t, 1, value);
+        cmc_assert_equals(size_t, 0, index);
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_go_to(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 1; i <= 100; i++)
+            cmc_assert(tms_insert_many(set, i, i));
+
+        struct treemultiset_iter it = tms_iter_start(set);
+
+        // The element at index i * (i + 1) / 2 is the first copy of i + 1
+        for (size_t i = 99; i > 0; i--)
+        {
+            cmc_assert(tms_iter_go_to(&it, i * (i + 1) / 2));
+            cmc_assert_equals(size_t, i + 1, tms_iter_value(&it));
+            cmc_assert_equals(size_t, i * (i + 1) / 2, tms_iter_index(&it));
+
+            cmc_assert(tms_iter_prev(&it));
+            cmc_assert_equals(size_t, i, tms_iter_value(&it));
+        }
+
+        cmc_assert(!tms_iter_go_to(&it, 5050));
+
+        cmc_assert(tms_iter_go_to(&it, 5049));
+        cmc_assert_equals(size_t, 100, tms_iter_value(&it));
+        cmc_assert(!tms_iter_advance(&it, 1));
+
+        cmc_assert(tms_iter_rewind(&it, 5049));
+        cmc_assert_equals(size_t, 1, tms_iter_value(&it));
+        cmc_assert_equals(size_t, 0, tms_iter_index(&it));
+
+        tms_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound(), {
+        struct treemultiset *set = tms_new(tms_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 10; i <= 100; i += 10)
+            cmc_assert(tms_insert_many(set, i, 2));
+
+        struct treemultiset_iter it = tms_iter_lower_bound(set, 30);
+
+        cmc_assert_equals(size_t, 30, tms_iter_value(&it));
+        cmc_assert_equals(size_t, 4, tms_iter_index(&it));
+
+        it = tms_iter_upper_bound(set, 30);
+
+        cmc_assert_equals(size_t, 40, tms_iter_value(&it));
+        cmc_assert_equals(size_t, 6, tms_iter_index(&it));
+
+        it = tms_iter_lower_bound(set, 5);
+
+        cmc_assert(tms_iter_at_start(&it));
+        cmc_assert_equals(size_t, 10, tms_iter_value(&it));
+
+        it = tms_iter_upper_bound(set, 100);
+
+        cmc_assert(tms_iter_at_end(&it));
+
+        tms_free(set);
+    });
+});
+
+#ifdef CMC_TEST_MAIN
+int main(void)
+{
+    int result = CMCTreeMultiSet() + CMCTreeMultiSetIter();
+
+    printf(" +---------------------------------------------------------------+");
+    printf("\n");
+    printf(" | CMCTreeMultiSet Suit : %-41s |\n", result == 0 ? "PASSED" : "FAILED");
+    printf(" +---------------------------------------------------------------+");
+    printf("\n\n\n");
+
+    return result;
+}
+#endif
+
+#endif /* CMC_TESTS_UNT_TREEMULTISET_H */
@@ -12,6 +12,27 @@ struct treeset_fval *ts_fval = &(struct treeset_fval){
     .cmp = cmc_size_cmp, .cpy = NULL, .str = cmc_size_str, .free = NULL, .hash = cmc_size_hash, .pri = cmc_size_cmp
 };
 
+/* Set functions with the arithmetic kernels */
+#undef V
+#define V uint32_t
+#define PFX tsa
+#define SNAME treeset_arith
+#define CMC_ARITHMETIC_V
+#include "cmc/treeset.h"
+
+#include "undef.h"
+
+struct treeset_arith_fval *tsa_fval = &(struct treeset_arith_fval){
+    .cmp = cmc_u32_cmp, .cpy = NULL, .str = cmc_u32_str, .free = NULL, .hash = cmc_u32_hash, .pri = cmc_u32_cmp
+};
+
+bool ts_range_count(size_t value, void *args)
+{
+    (void)value;
+    *(size_t *)args += 1;
+    return true;
+}
+
 CMC_CREATE_UNIT(CMCTreeSet, true, {
     CMC_CREATE_TEST(new, {
         struct treeset *set = ts_new(ts_fval);
@@ -102,6 +123,304 @@ CMC_CREATE_UNIT(CMCTreeSet, true, {
         ts_free(set);
         ts_free(set2);
     });
+
+    CMC_CREATE_TEST(PFX##_rank(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert(ts_insert(set, (i * 7919) % 1009));
+
+        for (size_t i = 0; i < 1009; i += 4)
+            ts_remove(set, i);
+
+        size_t expected = 0;
+        struct treeset_iter it = ts_iter_start(set);
+
+        for (; !ts_iter_at_end(&it); ts_iter_next(&it))
+        {
+            size_t value = 0;
+            cmc_assert(ts_select(set, expected, &value));
+            cmc_assert_equals(size_t, ts_iter_value(&it), value);
+            cmc_assert_equals(size_t, expected, ts_rank(set, value));
+            expected++;
+        }
+
+        cmc_assert_equals(size_t, ts_count(set), expected);
+        cmc_assert(!ts_select(set, expected, NULL));
+        cmc_assert_equals(int32_t, CMC_FLAG_RANGE, ts_flag(set));
+
+        cmc_assert_equals(size_t, ts_count(set), ts_count_range(set, 0, 1009));
+        cmc_assert_equals(size_t, 0, ts_count_range(set, 8, 9));
+        cmc_assert_equals(size_t, 3, ts_count_range(set, 8, 12));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_floor() and _ceiling(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t value = 0;
+
+        for (size_t i = 1; i <= 100; i++)
+            ts_insert(set, i * 10);
+
+        cmc_assert(!ts_floor(set, 5, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, ts_flag(set));
+        cmc_assert(ts_floor(set, 15, &value));
+        cmc_assert_equals(size_t, 10, value);
+
+        cmc_assert(!ts_ceiling(set, 1005, &value));
+        cmc_assert_equals(int32_t, CMC_FLAG_NOT_FOUND, ts_flag(set));
+        cmc_assert(ts_ceiling(set, 15, &value));
+        cmc_assert_equals(size_t, 20, value);
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_range() and _remove_range(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        size_t total = 0;
+
+        for (size_t i = 0; i < 1000; i++)
+            ts_insert(set, i);
+
+        cmc_assert_equals(size_t, 250, ts_range(set, 250, 500, ts_range_count, &total));
+        cmc_assert_equals(size_t, 250, total);
+
+        cmc_assert_equals(size_t, 250, ts_remove_range(set, 250, 500));
+        cmc_assert_equals(size_t, 750, ts_count(set));
+        cmc_assert_equals(size_t, 0, ts_range(set, 250, 500, ts_range_count, &total));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(bool, i < 250 || i >= 500, ts_contains(set, i));
+
+        cmc_assert_equals(size_t, 750, ts_remove_range(set, 0, 1000));
+        cmc_assert(ts_empty(set));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_from_sorted(), {
+        size_t values[1000];
+
+        for (size_t i = 0; i < 1000; i++)
+            values[i] = i * 3;
+
+        struct treeset *set = ts_from_sorted(values, 1000, ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert_equals(size_t, 1000, ts_count(set));
+
+        for (size_t i = 0; i < 1000; i++)
+        {
+            cmc_assert(ts_contains(set, i * 3));
+            cmc_assert_equals(size_t, i, ts_rank(set, i * 3));
+        }
+
+        /* The tree is still a valid AVL tree */
+        cmc_assert(ts_insert(set, 1));
+        cmc_assert(ts_remove(set, 0));
+        cmc_assert_equals(size_t, 1000, ts_count(set));
+
+        ts_free(set);
+
+        values[10] = values[9];
+
+        cmc_assert_equals(ptr, NULL, ts_from_sorted(values, 1000, ts_fval));
+
+        set = ts_from_sorted(values, 0, ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+        cmc_assert(ts_empty(set));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(set operations, {
+        struct treeset *set1 = ts_new(ts_fval);
+        struct treeset *set2 = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+
+        /* set1 = [0, 300) and set2 = [200, 500) */
+        for (size_t i = 0; i < 300; i++)
+        {
+            ts_insert(set1, i);
+            ts_insert(set2, i + 200);
+        }
+
+        struct treeset *result = ts_union(set1, set2);
+
+        cmc_assert_equals(size_t, 500, ts_count(result));
+        cmc_assert(ts_contains(result, 0));
+        cmc_assert(ts_contains(result, 499));
+        ts_free(result);
+
+        result = ts_intersection(set1, set2);
+
+        cmc_assert_equals(size_t, 100, ts_count(result));
+        cmc_assert(!ts_contains(result, 199));
+        cmc_assert(ts_contains(result, 200));
+        cmc_assert(ts_contains(result, 299));
+        ts_free(result);
+
+        result = ts_difference(set1, set2);
+
+        cmc_assert_equals(size_t, 200, ts_count(result));
+        cmc_assert(ts_contains(result, 199));
+        cmc_assert(!ts_contains(result, 200));
+        ts_free(result);
+
+        result = ts_symmetric_difference(set1, set2);
+
+        cmc_assert_equals(size_t, 400, ts_count(result));
+        cmc_assert(!ts_contains(result, 250));
+        cmc_assert(ts_contains(result, 499));
+        ts_free(result);
+
+        ts_free(set1);
+        ts_free(set2);
+    });
+
+    CMC_CREATE_TEST(set operations[arithmetic], {
+        struct treeset *set1 = ts_new(ts_fval);
+        struct treeset *set2 = ts_new(ts_fval);
+        struct treeset_arith *seta1 = tsa_new(tsa_fval);
+        struct treeset_arith *seta2 = tsa_new(tsa_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+        cmc_assert_not_equals(ptr, NULL, seta1);
+        cmc_assert_not_equals(ptr, NULL, seta2);
+
+        for (uint32_t round = 0; round < 2; round++)
+        {
+            /* The second round is skewed enough to use galloping */
+            for (uint32_t i = 0; i < 10000; i++)
+            {
+                ts_insert(set1, i * 2);
+                tsa_insert(seta1, i * 2);
+
+                if (round == 0 || i % 500 == 0)
+                {
+                    ts_insert(set2, i * 3);
+                    tsa_insert(seta2, i * 3);
+                }
+            }
+
+            for (size_t op = 0; op < 2; op++)
+            {
+                struct treeset *expected = op == 0 ? ts_union(set1, set2) : ts_intersection(set2, set1);
+                struct treeset_arith *result = op == 0 ? tsa_union(seta1, seta2) : tsa_intersection(seta2, seta1);
+
+                cmc_assert_not_equals(ptr, NULL, expected);
+                cmc_assert_not_equals(ptr, NULL, result);
+                cmc_assert_equals(size_t, ts_count(expected), tsa_count(result));
+
+                struct treeset_iter it = ts_iter_start(expected);
+
+                for (; !ts_iter_at_end(&it); ts_iter_next(&it))
+                    cmc_assert(tsa_contains(result, (uint32_t)ts_iter_value(&it)));
+
+                ts_free(expected);
+                tsa_free(result);
+            }
+
+            ts_clear(set1);
+            ts_clear(set2);
+            tsa_clear(seta1);
+            tsa_clear(seta2);
+        }
+
+        ts_free(set1);
+        ts_free(set2);
+        tsa_free(seta1);
+        tsa_free(seta2);
+    });
+
+    CMC_CREATE_TEST(parallel set operations, {
+        struct treeset *set1 = ts_new(ts_fval);
+        struct treeset *set2 = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set1);
+        cmc_assert_not_equals(ptr, NULL, set2);
+
+        for (size_t i = 0; i < 10000; i++)
+        {
+            ts_insert(set1, i * 2);
+            ts_insert(set2, i * 3);
+        }
+
+        struct treeset *expected = ts_union(set1, set2);
+        struct treeset *result = ts_union_parallel(set1, set2, 4);
+
+        cmc_assert(ts_equals(expected, result));
+        ts_free(expected);
+        ts_free(result);
+
+        expected = ts_intersection(set1, set2);
+        result = ts_intersection_parallel(set1, set2, 3);
+
+        cmc_assert(ts_equals(expected, result));
+        cmc_assert_equals(size_t, 3334, ts_count(result));
+        ts_free(expected);
+        ts_free(result);
+
+        expected = ts_difference(set1, set2);
+        result = ts_difference_parallel(set1, set2, 8);
+
+        cmc_assert(ts_equals(expected, result));
+        ts_free(expected);
+        ts_free(result);
+
+        expected = ts_symmetric_difference(set2, set1);
+        result = ts_symmetric_difference_parallel(set2, set1, 5);
+
+        cmc_assert(ts_equals(expected, result));
+
+        /* The joined tree is a valid AVL tree with correct ranks */
+        for (size_t i = 0; i < ts_count(result); i++)
+        {
+            size_t value = 0;
+
+            cmc_assert(ts_select(result, i, &value));
+            cmc_assert_equals(size_t, i, ts_rank(result, value));
+        }
+
+        ts_free(expected);
+        ts_free(result);
+
+        ts_free(set1);
+        ts_free(set2);
+    });
+
+    CMC_CREATE_TEST(PFX##_compact(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i < 1000; i++)
+            ts_insert(set, (i * 7919) % 1000);
+
+        cmc_assert(ts_compact(set));
+        cmc_assert_equals(size_t, 1000, ts_count(set));
+
+        for (size_t i = 0; i < 1000; i++)
+            cmc_assert_equals(size_t, i, ts_rank(set, i));
+
+        cmc_assert_equals(size_t, 800, ts_remove_range(set, 100, 900));
+        cmc_assert_equals(size_t, 200, ts_count(set));
+
+        ts_free(set);
+    });
 });
 
 CMC_CREATE_UNIT(CMCTreeSetIter, true, {
@@ -506,6 +825,54 @@ CMC_CREATE_UNIT(CMCTreeSetIter, true, {
 
         ts_free(set);
     });
+
+    CMC_CREATE_TEST(PFX##_iter_lower_bound() and _iter_upper_bound(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 1; i <= 100; i++)
+            ts_insert(set, i * 2);
+
+        struct treeset_iter it = ts_iter_lower_bound(set, 51);
+
+        cmc_assert_equals(size_t, 52, ts_iter_value(&it));
+        cmc_assert_equals(size_t, 25, ts_iter_index(&it));
+
+        it = ts_iter_upper_bound(set, 52);
+
+        cmc_assert_equals(size_t, 54, ts_iter_value(&it));
+        cmc_assert_equals(size_t, 26, ts_iter_index(&it));
+
+        it = ts_iter_upper_bound(set, 200);
+
+        cmc_assert(ts_iter_at_end(&it));
+
+        ts_free(set);
+    });
+
+    CMC_CREATE_TEST(PFX##_insert_hint(), {
+        struct treeset *set = ts_new(ts_fval);
+
+        cmc_assert_not_equals(ptr, NULL, set);
+
+        for (size_t i = 0; i < 100; i++)
+            cmc_assert(ts_insert(set, i * 10));
+
+        struct treeset_iter it = ts_iter_lower_bound(set, 500);
+
+        cmc_assert(ts_insert_hint(set, &it, 495));
+        cmc_assert(ts_insert_hint(set, &it, 505));
+        cmc_assert(ts_insert_hint(set, &it, 1000));
+        cmc_assert(!ts_insert_hint(set, &it, 500));
+        cmc_assert_equals(int32_t, CMC_FLAG_DUPLICATE, ts_flag(set));
+
+        cmc_assert_equals(size_t, 103, ts_count(set));
+        cmc_assert_equals(size_t, 50, ts_rank(set, 495));
+        cmc_assert_equals(size_t, 52, ts_rank(set, 505));
+
+        ts_free(set);
+    });
 });
 
 #ifdef CMC_TEST_MAIN
@@ -141,4 +141,32 @@ static struct CMC_ALLOC_NODE_NAME *custom_alloc = &(struct CMC_ALLOC_NODE_NAME){
     .free = free,
 };
 
+/* Counts the calls that allocate memory */
+int32_t alloc_total_calls = 0;
+
+void *counting_malloc(size_t size)
+{
+    alloc_total_calls++;
+    return malloc(size);
+}
+
+void *counting_calloc(size_t count, size_t size)
+{
+    alloc_total_calls++;
+    return calloc(count, size);
+}
+
+void *counting_realloc(void *ptr, size_t size)
+{
+    alloc_total_calls++;
+    return realloc(ptr, size);
+}
+
+static struct CMC_ALLOC_NODE_NAME *counting_alloc = &(struct CMC_ALLOC_NODE_NAME){
+    .malloc = counting_malloc,
+    .calloc = counting_calloc,
+    .realloc = counting_realloc,
+    .free = free,
+};
+
 #endif /* CMC_TESTS_UTL */